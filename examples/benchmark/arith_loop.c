@@ -0,0 +1,18 @@
+// 算术密集循环（性能测试用）
+// 没有函数调用和内存访问，主要开销在解释器的分派和操作数栈上
+
+int main() {
+    int i;
+    int sum = 0;
+    int x = 7;
+
+    for (i = 0; i < 2000; i = i + 1) {
+        x = (x * 13 + 7) % 1000;
+        sum = sum + x * 2 - i / 3;
+        if (sum > 100000) {
+            sum = sum - 100000;
+        }
+    }
+
+    return sum;
+}
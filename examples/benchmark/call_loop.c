@@ -0,0 +1,66 @@
+// 热循环里调用小函数（性能测试用）
+// 每次调用都要预留返回值、压参数、建立和恢复栈帧，函数体本身只有几条指令；
+// -O2 把这些叶子函数内联到循环里，返回结构体的 makePoint 和递归的 fib 保持调用
+
+struct Point {
+    int x;
+    int y;
+};
+
+int g_count;
+
+int square(int x) {
+    return x * x;
+}
+
+int max(int a, int b) {
+    if (a > b) {
+        return a;
+    }
+    return b;
+}
+
+int clamp(int v, int lo, int hi) {
+    int r = v;
+    if (r < lo) r = lo;
+    if (r > hi) r = hi;
+    return r;
+}
+
+void tick() {
+    g_count = g_count + 1;
+}
+
+struct Point makePoint(int x, int y) {
+    struct Point p;
+    p.x = x;
+    p.y = y;
+    return p;
+}
+
+int manhattan(struct Point p) {
+    return p.x + p.y;
+}
+
+int fib(int n) {
+    if (n < 2) return n;
+    return fib(n - 1) + fib(n - 2);
+}
+
+int main() {
+    int i;
+    int sum = 0;
+
+    for (i = 0; i < 2000; i = i + 1) {
+        sum = sum + square(i % 100) - max(i % 7, 3);
+        sum = sum + clamp(i - 1000, -50, 50);
+        struct Point p = makePoint(i % 10, i % 13);
+        sum = sum + manhattan(p);
+        tick();
+        if (sum > 100000) {
+            sum = sum - 100000;
+        }
+    }
+
+    return sum + g_count + fib(10);
+}
@@ -0,0 +1,106 @@
+// 常量折叠与传播测试（-O0 与 -O1 结果应相同）
+// 覆盖：常量条件的 if/while/for/do-while、循环中被修改的变量、continue 到增量、
+// 短路右边的赋值、被取地址的变量、常量数组下标、没有 else 的 if 之后落到函数末尾
+
+int g[4];
+
+struct Pair {
+    int a;
+    int arr[3];
+};
+
+int counter;
+
+void bump(int n) {
+    if (n > 0) {
+        counter = counter + n;
+        return;
+    }
+}
+
+int setThrough(int* p) {
+    *p = 40;
+    return 0;
+}
+
+int main() {
+    int a = 6;
+    int b = a * 7;           // 42
+    int c;
+    int i;
+    int k = 1;
+    int s = 0;
+    int local[3];
+    int m[2][3];
+    int t = 5;
+    int r = 0;
+    struct Pair pair;
+
+    // 常量条件
+    if (b == 42) {
+        c = 1;
+    } else if (b > 0) {
+        c = 2;
+    } else {
+        c = 3;
+    }
+    if (0) {
+        c = 100;
+    } else if (a - 6) {
+        c = 200;
+    }
+    while (0) {
+        c = 300;
+    }
+    for (i = 0; 0; i = i + 1) {
+        c = 400;
+    }
+    do {
+        c = c + 10;          // 11
+    } while (0);
+
+    // 循环中修改的变量：循环开始处就不再是常量
+    for (i = 0; i < 4; i = i + k) {
+        if (i == 1) {
+            k = 2;
+            continue;
+        }
+        k = 1;
+        s = s + i;           // i = 0, 3 -> s = 3
+    }
+
+    while (1) {
+        s = s + 100;
+        if (s > 300) {
+            break;
+        }
+    }                        // s = 303
+
+    // 短路右边的赋值不一定执行
+    if (s < 0 && (a = 100)) {
+        s = 0;
+    }
+    // a 仍为 6
+
+    // 被取地址的变量经由指针修改
+    setThrough(&t);          // t = 40
+
+    // 常量下标
+    local[0] = 1;
+    local[2] = 3;
+    local[1] = local[0] + local[2];       // 4
+    m[1][2] = 7;
+    m[0][1] = m[1][2] * 2;                 // 14
+    g[3] = 9;
+    pair.arr[2] = 5;
+    pair.a = pair.arr[2] + g[3];           // 14
+
+    // 没有 else 的 if 之后落到函数末尾
+    counter = 0;
+    bump(3);
+    bump(0);
+
+    r = c + s + a + t + local[1] + m[0][1] + pair.a + counter;
+    // 11 + 303 + 6 + 40 + 4 + 14 + 14 + 3 = 395
+    return r;
+}
@@ -0,0 +1,40 @@
+// 短路求值测试
+// && 左边为假、|| 左边为真时，右边（包括函数调用）不执行
+
+int calls;
+
+int touch(int v) {
+    calls = calls + 1;
+    return v;
+}
+
+int main() {
+    int i;
+    int hits = 0;
+    int x;
+    calls = 0;
+
+    // 循环条件：i < 10 为假时不再调用 touch
+    for (i = 0; i < 10 && touch(1); i = i + 1) {
+        // i > 5 时不调用 touch
+        if (i > 5 || touch(0)) {
+            hits = hits + 1;
+        }
+        // i >= 3 时不调用 touch
+        if (!(i < 3 && touch(1))) {
+            hits = hits + 100;
+        }
+    }
+    // calls = 10 + 6 + 3 = 19, hits = 4 + 700 = 704
+
+    // 作为值使用：结果是 0 或 1
+    x = (0 && touch(1)) + (1 || touch(1)) * 10 + (touch(2) && 3) * 1000;
+    // x = 0 + 10 + 1000 = 1010, calls = 20
+
+    do {
+        hits = hits + 1000;
+    } while (hits < 3000 && !(calls > 100));
+    // hits = 3704
+
+    return calls * 100000 + hits * 10 + x;  // 2000000 + 37040 + 1010
+}
@@ -0,0 +1,2017 @@
+// 作用域压力测试：2000 层嵌套的代码块
+// 每层声明一个新变量 aK，并声明 x 遮蔽外层的 x；最内层把 x 写入 main 的 result，
+// 逐层退出后检查外层的 x 和 total 没有被内层的同名变量影响
+// 生成的字节码与代码块个数成线性关系，编译时间也不应随嵌套深度平方增长
+
+int main() {
+    int x = 1;
+    int total = 7;
+    int result = 0;
+
+{ int a0 = x + 0; int x = a0 % 1000;
+{ int a1 = x + 1; int x = a1 % 1000;
+{ int a2 = x + 2; int x = a2 % 1000;
+{ int a3 = x + 0; int x = a3 % 1000;
+{ int a4 = x + 1; int x = a4 % 1000;
+{ int a5 = x + 2; int x = a5 % 1000;
+{ int a6 = x + 0; int x = a6 % 1000;
+{ int a7 = x + 1; int x = a7 % 1000;
+{ int a8 = x + 2; int x = a8 % 1000;
+{ int a9 = x + 0; int x = a9 % 1000;
+{ int a10 = x + 1; int x = a10 % 1000;
+{ int a11 = x + 2; int x = a11 % 1000;
+{ int a12 = x + 0; int x = a12 % 1000;
+{ int a13 = x + 1; int x = a13 % 1000;
+{ int a14 = x + 2; int x = a14 % 1000;
+{ int a15 = x + 0; int x = a15 % 1000;
+{ int a16 = x + 1; int x = a16 % 1000;
+{ int a17 = x + 2; int x = a17 % 1000;
+{ int a18 = x + 0; int x = a18 % 1000;
+{ int a19 = x + 1; int x = a19 % 1000;
+{ int a20 = x + 2; int x = a20 % 1000;
+{ int a21 = x + 0; int x = a21 % 1000;
+{ int a22 = x + 1; int x = a22 % 1000;
+{ int a23 = x + 2; int x = a23 % 1000;
+{ int a24 = x + 0; int x = a24 % 1000;
+{ int a25 = x + 1; int x = a25 % 1000;
+{ int a26 = x + 2; int x = a26 % 1000;
+{ int a27 = x + 0; int x = a27 % 1000;
+{ int a28 = x + 1; int x = a28 % 1000;
+{ int a29 = x + 2; int x = a29 % 1000;
+{ int a30 = x + 0; int x = a30 % 1000;
+{ int a31 = x + 1; int x = a31 % 1000;
+{ int a32 = x + 2; int x = a32 % 1000;
+{ int a33 = x + 0; int x = a33 % 1000;
+{ int a34 = x + 1; int x = a34 % 1000;
+{ int a35 = x + 2; int x = a35 % 1000;
+{ int a36 = x + 0; int x = a36 % 1000;
+{ int a37 = x + 1; int x = a37 % 1000;
+{ int a38 = x + 2; int x = a38 % 1000;
+{ int a39 = x + 0; int x = a39 % 1000;
+{ int a40 = x + 1; int x = a40 % 1000;
+{ int a41 = x + 2; int x = a41 % 1000;
+{ int a42 = x + 0; int x = a42 % 1000;
+{ int a43 = x + 1; int x = a43 % 1000;
+{ int a44 = x + 2; int x = a44 % 1000;
+{ int a45 = x + 0; int x = a45 % 1000;
+{ int a46 = x + 1; int x = a46 % 1000;
+{ int a47 = x + 2; int x = a47 % 1000;
+{ int a48 = x + 0; int x = a48 % 1000;
+{ int a49 = x + 1; int x = a49 % 1000;
+{ int a50 = x + 2; int x = a50 % 1000;
+{ int a51 = x + 0; int x = a51 % 1000;
+{ int a52 = x + 1; int x = a52 % 1000;
+{ int a53 = x + 2; int x = a53 % 1000;
+{ int a54 = x + 0; int x = a54 % 1000;
+{ int a55 = x + 1; int x = a55 % 1000;
+{ int a56 = x + 2; int x = a56 % 1000;
+{ int a57 = x + 0; int x = a57 % 1000;
+{ int a58 = x + 1; int x = a58 % 1000;
+{ int a59 = x + 2; int x = a59 % 1000;
+{ int a60 = x + 0; int x = a60 % 1000;
+{ int a61 = x + 1; int x = a61 % 1000;
+{ int a62 = x + 2; int x = a62 % 1000;
+{ int a63 = x + 0; int x = a63 % 1000;
+{ int a64 = x + 1; int x = a64 % 1000;
+{ int a65 = x + 2; int x = a65 % 1000;
+{ int a66 = x + 0; int x = a66 % 1000;
+{ int a67 = x + 1; int x = a67 % 1000;
+{ int a68 = x + 2; int x = a68 % 1000;
+{ int a69 = x + 0; int x = a69 % 1000;
+{ int a70 = x + 1; int x = a70 % 1000;
+{ int a71 = x + 2; int x = a71 % 1000;
+{ int a72 = x + 0; int x = a72 % 1000;
+{ int a73 = x + 1; int x = a73 % 1000;
+{ int a74 = x + 2; int x = a74 % 1000;
+{ int a75 = x + 0; int x = a75 % 1000;
+{ int a76 = x + 1; int x = a76 % 1000;
+{ int a77 = x + 2; int x = a77 % 1000;
+{ int a78 = x + 0; int x = a78 % 1000;
+{ int a79 = x + 1; int x = a79 % 1000;
+{ int a80 = x + 2; int x = a80 % 1000;
+{ int a81 = x + 0; int x = a81 % 1000;
+{ int a82 = x + 1; int x = a82 % 1000;
+{ int a83 = x + 2; int x = a83 % 1000;
+{ int a84 = x + 0; int x = a84 % 1000;
+{ int a85 = x + 1; int x = a85 % 1000;
+{ int a86 = x + 2; int x = a86 % 1000;
+{ int a87 = x + 0; int x = a87 % 1000;
+{ int a88 = x + 1; int x = a88 % 1000;
+{ int a89 = x + 2; int x = a89 % 1000;
+{ int a90 = x + 0; int x = a90 % 1000;
+{ int a91 = x + 1; int x = a91 % 1000;
+{ int a92 = x + 2; int x = a92 % 1000;
+{ int a93 = x + 0; int x = a93 % 1000;
+{ int a94 = x + 1; int x = a94 % 1000;
+{ int a95 = x + 2; int x = a95 % 1000;
+{ int a96 = x + 0; int x = a96 % 1000;
+{ int a97 = x + 1; int x = a97 % 1000;
+{ int a98 = x + 2; int x = a98 % 1000;
+{ int a99 = x + 0; int x = a99 % 1000;
+{ int a100 = x + 1; int x = a100 % 1000;
+{ int a101 = x + 2; int x = a101 % 1000;
+{ int a102 = x + 0; int x = a102 % 1000;
+{ int a103 = x + 1; int x = a103 % 1000;
+{ int a104 = x + 2; int x = a104 % 1000;
+{ int a105 = x + 0; int x = a105 % 1000;
+{ int a106 = x + 1; int x = a106 % 1000;
+{ int a107 = x + 2; int x = a107 % 1000;
+{ int a108 = x + 0; int x = a108 % 1000;
+{ int a109 = x + 1; int x = a109 % 1000;
+{ int a110 = x + 2; int x = a110 % 1000;
+{ int a111 = x + 0; int x = a111 % 1000;
+{ int a112 = x + 1; int x = a112 % 1000;
+{ int a113 = x + 2; int x = a113 % 1000;
+{ int a114 = x + 0; int x = a114 % 1000;
+{ int a115 = x + 1; int x = a115 % 1000;
+{ int a116 = x + 2; int x = a116 % 1000;
+{ int a117 = x + 0; int x = a117 % 1000;
+{ int a118 = x + 1; int x = a118 % 1000;
+{ int a119 = x + 2; int x = a119 % 1000;
+{ int a120 = x + 0; int x = a120 % 1000;
+{ int a121 = x + 1; int x = a121 % 1000;
+{ int a122 = x + 2; int x = a122 % 1000;
+{ int a123 = x + 0; int x = a123 % 1000;
+{ int a124 = x + 1; int x = a124 % 1000;
+{ int a125 = x + 2; int x = a125 % 1000;
+{ int a126 = x + 0; int x = a126 % 1000;
+{ int a127 = x + 1; int x = a127 % 1000;
+{ int a128 = x + 2; int x = a128 % 1000;
+{ int a129 = x + 0; int x = a129 % 1000;
+{ int a130 = x + 1; int x = a130 % 1000;
+{ int a131 = x + 2; int x = a131 % 1000;
+{ int a132 = x + 0; int x = a132 % 1000;
+{ int a133 = x + 1; int x = a133 % 1000;
+{ int a134 = x + 2; int x = a134 % 1000;
+{ int a135 = x + 0; int x = a135 % 1000;
+{ int a136 = x + 1; int x = a136 % 1000;
+{ int a137 = x + 2; int x = a137 % 1000;
+{ int a138 = x + 0; int x = a138 % 1000;
+{ int a139 = x + 1; int x = a139 % 1000;
+{ int a140 = x + 2; int x = a140 % 1000;
+{ int a141 = x + 0; int x = a141 % 1000;
+{ int a142 = x + 1; int x = a142 % 1000;
+{ int a143 = x + 2; int x = a143 % 1000;
+{ int a144 = x + 0; int x = a144 % 1000;
+{ int a145 = x + 1; int x = a145 % 1000;
+{ int a146 = x + 2; int x = a146 % 1000;
+{ int a147 = x + 0; int x = a147 % 1000;
+{ int a148 = x + 1; int x = a148 % 1000;
+{ int a149 = x + 2; int x = a149 % 1000;
+{ int a150 = x + 0; int x = a150 % 1000;
+{ int a151 = x + 1; int x = a151 % 1000;
+{ int a152 = x + 2; int x = a152 % 1000;
+{ int a153 = x + 0; int x = a153 % 1000;
+{ int a154 = x + 1; int x = a154 % 1000;
+{ int a155 = x + 2; int x = a155 % 1000;
+{ int a156 = x + 0; int x = a156 % 1000;
+{ int a157 = x + 1; int x = a157 % 1000;
+{ int a158 = x + 2; int x = a158 % 1000;
+{ int a159 = x + 0; int x = a159 % 1000;
+{ int a160 = x + 1; int x = a160 % 1000;
+{ int a161 = x + 2; int x = a161 % 1000;
+{ int a162 = x + 0; int x = a162 % 1000;
+{ int a163 = x + 1; int x = a163 % 1000;
+{ int a164 = x + 2; int x = a164 % 1000;
+{ int a165 = x + 0; int x = a165 % 1000;
+{ int a166 = x + 1; int x = a166 % 1000;
+{ int a167 = x + 2; int x = a167 % 1000;
+{ int a168 = x + 0; int x = a168 % 1000;
+{ int a169 = x + 1; int x = a169 % 1000;
+{ int a170 = x + 2; int x = a170 % 1000;
+{ int a171 = x + 0; int x = a171 % 1000;
+{ int a172 = x + 1; int x = a172 % 1000;
+{ int a173 = x + 2; int x = a173 % 1000;
+{ int a174 = x + 0; int x = a174 % 1000;
+{ int a175 = x + 1; int x = a175 % 1000;
+{ int a176 = x + 2; int x = a176 % 1000;
+{ int a177 = x + 0; int x = a177 % 1000;
+{ int a178 = x + 1; int x = a178 % 1000;
+{ int a179 = x + 2; int x = a179 % 1000;
+{ int a180 = x + 0; int x = a180 % 1000;
+{ int a181 = x + 1; int x = a181 % 1000;
+{ int a182 = x + 2; int x = a182 % 1000;
+{ int a183 = x + 0; int x = a183 % 1000;
+{ int a184 = x + 1; int x = a184 % 1000;
+{ int a185 = x + 2; int x = a185 % 1000;
+{ int a186 = x + 0; int x = a186 % 1000;
+{ int a187 = x + 1; int x = a187 % 1000;
+{ int a188 = x + 2; int x = a188 % 1000;
+{ int a189 = x + 0; int x = a189 % 1000;
+{ int a190 = x + 1; int x = a190 % 1000;
+{ int a191 = x + 2; int x = a191 % 1000;
+{ int a192 = x + 0; int x = a192 % 1000;
+{ int a193 = x + 1; int x = a193 % 1000;
+{ int a194 = x + 2; int x = a194 % 1000;
+{ int a195 = x + 0; int x = a195 % 1000;
+{ int a196 = x + 1; int x = a196 % 1000;
+{ int a197 = x + 2; int x = a197 % 1000;
+{ int a198 = x + 0; int x = a198 % 1000;
+{ int a199 = x + 1; int x = a199 % 1000;
+{ int a200 = x + 2; int x = a200 % 1000;
+{ int a201 = x + 0; int x = a201 % 1000;
+{ int a202 = x + 1; int x = a202 % 1000;
+{ int a203 = x + 2; int x = a203 % 1000;
+{ int a204 = x + 0; int x = a204 % 1000;
+{ int a205 = x + 1; int x = a205 % 1000;
+{ int a206 = x + 2; int x = a206 % 1000;
+{ int a207 = x + 0; int x = a207 % 1000;
+{ int a208 = x + 1; int x = a208 % 1000;
+{ int a209 = x + 2; int x = a209 % 1000;
+{ int a210 = x + 0; int x = a210 % 1000;
+{ int a211 = x + 1; int x = a211 % 1000;
+{ int a212 = x + 2; int x = a212 % 1000;
+{ int a213 = x + 0; int x = a213 % 1000;
+{ int a214 = x + 1; int x = a214 % 1000;
+{ int a215 = x + 2; int x = a215 % 1000;
+{ int a216 = x + 0; int x = a216 % 1000;
+{ int a217 = x + 1; int x = a217 % 1000;
+{ int a218 = x + 2; int x = a218 % 1000;
+{ int a219 = x + 0; int x = a219 % 1000;
+{ int a220 = x + 1; int x = a220 % 1000;
+{ int a221 = x + 2; int x = a221 % 1000;
+{ int a222 = x + 0; int x = a222 % 1000;
+{ int a223 = x + 1; int x = a223 % 1000;
+{ int a224 = x + 2; int x = a224 % 1000;
+{ int a225 = x + 0; int x = a225 % 1000;
+{ int a226 = x + 1; int x = a226 % 1000;
+{ int a227 = x + 2; int x = a227 % 1000;
+{ int a228 = x + 0; int x = a228 % 1000;
+{ int a229 = x + 1; int x = a229 % 1000;
+{ int a230 = x + 2; int x = a230 % 1000;
+{ int a231 = x + 0; int x = a231 % 1000;
+{ int a232 = x + 1; int x = a232 % 1000;
+{ int a233 = x + 2; int x = a233 % 1000;
+{ int a234 = x + 0; int x = a234 % 1000;
+{ int a235 = x + 1; int x = a235 % 1000;
+{ int a236 = x + 2; int x = a236 % 1000;
+{ int a237 = x + 0; int x = a237 % 1000;
+{ int a238 = x + 1; int x = a238 % 1000;
+{ int a239 = x + 2; int x = a239 % 1000;
+{ int a240 = x + 0; int x = a240 % 1000;
+{ int a241 = x + 1; int x = a241 % 1000;
+{ int a242 = x + 2; int x = a242 % 1000;
+{ int a243 = x + 0; int x = a243 % 1000;
+{ int a244 = x + 1; int x = a244 % 1000;
+{ int a245 = x + 2; int x = a245 % 1000;
+{ int a246 = x + 0; int x = a246 % 1000;
+{ int a247 = x + 1; int x = a247 % 1000;
+{ int a248 = x + 2; int x = a248 % 1000;
+{ int a249 = x + 0; int x = a249 % 1000;
+{ int a250 = x + 1; int x = a250 % 1000;
+{ int a251 = x + 2; int x = a251 % 1000;
+{ int a252 = x + 0; int x = a252 % 1000;
+{ int a253 = x + 1; int x = a253 % 1000;
+{ int a254 = x + 2; int x = a254 % 1000;
+{ int a255 = x + 0; int x = a255 % 1000;
+{ int a256 = x + 1; int x = a256 % 1000;
+{ int a257 = x + 2; int x = a257 % 1000;
+{ int a258 = x + 0; int x = a258 % 1000;
+{ int a259 = x + 1; int x = a259 % 1000;
+{ int a260 = x + 2; int x = a260 % 1000;
+{ int a261 = x + 0; int x = a261 % 1000;
+{ int a262 = x + 1; int x = a262 % 1000;
+{ int a263 = x + 2; int x = a263 % 1000;
+{ int a264 = x + 0; int x = a264 % 1000;
+{ int a265 = x + 1; int x = a265 % 1000;
+{ int a266 = x + 2; int x = a266 % 1000;
+{ int a267 = x + 0; int x = a267 % 1000;
+{ int a268 = x + 1; int x = a268 % 1000;
+{ int a269 = x + 2; int x = a269 % 1000;
+{ int a270 = x + 0; int x = a270 % 1000;
+{ int a271 = x + 1; int x = a271 % 1000;
+{ int a272 = x + 2; int x = a272 % 1000;
+{ int a273 = x + 0; int x = a273 % 1000;
+{ int a274 = x + 1; int x = a274 % 1000;
+{ int a275 = x + 2; int x = a275 % 1000;
+{ int a276 = x + 0; int x = a276 % 1000;
+{ int a277 = x + 1; int x = a277 % 1000;
+{ int a278 = x + 2; int x = a278 % 1000;
+{ int a279 = x + 0; int x = a279 % 1000;
+{ int a280 = x + 1; int x = a280 % 1000;
+{ int a281 = x + 2; int x = a281 % 1000;
+{ int a282 = x + 0; int x = a282 % 1000;
+{ int a283 = x + 1; int x = a283 % 1000;
+{ int a284 = x + 2; int x = a284 % 1000;
+{ int a285 = x + 0; int x = a285 % 1000;
+{ int a286 = x + 1; int x = a286 % 1000;
+{ int a287 = x + 2; int x = a287 % 1000;
+{ int a288 = x + 0; int x = a288 % 1000;
+{ int a289 = x + 1; int x = a289 % 1000;
+{ int a290 = x + 2; int x = a290 % 1000;
+{ int a291 = x + 0; int x = a291 % 1000;
+{ int a292 = x + 1; int x = a292 % 1000;
+{ int a293 = x + 2; int x = a293 % 1000;
+{ int a294 = x + 0; int x = a294 % 1000;
+{ int a295 = x + 1; int x = a295 % 1000;
+{ int a296 = x + 2; int x = a296 % 1000;
+{ int a297 = x + 0; int x = a297 % 1000;
+{ int a298 = x + 1; int x = a298 % 1000;
+{ int a299 = x + 2; int x = a299 % 1000;
+{ int a300 = x + 0; int x = a300 % 1000;
+{ int a301 = x + 1; int x = a301 % 1000;
+{ int a302 = x + 2; int x = a302 % 1000;
+{ int a303 = x + 0; int x = a303 % 1000;
+{ int a304 = x + 1; int x = a304 % 1000;
+{ int a305 = x + 2; int x = a305 % 1000;
+{ int a306 = x + 0; int x = a306 % 1000;
+{ int a307 = x + 1; int x = a307 % 1000;
+{ int a308 = x + 2; int x = a308 % 1000;
+{ int a309 = x + 0; int x = a309 % 1000;
+{ int a310 = x + 1; int x = a310 % 1000;
+{ int a311 = x + 2; int x = a311 % 1000;
+{ int a312 = x + 0; int x = a312 % 1000;
+{ int a313 = x + 1; int x = a313 % 1000;
+{ int a314 = x + 2; int x = a314 % 1000;
+{ int a315 = x + 0; int x = a315 % 1000;
+{ int a316 = x + 1; int x = a316 % 1000;
+{ int a317 = x + 2; int x = a317 % 1000;
+{ int a318 = x + 0; int x = a318 % 1000;
+{ int a319 = x + 1; int x = a319 % 1000;
+{ int a320 = x + 2; int x = a320 % 1000;
+{ int a321 = x + 0; int x = a321 % 1000;
+{ int a322 = x + 1; int x = a322 % 1000;
+{ int a323 = x + 2; int x = a323 % 1000;
+{ int a324 = x + 0; int x = a324 % 1000;
+{ int a325 = x + 1; int x = a325 % 1000;
+{ int a326 = x + 2; int x = a326 % 1000;
+{ int a327 = x + 0; int x = a327 % 1000;
+{ int a328 = x + 1; int x = a328 % 1000;
+{ int a329 = x + 2; int x = a329 % 1000;
+{ int a330 = x + 0; int x = a330 % 1000;
+{ int a331 = x + 1; int x = a331 % 1000;
+{ int a332 = x + 2; int x = a332 % 1000;
+{ int a333 = x + 0; int x = a333 % 1000;
+{ int a334 = x + 1; int x = a334 % 1000;
+{ int a335 = x + 2; int x = a335 % 1000;
+{ int a336 = x + 0; int x = a336 % 1000;
+{ int a337 = x + 1; int x = a337 % 1000;
+{ int a338 = x + 2; int x = a338 % 1000;
+{ int a339 = x + 0; int x = a339 % 1000;
+{ int a340 = x + 1; int x = a340 % 1000;
+{ int a341 = x + 2; int x = a341 % 1000;
+{ int a342 = x + 0; int x = a342 % 1000;
+{ int a343 = x + 1; int x = a343 % 1000;
+{ int a344 = x + 2; int x = a344 % 1000;
+{ int a345 = x + 0; int x = a345 % 1000;
+{ int a346 = x + 1; int x = a346 % 1000;
+{ int a347 = x + 2; int x = a347 % 1000;
+{ int a348 = x + 0; int x = a348 % 1000;
+{ int a349 = x + 1; int x = a349 % 1000;
+{ int a350 = x + 2; int x = a350 % 1000;
+{ int a351 = x + 0; int x = a351 % 1000;
+{ int a352 = x + 1; int x = a352 % 1000;
+{ int a353 = x + 2; int x = a353 % 1000;
+{ int a354 = x + 0; int x = a354 % 1000;
+{ int a355 = x + 1; int x = a355 % 1000;
+{ int a356 = x + 2; int x = a356 % 1000;
+{ int a357 = x + 0; int x = a357 % 1000;
+{ int a358 = x + 1; int x = a358 % 1000;
+{ int a359 = x + 2; int x = a359 % 1000;
+{ int a360 = x + 0; int x = a360 % 1000;
+{ int a361 = x + 1; int x = a361 % 1000;
+{ int a362 = x + 2; int x = a362 % 1000;
+{ int a363 = x + 0; int x = a363 % 1000;
+{ int a364 = x + 1; int x = a364 % 1000;
+{ int a365 = x + 2; int x = a365 % 1000;
+{ int a366 = x + 0; int x = a366 % 1000;
+{ int a367 = x + 1; int x = a367 % 1000;
+{ int a368 = x + 2; int x = a368 % 1000;
+{ int a369 = x + 0; int x = a369 % 1000;
+{ int a370 = x + 1; int x = a370 % 1000;
+{ int a371 = x + 2; int x = a371 % 1000;
+{ int a372 = x + 0; int x = a372 % 1000;
+{ int a373 = x + 1; int x = a373 % 1000;
+{ int a374 = x + 2; int x = a374 % 1000;
+{ int a375 = x + 0; int x = a375 % 1000;
+{ int a376 = x + 1; int x = a376 % 1000;
+{ int a377 = x + 2; int x = a377 % 1000;
+{ int a378 = x + 0; int x = a378 % 1000;
+{ int a379 = x + 1; int x = a379 % 1000;
+{ int a380 = x + 2; int x = a380 % 1000;
+{ int a381 = x + 0; int x = a381 % 1000;
+{ int a382 = x + 1; int x = a382 % 1000;
+{ int a383 = x + 2; int x = a383 % 1000;
+{ int a384 = x + 0; int x = a384 % 1000;
+{ int a385 = x + 1; int x = a385 % 1000;
+{ int a386 = x + 2; int x = a386 % 1000;
+{ int a387 = x + 0; int x = a387 % 1000;
+{ int a388 = x + 1; int x = a388 % 1000;
+{ int a389 = x + 2; int x = a389 % 1000;
+{ int a390 = x + 0; int x = a390 % 1000;
+{ int a391 = x + 1; int x = a391 % 1000;
+{ int a392 = x + 2; int x = a392 % 1000;
+{ int a393 = x + 0; int x = a393 % 1000;
+{ int a394 = x + 1; int x = a394 % 1000;
+{ int a395 = x + 2; int x = a395 % 1000;
+{ int a396 = x + 0; int x = a396 % 1000;
+{ int a397 = x + 1; int x = a397 % 1000;
+{ int a398 = x + 2; int x = a398 % 1000;
+{ int a399 = x + 0; int x = a399 % 1000;
+{ int a400 = x + 1; int x = a400 % 1000;
+{ int a401 = x + 2; int x = a401 % 1000;
+{ int a402 = x + 0; int x = a402 % 1000;
+{ int a403 = x + 1; int x = a403 % 1000;
+{ int a404 = x + 2; int x = a404 % 1000;
+{ int a405 = x + 0; int x = a405 % 1000;
+{ int a406 = x + 1; int x = a406 % 1000;
+{ int a407 = x + 2; int x = a407 % 1000;
+{ int a408 = x + 0; int x = a408 % 1000;
+{ int a409 = x + 1; int x = a409 % 1000;
+{ int a410 = x + 2; int x = a410 % 1000;
+{ int a411 = x + 0; int x = a411 % 1000;
+{ int a412 = x + 1; int x = a412 % 1000;
+{ int a413 = x + 2; int x = a413 % 1000;
+{ int a414 = x + 0; int x = a414 % 1000;
+{ int a415 = x + 1; int x = a415 % 1000;
+{ int a416 = x + 2; int x = a416 % 1000;
+{ int a417 = x + 0; int x = a417 % 1000;
+{ int a418 = x + 1; int x = a418 % 1000;
+{ int a419 = x + 2; int x = a419 % 1000;
+{ int a420 = x + 0; int x = a420 % 1000;
+{ int a421 = x + 1; int x = a421 % 1000;
+{ int a422 = x + 2; int x = a422 % 1000;
+{ int a423 = x + 0; int x = a423 % 1000;
+{ int a424 = x + 1; int x = a424 % 1000;
+{ int a425 = x + 2; int x = a425 % 1000;
+{ int a426 = x + 0; int x = a426 % 1000;
+{ int a427 = x + 1; int x = a427 % 1000;
+{ int a428 = x + 2; int x = a428 % 1000;
+{ int a429 = x + 0; int x = a429 % 1000;
+{ int a430 = x + 1; int x = a430 % 1000;
+{ int a431 = x + 2; int x = a431 % 1000;
+{ int a432 = x + 0; int x = a432 % 1000;
+{ int a433 = x + 1; int x = a433 % 1000;
+{ int a434 = x + 2; int x = a434 % 1000;
+{ int a435 = x + 0; int x = a435 % 1000;
+{ int a436 = x + 1; int x = a436 % 1000;
+{ int a437 = x + 2; int x = a437 % 1000;
+{ int a438 = x + 0; int x = a438 % 1000;
+{ int a439 = x + 1; int x = a439 % 1000;
+{ int a440 = x + 2; int x = a440 % 1000;
+{ int a441 = x + 0; int x = a441 % 1000;
+{ int a442 = x + 1; int x = a442 % 1000;
+{ int a443 = x + 2; int x = a443 % 1000;
+{ int a444 = x + 0; int x = a444 % 1000;
+{ int a445 = x + 1; int x = a445 % 1000;
+{ int a446 = x + 2; int x = a446 % 1000;
+{ int a447 = x + 0; int x = a447 % 1000;
+{ int a448 = x + 1; int x = a448 % 1000;
+{ int a449 = x + 2; int x = a449 % 1000;
+{ int a450 = x + 0; int x = a450 % 1000;
+{ int a451 = x + 1; int x = a451 % 1000;
+{ int a452 = x + 2; int x = a452 % 1000;
+{ int a453 = x + 0; int x = a453 % 1000;
+{ int a454 = x + 1; int x = a454 % 1000;
+{ int a455 = x + 2; int x = a455 % 1000;
+{ int a456 = x + 0; int x = a456 % 1000;
+{ int a457 = x + 1; int x = a457 % 1000;
+{ int a458 = x + 2; int x = a458 % 1000;
+{ int a459 = x + 0; int x = a459 % 1000;
+{ int a460 = x + 1; int x = a460 % 1000;
+{ int a461 = x + 2; int x = a461 % 1000;
+{ int a462 = x + 0; int x = a462 % 1000;
+{ int a463 = x + 1; int x = a463 % 1000;
+{ int a464 = x + 2; int x = a464 % 1000;
+{ int a465 = x + 0; int x = a465 % 1000;
+{ int a466 = x + 1; int x = a466 % 1000;
+{ int a467 = x + 2; int x = a467 % 1000;
+{ int a468 = x + 0; int x = a468 % 1000;
+{ int a469 = x + 1; int x = a469 % 1000;
+{ int a470 = x + 2; int x = a470 % 1000;
+{ int a471 = x + 0; int x = a471 % 1000;
+{ int a472 = x + 1; int x = a472 % 1000;
+{ int a473 = x + 2; int x = a473 % 1000;
+{ int a474 = x + 0; int x = a474 % 1000;
+{ int a475 = x + 1; int x = a475 % 1000;
+{ int a476 = x + 2; int x = a476 % 1000;
+{ int a477 = x + 0; int x = a477 % 1000;
+{ int a478 = x + 1; int x = a478 % 1000;
+{ int a479 = x + 2; int x = a479 % 1000;
+{ int a480 = x + 0; int x = a480 % 1000;
+{ int a481 = x + 1; int x = a481 % 1000;
+{ int a482 = x + 2; int x = a482 % 1000;
+{ int a483 = x + 0; int x = a483 % 1000;
+{ int a484 = x + 1; int x = a484 % 1000;
+{ int a485 = x + 2; int x = a485 % 1000;
+{ int a486 = x + 0; int x = a486 % 1000;
+{ int a487 = x + 1; int x = a487 % 1000;
+{ int a488 = x + 2; int x = a488 % 1000;
+{ int a489 = x + 0; int x = a489 % 1000;
+{ int a490 = x + 1; int x = a490 % 1000;
+{ int a491 = x + 2; int x = a491 % 1000;
+{ int a492 = x + 0; int x = a492 % 1000;
+{ int a493 = x + 1; int x = a493 % 1000;
+{ int a494 = x + 2; int x = a494 % 1000;
+{ int a495 = x + 0; int x = a495 % 1000;
+{ int a496 = x + 1; int x = a496 % 1000;
+{ int a497 = x + 2; int x = a497 % 1000;
+{ int a498 = x + 0; int x = a498 % 1000;
+{ int a499 = x + 1; int x = a499 % 1000;
+{ int a500 = x + 2; int x = a500 % 1000;
+{ int a501 = x + 0; int x = a501 % 1000;
+{ int a502 = x + 1; int x = a502 % 1000;
+{ int a503 = x + 2; int x = a503 % 1000;
+{ int a504 = x + 0; int x = a504 % 1000;
+{ int a505 = x + 1; int x = a505 % 1000;
+{ int a506 = x + 2; int x = a506 % 1000;
+{ int a507 = x + 0; int x = a507 % 1000;
+{ int a508 = x + 1; int x = a508 % 1000;
+{ int a509 = x + 2; int x = a509 % 1000;
+{ int a510 = x + 0; int x = a510 % 1000;
+{ int a511 = x + 1; int x = a511 % 1000;
+{ int a512 = x + 2; int x = a512 % 1000;
+{ int a513 = x + 0; int x = a513 % 1000;
+{ int a514 = x + 1; int x = a514 % 1000;
+{ int a515 = x + 2; int x = a515 % 1000;
+{ int a516 = x + 0; int x = a516 % 1000;
+{ int a517 = x + 1; int x = a517 % 1000;
+{ int a518 = x + 2; int x = a518 % 1000;
+{ int a519 = x + 0; int x = a519 % 1000;
+{ int a520 = x + 1; int x = a520 % 1000;
+{ int a521 = x + 2; int x = a521 % 1000;
+{ int a522 = x + 0; int x = a522 % 1000;
+{ int a523 = x + 1; int x = a523 % 1000;
+{ int a524 = x + 2; int x = a524 % 1000;
+{ int a525 = x + 0; int x = a525 % 1000;
+{ int a526 = x + 1; int x = a526 % 1000;
+{ int a527 = x + 2; int x = a527 % 1000;
+{ int a528 = x + 0; int x = a528 % 1000;
+{ int a529 = x + 1; int x = a529 % 1000;
+{ int a530 = x + 2; int x = a530 % 1000;
+{ int a531 = x + 0; int x = a531 % 1000;
+{ int a532 = x + 1; int x = a532 % 1000;
+{ int a533 = x + 2; int x = a533 % 1000;
+{ int a534 = x + 0; int x = a534 % 1000;
+{ int a535 = x + 1; int x = a535 % 1000;
+{ int a536 = x + 2; int x = a536 % 1000;
+{ int a537 = x + 0; int x = a537 % 1000;
+{ int a538 = x + 1; int x = a538 % 1000;
+{ int a539 = x + 2; int x = a539 % 1000;
+{ int a540 = x + 0; int x = a540 % 1000;
+{ int a541 = x + 1; int x = a541 % 1000;
+{ int a542 = x + 2; int x = a542 % 1000;
+{ int a543 = x + 0; int x = a543 % 1000;
+{ int a544 = x + 1; int x = a544 % 1000;
+{ int a545 = x + 2; int x = a545 % 1000;
+{ int a546 = x + 0; int x = a546 % 1000;
+{ int a547 = x + 1; int x = a547 % 1000;
+{ int a548 = x + 2; int x = a548 % 1000;
+{ int a549 = x + 0; int x = a549 % 1000;
+{ int a550 = x + 1; int x = a550 % 1000;
+{ int a551 = x + 2; int x = a551 % 1000;
+{ int a552 = x + 0; int x = a552 % 1000;
+{ int a553 = x + 1; int x = a553 % 1000;
+{ int a554 = x + 2; int x = a554 % 1000;
+{ int a555 = x + 0; int x = a555 % 1000;
+{ int a556 = x + 1; int x = a556 % 1000;
+{ int a557 = x + 2; int x = a557 % 1000;
+{ int a558 = x + 0; int x = a558 % 1000;
+{ int a559 = x + 1; int x = a559 % 1000;
+{ int a560 = x + 2; int x = a560 % 1000;
+{ int a561 = x + 0; int x = a561 % 1000;
+{ int a562 = x + 1; int x = a562 % 1000;
+{ int a563 = x + 2; int x = a563 % 1000;
+{ int a564 = x + 0; int x = a564 % 1000;
+{ int a565 = x + 1; int x = a565 % 1000;
+{ int a566 = x + 2; int x = a566 % 1000;
+{ int a567 = x + 0; int x = a567 % 1000;
+{ int a568 = x + 1; int x = a568 % 1000;
+{ int a569 = x + 2; int x = a569 % 1000;
+{ int a570 = x + 0; int x = a570 % 1000;
+{ int a571 = x + 1; int x = a571 % 1000;
+{ int a572 = x + 2; int x = a572 % 1000;
+{ int a573 = x + 0; int x = a573 % 1000;
+{ int a574 = x + 1; int x = a574 % 1000;
+{ int a575 = x + 2; int x = a575 % 1000;
+{ int a576 = x + 0; int x = a576 % 1000;
+{ int a577 = x + 1; int x = a577 % 1000;
+{ int a578 = x + 2; int x = a578 % 1000;
+{ int a579 = x + 0; int x = a579 % 1000;
+{ int a580 = x + 1; int x = a580 % 1000;
+{ int a581 = x + 2; int x = a581 % 1000;
+{ int a582 = x + 0; int x = a582 % 1000;
+{ int a583 = x + 1; int x = a583 % 1000;
+{ int a584 = x + 2; int x = a584 % 1000;
+{ int a585 = x + 0; int x = a585 % 1000;
+{ int a586 = x + 1; int x = a586 % 1000;
+{ int a587 = x + 2; int x = a587 % 1000;
+{ int a588 = x + 0; int x = a588 % 1000;
+{ int a589 = x + 1; int x = a589 % 1000;
+{ int a590 = x + 2; int x = a590 % 1000;
+{ int a591 = x + 0; int x = a591 % 1000;
+{ int a592 = x + 1; int x = a592 % 1000;
+{ int a593 = x + 2; int x = a593 % 1000;
+{ int a594 = x + 0; int x = a594 % 1000;
+{ int a595 = x + 1; int x = a595 % 1000;
+{ int a596 = x + 2; int x = a596 % 1000;
+{ int a597 = x + 0; int x = a597 % 1000;
+{ int a598 = x + 1; int x = a598 % 1000;
+{ int a599 = x + 2; int x = a599 % 1000;
+{ int a600 = x + 0; int x = a600 % 1000;
+{ int a601 = x + 1; int x = a601 % 1000;
+{ int a602 = x + 2; int x = a602 % 1000;
+{ int a603 = x + 0; int x = a603 % 1000;
+{ int a604 = x + 1; int x = a604 % 1000;
+{ int a605 = x + 2; int x = a605 % 1000;
+{ int a606 = x + 0; int x = a606 % 1000;
+{ int a607 = x + 1; int x = a607 % 1000;
+{ int a608 = x + 2; int x = a608 % 1000;
+{ int a609 = x + 0; int x = a609 % 1000;
+{ int a610 = x + 1; int x = a610 % 1000;
+{ int a611 = x + 2; int x = a611 % 1000;
+{ int a612 = x + 0; int x = a612 % 1000;
+{ int a613 = x + 1; int x = a613 % 1000;
+{ int a614 = x + 2; int x = a614 % 1000;
+{ int a615 = x + 0; int x = a615 % 1000;
+{ int a616 = x + 1; int x = a616 % 1000;
+{ int a617 = x + 2; int x = a617 % 1000;
+{ int a618 = x + 0; int x = a618 % 1000;
+{ int a619 = x + 1; int x = a619 % 1000;
+{ int a620 = x + 2; int x = a620 % 1000;
+{ int a621 = x + 0; int x = a621 % 1000;
+{ int a622 = x + 1; int x = a622 % 1000;
+{ int a623 = x + 2; int x = a623 % 1000;
+{ int a624 = x + 0; int x = a624 % 1000;
+{ int a625 = x + 1; int x = a625 % 1000;
+{ int a626 = x + 2; int x = a626 % 1000;
+{ int a627 = x + 0; int x = a627 % 1000;
+{ int a628 = x + 1; int x = a628 % 1000;
+{ int a629 = x + 2; int x = a629 % 1000;
+{ int a630 = x + 0; int x = a630 % 1000;
+{ int a631 = x + 1; int x = a631 % 1000;
+{ int a632 = x + 2; int x = a632 % 1000;
+{ int a633 = x + 0; int x = a633 % 1000;
+{ int a634 = x + 1; int x = a634 % 1000;
+{ int a635 = x + 2; int x = a635 % 1000;
+{ int a636 = x + 0; int x = a636 % 1000;
+{ int a637 = x + 1; int x = a637 % 1000;
+{ int a638 = x + 2; int x = a638 % 1000;
+{ int a639 = x + 0; int x = a639 % 1000;
+{ int a640 = x + 1; int x = a640 % 1000;
+{ int a641 = x + 2; int x = a641 % 1000;
+{ int a642 = x + 0; int x = a642 % 1000;
+{ int a643 = x + 1; int x = a643 % 1000;
+{ int a644 = x + 2; int x = a644 % 1000;
+{ int a645 = x + 0; int x = a645 % 1000;
+{ int a646 = x + 1; int x = a646 % 1000;
+{ int a647 = x + 2; int x = a647 % 1000;
+{ int a648 = x + 0; int x = a648 % 1000;
+{ int a649 = x + 1; int x = a649 % 1000;
+{ int a650 = x + 2; int x = a650 % 1000;
+{ int a651 = x + 0; int x = a651 % 1000;
+{ int a652 = x + 1; int x = a652 % 1000;
+{ int a653 = x + 2; int x = a653 % 1000;
+{ int a654 = x + 0; int x = a654 % 1000;
+{ int a655 = x + 1; int x = a655 % 1000;
+{ int a656 = x + 2; int x = a656 % 1000;
+{ int a657 = x + 0; int x = a657 % 1000;
+{ int a658 = x + 1; int x = a658 % 1000;
+{ int a659 = x + 2; int x = a659 % 1000;
+{ int a660 = x + 0; int x = a660 % 1000;
+{ int a661 = x + 1; int x = a661 % 1000;
+{ int a662 = x + 2; int x = a662 % 1000;
+{ int a663 = x + 0; int x = a663 % 1000;
+{ int a664 = x + 1; int x = a664 % 1000;
+{ int a665 = x + 2; int x = a665 % 1000;
+{ int a666 = x + 0; int x = a666 % 1000;
+{ int a667 = x + 1; int x = a667 % 1000;
+{ int a668 = x + 2; int x = a668 % 1000;
+{ int a669 = x + 0; int x = a669 % 1000;
+{ int a670 = x + 1; int x = a670 % 1000;
+{ int a671 = x + 2; int x = a671 % 1000;
+{ int a672 = x + 0; int x = a672 % 1000;
+{ int a673 = x + 1; int x = a673 % 1000;
+{ int a674 = x + 2; int x = a674 % 1000;
+{ int a675 = x + 0; int x = a675 % 1000;
+{ int a676 = x + 1; int x = a676 % 1000;
+{ int a677 = x + 2; int x = a677 % 1000;
+{ int a678 = x + 0; int x = a678 % 1000;
+{ int a679 = x + 1; int x = a679 % 1000;
+{ int a680 = x + 2; int x = a680 % 1000;
+{ int a681 = x + 0; int x = a681 % 1000;
+{ int a682 = x + 1; int x = a682 % 1000;
+{ int a683 = x + 2; int x = a683 % 1000;
+{ int a684 = x + 0; int x = a684 % 1000;
+{ int a685 = x + 1; int x = a685 % 1000;
+{ int a686 = x + 2; int x = a686 % 1000;
+{ int a687 = x + 0; int x = a687 % 1000;
+{ int a688 = x + 1; int x = a688 % 1000;
+{ int a689 = x + 2; int x = a689 % 1000;
+{ int a690 = x + 0; int x = a690 % 1000;
+{ int a691 = x + 1; int x = a691 % 1000;
+{ int a692 = x + 2; int x = a692 % 1000;
+{ int a693 = x + 0; int x = a693 % 1000;
+{ int a694 = x + 1; int x = a694 % 1000;
+{ int a695 = x + 2; int x = a695 % 1000;
+{ int a696 = x + 0; int x = a696 % 1000;
+{ int a697 = x + 1; int x = a697 % 1000;
+{ int a698 = x + 2; int x = a698 % 1000;
+{ int a699 = x + 0; int x = a699 % 1000;
+{ int a700 = x + 1; int x = a700 % 1000;
+{ int a701 = x + 2; int x = a701 % 1000;
+{ int a702 = x + 0; int x = a702 % 1000;
+{ int a703 = x + 1; int x = a703 % 1000;
+{ int a704 = x + 2; int x = a704 % 1000;
+{ int a705 = x + 0; int x = a705 % 1000;
+{ int a706 = x + 1; int x = a706 % 1000;
+{ int a707 = x + 2; int x = a707 % 1000;
+{ int a708 = x + 0; int x = a708 % 1000;
+{ int a709 = x + 1; int x = a709 % 1000;
+{ int a710 = x + 2; int x = a710 % 1000;
+{ int a711 = x + 0; int x = a711 % 1000;
+{ int a712 = x + 1; int x = a712 % 1000;
+{ int a713 = x + 2; int x = a713 % 1000;
+{ int a714 = x + 0; int x = a714 % 1000;
+{ int a715 = x + 1; int x = a715 % 1000;
+{ int a716 = x + 2; int x = a716 % 1000;
+{ int a717 = x + 0; int x = a717 % 1000;
+{ int a718 = x + 1; int x = a718 % 1000;
+{ int a719 = x + 2; int x = a719 % 1000;
+{ int a720 = x + 0; int x = a720 % 1000;
+{ int a721 = x + 1; int x = a721 % 1000;
+{ int a722 = x + 2; int x = a722 % 1000;
+{ int a723 = x + 0; int x = a723 % 1000;
+{ int a724 = x + 1; int x = a724 % 1000;
+{ int a725 = x + 2; int x = a725 % 1000;
+{ int a726 = x + 0; int x = a726 % 1000;
+{ int a727 = x + 1; int x = a727 % 1000;
+{ int a728 = x + 2; int x = a728 % 1000;
+{ int a729 = x + 0; int x = a729 % 1000;
+{ int a730 = x + 1; int x = a730 % 1000;
+{ int a731 = x + 2; int x = a731 % 1000;
+{ int a732 = x + 0; int x = a732 % 1000;
+{ int a733 = x + 1; int x = a733 % 1000;
+{ int a734 = x + 2; int x = a734 % 1000;
+{ int a735 = x + 0; int x = a735 % 1000;
+{ int a736 = x + 1; int x = a736 % 1000;
+{ int a737 = x + 2; int x = a737 % 1000;
+{ int a738 = x + 0; int x = a738 % 1000;
+{ int a739 = x + 1; int x = a739 % 1000;
+{ int a740 = x + 2; int x = a740 % 1000;
+{ int a741 = x + 0; int x = a741 % 1000;
+{ int a742 = x + 1; int x = a742 % 1000;
+{ int a743 = x + 2; int x = a743 % 1000;
+{ int a744 = x + 0; int x = a744 % 1000;
+{ int a745 = x + 1; int x = a745 % 1000;
+{ int a746 = x + 2; int x = a746 % 1000;
+{ int a747 = x + 0; int x = a747 % 1000;
+{ int a748 = x + 1; int x = a748 % 1000;
+{ int a749 = x + 2; int x = a749 % 1000;
+{ int a750 = x + 0; int x = a750 % 1000;
+{ int a751 = x + 1; int x = a751 % 1000;
+{ int a752 = x + 2; int x = a752 % 1000;
+{ int a753 = x + 0; int x = a753 % 1000;
+{ int a754 = x + 1; int x = a754 % 1000;
+{ int a755 = x + 2; int x = a755 % 1000;
+{ int a756 = x + 0; int x = a756 % 1000;
+{ int a757 = x + 1; int x = a757 % 1000;
+{ int a758 = x + 2; int x = a758 % 1000;
+{ int a759 = x + 0; int x = a759 % 1000;
+{ int a760 = x + 1; int x = a760 % 1000;
+{ int a761 = x + 2; int x = a761 % 1000;
+{ int a762 = x + 0; int x = a762 % 1000;
+{ int a763 = x + 1; int x = a763 % 1000;
+{ int a764 = x + 2; int x = a764 % 1000;
+{ int a765 = x + 0; int x = a765 % 1000;
+{ int a766 = x + 1; int x = a766 % 1000;
+{ int a767 = x + 2; int x = a767 % 1000;
+{ int a768 = x + 0; int x = a768 % 1000;
+{ int a769 = x + 1; int x = a769 % 1000;
+{ int a770 = x + 2; int x = a770 % 1000;
+{ int a771 = x + 0; int x = a771 % 1000;
+{ int a772 = x + 1; int x = a772 % 1000;
+{ int a773 = x + 2; int x = a773 % 1000;
+{ int a774 = x + 0; int x = a774 % 1000;
+{ int a775 = x + 1; int x = a775 % 1000;
+{ int a776 = x + 2; int x = a776 % 1000;
+{ int a777 = x + 0; int x = a777 % 1000;
+{ int a778 = x + 1; int x = a778 % 1000;
+{ int a779 = x + 2; int x = a779 % 1000;
+{ int a780 = x + 0; int x = a780 % 1000;
+{ int a781 = x + 1; int x = a781 % 1000;
+{ int a782 = x + 2; int x = a782 % 1000;
+{ int a783 = x + 0; int x = a783 % 1000;
+{ int a784 = x + 1; int x = a784 % 1000;
+{ int a785 = x + 2; int x = a785 % 1000;
+{ int a786 = x + 0; int x = a786 % 1000;
+{ int a787 = x + 1; int x = a787 % 1000;
+{ int a788 = x + 2; int x = a788 % 1000;
+{ int a789 = x + 0; int x = a789 % 1000;
+{ int a790 = x + 1; int x = a790 % 1000;
+{ int a791 = x + 2; int x = a791 % 1000;
+{ int a792 = x + 0; int x = a792 % 1000;
+{ int a793 = x + 1; int x = a793 % 1000;
+{ int a794 = x + 2; int x = a794 % 1000;
+{ int a795 = x + 0; int x = a795 % 1000;
+{ int a796 = x + 1; int x = a796 % 1000;
+{ int a797 = x + 2; int x = a797 % 1000;
+{ int a798 = x + 0; int x = a798 % 1000;
+{ int a799 = x + 1; int x = a799 % 1000;
+{ int a800 = x + 2; int x = a800 % 1000;
+{ int a801 = x + 0; int x = a801 % 1000;
+{ int a802 = x + 1; int x = a802 % 1000;
+{ int a803 = x + 2; int x = a803 % 1000;
+{ int a804 = x + 0; int x = a804 % 1000;
+{ int a805 = x + 1; int x = a805 % 1000;
+{ int a806 = x + 2; int x = a806 % 1000;
+{ int a807 = x + 0; int x = a807 % 1000;
+{ int a808 = x + 1; int x = a808 % 1000;
+{ int a809 = x + 2; int x = a809 % 1000;
+{ int a810 = x + 0; int x = a810 % 1000;
+{ int a811 = x + 1; int x = a811 % 1000;
+{ int a812 = x + 2; int x = a812 % 1000;
+{ int a813 = x + 0; int x = a813 % 1000;
+{ int a814 = x + 1; int x = a814 % 1000;
+{ int a815 = x + 2; int x = a815 % 1000;
+{ int a816 = x + 0; int x = a816 % 1000;
+{ int a817 = x + 1; int x = a817 % 1000;
+{ int a818 = x + 2; int x = a818 % 1000;
+{ int a819 = x + 0; int x = a819 % 1000;
+{ int a820 = x + 1; int x = a820 % 1000;
+{ int a821 = x + 2; int x = a821 % 1000;
+{ int a822 = x + 0; int x = a822 % 1000;
+{ int a823 = x + 1; int x = a823 % 1000;
+{ int a824 = x + 2; int x = a824 % 1000;
+{ int a825 = x + 0; int x = a825 % 1000;
+{ int a826 = x + 1; int x = a826 % 1000;
+{ int a827 = x + 2; int x = a827 % 1000;
+{ int a828 = x + 0; int x = a828 % 1000;
+{ int a829 = x + 1; int x = a829 % 1000;
+{ int a830 = x + 2; int x = a830 % 1000;
+{ int a831 = x + 0; int x = a831 % 1000;
+{ int a832 = x + 1; int x = a832 % 1000;
+{ int a833 = x + 2; int x = a833 % 1000;
+{ int a834 = x + 0; int x = a834 % 1000;
+{ int a835 = x + 1; int x = a835 % 1000;
+{ int a836 = x + 2; int x = a836 % 1000;
+{ int a837 = x + 0; int x = a837 % 1000;
+{ int a838 = x + 1; int x = a838 % 1000;
+{ int a839 = x + 2; int x = a839 % 1000;
+{ int a840 = x + 0; int x = a840 % 1000;
+{ int a841 = x + 1; int x = a841 % 1000;
+{ int a842 = x + 2; int x = a842 % 1000;
+{ int a843 = x + 0; int x = a843 % 1000;
+{ int a844 = x + 1; int x = a844 % 1000;
+{ int a845 = x + 2; int x = a845 % 1000;
+{ int a846 = x + 0; int x = a846 % 1000;
+{ int a847 = x + 1; int x = a847 % 1000;
+{ int a848 = x + 2; int x = a848 % 1000;
+{ int a849 = x + 0; int x = a849 % 1000;
+{ int a850 = x + 1; int x = a850 % 1000;
+{ int a851 = x + 2; int x = a851 % 1000;
+{ int a852 = x + 0; int x = a852 % 1000;
+{ int a853 = x + 1; int x = a853 % 1000;
+{ int a854 = x + 2; int x = a854 % 1000;
+{ int a855 = x + 0; int x = a855 % 1000;
+{ int a856 = x + 1; int x = a856 % 1000;
+{ int a857 = x + 2; int x = a857 % 1000;
+{ int a858 = x + 0; int x = a858 % 1000;
+{ int a859 = x + 1; int x = a859 % 1000;
+{ int a860 = x + 2; int x = a860 % 1000;
+{ int a861 = x + 0; int x = a861 % 1000;
+{ int a862 = x + 1; int x = a862 % 1000;
+{ int a863 = x + 2; int x = a863 % 1000;
+{ int a864 = x + 0; int x = a864 % 1000;
+{ int a865 = x + 1; int x = a865 % 1000;
+{ int a866 = x + 2; int x = a866 % 1000;
+{ int a867 = x + 0; int x = a867 % 1000;
+{ int a868 = x + 1; int x = a868 % 1000;
+{ int a869 = x + 2; int x = a869 % 1000;
+{ int a870 = x + 0; int x = a870 % 1000;
+{ int a871 = x + 1; int x = a871 % 1000;
+{ int a872 = x + 2; int x = a872 % 1000;
+{ int a873 = x + 0; int x = a873 % 1000;
+{ int a874 = x + 1; int x = a874 % 1000;
+{ int a875 = x + 2; int x = a875 % 1000;
+{ int a876 = x + 0; int x = a876 % 1000;
+{ int a877 = x + 1; int x = a877 % 1000;
+{ int a878 = x + 2; int x = a878 % 1000;
+{ int a879 = x + 0; int x = a879 % 1000;
+{ int a880 = x + 1; int x = a880 % 1000;
+{ int a881 = x + 2; int x = a881 % 1000;
+{ int a882 = x + 0; int x = a882 % 1000;
+{ int a883 = x + 1; int x = a883 % 1000;
+{ int a884 = x + 2; int x = a884 % 1000;
+{ int a885 = x + 0; int x = a885 % 1000;
+{ int a886 = x + 1; int x = a886 % 1000;
+{ int a887 = x + 2; int x = a887 % 1000;
+{ int a888 = x + 0; int x = a888 % 1000;
+{ int a889 = x + 1; int x = a889 % 1000;
+{ int a890 = x + 2; int x = a890 % 1000;
+{ int a891 = x + 0; int x = a891 % 1000;
+{ int a892 = x + 1; int x = a892 % 1000;
+{ int a893 = x + 2; int x = a893 % 1000;
+{ int a894 = x + 0; int x = a894 % 1000;
+{ int a895 = x + 1; int x = a895 % 1000;
+{ int a896 = x + 2; int x = a896 % 1000;
+{ int a897 = x + 0; int x = a897 % 1000;
+{ int a898 = x + 1; int x = a898 % 1000;
+{ int a899 = x + 2; int x = a899 % 1000;
+{ int a900 = x + 0; int x = a900 % 1000;
+{ int a901 = x + 1; int x = a901 % 1000;
+{ int a902 = x + 2; int x = a902 % 1000;
+{ int a903 = x + 0; int x = a903 % 1000;
+{ int a904 = x + 1; int x = a904 % 1000;
+{ int a905 = x + 2; int x = a905 % 1000;
+{ int a906 = x + 0; int x = a906 % 1000;
+{ int a907 = x + 1; int x = a907 % 1000;
+{ int a908 = x + 2; int x = a908 % 1000;
+{ int a909 = x + 0; int x = a909 % 1000;
+{ int a910 = x + 1; int x = a910 % 1000;
+{ int a911 = x + 2; int x = a911 % 1000;
+{ int a912 = x + 0; int x = a912 % 1000;
+{ int a913 = x + 1; int x = a913 % 1000;
+{ int a914 = x + 2; int x = a914 % 1000;
+{ int a915 = x + 0; int x = a915 % 1000;
+{ int a916 = x + 1; int x = a916 % 1000;
+{ int a917 = x + 2; int x = a917 % 1000;
+{ int a918 = x + 0; int x = a918 % 1000;
+{ int a919 = x + 1; int x = a919 % 1000;
+{ int a920 = x + 2; int x = a920 % 1000;
+{ int a921 = x + 0; int x = a921 % 1000;
+{ int a922 = x + 1; int x = a922 % 1000;
+{ int a923 = x + 2; int x = a923 % 1000;
+{ int a924 = x + 0; int x = a924 % 1000;
+{ int a925 = x + 1; int x = a925 % 1000;
+{ int a926 = x + 2; int x = a926 % 1000;
+{ int a927 = x + 0; int x = a927 % 1000;
+{ int a928 = x + 1; int x = a928 % 1000;
+{ int a929 = x + 2; int x = a929 % 1000;
+{ int a930 = x + 0; int x = a930 % 1000;
+{ int a931 = x + 1; int x = a931 % 1000;
+{ int a932 = x + 2; int x = a932 % 1000;
+{ int a933 = x + 0; int x = a933 % 1000;
+{ int a934 = x + 1; int x = a934 % 1000;
+{ int a935 = x + 2; int x = a935 % 1000;
+{ int a936 = x + 0; int x = a936 % 1000;
+{ int a937 = x + 1; int x = a937 % 1000;
+{ int a938 = x + 2; int x = a938 % 1000;
+{ int a939 = x + 0; int x = a939 % 1000;
+{ int a940 = x + 1; int x = a940 % 1000;
+{ int a941 = x + 2; int x = a941 % 1000;
+{ int a942 = x + 0; int x = a942 % 1000;
+{ int a943 = x + 1; int x = a943 % 1000;
+{ int a944 = x + 2; int x = a944 % 1000;
+{ int a945 = x + 0; int x = a945 % 1000;
+{ int a946 = x + 1; int x = a946 % 1000;
+{ int a947 = x + 2; int x = a947 % 1000;
+{ int a948 = x + 0; int x = a948 % 1000;
+{ int a949 = x + 1; int x = a949 % 1000;
+{ int a950 = x + 2; int x = a950 % 1000;
+{ int a951 = x + 0; int x = a951 % 1000;
+{ int a952 = x + 1; int x = a952 % 1000;
+{ int a953 = x + 2; int x = a953 % 1000;
+{ int a954 = x + 0; int x = a954 % 1000;
+{ int a955 = x + 1; int x = a955 % 1000;
+{ int a956 = x + 2; int x = a956 % 1000;
+{ int a957 = x + 0; int x = a957 % 1000;
+{ int a958 = x + 1; int x = a958 % 1000;
+{ int a959 = x + 2; int x = a959 % 1000;
+{ int a960 = x + 0; int x = a960 % 1000;
+{ int a961 = x + 1; int x = a961 % 1000;
+{ int a962 = x + 2; int x = a962 % 1000;
+{ int a963 = x + 0; int x = a963 % 1000;
+{ int a964 = x + 1; int x = a964 % 1000;
+{ int a965 = x + 2; int x = a965 % 1000;
+{ int a966 = x + 0; int x = a966 % 1000;
+{ int a967 = x + 1; int x = a967 % 1000;
+{ int a968 = x + 2; int x = a968 % 1000;
+{ int a969 = x + 0; int x = a969 % 1000;
+{ int a970 = x + 1; int x = a970 % 1000;
+{ int a971 = x + 2; int x = a971 % 1000;
+{ int a972 = x + 0; int x = a972 % 1000;
+{ int a973 = x + 1; int x = a973 % 1000;
+{ int a974 = x + 2; int x = a974 % 1000;
+{ int a975 = x + 0; int x = a975 % 1000;
+{ int a976 = x + 1; int x = a976 % 1000;
+{ int a977 = x + 2; int x = a977 % 1000;
+{ int a978 = x + 0; int x = a978 % 1000;
+{ int a979 = x + 1; int x = a979 % 1000;
+{ int a980 = x + 2; int x = a980 % 1000;
+{ int a981 = x + 0; int x = a981 % 1000;
+{ int a982 = x + 1; int x = a982 % 1000;
+{ int a983 = x + 2; int x = a983 % 1000;
+{ int a984 = x + 0; int x = a984 % 1000;
+{ int a985 = x + 1; int x = a985 % 1000;
+{ int a986 = x + 2; int x = a986 % 1000;
+{ int a987 = x + 0; int x = a987 % 1000;
+{ int a988 = x + 1; int x = a988 % 1000;
+{ int a989 = x + 2; int x = a989 % 1000;
+{ int a990 = x + 0; int x = a990 % 1000;
+{ int a991 = x + 1; int x = a991 % 1000;
+{ int a992 = x + 2; int x = a992 % 1000;
+{ int a993 = x + 0; int x = a993 % 1000;
+{ int a994 = x + 1; int x = a994 % 1000;
+{ int a995 = x + 2; int x = a995 % 1000;
+{ int a996 = x + 0; int x = a996 % 1000;
+{ int a997 = x + 1; int x = a997 % 1000;
+{ int a998 = x + 2; int x = a998 % 1000;
+{ int a999 = x + 0; int x = a999 % 1000;
+{ int a1000 = x + 1; int x = a1000 % 1000;
+{ int a1001 = x + 2; int x = a1001 % 1000;
+{ int a1002 = x + 0; int x = a1002 % 1000;
+{ int a1003 = x + 1; int x = a1003 % 1000;
+{ int a1004 = x + 2; int x = a1004 % 1000;
+{ int a1005 = x + 0; int x = a1005 % 1000;
+{ int a1006 = x + 1; int x = a1006 % 1000;
+{ int a1007 = x + 2; int x = a1007 % 1000;
+{ int a1008 = x + 0; int x = a1008 % 1000;
+{ int a1009 = x + 1; int x = a1009 % 1000;
+{ int a1010 = x + 2; int x = a1010 % 1000;
+{ int a1011 = x + 0; int x = a1011 % 1000;
+{ int a1012 = x + 1; int x = a1012 % 1000;
+{ int a1013 = x + 2; int x = a1013 % 1000;
+{ int a1014 = x + 0; int x = a1014 % 1000;
+{ int a1015 = x + 1; int x = a1015 % 1000;
+{ int a1016 = x + 2; int x = a1016 % 1000;
+{ int a1017 = x + 0; int x = a1017 % 1000;
+{ int a1018 = x + 1; int x = a1018 % 1000;
+{ int a1019 = x + 2; int x = a1019 % 1000;
+{ int a1020 = x + 0; int x = a1020 % 1000;
+{ int a1021 = x + 1; int x = a1021 % 1000;
+{ int a1022 = x + 2; int x = a1022 % 1000;
+{ int a1023 = x + 0; int x = a1023 % 1000;
+{ int a1024 = x + 1; int x = a1024 % 1000;
+{ int a1025 = x + 2; int x = a1025 % 1000;
+{ int a1026 = x + 0; int x = a1026 % 1000;
+{ int a1027 = x + 1; int x = a1027 % 1000;
+{ int a1028 = x + 2; int x = a1028 % 1000;
+{ int a1029 = x + 0; int x = a1029 % 1000;
+{ int a1030 = x + 1; int x = a1030 % 1000;
+{ int a1031 = x + 2; int x = a1031 % 1000;
+{ int a1032 = x + 0; int x = a1032 % 1000;
+{ int a1033 = x + 1; int x = a1033 % 1000;
+{ int a1034 = x + 2; int x = a1034 % 1000;
+{ int a1035 = x + 0; int x = a1035 % 1000;
+{ int a1036 = x + 1; int x = a1036 % 1000;
+{ int a1037 = x + 2; int x = a1037 % 1000;
+{ int a1038 = x + 0; int x = a1038 % 1000;
+{ int a1039 = x + 1; int x = a1039 % 1000;
+{ int a1040 = x + 2; int x = a1040 % 1000;
+{ int a1041 = x + 0; int x = a1041 % 1000;
+{ int a1042 = x + 1; int x = a1042 % 1000;
+{ int a1043 = x + 2; int x = a1043 % 1000;
+{ int a1044 = x + 0; int x = a1044 % 1000;
+{ int a1045 = x + 1; int x = a1045 % 1000;
+{ int a1046 = x + 2; int x = a1046 % 1000;
+{ int a1047 = x + 0; int x = a1047 % 1000;
+{ int a1048 = x + 1; int x = a1048 % 1000;
+{ int a1049 = x + 2; int x = a1049 % 1000;
+{ int a1050 = x + 0; int x = a1050 % 1000;
+{ int a1051 = x + 1; int x = a1051 % 1000;
+{ int a1052 = x + 2; int x = a1052 % 1000;
+{ int a1053 = x + 0; int x = a1053 % 1000;
+{ int a1054 = x + 1; int x = a1054 % 1000;
+{ int a1055 = x + 2; int x = a1055 % 1000;
+{ int a1056 = x + 0; int x = a1056 % 1000;
+{ int a1057 = x + 1; int x = a1057 % 1000;
+{ int a1058 = x + 2; int x = a1058 % 1000;
+{ int a1059 = x + 0; int x = a1059 % 1000;
+{ int a1060 = x + 1; int x = a1060 % 1000;
+{ int a1061 = x + 2; int x = a1061 % 1000;
+{ int a1062 = x + 0; int x = a1062 % 1000;
+{ int a1063 = x + 1; int x = a1063 % 1000;
+{ int a1064 = x + 2; int x = a1064 % 1000;
+{ int a1065 = x + 0; int x = a1065 % 1000;
+{ int a1066 = x + 1; int x = a1066 % 1000;
+{ int a1067 = x + 2; int x = a1067 % 1000;
+{ int a1068 = x + 0; int x = a1068 % 1000;
+{ int a1069 = x + 1; int x = a1069 % 1000;
+{ int a1070 = x + 2; int x = a1070 % 1000;
+{ int a1071 = x + 0; int x = a1071 % 1000;
+{ int a1072 = x + 1; int x = a1072 % 1000;
+{ int a1073 = x + 2; int x = a1073 % 1000;
+{ int a1074 = x + 0; int x = a1074 % 1000;
+{ int a1075 = x + 1; int x = a1075 % 1000;
+{ int a1076 = x + 2; int x = a1076 % 1000;
+{ int a1077 = x + 0; int x = a1077 % 1000;
+{ int a1078 = x + 1; int x = a1078 % 1000;
+{ int a1079 = x + 2; int x = a1079 % 1000;
+{ int a1080 = x + 0; int x = a1080 % 1000;
+{ int a1081 = x + 1; int x = a1081 % 1000;
+{ int a1082 = x + 2; int x = a1082 % 1000;
+{ int a1083 = x + 0; int x = a1083 % 1000;
+{ int a1084 = x + 1; int x = a1084 % 1000;
+{ int a1085 = x + 2; int x = a1085 % 1000;
+{ int a1086 = x + 0; int x = a1086 % 1000;
+{ int a1087 = x + 1; int x = a1087 % 1000;
+{ int a1088 = x + 2; int x = a1088 % 1000;
+{ int a1089 = x + 0; int x = a1089 % 1000;
+{ int a1090 = x + 1; int x = a1090 % 1000;
+{ int a1091 = x + 2; int x = a1091 % 1000;
+{ int a1092 = x + 0; int x = a1092 % 1000;
+{ int a1093 = x + 1; int x = a1093 % 1000;
+{ int a1094 = x + 2; int x = a1094 % 1000;
+{ int a1095 = x + 0; int x = a1095 % 1000;
+{ int a1096 = x + 1; int x = a1096 % 1000;
+{ int a1097 = x + 2; int x = a1097 % 1000;
+{ int a1098 = x + 0; int x = a1098 % 1000;
+{ int a1099 = x + 1; int x = a1099 % 1000;
+{ int a1100 = x + 2; int x = a1100 % 1000;
+{ int a1101 = x + 0; int x = a1101 % 1000;
+{ int a1102 = x + 1; int x = a1102 % 1000;
+{ int a1103 = x + 2; int x = a1103 % 1000;
+{ int a1104 = x + 0; int x = a1104 % 1000;
+{ int a1105 = x + 1; int x = a1105 % 1000;
+{ int a1106 = x + 2; int x = a1106 % 1000;
+{ int a1107 = x + 0; int x = a1107 % 1000;
+{ int a1108 = x + 1; int x = a1108 % 1000;
+{ int a1109 = x + 2; int x = a1109 % 1000;
+{ int a1110 = x + 0; int x = a1110 % 1000;
+{ int a1111 = x + 1; int x = a1111 % 1000;
+{ int a1112 = x + 2; int x = a1112 % 1000;
+{ int a1113 = x + 0; int x = a1113 % 1000;
+{ int a1114 = x + 1; int x = a1114 % 1000;
+{ int a1115 = x + 2; int x = a1115 % 1000;
+{ int a1116 = x + 0; int x = a1116 % 1000;
+{ int a1117 = x + 1; int x = a1117 % 1000;
+{ int a1118 = x + 2; int x = a1118 % 1000;
+{ int a1119 = x + 0; int x = a1119 % 1000;
+{ int a1120 = x + 1; int x = a1120 % 1000;
+{ int a1121 = x + 2; int x = a1121 % 1000;
+{ int a1122 = x + 0; int x = a1122 % 1000;
+{ int a1123 = x + 1; int x = a1123 % 1000;
+{ int a1124 = x + 2; int x = a1124 % 1000;
+{ int a1125 = x + 0; int x = a1125 % 1000;
+{ int a1126 = x + 1; int x = a1126 % 1000;
+{ int a1127 = x + 2; int x = a1127 % 1000;
+{ int a1128 = x + 0; int x = a1128 % 1000;
+{ int a1129 = x + 1; int x = a1129 % 1000;
+{ int a1130 = x + 2; int x = a1130 % 1000;
+{ int a1131 = x + 0; int x = a1131 % 1000;
+{ int a1132 = x + 1; int x = a1132 % 1000;
+{ int a1133 = x + 2; int x = a1133 % 1000;
+{ int a1134 = x + 0; int x = a1134 % 1000;
+{ int a1135 = x + 1; int x = a1135 % 1000;
+{ int a1136 = x + 2; int x = a1136 % 1000;
+{ int a1137 = x + 0; int x = a1137 % 1000;
+{ int a1138 = x + 1; int x = a1138 % 1000;
+{ int a1139 = x + 2; int x = a1139 % 1000;
+{ int a1140 = x + 0; int x = a1140 % 1000;
+{ int a1141 = x + 1; int x = a1141 % 1000;
+{ int a1142 = x + 2; int x = a1142 % 1000;
+{ int a1143 = x + 0; int x = a1143 % 1000;
+{ int a1144 = x + 1; int x = a1144 % 1000;
+{ int a1145 = x + 2; int x = a1145 % 1000;
+{ int a1146 = x + 0; int x = a1146 % 1000;
+{ int a1147 = x + 1; int x = a1147 % 1000;
+{ int a1148 = x + 2; int x = a1148 % 1000;
+{ int a1149 = x + 0; int x = a1149 % 1000;
+{ int a1150 = x + 1; int x = a1150 % 1000;
+{ int a1151 = x + 2; int x = a1151 % 1000;
+{ int a1152 = x + 0; int x = a1152 % 1000;
+{ int a1153 = x + 1; int x = a1153 % 1000;
+{ int a1154 = x + 2; int x = a1154 % 1000;
+{ int a1155 = x + 0; int x = a1155 % 1000;
+{ int a1156 = x + 1; int x = a1156 % 1000;
+{ int a1157 = x + 2; int x = a1157 % 1000;
+{ int a1158 = x + 0; int x = a1158 % 1000;
+{ int a1159 = x + 1; int x = a1159 % 1000;
+{ int a1160 = x + 2; int x = a1160 % 1000;
+{ int a1161 = x + 0; int x = a1161 % 1000;
+{ int a1162 = x + 1; int x = a1162 % 1000;
+{ int a1163 = x + 2; int x = a1163 % 1000;
+{ int a1164 = x + 0; int x = a1164 % 1000;
+{ int a1165 = x + 1; int x = a1165 % 1000;
+{ int a1166 = x + 2; int x = a1166 % 1000;
+{ int a1167 = x + 0; int x = a1167 % 1000;
+{ int a1168 = x + 1; int x = a1168 % 1000;
+{ int a1169 = x + 2; int x = a1169 % 1000;
+{ int a1170 = x + 0; int x = a1170 % 1000;
+{ int a1171 = x + 1; int x = a1171 % 1000;
+{ int a1172 = x + 2; int x = a1172 % 1000;
+{ int a1173 = x + 0; int x = a1173 % 1000;
+{ int a1174 = x + 1; int x = a1174 % 1000;
+{ int a1175 = x + 2; int x = a1175 % 1000;
+{ int a1176 = x + 0; int x = a1176 % 1000;
+{ int a1177 = x + 1; int x = a1177 % 1000;
+{ int a1178 = x + 2; int x = a1178 % 1000;
+{ int a1179 = x + 0; int x = a1179 % 1000;
+{ int a1180 = x + 1; int x = a1180 % 1000;
+{ int a1181 = x + 2; int x = a1181 % 1000;
+{ int a1182 = x + 0; int x = a1182 % 1000;
+{ int a1183 = x + 1; int x = a1183 % 1000;
+{ int a1184 = x + 2; int x = a1184 % 1000;
+{ int a1185 = x + 0; int x = a1185 % 1000;
+{ int a1186 = x + 1; int x = a1186 % 1000;
+{ int a1187 = x + 2; int x = a1187 % 1000;
+{ int a1188 = x + 0; int x = a1188 % 1000;
+{ int a1189 = x + 1; int x = a1189 % 1000;
+{ int a1190 = x + 2; int x = a1190 % 1000;
+{ int a1191 = x + 0; int x = a1191 % 1000;
+{ int a1192 = x + 1; int x = a1192 % 1000;
+{ int a1193 = x + 2; int x = a1193 % 1000;
+{ int a1194 = x + 0; int x = a1194 % 1000;
+{ int a1195 = x + 1; int x = a1195 % 1000;
+{ int a1196 = x + 2; int x = a1196 % 1000;
+{ int a1197 = x + 0; int x = a1197 % 1000;
+{ int a1198 = x + 1; int x = a1198 % 1000;
+{ int a1199 = x + 2; int x = a1199 % 1000;
+{ int a1200 = x + 0; int x = a1200 % 1000;
+{ int a1201 = x + 1; int x = a1201 % 1000;
+{ int a1202 = x + 2; int x = a1202 % 1000;
+{ int a1203 = x + 0; int x = a1203 % 1000;
+{ int a1204 = x + 1; int x = a1204 % 1000;
+{ int a1205 = x + 2; int x = a1205 % 1000;
+{ int a1206 = x + 0; int x = a1206 % 1000;
+{ int a1207 = x + 1; int x = a1207 % 1000;
+{ int a1208 = x + 2; int x = a1208 % 1000;
+{ int a1209 = x + 0; int x = a1209 % 1000;
+{ int a1210 = x + 1; int x = a1210 % 1000;
+{ int a1211 = x + 2; int x = a1211 % 1000;
+{ int a1212 = x + 0; int x = a1212 % 1000;
+{ int a1213 = x + 1; int x = a1213 % 1000;
+{ int a1214 = x + 2; int x = a1214 % 1000;
+{ int a1215 = x + 0; int x = a1215 % 1000;
+{ int a1216 = x + 1; int x = a1216 % 1000;
+{ int a1217 = x + 2; int x = a1217 % 1000;
+{ int a1218 = x + 0; int x = a1218 % 1000;
+{ int a1219 = x + 1; int x = a1219 % 1000;
+{ int a1220 = x + 2; int x = a1220 % 1000;
+{ int a1221 = x + 0; int x = a1221 % 1000;
+{ int a1222 = x + 1; int x = a1222 % 1000;
+{ int a1223 = x + 2; int x = a1223 % 1000;
+{ int a1224 = x + 0; int x = a1224 % 1000;
+{ int a1225 = x + 1; int x = a1225 % 1000;
+{ int a1226 = x + 2; int x = a1226 % 1000;
+{ int a1227 = x + 0; int x = a1227 % 1000;
+{ int a1228 = x + 1; int x = a1228 % 1000;
+{ int a1229 = x + 2; int x = a1229 % 1000;
+{ int a1230 = x + 0; int x = a1230 % 1000;
+{ int a1231 = x + 1; int x = a1231 % 1000;
+{ int a1232 = x + 2; int x = a1232 % 1000;
+{ int a1233 = x + 0; int x = a1233 % 1000;
+{ int a1234 = x + 1; int x = a1234 % 1000;
+{ int a1235 = x + 2; int x = a1235 % 1000;
+{ int a1236 = x + 0; int x = a1236 % 1000;
+{ int a1237 = x + 1; int x = a1237 % 1000;
+{ int a1238 = x + 2; int x = a1238 % 1000;
+{ int a1239 = x + 0; int x = a1239 % 1000;
+{ int a1240 = x + 1; int x = a1240 % 1000;
+{ int a1241 = x + 2; int x = a1241 % 1000;
+{ int a1242 = x + 0; int x = a1242 % 1000;
+{ int a1243 = x + 1; int x = a1243 % 1000;
+{ int a1244 = x + 2; int x = a1244 % 1000;
+{ int a1245 = x + 0; int x = a1245 % 1000;
+{ int a1246 = x + 1; int x = a1246 % 1000;
+{ int a1247 = x + 2; int x = a1247 % 1000;
+{ int a1248 = x + 0; int x = a1248 % 1000;
+{ int a1249 = x + 1; int x = a1249 % 1000;
+{ int a1250 = x + 2; int x = a1250 % 1000;
+{ int a1251 = x + 0; int x = a1251 % 1000;
+{ int a1252 = x + 1; int x = a1252 % 1000;
+{ int a1253 = x + 2; int x = a1253 % 1000;
+{ int a1254 = x + 0; int x = a1254 % 1000;
+{ int a1255 = x + 1; int x = a1255 % 1000;
+{ int a1256 = x + 2; int x = a1256 % 1000;
+{ int a1257 = x + 0; int x = a1257 % 1000;
+{ int a1258 = x + 1; int x = a1258 % 1000;
+{ int a1259 = x + 2; int x = a1259 % 1000;
+{ int a1260 = x + 0; int x = a1260 % 1000;
+{ int a1261 = x + 1; int x = a1261 % 1000;
+{ int a1262 = x + 2; int x = a1262 % 1000;
+{ int a1263 = x + 0; int x = a1263 % 1000;
+{ int a1264 = x + 1; int x = a1264 % 1000;
+{ int a1265 = x + 2; int x = a1265 % 1000;
+{ int a1266 = x + 0; int x = a1266 % 1000;
+{ int a1267 = x + 1; int x = a1267 % 1000;
+{ int a1268 = x + 2; int x = a1268 % 1000;
+{ int a1269 = x + 0; int x = a1269 % 1000;
+{ int a1270 = x + 1; int x = a1270 % 1000;
+{ int a1271 = x + 2; int x = a1271 % 1000;
+{ int a1272 = x + 0; int x = a1272 % 1000;
+{ int a1273 = x + 1; int x = a1273 % 1000;
+{ int a1274 = x + 2; int x = a1274 % 1000;
+{ int a1275 = x + 0; int x = a1275 % 1000;
+{ int a1276 = x + 1; int x = a1276 % 1000;
+{ int a1277 = x + 2; int x = a1277 % 1000;
+{ int a1278 = x + 0; int x = a1278 % 1000;
+{ int a1279 = x + 1; int x = a1279 % 1000;
+{ int a1280 = x + 2; int x = a1280 % 1000;
+{ int a1281 = x + 0; int x = a1281 % 1000;
+{ int a1282 = x + 1; int x = a1282 % 1000;
+{ int a1283 = x + 2; int x = a1283 % 1000;
+{ int a1284 = x + 0; int x = a1284 % 1000;
+{ int a1285 = x + 1; int x = a1285 % 1000;
+{ int a1286 = x + 2; int x = a1286 % 1000;
+{ int a1287 = x + 0; int x = a1287 % 1000;
+{ int a1288 = x + 1; int x = a1288 % 1000;
+{ int a1289 = x + 2; int x = a1289 % 1000;
+{ int a1290 = x + 0; int x = a1290 % 1000;
+{ int a1291 = x + 1; int x = a1291 % 1000;
+{ int a1292 = x + 2; int x = a1292 % 1000;
+{ int a1293 = x + 0; int x = a1293 % 1000;
+{ int a1294 = x + 1; int x = a1294 % 1000;
+{ int a1295 = x + 2; int x = a1295 % 1000;
+{ int a1296 = x + 0; int x = a1296 % 1000;
+{ int a1297 = x + 1; int x = a1297 % 1000;
+{ int a1298 = x + 2; int x = a1298 % 1000;
+{ int a1299 = x + 0; int x = a1299 % 1000;
+{ int a1300 = x + 1; int x = a1300 % 1000;
+{ int a1301 = x + 2; int x = a1301 % 1000;
+{ int a1302 = x + 0; int x = a1302 % 1000;
+{ int a1303 = x + 1; int x = a1303 % 1000;
+{ int a1304 = x + 2; int x = a1304 % 1000;
+{ int a1305 = x + 0; int x = a1305 % 1000;
+{ int a1306 = x + 1; int x = a1306 % 1000;
+{ int a1307 = x + 2; int x = a1307 % 1000;
+{ int a1308 = x + 0; int x = a1308 % 1000;
+{ int a1309 = x + 1; int x = a1309 % 1000;
+{ int a1310 = x + 2; int x = a1310 % 1000;
+{ int a1311 = x + 0; int x = a1311 % 1000;
+{ int a1312 = x + 1; int x = a1312 % 1000;
+{ int a1313 = x + 2; int x = a1313 % 1000;
+{ int a1314 = x + 0; int x = a1314 % 1000;
+{ int a1315 = x + 1; int x = a1315 % 1000;
+{ int a1316 = x + 2; int x = a1316 % 1000;
+{ int a1317 = x + 0; int x = a1317 % 1000;
+{ int a1318 = x + 1; int x = a1318 % 1000;
+{ int a1319 = x + 2; int x = a1319 % 1000;
+{ int a1320 = x + 0; int x = a1320 % 1000;
+{ int a1321 = x + 1; int x = a1321 % 1000;
+{ int a1322 = x + 2; int x = a1322 % 1000;
+{ int a1323 = x + 0; int x = a1323 % 1000;
+{ int a1324 = x + 1; int x = a1324 % 1000;
+{ int a1325 = x + 2; int x = a1325 % 1000;
+{ int a1326 = x + 0; int x = a1326 % 1000;
+{ int a1327 = x + 1; int x = a1327 % 1000;
+{ int a1328 = x + 2; int x = a1328 % 1000;
+{ int a1329 = x + 0; int x = a1329 % 1000;
+{ int a1330 = x + 1; int x = a1330 % 1000;
+{ int a1331 = x + 2; int x = a1331 % 1000;
+{ int a1332 = x + 0; int x = a1332 % 1000;
+{ int a1333 = x + 1; int x = a1333 % 1000;
+{ int a1334 = x + 2; int x = a1334 % 1000;
+{ int a1335 = x + 0; int x = a1335 % 1000;
+{ int a1336 = x + 1; int x = a1336 % 1000;
+{ int a1337 = x + 2; int x = a1337 % 1000;
+{ int a1338 = x + 0; int x = a1338 % 1000;
+{ int a1339 = x + 1; int x = a1339 % 1000;
+{ int a1340 = x + 2; int x = a1340 % 1000;
+{ int a1341 = x + 0; int x = a1341 % 1000;
+{ int a1342 = x + 1; int x = a1342 % 1000;
+{ int a1343 = x + 2; int x = a1343 % 1000;
+{ int a1344 = x + 0; int x = a1344 % 1000;
+{ int a1345 = x + 1; int x = a1345 % 1000;
+{ int a1346 = x + 2; int x = a1346 % 1000;
+{ int a1347 = x + 0; int x = a1347 % 1000;
+{ int a1348 = x + 1; int x = a1348 % 1000;
+{ int a1349 = x + 2; int x = a1349 % 1000;
+{ int a1350 = x + 0; int x = a1350 % 1000;
+{ int a1351 = x + 1; int x = a1351 % 1000;
+{ int a1352 = x + 2; int x = a1352 % 1000;
+{ int a1353 = x + 0; int x = a1353 % 1000;
+{ int a1354 = x + 1; int x = a1354 % 1000;
+{ int a1355 = x + 2; int x = a1355 % 1000;
+{ int a1356 = x + 0; int x = a1356 % 1000;
+{ int a1357 = x + 1; int x = a1357 % 1000;
+{ int a1358 = x + 2; int x = a1358 % 1000;
+{ int a1359 = x + 0; int x = a1359 % 1000;
+{ int a1360 = x + 1; int x = a1360 % 1000;
+{ int a1361 = x + 2; int x = a1361 % 1000;
+{ int a1362 = x + 0; int x = a1362 % 1000;
+{ int a1363 = x + 1; int x = a1363 % 1000;
+{ int a1364 = x + 2; int x = a1364 % 1000;
+{ int a1365 = x + 0; int x = a1365 % 1000;
+{ int a1366 = x + 1; int x = a1366 % 1000;
+{ int a1367 = x + 2; int x = a1367 % 1000;
+{ int a1368 = x + 0; int x = a1368 % 1000;
+{ int a1369 = x + 1; int x = a1369 % 1000;
+{ int a1370 = x + 2; int x = a1370 % 1000;
+{ int a1371 = x + 0; int x = a1371 % 1000;
+{ int a1372 = x + 1; int x = a1372 % 1000;
+{ int a1373 = x + 2; int x = a1373 % 1000;
+{ int a1374 = x + 0; int x = a1374 % 1000;
+{ int a1375 = x + 1; int x = a1375 % 1000;
+{ int a1376 = x + 2; int x = a1376 % 1000;
+{ int a1377 = x + 0; int x = a1377 % 1000;
+{ int a1378 = x + 1; int x = a1378 % 1000;
+{ int a1379 = x + 2; int x = a1379 % 1000;
+{ int a1380 = x + 0; int x = a1380 % 1000;
+{ int a1381 = x + 1; int x = a1381 % 1000;
+{ int a1382 = x + 2; int x = a1382 % 1000;
+{ int a1383 = x + 0; int x = a1383 % 1000;
+{ int a1384 = x + 1; int x = a1384 % 1000;
+{ int a1385 = x + 2; int x = a1385 % 1000;
+{ int a1386 = x + 0; int x = a1386 % 1000;
+{ int a1387 = x + 1; int x = a1387 % 1000;
+{ int a1388 = x + 2; int x = a1388 % 1000;
+{ int a1389 = x + 0; int x = a1389 % 1000;
+{ int a1390 = x + 1; int x = a1390 % 1000;
+{ int a1391 = x + 2; int x = a1391 % 1000;
+{ int a1392 = x + 0; int x = a1392 % 1000;
+{ int a1393 = x + 1; int x = a1393 % 1000;
+{ int a1394 = x + 2; int x = a1394 % 1000;
+{ int a1395 = x + 0; int x = a1395 % 1000;
+{ int a1396 = x + 1; int x = a1396 % 1000;
+{ int a1397 = x + 2; int x = a1397 % 1000;
+{ int a1398 = x + 0; int x = a1398 % 1000;
+{ int a1399 = x + 1; int x = a1399 % 1000;
+{ int a1400 = x + 2; int x = a1400 % 1000;
+{ int a1401 = x + 0; int x = a1401 % 1000;
+{ int a1402 = x + 1; int x = a1402 % 1000;
+{ int a1403 = x + 2; int x = a1403 % 1000;
+{ int a1404 = x + 0; int x = a1404 % 1000;
+{ int a1405 = x + 1; int x = a1405 % 1000;
+{ int a1406 = x + 2; int x = a1406 % 1000;
+{ int a1407 = x + 0; int x = a1407 % 1000;
+{ int a1408 = x + 1; int x = a1408 % 1000;
+{ int a1409 = x + 2; int x = a1409 % 1000;
+{ int a1410 = x + 0; int x = a1410 % 1000;
+{ int a1411 = x + 1; int x = a1411 % 1000;
+{ int a1412 = x + 2; int x = a1412 % 1000;
+{ int a1413 = x + 0; int x = a1413 % 1000;
+{ int a1414 = x + 1; int x = a1414 % 1000;
+{ int a1415 = x + 2; int x = a1415 % 1000;
+{ int a1416 = x + 0; int x = a1416 % 1000;
+{ int a1417 = x + 1; int x = a1417 % 1000;
+{ int a1418 = x + 2; int x = a1418 % 1000;
+{ int a1419 = x + 0; int x = a1419 % 1000;
+{ int a1420 = x + 1; int x = a1420 % 1000;
+{ int a1421 = x + 2; int x = a1421 % 1000;
+{ int a1422 = x + 0; int x = a1422 % 1000;
+{ int a1423 = x + 1; int x = a1423 % 1000;
+{ int a1424 = x + 2; int x = a1424 % 1000;
+{ int a1425 = x + 0; int x = a1425 % 1000;
+{ int a1426 = x + 1; int x = a1426 % 1000;
+{ int a1427 = x + 2; int x = a1427 % 1000;
+{ int a1428 = x + 0; int x = a1428 % 1000;
+{ int a1429 = x + 1; int x = a1429 % 1000;
+{ int a1430 = x + 2; int x = a1430 % 1000;
+{ int a1431 = x + 0; int x = a1431 % 1000;
+{ int a1432 = x + 1; int x = a1432 % 1000;
+{ int a1433 = x + 2; int x = a1433 % 1000;
+{ int a1434 = x + 0; int x = a1434 % 1000;
+{ int a1435 = x + 1; int x = a1435 % 1000;
+{ int a1436 = x + 2; int x = a1436 % 1000;
+{ int a1437 = x + 0; int x = a1437 % 1000;
+{ int a1438 = x + 1; int x = a1438 % 1000;
+{ int a1439 = x + 2; int x = a1439 % 1000;
+{ int a1440 = x + 0; int x = a1440 % 1000;
+{ int a1441 = x + 1; int x = a1441 % 1000;
+{ int a1442 = x + 2; int x = a1442 % 1000;
+{ int a1443 = x + 0; int x = a1443 % 1000;
+{ int a1444 = x + 1; int x = a1444 % 1000;
+{ int a1445 = x + 2; int x = a1445 % 1000;
+{ int a1446 = x + 0; int x = a1446 % 1000;
+{ int a1447 = x + 1; int x = a1447 % 1000;
+{ int a1448 = x + 2; int x = a1448 % 1000;
+{ int a1449 = x + 0; int x = a1449 % 1000;
+{ int a1450 = x + 1; int x = a1450 % 1000;
+{ int a1451 = x + 2; int x = a1451 % 1000;
+{ int a1452 = x + 0; int x = a1452 % 1000;
+{ int a1453 = x + 1; int x = a1453 % 1000;
+{ int a1454 = x + 2; int x = a1454 % 1000;
+{ int a1455 = x + 0; int x = a1455 % 1000;
+{ int a1456 = x + 1; int x = a1456 % 1000;
+{ int a1457 = x + 2; int x = a1457 % 1000;
+{ int a1458 = x + 0; int x = a1458 % 1000;
+{ int a1459 = x + 1; int x = a1459 % 1000;
+{ int a1460 = x + 2; int x = a1460 % 1000;
+{ int a1461 = x + 0; int x = a1461 % 1000;
+{ int a1462 = x + 1; int x = a1462 % 1000;
+{ int a1463 = x + 2; int x = a1463 % 1000;
+{ int a1464 = x + 0; int x = a1464 % 1000;
+{ int a1465 = x + 1; int x = a1465 % 1000;
+{ int a1466 = x + 2; int x = a1466 % 1000;
+{ int a1467 = x + 0; int x = a1467 % 1000;
+{ int a1468 = x + 1; int x = a1468 % 1000;
+{ int a1469 = x + 2; int x = a1469 % 1000;
+{ int a1470 = x + 0; int x = a1470 % 1000;
+{ int a1471 = x + 1; int x = a1471 % 1000;
+{ int a1472 = x + 2; int x = a1472 % 1000;
+{ int a1473 = x + 0; int x = a1473 % 1000;
+{ int a1474 = x + 1; int x = a1474 % 1000;
+{ int a1475 = x + 2; int x = a1475 % 1000;
+{ int a1476 = x + 0; int x = a1476 % 1000;
+{ int a1477 = x + 1; int x = a1477 % 1000;
+{ int a1478 = x + 2; int x = a1478 % 1000;
+{ int a1479 = x + 0; int x = a1479 % 1000;
+{ int a1480 = x + 1; int x = a1480 % 1000;
+{ int a1481 = x + 2; int x = a1481 % 1000;
+{ int a1482 = x + 0; int x = a1482 % 1000;
+{ int a1483 = x + 1; int x = a1483 % 1000;
+{ int a1484 = x + 2; int x = a1484 % 1000;
+{ int a1485 = x + 0; int x = a1485 % 1000;
+{ int a1486 = x + 1; int x = a1486 % 1000;
+{ int a1487 = x + 2; int x = a1487 % 1000;
+{ int a1488 = x + 0; int x = a1488 % 1000;
+{ int a1489 = x + 1; int x = a1489 % 1000;
+{ int a1490 = x + 2; int x = a1490 % 1000;
+{ int a1491 = x + 0; int x = a1491 % 1000;
+{ int a1492 = x + 1; int x = a1492 % 1000;
+{ int a1493 = x + 2; int x = a1493 % 1000;
+{ int a1494 = x + 0; int x = a1494 % 1000;
+{ int a1495 = x + 1; int x = a1495 % 1000;
+{ int a1496 = x + 2; int x = a1496 % 1000;
+{ int a1497 = x + 0; int x = a1497 % 1000;
+{ int a1498 = x + 1; int x = a1498 % 1000;
+{ int a1499 = x + 2; int x = a1499 % 1000;
+{ int a1500 = x + 0; int x = a1500 % 1000;
+{ int a1501 = x + 1; int x = a1501 % 1000;
+{ int a1502 = x + 2; int x = a1502 % 1000;
+{ int a1503 = x + 0; int x = a1503 % 1000;
+{ int a1504 = x + 1; int x = a1504 % 1000;
+{ int a1505 = x + 2; int x = a1505 % 1000;
+{ int a1506 = x + 0; int x = a1506 % 1000;
+{ int a1507 = x + 1; int x = a1507 % 1000;
+{ int a1508 = x + 2; int x = a1508 % 1000;
+{ int a1509 = x + 0; int x = a1509 % 1000;
+{ int a1510 = x + 1; int x = a1510 % 1000;
+{ int a1511 = x + 2; int x = a1511 % 1000;
+{ int a1512 = x + 0; int x = a1512 % 1000;
+{ int a1513 = x + 1; int x = a1513 % 1000;
+{ int a1514 = x + 2; int x = a1514 % 1000;
+{ int a1515 = x + 0; int x = a1515 % 1000;
+{ int a1516 = x + 1; int x = a1516 % 1000;
+{ int a1517 = x + 2; int x = a1517 % 1000;
+{ int a1518 = x + 0; int x = a1518 % 1000;
+{ int a1519 = x + 1; int x = a1519 % 1000;
+{ int a1520 = x + 2; int x = a1520 % 1000;
+{ int a1521 = x + 0; int x = a1521 % 1000;
+{ int a1522 = x + 1; int x = a1522 % 1000;
+{ int a1523 = x + 2; int x = a1523 % 1000;
+{ int a1524 = x + 0; int x = a1524 % 1000;
+{ int a1525 = x + 1; int x = a1525 % 1000;
+{ int a1526 = x + 2; int x = a1526 % 1000;
+{ int a1527 = x + 0; int x = a1527 % 1000;
+{ int a1528 = x + 1; int x = a1528 % 1000;
+{ int a1529 = x + 2; int x = a1529 % 1000;
+{ int a1530 = x + 0; int x = a1530 % 1000;
+{ int a1531 = x + 1; int x = a1531 % 1000;
+{ int a1532 = x + 2; int x = a1532 % 1000;
+{ int a1533 = x + 0; int x = a1533 % 1000;
+{ int a1534 = x + 1; int x = a1534 % 1000;
+{ int a1535 = x + 2; int x = a1535 % 1000;
+{ int a1536 = x + 0; int x = a1536 % 1000;
+{ int a1537 = x + 1; int x = a1537 % 1000;
+{ int a1538 = x + 2; int x = a1538 % 1000;
+{ int a1539 = x + 0; int x = a1539 % 1000;
+{ int a1540 = x + 1; int x = a1540 % 1000;
+{ int a1541 = x + 2; int x = a1541 % 1000;
+{ int a1542 = x + 0; int x = a1542 % 1000;
+{ int a1543 = x + 1; int x = a1543 % 1000;
+{ int a1544 = x + 2; int x = a1544 % 1000;
+{ int a1545 = x + 0; int x = a1545 % 1000;
+{ int a1546 = x + 1; int x = a1546 % 1000;
+{ int a1547 = x + 2; int x = a1547 % 1000;
+{ int a1548 = x + 0; int x = a1548 % 1000;
+{ int a1549 = x + 1; int x = a1549 % 1000;
+{ int a1550 = x + 2; int x = a1550 % 1000;
+{ int a1551 = x + 0; int x = a1551 % 1000;
+{ int a1552 = x + 1; int x = a1552 % 1000;
+{ int a1553 = x + 2; int x = a1553 % 1000;
+{ int a1554 = x + 0; int x = a1554 % 1000;
+{ int a1555 = x + 1; int x = a1555 % 1000;
+{ int a1556 = x + 2; int x = a1556 % 1000;
+{ int a1557 = x + 0; int x = a1557 % 1000;
+{ int a1558 = x + 1; int x = a1558 % 1000;
+{ int a1559 = x + 2; int x = a1559 % 1000;
+{ int a1560 = x + 0; int x = a1560 % 1000;
+{ int a1561 = x + 1; int x = a1561 % 1000;
+{ int a1562 = x + 2; int x = a1562 % 1000;
+{ int a1563 = x + 0; int x = a1563 % 1000;
+{ int a1564 = x + 1; int x = a1564 % 1000;
+{ int a1565 = x + 2; int x = a1565 % 1000;
+{ int a1566 = x + 0; int x = a1566 % 1000;
+{ int a1567 = x + 1; int x = a1567 % 1000;
+{ int a1568 = x + 2; int x = a1568 % 1000;
+{ int a1569 = x + 0; int x = a1569 % 1000;
+{ int a1570 = x + 1; int x = a1570 % 1000;
+{ int a1571 = x + 2; int x = a1571 % 1000;
+{ int a1572 = x + 0; int x = a1572 % 1000;
+{ int a1573 = x + 1; int x = a1573 % 1000;
+{ int a1574 = x + 2; int x = a1574 % 1000;
+{ int a1575 = x + 0; int x = a1575 % 1000;
+{ int a1576 = x + 1; int x = a1576 % 1000;
+{ int a1577 = x + 2; int x = a1577 % 1000;
+{ int a1578 = x + 0; int x = a1578 % 1000;
+{ int a1579 = x + 1; int x = a1579 % 1000;
+{ int a1580 = x + 2; int x = a1580 % 1000;
+{ int a1581 = x + 0; int x = a1581 % 1000;
+{ int a1582 = x + 1; int x = a1582 % 1000;
+{ int a1583 = x + 2; int x = a1583 % 1000;
+{ int a1584 = x + 0; int x = a1584 % 1000;
+{ int a1585 = x + 1; int x = a1585 % 1000;
+{ int a1586 = x + 2; int x = a1586 % 1000;
+{ int a1587 = x + 0; int x = a1587 % 1000;
+{ int a1588 = x + 1; int x = a1588 % 1000;
+{ int a1589 = x + 2; int x = a1589 % 1000;
+{ int a1590 = x + 0; int x = a1590 % 1000;
+{ int a1591 = x + 1; int x = a1591 % 1000;
+{ int a1592 = x + 2; int x = a1592 % 1000;
+{ int a1593 = x + 0; int x = a1593 % 1000;
+{ int a1594 = x + 1; int x = a1594 % 1000;
+{ int a1595 = x + 2; int x = a1595 % 1000;
+{ int a1596 = x + 0; int x = a1596 % 1000;
+{ int a1597 = x + 1; int x = a1597 % 1000;
+{ int a1598 = x + 2; int x = a1598 % 1000;
+{ int a1599 = x + 0; int x = a1599 % 1000;
+{ int a1600 = x + 1; int x = a1600 % 1000;
+{ int a1601 = x + 2; int x = a1601 % 1000;
+{ int a1602 = x + 0; int x = a1602 % 1000;
+{ int a1603 = x + 1; int x = a1603 % 1000;
+{ int a1604 = x + 2; int x = a1604 % 1000;
+{ int a1605 = x + 0; int x = a1605 % 1000;
+{ int a1606 = x + 1; int x = a1606 % 1000;
+{ int a1607 = x + 2; int x = a1607 % 1000;
+{ int a1608 = x + 0; int x = a1608 % 1000;
+{ int a1609 = x + 1; int x = a1609 % 1000;
+{ int a1610 = x + 2; int x = a1610 % 1000;
+{ int a1611 = x + 0; int x = a1611 % 1000;
+{ int a1612 = x + 1; int x = a1612 % 1000;
+{ int a1613 = x + 2; int x = a1613 % 1000;
+{ int a1614 = x + 0; int x = a1614 % 1000;
+{ int a1615 = x + 1; int x = a1615 % 1000;
+{ int a1616 = x + 2; int x = a1616 % 1000;
+{ int a1617 = x + 0; int x = a1617 % 1000;
+{ int a1618 = x + 1; int x = a1618 % 1000;
+{ int a1619 = x + 2; int x = a1619 % 1000;
+{ int a1620 = x + 0; int x = a1620 % 1000;
+{ int a1621 = x + 1; int x = a1621 % 1000;
+{ int a1622 = x + 2; int x = a1622 % 1000;
+{ int a1623 = x + 0; int x = a1623 % 1000;
+{ int a1624 = x + 1; int x = a1624 % 1000;
+{ int a1625 = x + 2; int x = a1625 % 1000;
+{ int a1626 = x + 0; int x = a1626 % 1000;
+{ int a1627 = x + 1; int x = a1627 % 1000;
+{ int a1628 = x + 2; int x = a1628 % 1000;
+{ int a1629 = x + 0; int x = a1629 % 1000;
+{ int a1630 = x + 1; int x = a1630 % 1000;
+{ int a1631 = x + 2; int x = a1631 % 1000;
+{ int a1632 = x + 0; int x = a1632 % 1000;
+{ int a1633 = x + 1; int x = a1633 % 1000;
+{ int a1634 = x + 2; int x = a1634 % 1000;
+{ int a1635 = x + 0; int x = a1635 % 1000;
+{ int a1636 = x + 1; int x = a1636 % 1000;
+{ int a1637 = x + 2; int x = a1637 % 1000;
+{ int a1638 = x + 0; int x = a1638 % 1000;
+{ int a1639 = x + 1; int x = a1639 % 1000;
+{ int a1640 = x + 2; int x = a1640 % 1000;
+{ int a1641 = x + 0; int x = a1641 % 1000;
+{ int a1642 = x + 1; int x = a1642 % 1000;
+{ int a1643 = x + 2; int x = a1643 % 1000;
+{ int a1644 = x + 0; int x = a1644 % 1000;
+{ int a1645 = x + 1; int x = a1645 % 1000;
+{ int a1646 = x + 2; int x = a1646 % 1000;
+{ int a1647 = x + 0; int x = a1647 % 1000;
+{ int a1648 = x + 1; int x = a1648 % 1000;
+{ int a1649 = x + 2; int x = a1649 % 1000;
+{ int a1650 = x + 0; int x = a1650 % 1000;
+{ int a1651 = x + 1; int x = a1651 % 1000;
+{ int a1652 = x + 2; int x = a1652 % 1000;
+{ int a1653 = x + 0; int x = a1653 % 1000;
+{ int a1654 = x + 1; int x = a1654 % 1000;
+{ int a1655 = x + 2; int x = a1655 % 1000;
+{ int a1656 = x + 0; int x = a1656 % 1000;
+{ int a1657 = x + 1; int x = a1657 % 1000;
+{ int a1658 = x + 2; int x = a1658 % 1000;
+{ int a1659 = x + 0; int x = a1659 % 1000;
+{ int a1660 = x + 1; int x = a1660 % 1000;
+{ int a1661 = x + 2; int x = a1661 % 1000;
+{ int a1662 = x + 0; int x = a1662 % 1000;
+{ int a1663 = x + 1; int x = a1663 % 1000;
+{ int a1664 = x + 2; int x = a1664 % 1000;
+{ int a1665 = x + 0; int x = a1665 % 1000;
+{ int a1666 = x + 1; int x = a1666 % 1000;
+{ int a1667 = x + 2; int x = a1667 % 1000;
+{ int a1668 = x + 0; int x = a1668 % 1000;
+{ int a1669 = x + 1; int x = a1669 % 1000;
+{ int a1670 = x + 2; int x = a1670 % 1000;
+{ int a1671 = x + 0; int x = a1671 % 1000;
+{ int a1672 = x + 1; int x = a1672 % 1000;
+{ int a1673 = x + 2; int x = a1673 % 1000;
+{ int a1674 = x + 0; int x = a1674 % 1000;
+{ int a1675 = x + 1; int x = a1675 % 1000;
+{ int a1676 = x + 2; int x = a1676 % 1000;
+{ int a1677 = x + 0; int x = a1677 % 1000;
+{ int a1678 = x + 1; int x = a1678 % 1000;
+{ int a1679 = x + 2; int x = a1679 % 1000;
+{ int a1680 = x + 0; int x = a1680 % 1000;
+{ int a1681 = x + 1; int x = a1681 % 1000;
+{ int a1682 = x + 2; int x = a1682 % 1000;
+{ int a1683 = x + 0; int x = a1683 % 1000;
+{ int a1684 = x + 1; int x = a1684 % 1000;
+{ int a1685 = x + 2; int x = a1685 % 1000;
+{ int a1686 = x + 0; int x = a1686 % 1000;
+{ int a1687 = x + 1; int x = a1687 % 1000;
+{ int a1688 = x + 2; int x = a1688 % 1000;
+{ int a1689 = x + 0; int x = a1689 % 1000;
+{ int a1690 = x + 1; int x = a1690 % 1000;
+{ int a1691 = x + 2; int x = a1691 % 1000;
+{ int a1692 = x + 0; int x = a1692 % 1000;
+{ int a1693 = x + 1; int x = a1693 % 1000;
+{ int a1694 = x + 2; int x = a1694 % 1000;
+{ int a1695 = x + 0; int x = a1695 % 1000;
+{ int a1696 = x + 1; int x = a1696 % 1000;
+{ int a1697 = x + 2; int x = a1697 % 1000;
+{ int a1698 = x + 0; int x = a1698 % 1000;
+{ int a1699 = x + 1; int x = a1699 % 1000;
+{ int a1700 = x + 2; int x = a1700 % 1000;
+{ int a1701 = x + 0; int x = a1701 % 1000;
+{ int a1702 = x + 1; int x = a1702 % 1000;
+{ int a1703 = x + 2; int x = a1703 % 1000;
+{ int a1704 = x + 0; int x = a1704 % 1000;
+{ int a1705 = x + 1; int x = a1705 % 1000;
+{ int a1706 = x + 2; int x = a1706 % 1000;
+{ int a1707 = x + 0; int x = a1707 % 1000;
+{ int a1708 = x + 1; int x = a1708 % 1000;
+{ int a1709 = x + 2; int x = a1709 % 1000;
+{ int a1710 = x + 0; int x = a1710 % 1000;
+{ int a1711 = x + 1; int x = a1711 % 1000;
+{ int a1712 = x + 2; int x = a1712 % 1000;
+{ int a1713 = x + 0; int x = a1713 % 1000;
+{ int a1714 = x + 1; int x = a1714 % 1000;
+{ int a1715 = x + 2; int x = a1715 % 1000;
+{ int a1716 = x + 0; int x = a1716 % 1000;
+{ int a1717 = x + 1; int x = a1717 % 1000;
+{ int a1718 = x + 2; int x = a1718 % 1000;
+{ int a1719 = x + 0; int x = a1719 % 1000;
+{ int a1720 = x + 1; int x = a1720 % 1000;
+{ int a1721 = x + 2; int x = a1721 % 1000;
+{ int a1722 = x + 0; int x = a1722 % 1000;
+{ int a1723 = x + 1; int x = a1723 % 1000;
+{ int a1724 = x + 2; int x = a1724 % 1000;
+{ int a1725 = x + 0; int x = a1725 % 1000;
+{ int a1726 = x + 1; int x = a1726 % 1000;
+{ int a1727 = x + 2; int x = a1727 % 1000;
+{ int a1728 = x + 0; int x = a1728 % 1000;
+{ int a1729 = x + 1; int x = a1729 % 1000;
+{ int a1730 = x + 2; int x = a1730 % 1000;
+{ int a1731 = x + 0; int x = a1731 % 1000;
+{ int a1732 = x + 1; int x = a1732 % 1000;
+{ int a1733 = x + 2; int x = a1733 % 1000;
+{ int a1734 = x + 0; int x = a1734 % 1000;
+{ int a1735 = x + 1; int x = a1735 % 1000;
+{ int a1736 = x + 2; int x = a1736 % 1000;
+{ int a1737 = x + 0; int x = a1737 % 1000;
+{ int a1738 = x + 1; int x = a1738 % 1000;
+{ int a1739 = x + 2; int x = a1739 % 1000;
+{ int a1740 = x + 0; int x = a1740 % 1000;
+{ int a1741 = x + 1; int x = a1741 % 1000;
+{ int a1742 = x + 2; int x = a1742 % 1000;
+{ int a1743 = x + 0; int x = a1743 % 1000;
+{ int a1744 = x + 1; int x = a1744 % 1000;
+{ int a1745 = x + 2; int x = a1745 % 1000;
+{ int a1746 = x + 0; int x = a1746 % 1000;
+{ int a1747 = x + 1; int x = a1747 % 1000;
+{ int a1748 = x + 2; int x = a1748 % 1000;
+{ int a1749 = x + 0; int x = a1749 % 1000;
+{ int a1750 = x + 1; int x = a1750 % 1000;
+{ int a1751 = x + 2; int x = a1751 % 1000;
+{ int a1752 = x + 0; int x = a1752 % 1000;
+{ int a1753 = x + 1; int x = a1753 % 1000;
+{ int a1754 = x + 2; int x = a1754 % 1000;
+{ int a1755 = x + 0; int x = a1755 % 1000;
+{ int a1756 = x + 1; int x = a1756 % 1000;
+{ int a1757 = x + 2; int x = a1757 % 1000;
+{ int a1758 = x + 0; int x = a1758 % 1000;
+{ int a1759 = x + 1; int x = a1759 % 1000;
+{ int a1760 = x + 2; int x = a1760 % 1000;
+{ int a1761 = x + 0; int x = a1761 % 1000;
+{ int a1762 = x + 1; int x = a1762 % 1000;
+{ int a1763 = x + 2; int x = a1763 % 1000;
+{ int a1764 = x + 0; int x = a1764 % 1000;
+{ int a1765 = x + 1; int x = a1765 % 1000;
+{ int a1766 = x + 2; int x = a1766 % 1000;
+{ int a1767 = x + 0; int x = a1767 % 1000;
+{ int a1768 = x + 1; int x = a1768 % 1000;
+{ int a1769 = x + 2; int x = a1769 % 1000;
+{ int a1770 = x + 0; int x = a1770 % 1000;
+{ int a1771 = x + 1; int x = a1771 % 1000;
+{ int a1772 = x + 2; int x = a1772 % 1000;
+{ int a1773 = x + 0; int x = a1773 % 1000;
+{ int a1774 = x + 1; int x = a1774 % 1000;
+{ int a1775 = x + 2; int x = a1775 % 1000;
+{ int a1776 = x + 0; int x = a1776 % 1000;
+{ int a1777 = x + 1; int x = a1777 % 1000;
+{ int a1778 = x + 2; int x = a1778 % 1000;
+{ int a1779 = x + 0; int x = a1779 % 1000;
+{ int a1780 = x + 1; int x = a1780 % 1000;
+{ int a1781 = x + 2; int x = a1781 % 1000;
+{ int a1782 = x + 0; int x = a1782 % 1000;
+{ int a1783 = x + 1; int x = a1783 % 1000;
+{ int a1784 = x + 2; int x = a1784 % 1000;
+{ int a1785 = x + 0; int x = a1785 % 1000;
+{ int a1786 = x + 1; int x = a1786 % 1000;
+{ int a1787 = x + 2; int x = a1787 % 1000;
+{ int a1788 = x + 0; int x = a1788 % 1000;
+{ int a1789 = x + 1; int x = a1789 % 1000;
+{ int a1790 = x + 2; int x = a1790 % 1000;
+{ int a1791 = x + 0; int x = a1791 % 1000;
+{ int a1792 = x + 1; int x = a1792 % 1000;
+{ int a1793 = x + 2; int x = a1793 % 1000;
+{ int a1794 = x + 0; int x = a1794 % 1000;
+{ int a1795 = x + 1; int x = a1795 % 1000;
+{ int a1796 = x + 2; int x = a1796 % 1000;
+{ int a1797 = x + 0; int x = a1797 % 1000;
+{ int a1798 = x + 1; int x = a1798 % 1000;
+{ int a1799 = x + 2; int x = a1799 % 1000;
+{ int a1800 = x + 0; int x = a1800 % 1000;
+{ int a1801 = x + 1; int x = a1801 % 1000;
+{ int a1802 = x + 2; int x = a1802 % 1000;
+{ int a1803 = x + 0; int x = a1803 % 1000;
+{ int a1804 = x + 1; int x = a1804 % 1000;
+{ int a1805 = x + 2; int x = a1805 % 1000;
+{ int a1806 = x + 0; int x = a1806 % 1000;
+{ int a1807 = x + 1; int x = a1807 % 1000;
+{ int a1808 = x + 2; int x = a1808 % 1000;
+{ int a1809 = x + 0; int x = a1809 % 1000;
+{ int a1810 = x + 1; int x = a1810 % 1000;
+{ int a1811 = x + 2; int x = a1811 % 1000;
+{ int a1812 = x + 0; int x = a1812 % 1000;
+{ int a1813 = x + 1; int x = a1813 % 1000;
+{ int a1814 = x + 2; int x = a1814 % 1000;
+{ int a1815 = x + 0; int x = a1815 % 1000;
+{ int a1816 = x + 1; int x = a1816 % 1000;
+{ int a1817 = x + 2; int x = a1817 % 1000;
+{ int a1818 = x + 0; int x = a1818 % 1000;
+{ int a1819 = x + 1; int x = a1819 % 1000;
+{ int a1820 = x + 2; int x = a1820 % 1000;
+{ int a1821 = x + 0; int x = a1821 % 1000;
+{ int a1822 = x + 1; int x = a1822 % 1000;
+{ int a1823 = x + 2; int x = a1823 % 1000;
+{ int a1824 = x + 0; int x = a1824 % 1000;
+{ int a1825 = x + 1; int x = a1825 % 1000;
+{ int a1826 = x + 2; int x = a1826 % 1000;
+{ int a1827 = x + 0; int x = a1827 % 1000;
+{ int a1828 = x + 1; int x = a1828 % 1000;
+{ int a1829 = x + 2; int x = a1829 % 1000;
+{ int a1830 = x + 0; int x = a1830 % 1000;
+{ int a1831 = x + 1; int x = a1831 % 1000;
+{ int a1832 = x + 2; int x = a1832 % 1000;
+{ int a1833 = x + 0; int x = a1833 % 1000;
+{ int a1834 = x + 1; int x = a1834 % 1000;
+{ int a1835 = x + 2; int x = a1835 % 1000;
+{ int a1836 = x + 0; int x = a1836 % 1000;
+{ int a1837 = x + 1; int x = a1837 % 1000;
+{ int a1838 = x + 2; int x = a1838 % 1000;
+{ int a1839 = x + 0; int x = a1839 % 1000;
+{ int a1840 = x + 1; int x = a1840 % 1000;
+{ int a1841 = x + 2; int x = a1841 % 1000;
+{ int a1842 = x + 0; int x = a1842 % 1000;
+{ int a1843 = x + 1; int x = a1843 % 1000;
+{ int a1844 = x + 2; int x = a1844 % 1000;
+{ int a1845 = x + 0; int x = a1845 % 1000;
+{ int a1846 = x + 1; int x = a1846 % 1000;
+{ int a1847 = x + 2; int x = a1847 % 1000;
+{ int a1848 = x + 0; int x = a1848 % 1000;
+{ int a1849 = x + 1; int x = a1849 % 1000;
+{ int a1850 = x + 2; int x = a1850 % 1000;
+{ int a1851 = x + 0; int x = a1851 % 1000;
+{ int a1852 = x + 1; int x = a1852 % 1000;
+{ int a1853 = x + 2; int x = a1853 % 1000;
+{ int a1854 = x + 0; int x = a1854 % 1000;
+{ int a1855 = x + 1; int x = a1855 % 1000;
+{ int a1856 = x + 2; int x = a1856 % 1000;
+{ int a1857 = x + 0; int x = a1857 % 1000;
+{ int a1858 = x + 1; int x = a1858 % 1000;
+{ int a1859 = x + 2; int x = a1859 % 1000;
+{ int a1860 = x + 0; int x = a1860 % 1000;
+{ int a1861 = x + 1; int x = a1861 % 1000;
+{ int a1862 = x + 2; int x = a1862 % 1000;
+{ int a1863 = x + 0; int x = a1863 % 1000;
+{ int a1864 = x + 1; int x = a1864 % 1000;
+{ int a1865 = x + 2; int x = a1865 % 1000;
+{ int a1866 = x + 0; int x = a1866 % 1000;
+{ int a1867 = x + 1; int x = a1867 % 1000;
+{ int a1868 = x + 2; int x = a1868 % 1000;
+{ int a1869 = x + 0; int x = a1869 % 1000;
+{ int a1870 = x + 1; int x = a1870 % 1000;
+{ int a1871 = x + 2; int x = a1871 % 1000;
+{ int a1872 = x + 0; int x = a1872 % 1000;
+{ int a1873 = x + 1; int x = a1873 % 1000;
+{ int a1874 = x + 2; int x = a1874 % 1000;
+{ int a1875 = x + 0; int x = a1875 % 1000;
+{ int a1876 = x + 1; int x = a1876 % 1000;
+{ int a1877 = x + 2; int x = a1877 % 1000;
+{ int a1878 = x + 0; int x = a1878 % 1000;
+{ int a1879 = x + 1; int x = a1879 % 1000;
+{ int a1880 = x + 2; int x = a1880 % 1000;
+{ int a1881 = x + 0; int x = a1881 % 1000;
+{ int a1882 = x + 1; int x = a1882 % 1000;
+{ int a1883 = x + 2; int x = a1883 % 1000;
+{ int a1884 = x + 0; int x = a1884 % 1000;
+{ int a1885 = x + 1; int x = a1885 % 1000;
+{ int a1886 = x + 2; int x = a1886 % 1000;
+{ int a1887 = x + 0; int x = a1887 % 1000;
+{ int a1888 = x + 1; int x = a1888 % 1000;
+{ int a1889 = x + 2; int x = a1889 % 1000;
+{ int a1890 = x + 0; int x = a1890 % 1000;
+{ int a1891 = x + 1; int x = a1891 % 1000;
+{ int a1892 = x + 2; int x = a1892 % 1000;
+{ int a1893 = x + 0; int x = a1893 % 1000;
+{ int a1894 = x + 1; int x = a1894 % 1000;
+{ int a1895 = x + 2; int x = a1895 % 1000;
+{ int a1896 = x + 0; int x = a1896 % 1000;
+{ int a1897 = x + 1; int x = a1897 % 1000;
+{ int a1898 = x + 2; int x = a1898 % 1000;
+{ int a1899 = x + 0; int x = a1899 % 1000;
+{ int a1900 = x + 1; int x = a1900 % 1000;
+{ int a1901 = x + 2; int x = a1901 % 1000;
+{ int a1902 = x + 0; int x = a1902 % 1000;
+{ int a1903 = x + 1; int x = a1903 % 1000;
+{ int a1904 = x + 2; int x = a1904 % 1000;
+{ int a1905 = x + 0; int x = a1905 % 1000;
+{ int a1906 = x + 1; int x = a1906 % 1000;
+{ int a1907 = x + 2; int x = a1907 % 1000;
+{ int a1908 = x + 0; int x = a1908 % 1000;
+{ int a1909 = x + 1; int x = a1909 % 1000;
+{ int a1910 = x + 2; int x = a1910 % 1000;
+{ int a1911 = x + 0; int x = a1911 % 1000;
+{ int a1912 = x + 1; int x = a1912 % 1000;
+{ int a1913 = x + 2; int x = a1913 % 1000;
+{ int a1914 = x + 0; int x = a1914 % 1000;
+{ int a1915 = x + 1; int x = a1915 % 1000;
+{ int a1916 = x + 2; int x = a1916 % 1000;
+{ int a1917 = x + 0; int x = a1917 % 1000;
+{ int a1918 = x + 1; int x = a1918 % 1000;
+{ int a1919 = x + 2; int x = a1919 % 1000;
+{ int a1920 = x + 0; int x = a1920 % 1000;
+{ int a1921 = x + 1; int x = a1921 % 1000;
+{ int a1922 = x + 2; int x = a1922 % 1000;
+{ int a1923 = x + 0; int x = a1923 % 1000;
+{ int a1924 = x + 1; int x = a1924 % 1000;
+{ int a1925 = x + 2; int x = a1925 % 1000;
+{ int a1926 = x + 0; int x = a1926 % 1000;
+{ int a1927 = x + 1; int x = a1927 % 1000;
+{ int a1928 = x + 2; int x = a1928 % 1000;
+{ int a1929 = x + 0; int x = a1929 % 1000;
+{ int a1930 = x + 1; int x = a1930 % 1000;
+{ int a1931 = x + 2; int x = a1931 % 1000;
+{ int a1932 = x + 0; int x = a1932 % 1000;
+{ int a1933 = x + 1; int x = a1933 % 1000;
+{ int a1934 = x + 2; int x = a1934 % 1000;
+{ int a1935 = x + 0; int x = a1935 % 1000;
+{ int a1936 = x + 1; int x = a1936 % 1000;
+{ int a1937 = x + 2; int x = a1937 % 1000;
+{ int a1938 = x + 0; int x = a1938 % 1000;
+{ int a1939 = x + 1; int x = a1939 % 1000;
+{ int a1940 = x + 2; int x = a1940 % 1000;
+{ int a1941 = x + 0; int x = a1941 % 1000;
+{ int a1942 = x + 1; int x = a1942 % 1000;
+{ int a1943 = x + 2; int x = a1943 % 1000;
+{ int a1944 = x + 0; int x = a1944 % 1000;
+{ int a1945 = x + 1; int x = a1945 % 1000;
+{ int a1946 = x + 2; int x = a1946 % 1000;
+{ int a1947 = x + 0; int x = a1947 % 1000;
+{ int a1948 = x + 1; int x = a1948 % 1000;
+{ int a1949 = x + 2; int x = a1949 % 1000;
+{ int a1950 = x + 0; int x = a1950 % 1000;
+{ int a1951 = x + 1; int x = a1951 % 1000;
+{ int a1952 = x + 2; int x = a1952 % 1000;
+{ int a1953 = x + 0; int x = a1953 % 1000;
+{ int a1954 = x + 1; int x = a1954 % 1000;
+{ int a1955 = x + 2; int x = a1955 % 1000;
+{ int a1956 = x + 0; int x = a1956 % 1000;
+{ int a1957 = x + 1; int x = a1957 % 1000;
+{ int a1958 = x + 2; int x = a1958 % 1000;
+{ int a1959 = x + 0; int x = a1959 % 1000;
+{ int a1960 = x + 1; int x = a1960 % 1000;
+{ int a1961 = x + 2; int x = a1961 % 1000;
+{ int a1962 = x + 0; int x = a1962 % 1000;
+{ int a1963 = x + 1; int x = a1963 % 1000;
+{ int a1964 = x + 2; int x = a1964 % 1000;
+{ int a1965 = x + 0; int x = a1965 % 1000;
+{ int a1966 = x + 1; int x = a1966 % 1000;
+{ int a1967 = x + 2; int x = a1967 % 1000;
+{ int a1968 = x + 0; int x = a1968 % 1000;
+{ int a1969 = x + 1; int x = a1969 % 1000;
+{ int a1970 = x + 2; int x = a1970 % 1000;
+{ int a1971 = x + 0; int x = a1971 % 1000;
+{ int a1972 = x + 1; int x = a1972 % 1000;
+{ int a1973 = x + 2; int x = a1973 % 1000;
+{ int a1974 = x + 0; int x = a1974 % 1000;
+{ int a1975 = x + 1; int x = a1975 % 1000;
+{ int a1976 = x + 2; int x = a1976 % 1000;
+{ int a1977 = x + 0; int x = a1977 % 1000;
+{ int a1978 = x + 1; int x = a1978 % 1000;
+{ int a1979 = x + 2; int x = a1979 % 1000;
+{ int a1980 = x + 0; int x = a1980 % 1000;
+{ int a1981 = x + 1; int x = a1981 % 1000;
+{ int a1982 = x + 2; int x = a1982 % 1000;
+{ int a1983 = x + 0; int x = a1983 % 1000;
+{ int a1984 = x + 1; int x = a1984 % 1000;
+{ int a1985 = x + 2; int x = a1985 % 1000;
+{ int a1986 = x + 0; int x = a1986 % 1000;
+{ int a1987 = x + 1; int x = a1987 % 1000;
+{ int a1988 = x + 2; int x = a1988 % 1000;
+{ int a1989 = x + 0; int x = a1989 % 1000;
+{ int a1990 = x + 1; int x = a1990 % 1000;
+{ int a1991 = x + 2; int x = a1991 % 1000;
+{ int a1992 = x + 0; int x = a1992 % 1000;
+{ int a1993 = x + 1; int x = a1993 % 1000;
+{ int a1994 = x + 2; int x = a1994 % 1000;
+{ int a1995 = x + 0; int x = a1995 % 1000;
+{ int a1996 = x + 1; int x = a1996 % 1000;
+{ int a1997 = x + 2; int x = a1997 % 1000;
+{ int a1998 = x + 0; int x = a1998 % 1000;
+{ int a1999 = x + 1; int x = a1999 % 1000;
+result = x + a0 + a1999;
+}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}}
+
+    if (x != 1) return -1;
+    if (total != 7) return -2;
+    return result;
+}
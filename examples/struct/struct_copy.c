@@ -0,0 +1,75 @@
+// 结构体整体复制：取值、传参、返回、赋值的各种来源和目标
+// 每种情况都是一条块复制指令（LOADMN/STOREMN/MEMCPY/RETN），不再逐个 slot 生成
+
+struct Point {
+    int x;
+    int y;
+};
+
+struct Line {
+    struct Point start;
+    struct Point end;
+};
+
+struct Line g_line;
+struct Point g_points[3];
+
+int sumPoint(struct Point p) {
+    return p.x + p.y;
+}
+
+int lineLength(struct Line l) {
+    return l.end.x - l.start.x + l.end.y - l.start.y;
+}
+
+struct Point makePoint(int x, int y) {
+    struct Point p;
+    p.x = x;
+    p.y = y;
+    return p;
+}
+
+// 没有局部变量：返回值直接从参数的成员复制到返回区
+struct Point endOf(struct Line l) {
+    return l.end;
+}
+
+// 返回另一个函数的返回值
+struct Point shifted(struct Point p, int d) {
+    return makePoint(p.x + d, p.y + d);
+}
+
+int main() {
+    g_line.start.x = 1;
+    g_line.start.y = 2;
+    g_line.end.x = 11;
+    g_line.end.y = 22;
+
+    // 测试1: 全局结构体和嵌套成员作为参数
+    int test1 = lineLength(g_line) + sumPoint(g_line.end);  // 30 + 33 = 63
+
+    // 测试2: 成员之间的赋值、数组元素作为赋值目标和参数
+    struct Line l;
+    l.start = g_line.end;
+    l.end = l.start;
+    g_points[1] = l.end;
+    int test2 = sumPoint(g_points[1]) + l.start.x;  // 33 + 11 = 44
+
+    // 测试3: 通过指针读写整个结构体
+    struct Point *p = &g_points[2];
+    *p = makePoint(5, 7);
+    struct Point q = *p;
+    int test3 = q.x * q.y + sumPoint(*p);  // 35 + 12 = 47
+
+    // 测试4: 返回值直接赋给成员
+    l.end = makePoint(l.start.y, 22);
+    g_line.start = makePoint(100, 200);
+    int test4 = l.end.y + g_line.start.x + g_line.start.y;  // 22 + 300 = 322
+
+    // 测试5: 成员和函数调用作为返回值
+    struct Point e = endOf(g_line);
+    struct Point s = shifted(e, 1);
+    int test5 = e.y + s.x + s.y;  // 22 + 12 + 23 = 57
+
+    return test1 + test2 + test3 + test4 + test5;  // 63 + 44 + 47 + 322 + 57 = 533
+}
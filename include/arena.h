@@ -0,0 +1,129 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// arena.h
+// AST 使用的内存分配工具
+//
+// - Arena：按块分配的线性（bump）分配器。分配只是移动指针，整块一起释放，
+//   从不调用对象的析构函数，所以只能存放平凡析构的对象
+// - ArenaArray<T>：指向 Arena 中一段连续元素的视图（指针 + 长度），代替节点里的 std::vector
+// - Identifier / StringInterner：标识符驻留，相同的名字只保存一份，节点里只存一个指针
+
+class Arena {
+private:
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    char* cursor_ = nullptr;
+    char* limit_ = nullptr;
+    size_t bytes_allocated_ = 0;   // 已分配给对象的字节数（不含块尾浪费）
+
+    // 当前块放不下时分配新块；超过块大小一半的请求单独占一块
+    void* allocateSlow(size_t size, size_t align);
+
+public:
+    Arena() = default;
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* allocate(size_t size, size_t align) {
+        uintptr_t p = (reinterpret_cast<uintptr_t>(cursor_) + align - 1) & ~(uintptr_t)(align - 1);
+        if (cursor_ && p + size <= reinterpret_cast<uintptr_t>(limit_)) {
+            cursor_ = reinterpret_cast<char*>(p + size);
+            bytes_allocated_ += size;
+            return reinterpret_cast<void*>(p);
+        }
+        return allocateSlow(size, align);
+    }
+
+    template <typename T, typename... Args>
+    T* create(Args&&... args) {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "Arena 不调用析构函数，只能存放平凡析构的对象");
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    size_t bytesAllocated() const { return bytes_allocated_; }
+    size_t blockCount() const { return blocks_.size(); }
+};
+
+// Arena 中的连续数组视图，按值传递（相当于 C++20 的 std::span）
+template <typename T>
+class ArenaArray {
+private:
+    T* data_ = nullptr;
+    uint32_t size_ = 0;
+
+public:
+    ArenaArray() = default;
+    ArenaArray(T* data, uint32_t size) : data_(data), size_(size) {}
+
+    // 把 vector 的内容复制到 Arena 中
+    static ArenaArray copyOf(Arena& arena, const std::vector<T>& values) {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "Arena 不调用析构函数，只能存放平凡析构的对象");
+        if (values.empty()) return ArenaArray();
+        T* data = static_cast<T*>(arena.allocate(sizeof(T) * values.size(), alignof(T)));
+        std::uninitialized_copy(values.begin(), values.end(), data);
+        return ArenaArray(data, (uint32_t)values.size());
+    }
+
+    T* begin() const { return data_; }
+    T* end() const { return data_ + size_; }
+    std::reverse_iterator<T*> rbegin() const { return std::reverse_iterator<T*>(end()); }
+    std::reverse_iterator<T*> rend() const { return std::reverse_iterator<T*>(begin()); }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    T& operator[](size_t i) const { return data_[i]; }
+    T& front() const { return data_[0]; }
+    T& back() const { return data_[size_ - 1]; }
+};
+
+// 驻留的标识符：相同内容的字符串共享同一个 std::string，比较只需比较指针
+class Identifier {
+private:
+    const std::string* str_ = nullptr;
+
+public:
+    Identifier() = default;
+    explicit Identifier(const std::string* str) : str_(str) {}
+
+    const std::string& str() const { return *str_; }
+    bool operator==(Identifier other) const { return str_ == other.str_; }
+    bool operator!=(Identifier other) const { return str_ != other.str_; }
+};
+
+// 查找直接用 Token 中指向源代码的 string_view，只有第一次出现的名字才复制一份
+class StringInterner {
+private:
+    std::deque<std::string> strings_;   // 驻留的字符串，deque 追加时已有元素的地址不变
+    std::unordered_map<std::string_view, const std::string*> index_;   // 键指向 strings_ 中的内容
+
+public:
+    Identifier intern(std::string_view str) {
+        auto it = index_.find(str);
+        if (it == index_.end()) {
+            const std::string& stored = strings_.emplace_back(str);
+            it = index_.emplace(stored, &stored).first;
+        }
+        return Identifier(it->second);
+    }
+
+    size_t size() const { return strings_.size(); }
+};
+
+#endif // ARENA_H
@@ -3,6 +3,8 @@
 
 #include "../include/token.h"
 #include "../include/type.h"
+#include "../include/arena.h"
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <vector>
@@ -10,41 +12,101 @@
 // ast.h
 // SimpleC编译器的抽象语法树(AST)节点定义
 // 第二阶段：表达式语法分析
+//
+// 内存布局：除 ProgramNode 外，所有节点都由 ASTContext 的 Arena 分配，
+// 子节点用裸指针、列表用 ArenaArray、名字用驻留的 Identifier、类型用驻留的 const Type*。
+// 节点没有虚函数，都是平凡析构的，整棵树随 ProgramNode（持有 ASTContext）一次释放。
+
+// 节点类型标签：Sema / CodeGen 用 switch (node->getKind()) 分派，不再依赖 dynamic_cast
+enum class NodeKind : uint8_t {
+    // 表达式
+    Number, Variable, BinaryOp, UnaryOp, FunctionCall, ArrayAccess, MemberAccess, InitializerList,
+    // 语句
+    VarDecl, Return, If, While, For, DoWhile, Break, Continue, Empty, ExprStmt, Compound,
+    // 顶层
+    FunctionDecl, StructDecl, Program
+};
+
+// AST 的所有权：节点的 Arena、标识符表和类型表
+class ASTContext {
+private:
+    Arena arena_;
+    StringInterner identifiers_;
+    TypeContext types_;     // Parser 写入声明的类型、Sema 写入表达式的类型都在这里驻留
+
+public:
+    template <typename T, typename... Args>
+    T* create(Args&&... args) {
+        return arena_.create<T>(std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    ArenaArray<T> copyArray(const std::vector<T>& values) {
+        return ArenaArray<T>::copyOf(arena_, values);
+    }
+
+    Identifier intern(std::string_view name) { return identifiers_.intern(name); }
+
+    TypeContext& getTypes() { return types_; }
+
+    const Arena& getArena() const { return arena_; }
+    size_t getIdentifierCount() const { return identifiers_.size(); }
+    size_t getTypeCount() const { return types_.size(); }
+};
 
 // AST节点基类
 class ASTNode {
+private:
+    NodeKind kind_;
+
+protected:
+    explicit ASTNode(NodeKind kind) : kind_(kind) {}
+
 public:
-    virtual ~ASTNode() = default;
-    virtual std::string toString() const = 0;
+    // 按 kind_ 分派到具体节点的 toString（定义在文件末尾）
+    std::string toString() const;
+
+    NodeKind getKind() const { return kind_; }
 };
 
+// 按标签向下转换：node 是 T 类型时返回 T*，否则返回 nullptr（node 可以为空）
+// 每个具体节点类都定义了 static constexpr NodeKind KIND
+template <typename T>
+T* nodeCast(ASTNode* node) {
+    return node && node->getKind() == T::KIND ? static_cast<T*>(node) : nullptr;
+}
+
+template <typename T>
+const T* nodeCast(const ASTNode* node) {
+    return node && node->getKind() == T::KIND ? static_cast<const T*>(node) : nullptr;
+}
+
 // 表达式节点基类
 class ExprNode : public ASTNode {
 private:
-    std::shared_ptr<Type> resolved_type_;
+    const Type* resolved_type_ = nullptr;
 
-public:
-    ~ExprNode() override = default;
-    virtual std::string toString() const override = 0;
+protected:
+    explicit ExprNode(NodeKind kind) : ASTNode(kind) {}
 
-    void setResolvedType(std::shared_ptr<Type> type) { resolved_type_ = type; }
-    std::shared_ptr<Type> getResolvedType() const { return resolved_type_; }
+public:
+    void setResolvedType(const Type* type) { resolved_type_ = type; }
+    const Type* getResolvedType() const { return resolved_type_; }
 };
 
 // 初始化列表节点：{expr1, expr2, ...}
 // 用于数组和结构体的初始化
 class InitializerListNode : public ExprNode {
 private:
-    std::vector<std::unique_ptr<ExprNode>> elements_;
+    ArenaArray<ExprNode*> elements_;
 
 public:
-    InitializerListNode() = default;
+    static constexpr NodeKind KIND = NodeKind::InitializerList;
 
-    void addElement(std::unique_ptr<ExprNode> elem) {
-        elements_.push_back(std::move(elem));
-    }
+    explicit InitializerListNode(ArenaArray<ExprNode*> elements)
+        : ExprNode(KIND), elements_(elements) {}
 
-    const std::vector<std::unique_ptr<ExprNode>>& getElements() const {
+    ArenaArray<ExprNode*> getElements() const {
         return elements_;
     }
 
@@ -52,7 +114,7 @@ public:
         return elements_.size();
     }
 
-    std::string toString() const override {
+    std::string toString() const {
         std::string result = "InitializerList(";
         for (size_t i = 0; i < elements_.size(); ++i) {
             if (i > 0) result += ", ";
@@ -69,11 +131,13 @@ private:
     int value_;
 
 public:
-    explicit NumberNode(int value) : value_(value) {}
+    static constexpr NodeKind KIND = NodeKind::Number;
+
+    explicit NumberNode(int value) : ExprNode(KIND), value_(value) {}
 
     int getValue() const { return value_; }
 
-    std::string toString() const override {
+    std::string toString() const {
         return "Number(" + std::to_string(value_) + ")";
     }
 };
@@ -81,34 +145,38 @@ public:
 // 变量引用节点
 class VariableNode : public ExprNode {
 private:
-    std::string name_;
+    Identifier name_;
 
 public:
-    explicit VariableNode(const std::string& name) : name_(name) {}
+    static constexpr NodeKind KIND = NodeKind::Variable;
+
+    explicit VariableNode(Identifier name) : ExprNode(KIND), name_(name) {}
 
-    const std::string& getName() const { return name_; }
+    const std::string& getName() const { return name_.str(); }
 
-    std::string toString() const override {
-        return "Variable(" + name_ + ")";
+    std::string toString() const {
+        return "Variable(" + name_.str() + ")";
     }
 };
 
 // 二元运算符节点
 class BinaryOpNode : public ExprNode {
 private:
-    std::unique_ptr<ExprNode> left_;
-    std::unique_ptr<ExprNode> right_;
+    ExprNode* left_;
+    ExprNode* right_;
     TokenType op_;
 
 public:
-    BinaryOpNode(std::unique_ptr<ExprNode> left, TokenType op, std::unique_ptr<ExprNode> right)
-        : left_(std::move(left)), right_(std::move(right)), op_(op) {}
+    static constexpr NodeKind KIND = NodeKind::BinaryOp;
 
-    ExprNode* getLeft() const { return left_.get(); }
-    ExprNode* getRight() const { return right_.get(); }
+    BinaryOpNode(ExprNode* left, TokenType op, ExprNode* right)
+        : ExprNode(KIND), left_(left), right_(right), op_(op) {}
+
+    ExprNode* getLeft() const { return left_; }
+    ExprNode* getRight() const { return right_; }
     TokenType getOperator() const { return op_; }
 
-    std::string toString() const override {
+    std::string toString() const {
         return "BinaryOp(" + Token::typeToString(op_) + ", " +
                left_->toString() + ", " + right_->toString() + ")";
     }
@@ -117,17 +185,19 @@ public:
 // 一元运算符节点
 class UnaryOpNode : public ExprNode {
 private:
-    std::unique_ptr<ExprNode> operand_;
+    ExprNode* operand_;
     TokenType op_;
 
 public:
-    UnaryOpNode(TokenType op, std::unique_ptr<ExprNode> operand)
-        : operand_(std::move(operand)), op_(op) {}
+    static constexpr NodeKind KIND = NodeKind::UnaryOp;
+
+    UnaryOpNode(TokenType op, ExprNode* operand)
+        : ExprNode(KIND), operand_(operand), op_(op) {}
 
-    ExprNode* getOperand() const { return operand_.get(); }
+    ExprNode* getOperand() const { return operand_; }
     TokenType getOperator() const { return op_; }
 
-    std::string toString() const override {
+    std::string toString() const {
         return "UnaryOp(" + Token::typeToString(op_) + ", " + operand_->toString() + ")";
     }
 };
@@ -135,19 +205,21 @@ public:
 // 函数调用节点：foo(arg1, arg2, ...)
 class FunctionCallNode : public ExprNode {
 private:
-    std::string name_;
-    std::vector<std::unique_ptr<ExprNode>> args_;
+    Identifier name_;
+    ArenaArray<ExprNode*> args_;
 
 public:
-    FunctionCallNode(const std::string& name, std::vector<std::unique_ptr<ExprNode>> args)
-        : name_(name), args_(std::move(args)) {}
+    static constexpr NodeKind KIND = NodeKind::FunctionCall;
+
+    FunctionCallNode(Identifier name, ArenaArray<ExprNode*> args)
+        : ExprNode(KIND), name_(name), args_(args) {}
 
-    const std::string& getName() const { return name_; }
-    const std::vector<std::unique_ptr<ExprNode>>& getArgs() const { return args_; }
+    const std::string& getName() const { return name_.str(); }
+    ArenaArray<ExprNode*> getArgs() const { return args_; }
 
-    std::string toString() const override {
-        std::string result = "FunctionCall(" + name_;
-        for (const auto& arg : args_) {
+    std::string toString() const {
+        std::string result = "FunctionCall(" + name_.str();
+        for (ExprNode* arg : args_) {
             result += ", " + arg->toString();
         }
         result += ")";
@@ -158,17 +230,19 @@ public:
 // 数组访问节点：arr[index] 或 arr[i][j]
 class ArrayAccessNode : public ExprNode {
 private:
-    std::unique_ptr<ExprNode> array_;         // 数组表达式（可以是变量或另一个数组访问）
-    std::unique_ptr<ExprNode> index_;         // 下标表达式
+    ExprNode* array_;         // 数组表达式（可以是变量或另一个数组访问）
+    ExprNode* index_;         // 下标表达式
 
 public:
-    ArrayAccessNode(std::unique_ptr<ExprNode> array, std::unique_ptr<ExprNode> index)
-        : array_(std::move(array)), index_(std::move(index)) {}
+    static constexpr NodeKind KIND = NodeKind::ArrayAccess;
 
-    ExprNode* getArray() const { return array_.get(); }
-    ExprNode* getIndex() const { return index_.get(); }
+    ArrayAccessNode(ExprNode* array, ExprNode* index)
+        : ExprNode(KIND), array_(array), index_(index) {}
 
-    std::string toString() const override {
+    ExprNode* getArray() const { return array_; }
+    ExprNode* getIndex() const { return index_; }
+
+    std::string toString() const {
         return "ArrayAccess(" + array_->toString() + ", " + index_->toString() + ")";
     }
 };
@@ -176,58 +250,64 @@ public:
 // 成员访问节点：obj.member
 class MemberAccessNode : public ExprNode {
 private:
-    std::unique_ptr<ExprNode> object_;
-    std::string member_;
+    ExprNode* object_;
+    Identifier member_;
+    int member_index_ = -1;     // 成员在结构体中的下标，由 Sema 填写
 
 public:
-    MemberAccessNode(std::unique_ptr<ExprNode> object, const std::string& member)
-        : object_(std::move(object)), member_(member) {}
+    static constexpr NodeKind KIND = NodeKind::MemberAccess;
+
+    MemberAccessNode(ExprNode* object, Identifier member)
+        : ExprNode(KIND), object_(object), member_(member) {}
 
-    ExprNode* getObject() const { return object_.get(); }
-    const std::string& getMember() const { return member_; }
+    ExprNode* getObject() const { return object_; }
+    const std::string& getMember() const { return member_.str(); }
+    int getMemberIndex() const { return member_index_; }
+    void setMemberIndex(int index) { member_index_ = index; }
 
-    std::string toString() const override {
-        return "MemberAccess(" + object_->toString() + "." + member_ + ")";
+    std::string toString() const {
+        return "MemberAccess(" + object_->toString() + "." + member_.str() + ")";
     }
 };
 
 // 语句节点基类
 class StmtNode : public ASTNode {
-public:
-    virtual ~StmtNode() = default;
-    virtual std::string toString() const override = 0;
+protected:
+    explicit StmtNode(NodeKind kind) : ASTNode(kind) {}
 };
 
 // 变量声明语句节点（支持普通变量、指针和多维数组）
 class VarDeclStmtNode : public StmtNode {
 private:
-    std::string type_;                        // 基础类型（含指针，如 "int*"）
-    std::string name_;
-    std::unique_ptr<ExprNode> initializer_;
-    std::vector<int> array_dims_;             // 数组各维度大小，空表示非数组
-    std::shared_ptr<Type> resolved_type_;
+    const Type* type_;                        // 声明的基础类型（含指针，如 int*），由 Parser 解析
+    Identifier name_;
+    ExprNode* initializer_;
+    ArenaArray<int> array_dims_;              // 数组各维度大小，空表示非数组
+    const Type* resolved_type_ = nullptr;     // 加上数组维度后的实际类型，由 Sema 填写
 
 public:
+    static constexpr NodeKind KIND = NodeKind::VarDecl;
+
     // 普通变量声明
-    VarDeclStmtNode(const std::string& type, const std::string& name, std::unique_ptr<ExprNode> initializer = nullptr)
-        : type_(type), name_(name), initializer_(std::move(initializer)) {}
+    VarDeclStmtNode(const Type* type, Identifier name, ExprNode* initializer = nullptr)
+        : StmtNode(KIND), type_(type), name_(name), initializer_(initializer) {}
 
     // 数组声明（支持多维，支持初始化列表）
-    VarDeclStmtNode(const std::string& type, const std::string& name, std::vector<int> dims, std::unique_ptr<ExprNode> initializer = nullptr)
-        : type_(type), name_(name), initializer_(std::move(initializer)), array_dims_(std::move(dims)) {}
+    VarDeclStmtNode(const Type* type, Identifier name, ArenaArray<int> dims, ExprNode* initializer = nullptr)
+        : StmtNode(KIND), type_(type), name_(name), initializer_(initializer), array_dims_(dims) {}
 
-    const std::string& getType() const { return type_; }
-    const std::string& getName() const { return name_; }
-    ExprNode* getInitializer() const { return initializer_.get(); }
+    const Type* getType() const { return type_; }
+    const std::string& getName() const { return name_.str(); }
+    ExprNode* getInitializer() const { return initializer_; }
     bool hasInitializer() const { return initializer_ != nullptr; }
     bool isArray() const { return !array_dims_.empty(); }
-    const std::vector<int>& getArrayDims() const { return array_dims_; }
+    ArenaArray<int> getArrayDims() const { return array_dims_; }
 
-    void setResolvedType(std::shared_ptr<Type> type) { resolved_type_ = type; }
-    std::shared_ptr<Type> getResolvedType() const { return resolved_type_; }
+    void setResolvedType(const Type* type) { resolved_type_ = type; }
+    const Type* getResolvedType() const { return resolved_type_; }
 
-    std::string toString() const override {
-        std::string result = "VarDecl(" + type_ + " " + name_;
+    std::string toString() const {
+        std::string result = "VarDecl(" + type_->toString() + " " + name_.str();
         for (int dim : array_dims_) {
             result += "[" + std::to_string(dim) + "]";
         }
@@ -242,16 +322,18 @@ public:
 // 返回语句节点
 class ReturnStmtNode : public StmtNode {
 private:
-    std::unique_ptr<ExprNode> expr_;                     // 返回表达式（可为空）
+    ExprNode* expr_;                                     // 返回表达式（可为空）
 
 public:
-    explicit ReturnStmtNode(std::unique_ptr<ExprNode> expr = nullptr)
-        : expr_(std::move(expr)) {}
+    static constexpr NodeKind KIND = NodeKind::Return;
 
-    ExprNode* getExpression() const { return expr_.get(); }
+    explicit ReturnStmtNode(ExprNode* expr = nullptr)
+        : StmtNode(KIND), expr_(expr) {}
+
+    ExprNode* getExpression() const { return expr_; }
     bool hasExpression() const { return expr_ != nullptr; }
 
-    std::string toString() const override {
+    std::string toString() const {
         if (expr_) {
             return "Return(" + expr_->toString() + ")";
         } else {
@@ -262,50 +344,43 @@ public:
 
 // ElseIf分支结构
 struct ElseIfBranch {
-    std::unique_ptr<ExprNode> condition;               // 条件表达式
-    std::unique_ptr<StmtNode> statement;               // 分支语句
+    ExprNode* condition;                               // 条件表达式
+    StmtNode* statement;                               // 分支语句
 
-    ElseIfBranch(std::unique_ptr<ExprNode> cond, std::unique_ptr<StmtNode> stmt)
-        : condition(std::move(cond)), statement(std::move(stmt)) {}
+    ElseIfBranch(ExprNode* cond, StmtNode* stmt)
+        : condition(cond), statement(stmt) {}
 };
 
 // If语句节点：if (condition) then_stmt [else if (condition) stmt ...] [else else_stmt]
 class IfStmtNode : public StmtNode {
 private:
-    std::unique_ptr<ExprNode> condition_;               // 主条件表达式
-    std::unique_ptr<StmtNode> then_stmt_;               // then分支语句
-    std::vector<std::unique_ptr<ElseIfBranch>> else_ifs_; // else if分支列表
-    std::unique_ptr<StmtNode> else_stmt_;               // else分支语句（可为空）
+    ExprNode* condition_;                               // 主条件表达式
+    StmtNode* then_stmt_;                               // then分支语句
+    ArenaArray<ElseIfBranch> else_ifs_;                 // else if分支列表
+    StmtNode* else_stmt_;                               // else分支语句（可为空）
 
 public:
-    IfStmtNode(std::unique_ptr<ExprNode> condition,
-               std::unique_ptr<StmtNode> then_stmt)
-        : condition_(std::move(condition)), then_stmt_(std::move(then_stmt)) {}
+    static constexpr NodeKind KIND = NodeKind::If;
 
-    // 添加else if分支
-    void addElseIf(std::unique_ptr<ExprNode> condition, std::unique_ptr<StmtNode> statement) {
-        else_ifs_.push_back(std::make_unique<ElseIfBranch>(std::move(condition), std::move(statement)));
-    }
-
-    // 设置else分支
-    void setElseStmt(std::unique_ptr<StmtNode> else_stmt) {
-        else_stmt_ = std::move(else_stmt);
-    }
+    IfStmtNode(ExprNode* condition, StmtNode* then_stmt,
+               ArenaArray<ElseIfBranch> else_ifs, StmtNode* else_stmt)
+        : StmtNode(KIND), condition_(condition), then_stmt_(then_stmt),
+          else_ifs_(else_ifs), else_stmt_(else_stmt) {}
 
     // 访问器方法
-    ExprNode* getCondition() const { return condition_.get(); }
-    StmtNode* getThenStmt() const { return then_stmt_.get(); }
-    StmtNode* getElseStmt() const { return else_stmt_.get(); }
-    const std::vector<std::unique_ptr<ElseIfBranch>>& getElseIfs() const { return else_ifs_; }
+    ExprNode* getCondition() const { return condition_; }
+    StmtNode* getThenStmt() const { return then_stmt_; }
+    StmtNode* getElseStmt() const { return else_stmt_; }
+    ArenaArray<ElseIfBranch> getElseIfs() const { return else_ifs_; }
     bool hasElseIfs() const { return !else_ifs_.empty(); }
     bool hasElseStmt() const { return else_stmt_ != nullptr; }
 
-    std::string toString() const override {
+    std::string toString() const {
         std::string result = "If(" + condition_->toString() + ", " + then_stmt_->toString();
 
         // 添加else if分支
         for (const auto& else_if : else_ifs_) {
-            result += ", ElseIf(" + else_if->condition->toString() + ", " + else_if->statement->toString() + ")";
+            result += ", ElseIf(" + else_if.condition->toString() + ", " + else_if.statement->toString() + ")";
         }
 
         // 添加else分支
@@ -321,17 +396,19 @@ public:
 // While语句节点：while (condition) stmt
 class WhileStmtNode : public StmtNode {
 private:
-    std::unique_ptr<ExprNode> condition_;               // 循环条件
-    std::unique_ptr<StmtNode> body_;                    // 循环体
+    ExprNode* condition_;                               // 循环条件
+    StmtNode* body_;                                    // 循环体
 
 public:
-    WhileStmtNode(std::unique_ptr<ExprNode> condition, std::unique_ptr<StmtNode> body)
-        : condition_(std::move(condition)), body_(std::move(body)) {}
+    static constexpr NodeKind KIND = NodeKind::While;
+
+    WhileStmtNode(ExprNode* condition, StmtNode* body)
+        : StmtNode(KIND), condition_(condition), body_(body) {}
 
-    ExprNode* getCondition() const { return condition_.get(); }
-    StmtNode* getBody() const { return body_.get(); }
+    ExprNode* getCondition() const { return condition_; }
+    StmtNode* getBody() const { return body_; }
 
-    std::string toString() const override {
+    std::string toString() const {
         return "While(" + condition_->toString() + ", " + body_->toString() + ")";
     }
 };
@@ -339,28 +416,27 @@ public:
 // For语句节点：for (init; condition; increment) stmt
 class ForStmtNode : public StmtNode {
 private:
-    std::unique_ptr<StmtNode> init_;                    // 初始化语句（可为空）
-    std::unique_ptr<ExprNode> condition_;               // 循环条件（可为空）
-    std::unique_ptr<ExprNode> increment_;               // 增量表达式（可为空）
-    std::unique_ptr<StmtNode> body_;                    // 循环体
+    StmtNode* init_;                                    // 初始化语句（可为空）
+    ExprNode* condition_;                               // 循环条件（可为空）
+    ExprNode* increment_;                               // 增量表达式（可为空）
+    StmtNode* body_;                                    // 循环体
 
 public:
-    ForStmtNode(std::unique_ptr<StmtNode> init,
-                std::unique_ptr<ExprNode> condition,
-                std::unique_ptr<ExprNode> increment,
-                std::unique_ptr<StmtNode> body)
-        : init_(std::move(init)), condition_(std::move(condition)),
-          increment_(std::move(increment)), body_(std::move(body)) {}
-
-    StmtNode* getInit() const { return init_.get(); }
-    ExprNode* getCondition() const { return condition_.get(); }
-    ExprNode* getIncrement() const { return increment_.get(); }
-    StmtNode* getBody() const { return body_.get(); }
+    static constexpr NodeKind KIND = NodeKind::For;
+
+    ForStmtNode(StmtNode* init, ExprNode* condition, ExprNode* increment, StmtNode* body)
+        : StmtNode(KIND), init_(init), condition_(condition),
+          increment_(increment), body_(body) {}
+
+    StmtNode* getInit() const { return init_; }
+    ExprNode* getCondition() const { return condition_; }
+    ExprNode* getIncrement() const { return increment_; }
+    StmtNode* getBody() const { return body_; }
     bool hasInit() const { return init_ != nullptr; }
     bool hasCondition() const { return condition_ != nullptr; }
     bool hasIncrement() const { return increment_ != nullptr; }
 
-    std::string toString() const override {
+    std::string toString() const {
         std::string result = "For(";
         if (init_) result += init_->toString(); else result += "null";
         result += ", ";
@@ -375,17 +451,19 @@ public:
 // Do-While语句节点：do stmt while (condition)
 class DoWhileStmtNode : public StmtNode {
 private:
-    std::unique_ptr<StmtNode> body_;                    // 循环体
-    std::unique_ptr<ExprNode> condition_;               // 循环条件
+    StmtNode* body_;                                    // 循环体
+    ExprNode* condition_;                               // 循环条件
 
 public:
-    DoWhileStmtNode(std::unique_ptr<StmtNode> body, std::unique_ptr<ExprNode> condition)
-        : body_(std::move(body)), condition_(std::move(condition)) {}
+    static constexpr NodeKind KIND = NodeKind::DoWhile;
+
+    DoWhileStmtNode(StmtNode* body, ExprNode* condition)
+        : StmtNode(KIND), body_(body), condition_(condition) {}
 
-    StmtNode* getBody() const { return body_.get(); }
-    ExprNode* getCondition() const { return condition_.get(); }
+    StmtNode* getBody() const { return body_; }
+    ExprNode* getCondition() const { return condition_; }
 
-    std::string toString() const override {
+    std::string toString() const {
         return "DoWhile(" + body_->toString() + ", " + condition_->toString() + ")";
     }
 };
@@ -393,9 +471,11 @@ public:
 // Break语句节点：break;
 class BreakStmtNode : public StmtNode {
 public:
-    BreakStmtNode() = default;
+    static constexpr NodeKind KIND = NodeKind::Break;
+
+    BreakStmtNode() : StmtNode(KIND) {}
 
-    std::string toString() const override {
+    std::string toString() const {
         return "Break()";
     }
 };
@@ -403,9 +483,11 @@ public:
 // Continue语句节点：continue;
 class ContinueStmtNode : public StmtNode {
 public:
-    ContinueStmtNode() = default;
+    static constexpr NodeKind KIND = NodeKind::Continue;
 
-    std::string toString() const override {
+    ContinueStmtNode() : StmtNode(KIND) {}
+
+    std::string toString() const {
         return "Continue()";
     }
 };
@@ -413,9 +495,11 @@ public:
 // 空语句节点：;
 class EmptyStmtNode : public StmtNode {
 public:
-    EmptyStmtNode() = default;
+    static constexpr NodeKind KIND = NodeKind::Empty;
+
+    EmptyStmtNode() : StmtNode(KIND) {}
 
-    std::string toString() const override {
+    std::string toString() const {
         return "EmptyStmt()";
     }
 };
@@ -423,15 +507,17 @@ public:
 // 表达式语句节点：expr;
 class ExprStmtNode : public StmtNode {
 private:
-    std::unique_ptr<ExprNode> expr_;
+    ExprNode* expr_;
 
 public:
-    explicit ExprStmtNode(std::unique_ptr<ExprNode> expr)
-        : expr_(std::move(expr)) {}
+    static constexpr NodeKind KIND = NodeKind::ExprStmt;
 
-    ExprNode* getExpression() const { return expr_.get(); }
+    explicit ExprStmtNode(ExprNode* expr)
+        : StmtNode(KIND), expr_(expr) {}
 
-    std::string toString() const override {
+    ExprNode* getExpression() const { return expr_; }
+
+    std::string toString() const {
         return "ExprStmt(" + expr_->toString() + ")";
     }
 };
@@ -439,18 +525,19 @@ public:
 // 复合语句节点：{ stmt1; stmt2; ... }
 class CompoundStmtNode : public StmtNode {
 private:
-    std::vector<std::unique_ptr<StmtNode>> statements_;
+    ArenaArray<StmtNode*> statements_;
 
 public:
-    void addStatement(std::unique_ptr<StmtNode> stmt) {
-        statements_.push_back(std::move(stmt));
-    }
+    static constexpr NodeKind KIND = NodeKind::Compound;
 
-    const std::vector<std::unique_ptr<StmtNode>>& getStatements() const {
+    explicit CompoundStmtNode(ArenaArray<StmtNode*> statements)
+        : StmtNode(KIND), statements_(statements) {}
+
+    ArenaArray<StmtNode*> getStatements() const {
         return statements_;
     }
 
-    std::string toString() const override {
+    std::string toString() const {
         std::string result = "CompoundStmt(";
         for (size_t i = 0; i < statements_.size(); ++i) {
             if (i > 0) result += ", ";
@@ -463,44 +550,41 @@ public:
 
 // 函数参数
 struct FunctionParam {
-    std::string type;
-    std::string name;
-    std::shared_ptr<Type> resolved_type;
+    const Type* type;
+    Identifier name;
 
-    FunctionParam(const std::string& t, const std::string& n) : type(t), name(n) {}
+    FunctionParam(const Type* t, Identifier n) : type(t), name(n) {}
 
-    void setResolvedType(std::shared_ptr<Type> t) { resolved_type = t; }
-    std::shared_ptr<Type> getResolvedType() const { return resolved_type; }
+    const Type* getResolvedType() const { return type; }
 };
 
 // 函数定义节点：int foo(int a, int b) { ... }
 class FunctionDeclNode : public ASTNode {
 private:
-    std::string return_type_;
-    std::string name_;
-    std::vector<FunctionParam> params_;
-    std::unique_ptr<CompoundStmtNode> body_;
-    std::shared_ptr<Type> resolved_return_type_;
+    const Type* return_type_;
+    Identifier name_;
+    ArenaArray<FunctionParam> params_;
+    CompoundStmtNode* body_;
 
 public:
-    FunctionDeclNode(const std::string& return_type, const std::string& name,
-                     std::vector<FunctionParam> params, std::unique_ptr<CompoundStmtNode> body)
-        : return_type_(return_type), name_(name), params_(std::move(params)), body_(std::move(body)) {}
+    static constexpr NodeKind KIND = NodeKind::FunctionDecl;
+
+    FunctionDeclNode(const Type* return_type, Identifier name,
+                     ArenaArray<FunctionParam> params, CompoundStmtNode* body)
+        : ASTNode(KIND), return_type_(return_type), name_(name), params_(params), body_(body) {}
 
-    const std::string& getReturnType() const { return return_type_; }
-    const std::string& getName() const { return name_; }
-    const std::vector<FunctionParam>& getParams() const { return params_; }
-    std::vector<FunctionParam>& getParams() { return params_; }
-    CompoundStmtNode* getBody() const { return body_.get(); }
+    const Type* getReturnType() const { return return_type_; }
+    const std::string& getName() const { return name_.str(); }
+    ArenaArray<FunctionParam> getParams() const { return params_; }
+    CompoundStmtNode* getBody() const { return body_; }
 
-    void setResolvedReturnType(std::shared_ptr<Type> type) { resolved_return_type_ = type; }
-    std::shared_ptr<Type> getResolvedReturnType() const { return resolved_return_type_; }
+    const Type* getResolvedReturnType() const { return return_type_; }
 
-    std::string toString() const override {
-        std::string result = "FunctionDecl(" + return_type_ + " " + name_ + "(";
+    std::string toString() const {
+        std::string result = "FunctionDecl(" + return_type_->toString() + " " + name_.str() + "(";
         for (size_t i = 0; i < params_.size(); ++i) {
             if (i > 0) result += ", ";
-            result += params_[i].type + " " + params_[i].name;
+            result += params_[i].type->toString() + " " + params_[i].name.str();
         }
         result += "), " + body_->toString() + ")";
         return result;
@@ -509,15 +593,12 @@ public:
 
 // 结构体成员
 struct StructMember {
-    std::string type;           // 成员类型（如 "int", "int*", "int"）
-    std::string name;           // 成员名
-    std::vector<int> array_dims; // 如果是数组成员，存储维度
-
-    StructMember(const std::string& t, const std::string& n)
-        : type(t), name(n) {}
+    const Type* type;           // 成员的基础类型（如 int、int*、struct Point）
+    Identifier name;            // 成员名
+    ArenaArray<int> array_dims; // 如果是数组成员，存储维度
 
-    StructMember(const std::string& t, const std::string& n, std::vector<int> dims)
-        : type(t), name(n), array_dims(std::move(dims)) {}
+    StructMember(const Type* t, Identifier n, ArenaArray<int> dims = ArenaArray<int>())
+        : type(t), name(n), array_dims(dims) {}
 
     bool isArray() const { return !array_dims.empty(); }
 };
@@ -525,28 +606,23 @@ struct StructMember {
 // 结构体定义节点：struct Point { int x; int y; };
 class StructDeclNode : public ASTNode {
 private:
-    std::string name_;
-    std::vector<StructMember> members_;
+    Identifier name_;
+    ArenaArray<StructMember> members_;
 
 public:
-    explicit StructDeclNode(const std::string& name) : name_(name) {}
+    static constexpr NodeKind KIND = NodeKind::StructDecl;
 
-    void addMember(const std::string& type, const std::string& name) {
-        members_.push_back(StructMember(type, name));
-    }
-
-    void addMember(const std::string& type, const std::string& name, std::vector<int> dims) {
-        members_.push_back(StructMember(type, name, std::move(dims)));
-    }
+    StructDeclNode(Identifier name, ArenaArray<StructMember> members)
+        : ASTNode(KIND), name_(name), members_(members) {}
 
-    const std::string& getName() const { return name_; }
-    const std::vector<StructMember>& getMembers() const { return members_; }
+    const std::string& getName() const { return name_.str(); }
+    ArenaArray<StructMember> getMembers() const { return members_; }
 
-    std::string toString() const override {
-        std::string result = "StructDecl(" + name_ + ") {";
+    std::string toString() const {
+        std::string result = "StructDecl(" + name_.str() + ") {";
         for (size_t i = 0; i < members_.size(); ++i) {
             if (i > 0) result += ", ";
-            result += members_[i].type + " " + members_[i].name;
+            result += members_[i].type->toString() + " " + members_[i].name.str();
             for (int dim : members_[i].array_dims) {
                 result += "[" + std::to_string(dim) + "]";
             }
@@ -557,29 +633,38 @@ public:
 };
 
 // 程序节点：顶层，包含多个函数定义、结构体定义和全局变量
+// 唯一一个不在 Arena 中的节点：它持有 ASTContext，释放它就释放了整棵树
 class ProgramNode : public ASTNode {
 private:
-    std::vector<std::unique_ptr<FunctionDeclNode>> functions_;
-    std::vector<std::unique_ptr<StructDeclNode>> structs_;
-    std::vector<std::unique_ptr<VarDeclStmtNode>> global_vars_;
+    std::unique_ptr<ASTContext> context_;
+    std::vector<FunctionDeclNode*> functions_;
+    std::vector<StructDeclNode*> structs_;
+    std::vector<VarDeclStmtNode*> global_vars_;
 
     // 声明顺序记录（用于 Sema 按源文件顺序分析）
     // 0 = struct, 1 = global_var, 2 = function
     std::vector<int> declaration_order_;
 
 public:
-    void addFunction(std::unique_ptr<FunctionDeclNode> func) {
-        functions_.push_back(std::move(func));
+    static constexpr NodeKind KIND = NodeKind::Program;
+
+    explicit ProgramNode(std::unique_ptr<ASTContext> context)
+        : ASTNode(KIND), context_(std::move(context)) {}
+
+    ASTContext& getContext() const { return *context_; }
+
+    void addFunction(FunctionDeclNode* func) {
+        functions_.push_back(func);
         declaration_order_.push_back(2);  // function
     }
 
-    void addStruct(std::unique_ptr<StructDeclNode> struct_decl) {
-        structs_.push_back(std::move(struct_decl));
+    void addStruct(StructDeclNode* struct_decl) {
+        structs_.push_back(struct_decl);
         declaration_order_.push_back(0);  // struct
     }
 
-    void addGlobalVar(std::unique_ptr<VarDeclStmtNode> global_var) {
-        global_vars_.push_back(std::move(global_var));
+    void addGlobalVar(VarDeclStmtNode* global_var) {
+        global_vars_.push_back(global_var);
         declaration_order_.push_back(1);  // global_var
     }
 
@@ -588,19 +673,19 @@ public:
         return declaration_order_;
     }
 
-    const std::vector<std::unique_ptr<FunctionDeclNode>>& getFunctions() const {
+    const std::vector<FunctionDeclNode*>& getFunctions() const {
         return functions_;
     }
 
-    const std::vector<std::unique_ptr<StructDeclNode>>& getStructs() const {
+    const std::vector<StructDeclNode*>& getStructs() const {
         return structs_;
     }
 
-    const std::vector<std::unique_ptr<VarDeclStmtNode>>& getGlobalVars() const {
+    const std::vector<VarDeclStmtNode*>& getGlobalVars() const {
         return global_vars_;
     }
 
-    std::string toString() const override {
+    std::string toString() const {
         std::string result = "Program(";
         for (size_t i = 0; i < structs_.size(); ++i) {
             if (i > 0) result += ", ";
@@ -621,4 +706,32 @@ public:
     }
 };
 
-#endif // AST_H
\ No newline at end of file
+inline std::string ASTNode::toString() const {
+    switch (kind_) {
+        case NodeKind::Number:          return static_cast<const NumberNode*>(this)->toString();
+        case NodeKind::Variable:        return static_cast<const VariableNode*>(this)->toString();
+        case NodeKind::BinaryOp:        return static_cast<const BinaryOpNode*>(this)->toString();
+        case NodeKind::UnaryOp:         return static_cast<const UnaryOpNode*>(this)->toString();
+        case NodeKind::FunctionCall:    return static_cast<const FunctionCallNode*>(this)->toString();
+        case NodeKind::ArrayAccess:     return static_cast<const ArrayAccessNode*>(this)->toString();
+        case NodeKind::MemberAccess:    return static_cast<const MemberAccessNode*>(this)->toString();
+        case NodeKind::InitializerList: return static_cast<const InitializerListNode*>(this)->toString();
+        case NodeKind::VarDecl:         return static_cast<const VarDeclStmtNode*>(this)->toString();
+        case NodeKind::Return:          return static_cast<const ReturnStmtNode*>(this)->toString();
+        case NodeKind::If:              return static_cast<const IfStmtNode*>(this)->toString();
+        case NodeKind::While:           return static_cast<const WhileStmtNode*>(this)->toString();
+        case NodeKind::For:             return static_cast<const ForStmtNode*>(this)->toString();
+        case NodeKind::DoWhile:         return static_cast<const DoWhileStmtNode*>(this)->toString();
+        case NodeKind::Break:           return static_cast<const BreakStmtNode*>(this)->toString();
+        case NodeKind::Continue:        return static_cast<const ContinueStmtNode*>(this)->toString();
+        case NodeKind::Empty:           return static_cast<const EmptyStmtNode*>(this)->toString();
+        case NodeKind::ExprStmt:        return static_cast<const ExprStmtNode*>(this)->toString();
+        case NodeKind::Compound:        return static_cast<const CompoundStmtNode*>(this)->toString();
+        case NodeKind::FunctionDecl:    return static_cast<const FunctionDeclNode*>(this)->toString();
+        case NodeKind::StructDecl:      return static_cast<const StructDeclNode*>(this)->toString();
+        case NodeKind::Program:         return static_cast<const ProgramNode*>(this)->toString();
+    }
+    return "";
+}
+
+#endif // AST_H
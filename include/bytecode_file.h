@@ -0,0 +1,50 @@
+#ifndef BYTECODE_FILE_H
+#define BYTECODE_FILE_H
+
+#include "vm.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// bytecode_file.h
+// 字节码文件（.bc）：把 ByteCode 保存下来，之后直接加载执行，跳过整个前端
+//
+// 文件格式（小端序，偏移以字节计）：
+//   0   "SCBC"                 魔数
+//   4   uint32 版本            VERSION，格式变化时递增
+//   8   uint32 指令种类数      OPCODE_COUNT，指令集变化后旧文件不能再用
+//   12  int32  entry_point
+//   16  uint64 源代码哈希      hashSource() 的结果，0 表示未知
+//   24  uint32 函数个数
+//   28  uint32 全局变量个数
+//   32  uint32 指令条数
+//   36  uint32 指令段偏移      8 的倍数
+//   40  函数表：     { uint32 地址; uint32 参数和返回值 slot 数; uint32 名字长度; 名字 }，按地址排序
+//       全局变量表： { int32 offset; int32 slot_count; uint32 初值个数; int32 初值... }
+//       填充 0 到 8 字节对齐
+//   指令段：每条 8 字节 { uint8 op; 3 字节 0; int32 operand }，与内存中的 Instruction 相同
+//
+// 加载时文件用 mmap 映射，指令段按 Instruction 对齐且布局相同，ByteCode::code 直接引用映射的内容，
+// 不做复制（大端平台或无法映射时退回到逐条解码）。
+// 加载时检查文件结构、指令编号和函数地址，再用 BytecodeVerifier 校验整个程序（跳转目标、栈深度、帧偏移等），
+// 损坏或被改动的文件报错而不是执行。
+
+class BytecodeFile {
+public:
+    // 2: 全局区移到地址 GLOBAL_BASE = 1（全局指针的初值随之改变）
+    // 3: 函数表增加 ByteCode::arg_slots（校验器检查负的帧偏移）
+    static constexpr uint32_t VERSION = 3;
+
+    // 序列化为字节串 / 写入文件（失败抛出 std::runtime_error）
+    static std::string serialize(const ByteCode& bytecode, uint64_t source_hash = 0);
+    static void write(const ByteCode& bytecode, const std::string& path, uint64_t source_hash = 0);
+
+    // 加载字节码文件，失败（不是字节码文件、版本不符、文件损坏或校验失败）抛出 std::runtime_error；
+    // source_hash 非空时写入文件中记录的源代码哈希
+    static ByteCode load(const std::string& path, uint64_t* source_hash = nullptr);
+
+    // 源代码的内容哈希（64 位 FNV-1a），用作字节码缓存的键
+    static uint64_t hashSource(std::string_view source);
+};
+
+#endif // BYTECODE_FILE_H
@@ -0,0 +1,54 @@
+#ifndef CBACKEND_H
+#define CBACKEND_H
+
+#include "vm.h"
+#include <sstream>
+#include <string>
+#include <vector>
+
+// cbackend.h
+// AOT 后端：把栈式字节码翻译成可移植的 C 源文件，再交给系统 cc 编译成原生程序
+//
+// 生成的 C 代码保留 VM 的内存模型：
+//   - int32_t stack[STACK_SIZE] 和栈帧布局（ret_slot、fp-3 起的参数、ret_addr、old_fp）不变，
+//     LEA 得到的地址仍然是 stack 下标，指针可以照常传递
+//   - 全局区是一个静态数组，按 GlobalVarInit 的顺序和 slot 数排布，初值也来自 GlobalVarInit
+//   - 每个 SimpleC 函数对应一个 C 函数 static void sc_<name>(int32_t fp)
+// 每条指令执行前的栈深度由 BytecodeVerifier 静态算出，所以操作数栈位置 sp - 1
+// 可以直接写成 f[depth - 1]（f = stack + fp），生成的代码里没有 sp。
+// 运行时检查与 VM::executeVerified 相同：CALL 检查栈溢出，LOADM/STOREM/MEMCPY/LOADMN/STOREMN/RETN 检查越界，除法检查除零。
+
+class BytecodeVerifier;
+
+class CBackend {
+public:
+    // 生成代码中的 STACK_SIZE（slot 数），范围与 VM::setStackSize 相同
+    void setStackSize(int slots);
+
+    // bytecode 必须已通过 verifier 校验；source_name 只用于生成文件头部的注释
+    std::string generate(const ByteCode& bytecode, const BytecodeVerifier& verifier,
+                         const std::string& source_name);
+
+private:
+    int stack_size_ = VM::DEFAULT_STACK_SIZE;
+    const ByteCode* bytecode_ = nullptr;
+    const BytecodeVerifier* verifier_ = nullptr;
+    std::ostringstream out_;
+    std::vector<bool> is_target_;   // 跳转目标（需要生成标签）
+    std::string function_;          // 正在翻译的函数及其地址范围 [entry_, end_)
+    int entry_ = 0;
+    int end_ = 0;
+
+    void emitPrelude(const std::string& source_name);
+    void emitGlobals();
+    void emitFunction();
+    // 翻译 code[pc]（执行前栈深度为 d），返回消耗的字节码条数
+    int emitInstruction(int pc, int d);
+    // cond 成立时跳到 target（d 为跳转后的栈深度，跳到代码末尾即结束程序）
+    void emitJump(const std::string& cond, int target, int d);
+    void emitMain();
+
+    static std::string cName(const std::string& name) { return "sc_" + name; }
+};
+
+#endif // CBACKEND_H
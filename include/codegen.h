@@ -4,8 +4,10 @@
 #include "ast.h"
 #include "vm.h"
 #include "type.h"
+#include <optional>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 
 // 变量信息结构
 struct VariableInfo {
@@ -27,7 +29,16 @@ private:
 
     // ========== 新的统一变量管理系统 ==========
     // 统一的变量表：管理局部变量、参数
-    std::unordered_map<std::string, VariableInfo> variables_;
+    // 变量按声明顺序压入 locals_，local_index_ 记录每个名字当前可见的那一项；
+    // 内层的同名变量记下被它遮蔽的项，离开代码块时弹出块内声明的变量并恢复被遮蔽的项，
+    // 进出代码块的代价只与块内声明的变量个数有关
+    struct LocalVariable {
+        const std::string* name;   // 指向 local_index_ 中的键
+        VariableInfo info;
+        int shadowed;              // 被遮蔽的同名变量在 locals_ 中的下标，-1 表示没有
+    };
+    std::vector<LocalVariable> locals_;
+    std::unordered_map<std::string, int> local_index_;   // 名字 -> locals_ 下标，-1 表示不可见
 
     // 全局变量表（不随函数清空，持久存在）
     std::unordered_map<std::string, VariableInfo> global_variables_;
@@ -39,14 +50,28 @@ private:
     // 用于 break/continue
     std::vector<int> break_targets_;
     std::vector<int> continue_targets_;
+    // 每层循环开始时的局部变量偏移，break/continue 跳转前据此回收循环体内的局部变量
+    std::vector<int> loop_local_bases_;
 
     // 当前函数的参数 slot 数 (用于计算 ret_slot_offset)
     // TODO: 支持 struct 参数时，需改为计算总 slot 数而非参数个数
     int current_param_slots_ = 0;
 
+    // ========== 常量折叠与传播（-O1）==========
+    bool constant_folding_ = false;
+    // 当前程序点上值已知的局部 int 变量（栈偏移 -> 值），只记录从未被取地址的变量
+    using KnownValues = std::unordered_map<int, int32_t>;
+    KnownValues known_locals_;
+    // 当前函数中被取过地址（&x）的变量名，这些变量可能经由指针修改，不做传播
+    std::unordered_set<std::string> address_taken_;
+
 public:
     ByteCode generate(ProgramNode* program);
 
+    // 在函数体内折叠常量表达式、传播局部变量的常量值，常量条件的 if/while 生成直线代码，
+    // 常量数组下标生成静态偏移
+    void setConstantFolding(bool enabled) { constant_folding_ = enabled; }
+
 private:
     void genFunction(FunctionDeclNode* func);
     void genStatement(StmtNode* stmt);
@@ -61,18 +86,29 @@ private:
 
     void genExpression(ExprNode* expr);
     void genBinaryOp(BinaryOpNode* expr);
+    void genLogicalOp(BinaryOpNode* expr);
+    // 条件跳转：cond 的真假等于 jump_if 时跳转，否则顺序执行
+    // 返回尚未回填目标的跳转指令地址（&&、|| 短路求值，右操作数可能不执行）
+    std::vector<int> genCondJump(ExprNode* cond, bool jump_if);
+    void patchJumps(const std::vector<int>& jumps, int target);
     void genUnaryOp(UnaryOpNode* expr);
     void genFunctionCall(FunctionCallNode* expr);
     void genArrayAccess(ArrayAccessNode* expr);
     void genArrayAccessAddr(ArrayAccessNode* expr);
     void genMemberAccess(MemberAccessNode* expr);
     void genMemberAccessAddr(MemberAccessNode* expr);
+    // 结构体值所在的地址（变量、成员、数组元素、解引用），用于 LOADMN/STOREMN/MEMCPY
+    void genStructAddr(ExprNode* expr);
 
     int getLocal(const std::string& name);
 
     // ========== 统一变量分配接口 ==========
-    int allocateVariable(const std::string& name, std::shared_ptr<Type> type);
-    int allocateGlobalVariable(const std::string& name, std::shared_ptr<Type> type);  // Phase 6
+    int allocateVariable(const std::string& name, const Type* type);
+    int allocateGlobalVariable(const std::string& name, const Type* type);  // Phase 6
+
+    // 局部变量表：声明一个局部变量或参数；弹出 locals_ 中 count 之后的变量（离开代码块）
+    void declareLocal(const std::string& name, const VariableInfo& info);
+    void popLocals(size_t count);
 
     // 变量查询
     const VariableInfo* findVariable(const std::string& name) const;
@@ -87,9 +123,9 @@ private:
     bool isPointerType(ExprNode* node) const;
     bool isIntType(ExprNode* node) const;
     int getSlotCount(ExprNode* node) const;
-    int getSlotCount(std::shared_ptr<Type> type) const;
+    int getSlotCount(const Type* type) const;
     bool hasValidType(ExprNode* node) const;
-    std::shared_ptr<Type> getType(ExprNode* node) const;
+    const Type* getType(ExprNode* node) const;
 
     // ========== 常量表达式求值 (Phase 6) ==========
     // 在编译时求值常量表达式，用于全局变量初始化
@@ -99,6 +135,17 @@ private:
     //   - 取地址: &global_var
     //   - 负数: -10
     int32_t evaluateConstExpr(ExprNode* expr);
+
+    // ========== 常量折叠与传播 ==========
+    // expr 没有副作用且值在编译时已知时返回该值（未启用常量折叠时总是返回空）
+    // 除零、INT_MIN / -1 留到运行时报错，不折叠
+    std::optional<int32_t> foldConstant(ExprNode* expr) const;
+    // name 是否是可以传播常量值的局部 int 变量
+    bool isPropagatable(const std::string& name) const;
+    // 进入循环或条件执行的代码前：忘掉 node 中会被赋值的变量的已知值
+    void forgetAssignedIn(ASTNode* node);
+    // 控制流汇合：只保留两边都已知且相等的值
+    static void intersectKnown(KnownValues& into, const KnownValues& other);
 };
 
 #endif // CODEGEN_H
@@ -0,0 +1,65 @@
+#ifndef INLINER_H
+#define INLINER_H
+
+#include "vm.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+// inliner.h
+// 函数内联：把对小的叶子函数的 CALL 替换成函数体的副本（-O2 启用，在窥孔优化之前运行）
+//
+// 每次调用都要预留返回值 slot、压入参数、CALL 压入 [ret_addr][old_fp]、RET 写回返回值并恢复栈帧，
+// 最后 ADJSP 弹出参数。sq、max、取成员这样只有几条指令的函数，调用开销比函数体本身还大。
+//
+// 内联在字节码上进行，调用处的栈深度由 BytecodeVerifier 静态算出。设 CALL 之前的深度为 D（参数已经压栈），
+// 被调函数的栈帧原样搬到调用者的栈顶：
+//   - 参数和返回值 slot（fp 负偏移 k）本来就在调用者的栈上：k -> D + 2 + k
+//   - 局部变量（CodeGen 按 VariableInfo 分配的偏移 k >= 0）在调用者栈顶之上得到新的 slot：k -> D + k
+//     （没有 [ret_addr][old_fp]，局部变量紧接在参数之后）
+// LOAD/STORE/LEA 只改写偏移；RET k 改成 STORE 到返回值 slot，之后弹出被调函数剩下的 slot 并跳到调用之后。
+// 此时的栈深度与原来 RET 返回后相同，调用者后面的 ADJSP 不变。
+//
+// 只内联叶子函数：不含 CALL（因此不会递归）、HALT 和 RETN（返回结构体），可达指令数不超过阈值。
+// 被内联的函数本身保留：入口函数和不可达的调用点仍然用到它。
+
+struct InlineStats {
+    std::vector<std::pair<std::string, int>> inlined_calls;  // 被调函数 -> 消除的调用次数，按函数入口地址排序
+
+    int total() const {
+        int sum = 0;
+        for (const auto& [name, count] : inlined_calls) sum += count;
+        return sum;
+    }
+};
+
+class FunctionInliner {
+public:
+    static constexpr int DEFAULT_MAX_INSTRUCTIONS = 24;
+
+    // max_instructions：被调函数可达指令数的上限（每个调用点都会复制一份函数体）
+    explicit FunctionInliner(int max_instructions = DEFAULT_MAX_INSTRUCTIONS)
+        : max_instructions_(max_instructions) {}
+
+    // 必须在超级指令融合之前运行；字节码校验不通过时不做任何改写（错误留给之后的阶段报告）
+    InlineStats run(ByteCode& bytecode);
+
+private:
+    struct Function {
+        std::string name;
+        int entry;
+        int end;            // 下一个函数的入口（不含）
+        bool inlinable;
+    };
+
+    int max_instructions_;
+    std::vector<Function> functions_;  // 按入口地址排序
+
+    bool isInlinable(const InstructionBuffer& code, const std::vector<int>& depth, const Function& func) const;
+
+    // 把 callee 的函数体展开到 out 末尾，调用处 CALL 之前的栈深度为 call_depth
+    void expand(const InstructionBuffer& code, const std::vector<int>& depth, const Function& callee,
+                int call_depth, std::vector<Instruction>& out) const;
+};
+
+#endif // INLINER_H
@@ -0,0 +1,103 @@
+#ifndef JIT_H
+#define JIT_H
+
+#include "vm.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// jit.h
+// x86-64 模板 JIT
+//
+// 把整个 ByteCode（ByteCode::functions 里的每个函数）逐条指令翻译成机器码，
+// 放在 mmap 得到的可执行内存里。每条栈式指令对应一段固定的机器码模板，
+// 操作的仍然是 VM 的线性内存：
+//   rbx = 栈基址          r12 = sp   r13 = fp
+//   r14 = 内存基址        r15 = JitContext*
+// CALL 和解释器一样在 VM 栈上压入 [ret_addr][old_fp]，再用原生 call 进入被调函数；
+// RET 写 ret_slot、恢复 sp/fp 后原生 ret。因此栈帧布局（ret_slot、fp-3 起的参数、
+// ret_addr、old_fp）和解释器完全一致，执行结束后 VM 的栈内容也和解释执行相同。
+//
+// 只接受已通过 BytecodeVerifier 校验的程序：操作数栈不会下溢，
+// 栈溢出检查合并到 CALL（机器码不经过 VM 的保护页处理），LOADG/STOREG 不再检查。
+// 每层调用还占用 8 字节原生栈（返回地址），原生栈通常只有 8 MB，比 --stack-size 允许的 VM 栈小得多，
+// 所以 CALL 同时检查 rsp，原生栈用完时也报告栈溢出，而不是直接 SIGSEGV。
+// 运行时错误（除零、越界、栈溢出）跳到公共出口，恢复进入时的原生栈后返回错误码，
+// 由 VM::executeJit 转换成与解释器相同的异常。
+//
+// 仅支持 x86-64 Linux，其他平台 isSupported() 返回 false。
+
+class BytecodeVerifier;
+
+// 机器码和 C++ 之间传递的执行状态（字段偏移在生成的代码里直接使用）
+struct JitContext {
+    int32_t* memory;
+    int32_t* stack;
+    int64_t sp;
+    int64_t fp;
+    int64_t stack_size;
+    int64_t address_limit;        // 内存大小 - GLOBAL_BASE：地址减 GLOBAL_BASE 后一次无符号比较
+    void* saved_rsp;              // 进入时的原生栈指针，出错/HALT 时从任意调用深度直接返回
+    uintptr_t native_stack_limit; // CALL 时 rsp 低于它就报告栈溢出（jitNativeStackLimit()）
+    VM* vm;                       // MEMCPY 调用 VM::copyMemory
+    char error_message[128];      // MEMCPY 出错时的异常信息
+};
+
+// 运行时错误码（0 表示正常结束）
+enum class JitStatus : int32_t {
+    Ok = 0,
+    StackOverflow,
+    DivisionByZero,
+    LoadOutOfRange,
+    StoreOutOfRange,
+    LoadBlockOutOfRange,
+    StoreBlockOutOfRange,
+    ReturnBlockOutOfRange,
+    MemcpyFailed,   // 具体信息在 JitContext::error_message 中
+};
+
+std::string jitStatusMessage(JitStatus status, const JitContext& ctx);
+
+// 当前线程原生栈的最低可用地址，上面留出 C++ 辅助函数（PRINT、MEMCPY）需要的余量
+uintptr_t jitNativeStackLimit();
+
+// 编译结果：持有可执行内存
+class JitProgram {
+public:
+    using EntryFn = int32_t (*)(JitContext*);
+
+    JitProgram(const ByteCode& bytecode, void* memory, size_t mapped_size, size_t code_size,
+               int entry_depth);
+    ~JitProgram();
+    JitProgram(const JitProgram&) = delete;
+    JitProgram& operator=(const JitProgram&) = delete;
+
+    const ByteCode& bytecode() const { return *bytecode_; }
+    size_t codeSize() const { return code_size_; }
+    // main 的最大栈深度（进入前检查一次栈溢出）
+    int entryDepth() const { return entry_depth_; }
+
+    // 从 bytecode.entry_point 开始执行（ctx 的 sp/fp 是 main 调用帧建立之后的值）
+    JitStatus run(JitContext& ctx) const {
+        return static_cast<JitStatus>(reinterpret_cast<EntryFn>(memory_)(&ctx));
+    }
+
+private:
+    const ByteCode* bytecode_;
+    void* memory_;
+    size_t mapped_size_;
+    size_t code_size_;
+    int entry_depth_;
+};
+
+class JitCompiler {
+public:
+    // 当前平台能否生成并执行 x86-64 机器码
+    static bool isSupported();
+
+    // 编译整个程序；bytecode 必须已通过 verifier 校验，且在 JitProgram 的生命周期内不能修改
+    std::unique_ptr<JitProgram> compile(const ByteCode& bytecode, const BytecodeVerifier& verifier);
+};
+
+#endif // JIT_H
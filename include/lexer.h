@@ -2,20 +2,26 @@
 #define LEXER_H
 
 #include "token.h"
+#include "source.h"
+#include <deque>
+#include <memory>
 #include <string>
-#include <fstream>
+#include <string_view>
+#include <vector>
 
 // lexer.h
 // SimpleC编译器的词法分析器
 // 第一阶段：将源代码转换为Token流
 
 // 词法分析器类：将源代码字符串转换为Token序列
+// Token 的字面值是指向源代码的 string_view，Lexer 不复制源代码
+// 向前看的 Token 保存在环形缓冲区中，每个字符只扫描一次
 class Lexer {
 public:
-    // 构造函数 - 从字符串创建词法分析器
-    explicit Lexer(const std::string& source);
+    // 构造函数 - 从字符串创建词法分析器（不复制，source 必须比 Lexer 和它产生的 Token 活得长）
+    explicit Lexer(std::string_view source);
 
-    // 构造函数 - 从文件创建词法分析器
+    // 构造函数 - 从文件创建词法分析器（文件被映射到内存，由 Lexer 持有）
     explicit Lexer(const char* filename);
 
     // 析构函数
@@ -28,7 +34,8 @@ public:
     Token peekNextToken();
 
     // 预览第 n 个 Token（不消耗，n 从 1 开始，n=1 等同于 peekNextToken）
-    Token peekNthToken(size_t n);
+    // 不足 n 个时从源代码继续扫描并放入缓冲区，已缓冲的 Token 直接按下标取出
+    const Token& peekNthToken(size_t n);
 
     // 检查是否到达输入结尾
     bool isAtEnd() const { return current_pos_ >= source_.length(); }
@@ -55,10 +62,10 @@ public:
     Token readMultiCharOperator(TokenType type);
 
     // 检查字符串是否是关键字
-    bool isKeyword(const std::string& str);
+    static bool isKeyword(std::string_view str);
 
-    // 获取关键字对应的Token类型
-    TokenType getKeywordType(const std::string& str);
+    // 获取关键字对应的Token类型（编译期生成的完美哈希表，不是关键字时返回 Invalid）
+    static TokenType getKeywordType(std::string_view str);
 
     // 重置词法分析器到开始位置
     void reset();
@@ -69,25 +76,37 @@ public:
     // 获取当前列号
     int getCurrentColumn() const { return column_; }
 
+    // 用 SSE2 一次检查 16 个字节来跳过空白和标识符（平台不支持时忽略，始终逐字节扫描）
+    void setSimdEnabled(bool enabled) { simd_enabled_ = enabled && supportsSimd(); }
+    static bool supportsSimd();
+
+    // 统计：扫描过的字符数和 Token 数（reset 后继续累加）
+    size_t getCharsScanned() const { return chars_before_reset_ + current_pos_; }
+    size_t getTokensScanned() const { return tokens_scanned_; }
+
 private:
-    std::string source_;          // 源代码
-    size_t current_pos_;          // 当前位置
+    std::unique_ptr<SourceFile> file_;  // 从文件创建时持有的映射
+    std::string_view source_;     // 源代码
+    size_t current_pos_ = 0;      // 当前位置
     int line_;                    // 当前行号
     int column_;                  // 当前列号
-    Token current_token_;         // 当前缓存的Token
-    bool has_cached_token_;       // 是否有缓存的Token
+    std::vector<Token> lookahead_;      // 向前看的环形缓冲区，容量是 2 的幂，满了翻倍
+    size_t lookahead_head_ = 0;         // 缓冲区中第一个 Token 的下标
+    size_t lookahead_count_ = 0;        // 缓冲区中的 Token 数
+    size_t tokens_scanned_ = 0;
+    size_t chars_before_reset_ = 0;
+    bool simd_enabled_ = supportsSimd();
+    std::deque<std::string> messages_;  // Invalid Token 的错误消息（deque 保证已有元素的地址不变）
 
     // 初始化词法分析器状态
     void initialize();
 
-    // 判断字符是否为数字
-    bool isDigit(char c) const { return c >= '0' && c <= '9'; }
+    // 从源代码扫描下一个Token（不经过缓冲区）
+    Token scanToken();
 
-    // 判断字符是否为空白字符
-    bool isWhitespace(char c) const { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
 
-    // 从文件加载源代码
-    std::string loadFromFile(const char* filename);
+    // 生成一个 Invalid Token，消息保存在 messages_ 中
+    Token makeInvalid(std::string message, int line, int column);
 };
 
 #endif // LEXER_H
\ No newline at end of file
@@ -23,37 +23,42 @@ public:
     bool isAtEnd() const;
 
     // 解析表达式 - 公共接口
-    std::unique_ptr<ExprNode> parseExpression();
+    ExprNode* parseExpression();
 
     // 解析完整表达式并检查语法错误
-    std::unique_ptr<ExprNode> parseCompleteExpression();
+    ExprNode* parseCompleteExpression();
 
     // 语句解析功能
-    std::unique_ptr<StmtNode> parseStatement();
-    std::unique_ptr<CompoundStmtNode> parseCompoundStatement();
+    StmtNode* parseStatement();
+    CompoundStmtNode* parseCompoundStatement();
 
     // 函数和程序解析
-    std::unique_ptr<FunctionDeclNode> parseFunctionDeclaration();
-    std::unique_ptr<StructDeclNode> parseStructDeclaration();
-    std::unique_ptr<VarDeclStmtNode> parseGlobalVarDeclaration();
+    FunctionDeclNode* parseFunctionDeclaration();
+    StructDeclNode* parseStructDeclaration();
+    VarDeclStmtNode* parseGlobalVarDeclaration();
     std::unique_ptr<ProgramNode> parseProgram();
 
     // 声明和特定语句解析功能
-    std::unique_ptr<VarDeclStmtNode> parseVariableDeclaration();
-    std::unique_ptr<ReturnStmtNode> parseReturnStatement();
+    VarDeclStmtNode* parseVariableDeclaration();
+    ReturnStmtNode* parseReturnStatement();
 
     // 控制流语句解析功能
-    std::unique_ptr<IfStmtNode> parseIfStatement();
-    std::unique_ptr<WhileStmtNode> parseWhileStatement();
-    std::unique_ptr<ForStmtNode> parseForStatement();
-    std::unique_ptr<DoWhileStmtNode> parseDoWhileStatement();
-    std::unique_ptr<BreakStmtNode> parseBreakStatement();
-    std::unique_ptr<ContinueStmtNode> parseContinueStatement();
+    IfStmtNode* parseIfStatement();
+    WhileStmtNode* parseWhileStatement();
+    ForStmtNode* parseForStatement();
+    DoWhileStmtNode* parseDoWhileStatement();
+    BreakStmtNode* parseBreakStatement();
+    ContinueStmtNode* parseContinueStatement();
 
 private:
     Lexer& lexer_;            // 词法分析器引用
     Token currentToken_;       // 当前Token
 
+    // 节点都分配在 context_ 的 Arena 中；parseProgram 把它的所有权交给 ProgramNode，
+    // 之后 ctx_ 指向 ProgramNode 持有的同一个 ASTContext
+    std::unique_ptr<ASTContext> context_;
+    ASTContext* ctx_;
+
     // 运算符优先级定义
     enum Precedence {
         PREC_LOWEST = 1,
@@ -71,25 +76,27 @@ private:
 
   
     // 表达式基础解析方法
-    std::unique_ptr<ExprNode> parsePrimary();
-    std::unique_ptr<ExprNode> parseUnary();
-    std::unique_ptr<ExprNode> parseFactor();
-    std::unique_ptr<ExprNode> parseTerm();
-    std::unique_ptr<ExprNode> parseComparison();
-    std::unique_ptr<ExprNode> parseEquality();
-    std::unique_ptr<ExprNode> parseLogicalAnd();
-    std::unique_ptr<ExprNode> parseLogicalOr();
-    std::unique_ptr<ExprNode> parseAssignment();
+    ExprNode* parsePrimary();
+    ExprNode* parseUnary();
+    ExprNode* parseFactor();
+    ExprNode* parseTerm();
+    ExprNode* parseComparison();
+    ExprNode* parseEquality();
+    ExprNode* parseLogicalAnd();
+    ExprNode* parseLogicalOr();
+    ExprNode* parseAssignment();
 
     // 辅助方法
     void advance();                          // 前进到下一个Token
     Token consume(TokenType type, const std::string& message); // 消费指定类型的Token
     bool match(TokenType type);             // 检查并消费Token
     bool isTypeKeyword() const;             // 检查是否是类型关键字
+    const Type* keywordType() const;        // 当前类型关键字（int/void）对应的类型
+    const Type* structType();               // 当前标识符命名的结构体类型（是否已定义由 Sema 检查）
     Precedence getOperatorPrecedence(TokenType op); // 获取运算符优先级
 
     // 函数调用解析
-    std::unique_ptr<FunctionCallNode> parseFunctionCall(const std::string& name);
+    FunctionCallNode* parseFunctionCall(Identifier name);
 };
 
 #endif // PARSER_H
\ No newline at end of file
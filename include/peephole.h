@@ -0,0 +1,86 @@
+#ifndef PEEPHOLE_H
+#define PEEPHOLE_H
+
+#include "vm.h"
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+// peephole.h
+// 窥孔优化：CodeGen 之后、超级指令融合之前的字节码改写（-O1 启用）
+//
+// CodeGen 逐个语法结构生成代码，结构之间会留下冗余序列，例如
+//   i = i + 1;        ->  ... STORE i; LOAD i; POP        （赋值表达式的结果被丢弃）
+//   a[i] = v;         ->  ... ADDPTRD 1; STOREM; LOAD i; LEA a; ADDPTRD 1; LOADM; POP
+//   if (...) continue ->  JZ L; JMP loop; L:
+//   return x; }       ->  RET; ADJSP n; PUSH 0; RET        （RET 之后不可达）
+// 每一轮扫描把删除的指令标记出来，扫描结束后压缩代码、重新计算所有跳转目标和函数入口，
+// 重复直到没有变化。所有改写都保持每个保留下来的地址上的栈深度不变。
+
+// 可以单独关闭的改写规则
+struct PeepholeConfig {
+    bool dead_values = true;     // 纯表达式的结果立即被 POP：整体删除（包括 STOREM 后重新加载赋值结果）
+    bool stack_adjust = true;    // POP / ADJSP / 单个压栈之间的合并，LEA/LEAG 与 ADDPTR 合并
+    bool jumps = true;           // 跳转链、跳到下一条、JZ L; JMP M; L: 反转为 JNZ M、跳到 RET
+    bool unreachable = true;     // JMP / RET / HALT 之后到下一个跳转目标之前的指令
+};
+
+struct PeepholeStats {
+    std::vector<std::pair<std::string, int>> removed_per_function;  // 按函数入口地址排序
+    int rounds = 0;
+
+    int total() const {
+        int sum = 0;
+        for (const auto& [name, count] : removed_per_function) sum += count;
+        return sum;
+    }
+
+    // 累加同一个程序再次优化的结果（-O2 内联之后再做一次）
+    void merge(const PeepholeStats& other) {
+        for (const auto& [name, count] : other.removed_per_function) {
+            auto it = std::find_if(removed_per_function.begin(), removed_per_function.end(),
+                                   [&](const std::pair<std::string, int>& entry) { return entry.first == name; });
+            if (it != removed_per_function.end()) {
+                it->second += count;
+            } else {
+                removed_per_function.push_back({name, count});
+            }
+        }
+        rounds += other.rounds;
+    }
+};
+
+class PeepholeOptimizer {
+public:
+    explicit PeepholeOptimizer(PeepholeConfig config = PeepholeConfig()) : config_(config) {}
+
+    // 必须在超级指令融合之前运行
+    PeepholeStats run(ByteCode& bytecode);
+
+private:
+    PeepholeConfig config_;
+    InstructionBuffer* code_ = nullptr;
+    std::vector<bool> is_label_;
+    std::vector<bool> removed_;
+
+    void collectLabels(const ByteCode& bytecode);
+    // [start + 1, end) 内没有跳转目标，且都还没有被删除
+    bool isStraightLine(int start, int end) const;
+    void remove(int i) { removed_[i] = true; }
+
+    // 各规则：在 code[i] 处匹配成功则改写并返回 true
+    bool removeDeadValue(int i);
+    bool removeStoreReload(int i);
+    bool simplifyStack(int i);
+    bool simplifyJump(int i);
+    bool removeUnreachable(int i);
+
+    // 以 end（不含）结尾、恰好压入一个值且没有副作用的指令序列的起始地址，不存在返回 -1
+    int pureValueStart(int end) const;
+
+    // 删除标记的指令，重新计算跳转目标、函数入口和入口点，并把删除条数计入所属函数
+    void compact(ByteCode& bytecode, PeepholeStats& stats);
+};
+
+#endif // PEEPHOLE_H
@@ -0,0 +1,160 @@
+#ifndef REGVM_H
+#define REGVM_H
+
+#include "vm.h"
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <cstdint>
+
+// regvm.h
+// 寄存器式虚拟机后端
+//
+// "寄存器"就是当前栈帧里的 slot：r[k] = stack[fp + k]。
+// 局部变量、参数（负偏移）和表达式临时值都直接用 slot 编号寻址，
+// 因此栈帧布局、调用约定和栈式 VM 完全一致，指针（LEA 得到的地址）也可以互通。
+//
+// 栈式指令 LOAD a; LOAD b; ADD; STORE c 在这里是一条三地址指令 ADD c, a, b。
+
+// 寄存器指令
+enum class RegOp : uint8_t {
+    // 数据传送
+    MOV,        // r[dst] = r[a]
+    MOVI,       // r[dst] = imm
+
+    // 内存访问
+    LOADM,      // r[dst] = mem[r[a]]
+    STOREM,     // mem[r[a]] = r[b]
+    LOADG,      // r[dst] = globals[imm]
+    STOREG,     // globals[imm] = r[a]
+    MEMCPY,     // 复制 imm 个 slot: mem[r[b]..] = mem[r[a]..]
+    LOADMN,     // r[dst..dst+imm-1] = mem[r[a]..]（按地址从低到高逐个 slot）
+    STOREMN,    // mem[r[a]..] = r[b..b+imm-1]
+
+    // 地址计算
+    LEA,        // r[dst] = 栈基址 + fp + imm
+    LEAG,       // r[dst] = GLOBAL_BASE + imm
+    ADDPTRD,    // r[dst] = r[a] + r[b] * imm
+
+    // 二元运算: r[dst] = r[a] op r[b]
+    ADD, SUB, MUL, DIV, MOD,
+    EQ, NE, LT, LE, GT, GE,
+    AND, OR,
+
+    // 二元运算（右操作数为立即数）: r[dst] = r[a] op imm
+    ADDI, SUBI, MULI, DIVI, MODI,
+    EQI, NEI, LTI, LEI, GTI, GEI,
+    ANDI, ORI,
+
+    // 一元运算
+    NEG,        // r[dst] = -r[a]
+    NOT,        // r[dst] = !r[a]
+
+    // 控制流
+    JMP,        // pc = imm
+    JZ,         // if (r[a] == 0) pc = imm
+    JNZ,        // if (r[a] != 0) pc = imm
+
+    // 函数
+    CALL,       // 新帧从 fp + dst 开始: [ret_addr][old_fp]，fp = fp + dst + 2，pc = imm
+                // a = 被调函数的栈帧大小（用于溢出检查）
+    RET,        // r[imm] = r[a]（写入 ret_slot），恢复 fp 并返回
+    RETI,       // r[imm] = a（返回常量）
+    RETN,       // mem[r[b]..] = mem[r[a]..] 复制 imm 个 slot（结构体返回值写入返回区），恢复 fp 并返回
+
+    // 其他
+    PRINT,      // 打印 r[a]
+    HALT,
+};
+
+// 单条寄存器指令
+// 字段含义因指令而异，见 RegOp 注释
+struct RegInstr {
+    RegOp op;
+    int32_t dst;
+    int32_t a;
+    int32_t b;
+    int32_t imm;
+
+    RegInstr(RegOp o, int32_t d = 0, int32_t x = 0, int32_t y = 0, int32_t i = 0)
+        : op(o), dst(d), a(x), b(y), imm(i) {}
+};
+
+// 寄存器字节码程序
+class RegByteCode {
+public:
+    std::vector<RegInstr> code;
+    std::unordered_map<std::string, int> functions;  // 函数名 -> 地址
+    std::unordered_map<int, int> frame_sizes;        // 函数地址 -> 栈帧大小（slot 数）
+    std::vector<GlobalVarInit> global_inits;
+    int entry_point = -1;
+
+    std::string toString() const;
+};
+
+// 把栈式字节码翻译为寄存器字节码
+//
+// 翻译时静态模拟操作数栈：每个栈位置记录"值在哪里"
+//   - Slot: 值已经在自己的 slot 里（r[位置]）
+//   - Reg:  值是某个变量 r[k] 的别名，尚未复制
+//   - Imm:  值是常量，尚未写入
+// 只有真正需要时（被运算消费、跳转/调用/内存访问前）才生成指令，
+// 这样 LOAD/PUSH 不产生任何指令，STORE 会直接改写上一条指令的目标寄存器。
+class RegisterLowering {
+public:
+    RegByteCode lower(const ByteCode& bytecode);
+
+private:
+    struct StackValue {
+        enum Kind { Slot, Reg, Imm } kind;
+        int32_t value;  // Reg: slot 编号；Imm: 常量值
+    };
+
+    const ByteCode* src_ = nullptr;
+    RegByteCode out_;
+    std::vector<StackValue> stack_;   // 模拟的操作数栈，下标就是相对 fp 的 slot 编号
+    int last_def_ = -1;               // 上一条指令写入的 slot（可以被 STORE 改写目标），-1 表示无效
+
+    // 栈深度分析：每条栈式指令执行前相对 fp 的栈深度（-1 = 不可达）
+    std::vector<int> depth_;
+    std::vector<bool> is_label_;
+    std::unordered_map<int, int> frame_sizes_;  // 函数地址 -> 最大栈深度
+
+    void analyzeDepths();
+
+    void emit(RegOp op, int32_t dst = 0, int32_t a = 0, int32_t b = 0, int32_t imm = 0);
+    void resetStack(int depth);
+
+    // 把位置 pos 上的值写入它自己的 slot
+    void materialize(int pos);
+    // 把所有位置上的值写回 slot（基本块边界、调用、间接内存访问前）
+    void flush();
+    // 把所有引用 r[k] 的别名写回（r[k] 即将被修改）
+    void materializeAliasesOf(int k);
+    // 获取值所在的寄存器（常量会先写入 pos）
+    int operandReg(const StackValue& v, int pos);
+
+    void lowerBinary(OpCode op);
+    void lowerStore(int k);
+};
+
+// 寄存器式虚拟机
+class RegVM {
+private:
+    // 与栈式 VM 相同的线性内存: [空指针][全局区][栈]
+    // CALL 按帧大小显式检查溢出，不登记保护页，只用 VMMemory 按需分配物理内存
+    VMMemory memory_;
+    int stack_size_ = VM::DEFAULT_STACK_SIZE;
+
+public:
+    RegVM() = default;
+
+    // 栈大小（slot 数），范围与 VM::setStackSize 相同
+    void setStackSize(int slots);
+
+    int execute(const RegByteCode& code);
+};
+
+std::string regOpcodeName(RegOp op);
+
+#endif // REGVM_H
@@ -3,50 +3,39 @@
 
 #include "type.h"
 #include <string>
-#include <memory>
 #include <vector>
 #include <unordered_map>
 
 // 符号：代表一个声明的变量或函数
 class Symbol {
 private:
-    std::string name_;
-    std::shared_ptr<Type> type_;
+    const std::string* name_;   // 指向 Scope 索引中的键，地址在 Scope 的生命周期内不变
+    const Type* type_;
 
 public:
-    Symbol(const std::string& name, std::shared_ptr<Type> type)
+    Symbol(const std::string* name, const Type* type)
         : name_(name), type_(type) {}
 
-    const std::string& getName() const { return name_; }
-    std::shared_ptr<Type> getType() const { return type_; }
+    const std::string& getName() const { return *name_; }
+    const Type* getType() const { return type_; }
 };
 
-// 环境：一个作用域内的符号表
-class Env {
-private:
-    std::unordered_map<std::string, std::shared_ptr<Symbol>> symbols_;
-
-public:
-    // 添加符号，返回是否成功（重复声明返回 false）
-    bool addSymbol(std::shared_ptr<Symbol> symbol) {
-        auto [it, inserted] = symbols_.emplace(symbol->getName(), symbol);
-        return inserted;
-    }
-
-    // 在当前环境中查找符号
-    std::shared_ptr<Symbol> findSymbol(const std::string& name) const {
-        auto it = symbols_.find(name);
-        if (it != symbols_.end()) {
-            return it->second;
-        }
-        return nullptr;
-    }
-};
-
-// 作用域管理器：管理嵌套的作用域
+// 作用域管理器：所有作用域共用一个扁平的符号栈
+// - bindings_：按声明顺序排列的符号，每个记录被它遮蔽的同名符号
+// - index_：名字 -> 当前可见的符号在 bindings_ 中的下标（-1 表示没有）
+// - markers_：每个作用域开始时 bindings_ 的大小
+// 进入作用域只记一个位置，退出时弹出这个作用域的符号并恢复被遮蔽的绑定；
+// index_ 中的名字不删除，再次声明同名符号不需要分配内存
 class Scope {
 private:
-    std::vector<std::shared_ptr<Env>> envs_;  // 作用域栈
+    struct Binding {
+        Symbol symbol;
+        int shadowed;   // 被遮蔽的同名符号的下标，-1 表示没有
+    };
+
+    std::vector<Binding> bindings_;
+    std::unordered_map<std::string, int> index_;
+    std::vector<size_t> markers_;
 
 public:
     Scope() {
@@ -56,43 +45,59 @@ public:
 
     // 进入新作用域
     void enterScope() {
-        envs_.push_back(std::make_shared<Env>());
+        markers_.push_back(bindings_.size());
     }
 
     // 退出当前作用域
     void exitScope() {
-        if (envs_.size() > 1) {  // 保留全局作用域
-            envs_.pop_back();
+        if (markers_.size() <= 1) {  // 保留全局作用域
+            return;
+        }
+        size_t marker = markers_.back();
+        markers_.pop_back();
+        while (bindings_.size() > marker) {
+            const Binding& binding = bindings_.back();
+            index_.find(binding.symbol.getName())->second = binding.shadowed;
+            bindings_.pop_back();
         }
     }
 
-    // 在当前作用域添加符号
-    bool addSymbol(const std::string& name, std::shared_ptr<Type> type) {
-        auto symbol = std::make_shared<Symbol>(name, type);
-        return envs_.back()->addSymbol(symbol);
+    // 在当前作用域添加符号，返回是否成功（重复声明返回 false）
+    bool addSymbol(const std::string& name, const Type* type) {
+        auto it = index_.try_emplace(name, -1).first;
+        int current = it->second;
+        if (current >= 0 && static_cast<size_t>(current) >= markers_.back()) {
+            return false;
+        }
+        it->second = static_cast<int>(bindings_.size());
+        bindings_.push_back({Symbol(&it->first, type), current});
+        return true;
     }
 
-    // 在所有作用域中查找符号（从内到外）
-    std::shared_ptr<Symbol> findSymbol(const std::string& name) const {
-        for (auto it = envs_.rbegin(); it != envs_.rend(); ++it) {
-            auto symbol = (*it)->findSymbol(name);
-            if (symbol) {
-                return symbol;
-            }
+    // 在所有作用域中查找符号（最内层的可见绑定）
+    // 返回的指针在下一次 addSymbol / exitScope 之前有效
+    const Symbol* findSymbol(const std::string& name) const {
+        auto it = index_.find(name);
+        if (it == index_.end() || it->second < 0) {
+            return nullptr;
         }
-        return nullptr;
+        return &bindings_[it->second].symbol;
     }
 
     // 仅在当前作用域查找符号
-    std::shared_ptr<Symbol> findSymbolInCurrentScope(const std::string& name) const {
-        return envs_.back()->findSymbol(name);
+    const Symbol* findSymbolInCurrentScope(const std::string& name) const {
+        auto it = index_.find(name);
+        if (it == index_.end() || it->second < 0 || static_cast<size_t>(it->second) < markers_.back()) {
+            return nullptr;
+        }
+        return &bindings_[it->second].symbol;
     }
 
     // 获取当前作用域深度
-    size_t depth() const { return envs_.size(); }
+    size_t depth() const { return markers_.size(); }
 
     // 是否在全局作用域
-    bool isGlobalScope() const { return envs_.size() == 1; }
+    bool isGlobalScope() const { return markers_.size() == 1; }
 };
 
 #endif // SCOPE_H
@@ -21,13 +21,17 @@ class Sema {
 private:
     Scope scope_;
     std::vector<SemanticError> errors_;
-    std::unordered_map<std::string, std::shared_ptr<StructType>> struct_types_;
+    // 已经定义的结构体（类型对象由 Parser 在第一次引用时创建，这里只记录哪些有定义）
+    std::unordered_map<std::string, StructType*> struct_types_;
 
     // 当前正在分析的函数的返回类型
-    std::shared_ptr<Type> current_function_return_type_;
+    const Type* current_function_return_type_ = nullptr;
 
     // 全局符号表（用于检查重复定义）
-    std::unordered_map<std::string, std::shared_ptr<Type>> global_symbols_;
+    std::unordered_map<std::string, const Type*> global_symbols_;
+
+    // 正在分析的程序的类型表：表达式的类型（&x 的指针、函数类型）在这里驻留
+    TypeContext* types_ = nullptr;
 
     void error(const std::string& msg, int line = 0) {
         errors_.emplace_back(msg, line);
@@ -44,7 +48,7 @@ public:
     bool hasErrors() const { return !errors_.empty(); }
 
     // 获取全局符号表（供 CodeGen 使用）
-    const std::unordered_map<std::string, std::shared_ptr<Type>>& getGlobalSymbols() const {
+    const std::unordered_map<std::string, const Type*>& getGlobalSymbols() const {
         return global_symbols_;
     }
 
@@ -70,17 +74,17 @@ private:
     void analyzeExprStatement(ExprStmtNode* stmt);
 
     // 分析表达式，返回表达式的类型
-    std::shared_ptr<Type> analyzeExpression(ExprNode* expr);
-    std::shared_ptr<Type> analyzeVariable(VariableNode* expr);
-    std::shared_ptr<Type> analyzeBinaryOp(BinaryOpNode* expr);
-    std::shared_ptr<Type> analyzeUnaryOp(UnaryOpNode* expr);
-    std::shared_ptr<Type> analyzeFunctionCall(FunctionCallNode* expr);
-    std::shared_ptr<Type> analyzeArrayAccess(ArrayAccessNode* expr);
-    std::shared_ptr<Type> analyzeMemberAccess(MemberAccessNode* expr);
+    const Type* analyzeExpression(ExprNode* expr);
+    const Type* analyzeVariable(VariableNode* expr);
+    const Type* analyzeBinaryOp(BinaryOpNode* expr);
+    const Type* analyzeUnaryOp(UnaryOpNode* expr);
+    const Type* analyzeFunctionCall(FunctionCallNode* expr);
+    const Type* analyzeArrayAccess(ArrayAccessNode* expr);
+    const Type* analyzeMemberAccess(MemberAccessNode* expr);
 
     // 辅助方法
-    std::shared_ptr<Type> stringToType(const std::string& type_name);
-    bool isTypeCompatible(const std::shared_ptr<Type>& left, const std::shared_ptr<Type>& right);
+    bool isDefinedType(const Type* type) const;
+    bool isTypeCompatible(const Type* left, const Type* right);
 
     // ========== 常量表达式检查 (Phase 6) ==========
     // 检查表达式是否是编译时常量
@@ -89,10 +93,10 @@ private:
 
     // ========== 初始化列表检查 (Phase 7) ==========
     // 检查数组初始化列表的合法性
-    void checkArrayInitializer(InitializerListNode* init_list, ArrayType* array_type, bool is_global);
+    void checkArrayInitializer(InitializerListNode* init_list, const ArrayType* array_type, bool is_global);
 
     // 检查结构体初始化列表的合法性
-    void checkStructInitializer(InitializerListNode* init_list, StructType* struct_type, bool is_global);
+    void checkStructInitializer(InitializerListNode* init_list, const StructType* struct_type, bool is_global);
 };
 
 #endif // SEMA_H
@@ -0,0 +1,36 @@
+#ifndef SOURCE_H
+#define SOURCE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// source.h
+// 源文件的只读视图
+//
+// 普通文件用 mmap 整个映射进来，Lexer 和 Token 直接引用映射中的字节，不做任何复制；
+// 空文件、管道等无法映射的输入退回到读入内存。
+// SourceFile 必须比引用它的 Lexer / Token 活得长（AST 中的名字已经驻留，不受影响）。
+// BytecodeFile::load 也用它映射字节码文件，由加载得到的 ByteCode 共同持有。
+
+class SourceFile {
+public:
+    // 打开失败抛出 std::runtime_error
+    explicit SourceFile(const std::string& filename);
+    ~SourceFile();
+
+    SourceFile(const SourceFile&) = delete;
+    SourceFile& operator=(const SourceFile&) = delete;
+
+    std::string_view text() const { return std::string_view(data_, size_); }
+    size_t size() const { return size_; }
+    bool isMapped() const { return mapped_; }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    bool mapped_ = false;
+    std::string buffer_;      // 无法映射时的文件内容
+};
+
+#endif // SOURCE_H
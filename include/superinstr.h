@@ -0,0 +1,51 @@
+#ifndef SUPERINSTR_H
+#define SUPERINSTR_H
+
+#include "vm.h"
+#include <vector>
+
+// superinstr.h
+// 超级指令融合：CodeGen 之后的字节码改写
+//
+// CodeGen 生成的指令序列非常固定，例如
+//   i = i + 1      ->  LOAD i; PUSH 1; ADD; STORE i
+//   while (i < n)  ->  LOAD i; LOAD n; LT; JZ end
+//   arr[i]         ->  LEA arr; ADDPTRD 1; LOADM     (index 已在栈上)
+// 把这些序列改写为一条超级指令，可以省掉多次分派和中间值的压栈/出栈。
+//
+// 融合是原地进行的：超级指令替换序列第一条指令，其余指令保持不变（见 vm.h），
+// 所有地址、跳转目标和函数入口都不需要重新计算。
+// 序列中间如果有跳转目标（除第一条外），则不融合。
+
+// 各模式的融合次数
+struct FusionStats {
+    int inc_local = 0;
+    int jlt_locals = 0;
+    int jlt_local_const = 0;
+    int jle_local_const = 0;
+    int load_idx = 0;
+
+    int total() const {
+        return inc_local + jlt_locals + jlt_local_const + jle_local_const + load_idx;
+    }
+};
+
+class SuperinstructionFusion {
+public:
+    FusionStats run(ByteCode& bytecode);
+
+private:
+    std::vector<bool> is_label_;
+
+    // [start + 1, start + len) 内没有跳转目标
+    bool isStraightLine(int start, int len) const;
+
+    bool matchIncLocal(InstructionBuffer& code, int i);
+    bool matchCompareJump(InstructionBuffer& code, int i, FusionStats& stats);
+    bool matchLoadIdx(InstructionBuffer& code, int i);
+};
+
+// code[pc] 是超级指令时，检查它后面保留的原指令是否与融合模式一致（供字节码校验使用）
+bool isWellFormedSuperinstruction(const InstructionBuffer& code, int pc);
+
+#endif // SUPERINSTR_H
@@ -1,7 +1,9 @@
 #ifndef TOKEN_H
 #define TOKEN_H
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <iostream>
 
 // token.h
@@ -74,16 +76,20 @@ enum class TokenType {
 class Token {
 public:
     // 默认构造函数
-    Token() : type_(TokenType::Invalid), value_(""), line_(1), column_(1) {}
+    Token() : type_(TokenType::Invalid), line_(1), column_(1) {}
 
-    // 构造函数
-    Token(TokenType type, const std::string& value = "", int line = 1, int column = 1);
+    // 构造函数（value 不复制，必须指向比 Token 活得长的内存：源代码、字符串字面量或 Lexer 保存的消息）
+    Token(TokenType type, std::string_view value = {}, int line = 1, int column = 1,
+          int32_t number = 0);
 
     // 获取Token类型
     TokenType getType() const { return type_; }
 
-    // 获取Token的字面值
-    const std::string& getValue() const { return value_; }
+    // 获取Token的字面值（指向源代码的视图）
+    std::string_view getValue() const { return value_; }
+
+    // 获取数字字面量的值（由 Lexer 解析好，Parser 不必再转换）
+    int32_t getNumber() const { return number_; }
 
     // 获取行号
     int getLine() const { return line_; }
@@ -101,10 +107,11 @@ public:
     static std::string typeToString(TokenType type);
 
 private:
-    TokenType type_;      // Token类型
-    std::string value_;   // Token的字面值
-    int line_;           // 行号
-    int column_;         // 列号
+    TokenType type_;          // Token类型
+    int32_t number_ = 0;      // 数字字面量的值
+    std::string_view value_;  // Token的字面值
+    int line_;               // 行号
+    int column_;             // 列号
 };
 
 // Token流输出运算符
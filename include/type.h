@@ -2,9 +2,19 @@
 #define TYPE_H
 
 #include <string>
+#include <map>
 #include <memory>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+// type.h
+// 类型系统
+//
+// 类型对象由 TypeContext 统一创建并驻留（hash-consing）：同一个类型只有一个对象，
+// 类型相等就是指针相等，所有地方都用 const Type* 引用类型，不再复制 shared_ptr。
+// int / void 是全局单例；结构体按名字唯一（名义类型），成员由 Sema 在分析定义时填入。
+
 // 类型种类
 enum class TypeKind {
     Int,        // int
@@ -39,8 +49,8 @@ public:
     virtual int getSlotCount() const { return 1; }
 
     // 预定义的基本类型（单例）
-    static std::shared_ptr<Type> getIntType();
-    static std::shared_ptr<Type> getVoidType();
+    static const Type* getIntType();
+    static const Type* getVoidType();
 };
 
 // 基本类型 (int, void)
@@ -57,49 +67,40 @@ public:
     }
 };
 
-// 函数类型
+// 函数类型（只包含返回类型和参数类型，参数名属于函数声明）
 class FunctionType : public Type {
-public:
-    struct Param {
-        std::shared_ptr<Type> type;
-        std::string name;
-
-        Param(std::shared_ptr<Type> t, const std::string& n)
-            : type(t), name(n) {}
-    };
-
 private:
-    std::shared_ptr<Type> return_type_;
-    std::vector<Param> params_;
+    const Type* return_type_;
+    std::vector<const Type*> params_;
 
 public:
-    FunctionType(std::shared_ptr<Type> ret_type, std::vector<Param> params)
+    FunctionType(const Type* ret_type, std::vector<const Type*> params)
         : Type(TypeKind::Function), return_type_(ret_type), params_(std::move(params)) {}
 
-    std::shared_ptr<Type> getReturnType() const { return return_type_; }
-    const std::vector<Param>& getParams() const { return params_; }
+    const Type* getReturnType() const { return return_type_; }
+    const std::vector<const Type*>& getParams() const { return params_; }
 
     std::string toString() const override {
         std::string result = return_type_->toString() + "(";
         for (size_t i = 0; i < params_.size(); ++i) {
             if (i > 0) result += ", ";
-            result += params_[i].type->toString();
+            result += params_[i]->toString();
         }
         result += ")";
         return result;
     }
 };
 
-// 指针类型 (预留)
+// 指针类型
 class PointerType : public Type {
 private:
-    std::shared_ptr<Type> base_type_;
+    const Type* base_type_;
 
 public:
-    explicit PointerType(std::shared_ptr<Type> base)
+    explicit PointerType(const Type* base)
         : Type(TypeKind::Pointer), base_type_(base) {}
 
-    std::shared_ptr<Type> getBaseType() const { return base_type_; }
+    const Type* getBaseType() const { return base_type_; }
 
     std::string toString() const override {
         return base_type_->toString() + "*";
@@ -109,14 +110,14 @@ public:
 // 数组类型
 class ArrayType : public Type {
 private:
-    std::shared_ptr<Type> element_type_;  // 元素类型
-    int size_;                             // 数组大小
+    const Type* element_type_;  // 元素类型
+    int size_;                  // 数组大小
 
 public:
-    ArrayType(std::shared_ptr<Type> elem, int size)
+    ArrayType(const Type* elem, int size)
         : Type(TypeKind::Array), element_type_(elem), size_(size) {}
 
-    std::shared_ptr<Type> getElementType() const { return element_type_; }
+    const Type* getElementType() const { return element_type_; }
     int getSize() const { return size_; }
 
     // 数组总slot数 = 元素slot数 * 数组大小
@@ -133,49 +134,38 @@ public:
 class StructType : public Type {
 private:
     std::string name_;
-    std::vector<std::pair<std::string, std::shared_ptr<Type>>> members_;
-    mutable int cached_slot_count_ = -1;
+    std::vector<std::pair<std::string, const Type*>> members_;
+    // 布局在 Sema 分析结构体定义、逐个添加成员时算好，之后只读
+    std::vector<int> offsets_;                       // 每个成员的 slot 偏移量，与 members_ 一一对应
+    std::unordered_map<std::string, int> index_;     // 成员名 -> 成员下标
+    int slot_count_ = 0;
 
 public:
     explicit StructType(const std::string& name)
         : Type(TypeKind::Struct), name_(name) {}
 
-    void addMember(const std::string& name, std::shared_ptr<Type> type) {
+    void addMember(const std::string& name, const Type* type) {
+        index_.emplace(name, static_cast<int>(members_.size()));   // 同名成员以第一个为准
         members_.push_back({name, type});
-        cached_slot_count_ = -1;  // 失效缓存
+        offsets_.push_back(slot_count_);
+        slot_count_ += type->getSlotCount();
     }
 
     // 获取结构体占用的总slot数
-    int getSlotCount() const override {
-        if (cached_slot_count_ >= 0) return cached_slot_count_;
-        int total = 0;
-        for (const auto& [name, type] : members_) {
-            total += type->getSlotCount();
-        }
-        cached_slot_count_ = total;
-        return total;
-    }
+    int getSlotCount() const override { return slot_count_; }
 
-    // 获取成员在结构体中的偏移量
-    int getMemberOffset(const std::string& member) const {
-        int offset = 0;
-        for (const auto& [name, type] : members_) {
-            if (name == member) return offset;
-            offset += type->getSlotCount();
-        }
-        throw std::runtime_error("Unknown member: " + member);
+    // 查找成员下标，没有这个成员时返回 -1
+    int findMember(const std::string& member) const {
+        auto it = index_.find(member);
+        return it == index_.end() ? -1 : it->second;
     }
 
-    // 获取成员类型
-    std::shared_ptr<Type> getMemberType(const std::string& member) const {
-        for (const auto& [name, type] : members_) {
-            if (name == member) return type;
-        }
-        return nullptr;
-    }
+    // 按下标获取成员在结构体中的偏移量和类型
+    int getMemberOffset(int index) const { return offsets_[index]; }
+    const Type* getMemberType(int index) const { return members_[index].second; }
 
     const std::string& getName() const { return name_; }
-    const std::vector<std::pair<std::string, std::shared_ptr<Type>>>& getMembers() const {
+    const std::vector<std::pair<std::string, const Type*>>& getMembers() const {
         return members_;
     }
 
@@ -184,4 +174,29 @@ public:
     }
 };
 
+// 类型的创建者和所有者：相同的指针、数组、函数类型只创建一次
+// 由 ASTContext 持有，与 AST 同生命周期（Parser 创建声明中的类型，Sema 创建表达式的类型）
+class TypeContext {
+private:
+    std::vector<std::unique_ptr<Type>> types_;
+    std::unordered_map<const Type*, const PointerType*> pointers_;
+    std::map<std::pair<const Type*, int>, const ArrayType*> arrays_;
+    std::map<std::vector<const Type*>, const FunctionType*> functions_;   // 键：返回类型 + 参数类型
+    std::unordered_map<std::string, StructType*> structs_;
+
+public:
+    TypeContext() = default;
+    TypeContext(const TypeContext&) = delete;
+    TypeContext& operator=(const TypeContext&) = delete;
+
+    const PointerType* getPointerType(const Type* base);
+    const ArrayType* getArrayType(const Type* element, int size);
+    const FunctionType* getFunctionType(const Type* return_type, const std::vector<const Type*>& params);
+
+    // 同名结构体只有一个对象；第一次引用时创建（此时还没有成员），Sema 分析定义时填入成员
+    StructType* getStructType(const std::string& name);
+
+    size_t size() const { return types_.size(); }
+};
+
 #endif // TYPE_H
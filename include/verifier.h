@@ -0,0 +1,66 @@
+#ifndef VERIFIER_H
+#define VERIFIER_H
+
+#include "vm.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+// verifier.h
+// 字节码加载时校验
+//
+// 对每个函数从入口开始遍历所有可达指令，静态证明：
+//   - 跳转目标在代码范围内，不会跳进超级指令中间；CALL 的目标是函数入口
+//   - 每条指令执行前栈上有足够的操作数（相对 fp 的栈深度不会小于 0），
+//     跳转汇合处的栈深度一致；同时得到每个函数的最大栈深度
+//   - LOAD/STORE/LEA/RET 等按帧偏移访问的指令：非负偏移是已经分配的局部变量，
+//     负偏移在 fp-3 到 fp-2-arg_slots 之间（ByteCode::arg_slots）；CALL 之前栈上至少有被调函数的
+//     参数和返回值 slot，入口函数最多一个（VM 只为 main 预留返回值 slot）
+//   - LOADG/STOREG 的偏移在 global_inits 分配的全局数据区内
+//   - 超级指令后面保留的原指令与融合模式一致
+//
+// 通过校验的程序可以用 VM::executeVerified 运行：pop 不再检查下溢（溢出由栈的保护页检测），
+// LOADG/STOREG 不再检查越界。
+// LOADM/STOREM/MEMCPY/LOADMN/STOREMN/RETN 的地址是运行时计算的，仍然保留检查。
+
+class BytecodeVerifier {
+private:
+    std::vector<std::string> errors_;
+    std::unordered_map<int, int> max_depths_;  // 函数入口 -> 最大栈深度（相对 fp 的 slot 数）
+    std::unordered_map<int, int> arg_slots_;   // 函数入口 -> 调用者压入的参数和返回值 slot 数
+    int globals_size_ = 0;
+    const ByteCode* verified_ = nullptr;
+
+    // 每条指令执行前的栈深度（-1 = 未访问），以及哪些地址在超级指令中间
+    std::vector<int> depth_;
+    std::vector<bool> inside_fused_;
+    // verifyFunction 的工作区：当前函数访问过的地址的栈深度，函数校验完后恢复为 -1，
+    // 每个函数的开销与它的指令数成正比，而不是与整个程序的指令数成正比
+    std::vector<int> function_depth_;
+
+    void error(const std::string& msg) {
+        errors_.push_back(msg);
+    }
+
+    bool checkFusedOperands(const InstructionBuffer& code, int pc);
+    bool checkTarget(const ByteCode& bytecode, int pc, int target);
+    void verifyFunction(const ByteCode& bytecode, const std::string& name, int entry);
+
+public:
+    // 校验整个程序，返回是否通过
+    bool verify(const ByteCode& bytecode);
+
+    const std::vector<std::string>& getErrors() const { return errors_; }
+
+    // 是否已通过校验（必须是同一个 ByteCode 对象，校验之后不能再修改）
+    bool isVerified(const ByteCode& bytecode) const {
+        return verified_ == &bytecode && errors_.empty();
+    }
+
+    const std::unordered_map<int, int>& getMaxDepths() const { return max_depths_; }
+    // 每条指令执行前相对 fp 的栈深度（-1 = 不可达或超级指令中间）
+    const std::vector<int>& getStackDepths() const { return depth_; }
+    int getGlobalsSize() const { return globals_size_; }
+};
+
+#endif // VERIFIER_H
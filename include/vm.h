@@ -1,8 +1,10 @@
 #ifndef VM_H
 #define VM_H
 
+#include "vm_memory.h"
 #include <vector>
 #include <string>
+#include <memory>
 #include <unordered_map>
 #include <cstdint>
 
@@ -15,8 +17,8 @@ enum class OpCode : uint8_t {
     // 变量操作
     LOAD,       // 加载局部变量: push(stack[fp + operand])
     STORE,      // 存储局部变量: stack[fp + operand] = pop()
-    LOADM,      // 内存加载: addr = pop(); push(stack[addr] 或 globals_[addr - GLOBAL_BASE])
-    STOREM,     // 内存存储: addr = pop(); value = pop(); stack[addr] 或 globals_[...] = value
+    LOADM,      // 内存加载: addr = pop(); push(memory[addr])
+    STOREM,     // 内存存储: addr = pop(); value = pop(); memory[addr] = value
 
     // 全局变量操作 (Phase 6)
     LOADG,      // 加载全局变量: push(globals_[operand])
@@ -24,7 +26,7 @@ enum class OpCode : uint8_t {
     LEAG,       // 加载全局变量地址: push(GLOBAL_BASE + operand)
 
     // 地址计算
-    LEA,        // 加载有效地址: push(fp + operand)
+    LEA,        // 加载有效地址: push(栈基址 + fp + operand)
     ADDPTR,     // 地址加静态偏移: addr = pop(); push(addr + operand)
     ADDPTRD,    // 地址加动态偏移: base = pop(); index = pop(); push(base + index * operand)
 
@@ -45,17 +47,40 @@ enum class OpCode : uint8_t {
 
     // 函数
     CALL,       // 调用函数
-    RET,        // 返回: operand = ret_slot_offset (相对于 fp)
-                // TODO: 支持 struct 返回值时，需考虑多 slot 写入
+    RET,        // 返回: operand = ret_slot_offset (相对于 fp)，栈顶的单个返回值写入该 slot
+    RETN,       // 块返回（结构体返回值）: dst = pop(); src = pop();
+                // memory[src..src+operand-1] 按地址从低到高复制到调用者预留的返回区 memory[dst..]，
+                // 然后与 RET 相同地恢复栈帧返回（不再写单个返回值）
 
     // 其他
     PRINT,      // 打印栈顶（调试用）
     HALT,       // 停止
     ADJSP,      // 调整栈指针: sp -= operand
-    MEMCPY      // 内存复制: size = operand; dst = pop(); src = pop();
-                // 复制 size 个 slot: stack[dst..dst+size-1] = stack[src..src+size-1]
+    MEMCPY,     // 内存复制: size = operand; dst = pop(); src = pop();
+                // 复制 size 个 slot: memory[dst..dst+size-1] = memory[src..src+size-1]
+    LOADMN,     // 块加载: addr = pop(); 依次压入 memory[addr..addr+operand-1]（结构体取值、传参）
+    STOREMN,    // 块存储: addr = pop(); 栈顶 operand 个值依次存入 memory[addr..addr+operand-1] 并弹出
+                // 两者都按地址从低到高逐个 slot 复制，与逐个 LOADM/STOREM 的结果相同
+
+    // 超级指令（由 SuperinstructionFusion 在 CodeGen 之后生成）
+    // 融合指令替换原序列的第一条，其余原指令原样保留，作为操作数被处理程序读取并跳过，
+    // 因此融合不改变任何指令地址。下面的 [i] 表示序列中第 i 条原指令
+    INCLOCAL,         // LOAD x; PUSH c; ADD; STORE x       -> stack[fp + x] += c
+    JLT_LOCALS,       // LOAD a; LOAD b; LT; JZ t          -> a < b 不成立时跳到 t
+    JLT_LOCAL_CONST,  // LOAD a; PUSH c; LT; JZ t          -> a < c 不成立时跳到 t
+    JLE_LOCAL_CONST,  // LOAD a; PUSH c; LE; JZ t          -> a <= c 不成立时跳到 t
+    LOADIDX           // LEA k; ADDPTRD s; LOADM           -> index = pop(); push(stack[fp + k + index * s])
 };
 
+// 指令总数（新增指令时需同步更新，线索化分派的跳转表依赖它）
+constexpr int OPCODE_COUNT = static_cast<int>(OpCode::LOADIDX) + 1;
+
+// 指令占用的条数：普通指令为 1，超级指令为它替换的原序列长度
+int instructionLength(OpCode op);
+
+// 超级指令替换掉的原序列第一条指令（普通指令返回自身）
+OpCode unfusedOpcode(OpCode op);
+
 // 单条指令
 struct Instruction {
     OpCode op;
@@ -64,6 +89,103 @@ struct Instruction {
     Instruction(OpCode o, int32_t val = 0) : op(o), operand(val) {}
 };
 
+// 指令数组：CodeGen 生成的字节码自己持有指令（std::vector）；
+// 从字节码文件加载时直接引用映射的文件内容，不做复制，第一次修改时才复制一份。
+// 接口与 std::vector 相同的部分保持一致，读取只是一次指针下标访问
+class InstructionBuffer {
+private:
+    std::vector<Instruction> owned_;
+    std::shared_ptr<const void> backing_;   // 引用外部内存时保持其有效（如映射的文件），为空表示自己持有
+    const Instruction* data_ = nullptr;     // 自己持有时等于 owned_.data()
+    size_t size_ = 0;
+
+    void sync() {
+        data_ = owned_.data();
+        size_ = owned_.size();
+    }
+
+    // 引用外部内存时先复制一份，之后才能修改
+    void own() {
+        if (backing_) {
+            owned_.assign(data_, data_ + size_);
+            backing_.reset();
+            sync();
+        }
+    }
+
+public:
+    InstructionBuffer() = default;
+    InstructionBuffer(const InstructionBuffer& other)
+        : owned_(other.owned_), backing_(other.backing_), data_(other.data_), size_(other.size_) {
+        if (!backing_) sync();
+    }
+    InstructionBuffer& operator=(const InstructionBuffer& other) {
+        owned_ = other.owned_;
+        backing_ = other.backing_;
+        data_ = other.data_;
+        size_ = other.size_;
+        if (!backing_) sync();
+        return *this;
+    }
+    InstructionBuffer(InstructionBuffer&& other) noexcept
+        : owned_(std::move(other.owned_)), backing_(std::move(other.backing_)), data_(other.data_), size_(other.size_) {
+        if (!backing_) sync();
+        other.sync();
+    }
+    InstructionBuffer& operator=(InstructionBuffer&& other) noexcept {
+        owned_ = std::move(other.owned_);
+        backing_ = std::move(other.backing_);
+        data_ = other.data_;
+        size_ = other.size_;
+        if (!backing_) sync();
+        other.sync();
+        return *this;
+    }
+
+    // 引用外部的 count 条指令（data 按 Instruction 对齐），backing 负责保持这段内存有效
+    void borrow(const Instruction* data, size_t count, std::shared_ptr<const void> backing) {
+        owned_.clear();
+        backing_ = std::move(backing);
+        data_ = data;
+        size_ = count;
+    }
+    bool isBorrowed() const { return backing_ != nullptr; }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    const Instruction* data() const { return data_; }
+    const Instruction& operator[](size_t i) const { return data_[i]; }
+    const Instruction& back() const { return data_[size_ - 1]; }
+    const Instruction* begin() const { return data_; }
+    const Instruction* end() const { return data_ + size_; }
+
+    Instruction& operator[](size_t i) { own(); return owned_[i]; }
+    Instruction* begin() { own(); return owned_.data(); }
+    Instruction* end() { own(); return owned_.data() + owned_.size(); }
+
+    template <typename... Args>
+    void emplace_back(Args&&... args) {
+        own();
+        owned_.emplace_back(std::forward<Args>(args)...);
+        sync();
+    }
+
+    // 只保留前 count 条指令
+    void truncate(size_t count) {
+        own();
+        owned_.erase(owned_.begin() + count, owned_.end());
+        sync();
+    }
+};
+
+// 指令对操作数栈的影响：先弹出 pops 个值，再压入 pushes 个值
+// 超级指令按整体计算；RET 是否弹出返回值取决于运行时栈深度，这里记为 0；RETN 弹出两个地址
+struct StackEffect {
+    int pops;
+    int pushes;
+};
+StackEffect stackEffect(const Instruction& instr);
+
 // 全局变量初始化信息 (Phase 6)
 struct GlobalVarInit {
     int offset;           // 全局变量偏移
@@ -75,7 +197,7 @@ struct GlobalVarInit {
     // 支持：
     //   - 单值：{42} → int x = 42;
     //   - 多值：{1, 2, 3} → int arr[3] = {1, 2, 3};
-    //   - 指针：{GLOBAL_BASE + offset} → int *p = &global_x;
+    //   - 指针：{GLOBAL_BASE + offset} → int *p = &global_x;（全局区位置固定，地址在编译时确定）
     //   - 结构体：{10, 20} → struct Point p = {10, 20};
 
     GlobalVarInit() : offset(0), slot_count(0) {}
@@ -84,8 +206,10 @@ struct GlobalVarInit {
 // 字节码程序
 class ByteCode {
 public:
-    std::vector<Instruction> code;
+    InstructionBuffer code;
     std::unordered_map<std::string, int> functions;  // 函数名 -> 地址
+    // 函数名 -> 调用者压入的参数和返回值 slot 数：函数可以访问 fp-3 到 fp-2-arg_slots（校验器据此检查负偏移）
+    std::unordered_map<std::string, int> arg_slots;
     std::vector<GlobalVarInit> global_inits;         // 全局变量初始化信息 (Phase 6)
     int entry_point = -1;
 
@@ -102,33 +226,137 @@ public:
     std::string toString() const;
 };
 
+// 指令分派方式
+enum class DispatchMode {
+    Switch,     // 每条指令经过一次 switch 分派（所有编译器可用）
+    Threaded,   // 直接线索化：预先把字节码翻译成处理程序地址流，
+                // 用 computed goto 跳转（仅 GCC/Clang，其他编译器回退到 Switch）
+};
+
+class BytecodeVerifier;
+class JitProgram;
+
 // 栈式虚拟机
+//
+// 全局区和栈共用一段线性内存（vm_memory.h），指针就是内存下标：
+//   地址 0                         空指针，不能访问
+//   GLOBAL_BASE ...                全局区，全局变量 offset 的地址是 GLOBAL_BASE + offset
+//   stackBase() ...                栈，sp/fp 是相对栈基址的下标，LEA 得到 栈基址 + fp + operand
+// 全局区的位置固定，全局变量的地址在编译时就能确定（LEAG、全局指针的初值）；
+// 栈基址取决于全局区大小，对同一个程序也是固定的。
 class VM {
 public:
-    static const int GLOBAL_BASE = 0x40000000;  // 全局变量地址基址（Phase 6）
+    static const int GLOBAL_BASE = 1;   // 全局区起始地址（0 留给空指针）
+    static const int DEFAULT_STACK_SIZE = 4096;
+    static const int MAX_STACK_SIZE = 1 << 30;
 
-private:
-    static const int STACK_SIZE = 4096;
+    // 程序的栈基址：GLOBAL_BASE + 全局区大小
+    static int stackBase(const std::vector<GlobalVarInit>& global_inits);
 
-    std::vector<int32_t> stack_;
-    std::vector<int32_t> globals_;  // 全局变量存储区（Phase 6）
+private:
+    VMMemory memory_;               // 线性内存，越过栈顶由保护页检测
+    int32_t* globals_ = nullptr;    // memory_ + GLOBAL_BASE
+    int32_t* stack_ = nullptr;      // memory_ + stack_base_
+    int global_slots_ = 0;
+    int stack_base_ = 0;
+    int stack_size_ = DEFAULT_STACK_SIZE;
     int sp_ = 0;    // 栈指针
     int fp_ = 0;    // 帧指针
     int pc_ = 0;    // 程序计数器
     bool running_ = false;
     bool debug_ = false;
+    DispatchMode dispatch_ = defaultDispatchMode();
+    bool tos_cache_ = false;
+
+    // 线索化分派时每条指令的处理程序地址（成员而不是主循环的局部变量：
+    // 保护页触发时 siglongjmp 会越过主循环的栈帧，其中不能有需要析构的对象）
+    std::vector<const void*> threaded_targets_;
 
 public:
-    VM() : stack_(STACK_SIZE, 0) {}
+    VM() = default;
 
     int execute(const ByteCode& code);
+
+    // 执行已通过 BytecodeVerifier 校验的程序：去掉校验已经证明不会发生的运行时检查
+    int executeVerified(const ByteCode& code, const BytecodeVerifier& verifier);
+
+    // 执行 JIT 编译好的机器码（栈帧布局与解释器相同，结束后 VM 状态也相同）
+    int executeJit(const JitProgram& program);
     void setDebug(bool d) { debug_ = d; }
+    void setDispatchMode(DispatchMode mode) { dispatch_ = mode; }
+    DispatchMode getDispatchMode() const { return dispatch_; }
+    // 栈顶缓存：sp/fp/pc 和栈顶元素放在局部变量里（调试模式下不生效）
+    void setTosCache(bool enable) { tos_cache_ = enable; }
+    bool getTosCache() const { return tos_cache_; }
+    // 栈大小（slot 数），最大 MAX_STACK_SIZE；下一次执行时按它分配内存（取整到整页，多出的部分留给栈）
+    void setStackSize(int slots);
+    int getStackSize() const { return stack_size_; }
+
+    // 当前编译器是否支持 computed goto（决定 Threaded 是否真正生效）
+    static bool supportsThreadedDispatch();
+    static DispatchMode defaultDispatchMode() {
+        return supportsThreadedDispatch() ? DispatchMode::Threaded : DispatchMode::Switch;
+    }
 
 private:
+    // JIT 生成的代码通过它调用 copyMemory
+    friend struct JitRuntime;
+
+    // 溢出不在这里检查，由栈上方的保护页捕获
     void push(int32_t val);
+    // Checked = false 时不检查下溢（仅用于校验过的程序）
+    template <bool Checked = true>
     int32_t pop();
+
+    // 按全局区大小分配内存，初始化全局区和模拟 main 调用的栈帧
+    void setup(const ByteCode& bytecode);
+
+    // 栈上可用的 slot 数（内存取整到整页后多出的部分也属于栈）
+    int stackCapacity() const { return memory_.size() - stack_base_; }
+    // addr 是否在内存中（全局区或栈，不含空指针）：一次无符号比较
+    bool validAddress(int32_t addr) const {
+        return static_cast<uint32_t>(addr) - GLOBAL_BASE < static_cast<uint32_t>(memory_.size() - GLOBAL_BASE);
+    }
+
+    // [addr, addr + size) 是否整个在内存中：与 validAddress 相同，一次无符号比较
+    bool validRange(int32_t addr, int32_t size) const {
+        return size >= 0 && static_cast<uint32_t>(addr) - GLOBAL_BASE + static_cast<uint64_t>(size) <=
+                                static_cast<uint64_t>(memory_.size() - GLOBAL_BASE);
+    }
+
+    // 复制 size 个 slot（MEMCPY），区间可以重叠
+    void copyMemory(int32_t src, int32_t dst, int32_t size);
+    // LOADMN：memory[addr..] 的 size 个 slot 复制到 stack[sp..]（检查越界和栈溢出）
+    void loadBlock(int32_t addr, int32_t size, int sp);
+    // STOREMN：stack[sp..] 的 size 个 slot 复制到 memory[addr..]（检查越界）
+    void storeBlock(int32_t addr, int32_t size, int sp);
+    // RETN：memory[src..] 的 size 个 slot 按地址从低到高复制到 memory[dst..]（检查越界）
+    void returnBlock(int32_t src, int32_t dst, int32_t size);
+    static void checkJumpTargets(const ByteCode& bytecode);
+
+    // 登记内存的保护页后执行 body：上方保护页被访问时跳回这里，抛出 "Stack overflow"
+    template <typename Body>
+    int guarded(Body&& body);
+
+    // 按 debug_/tos_cache_/dispatch_ 选择主循环
+    template <bool Checked>
+    int dispatch(const ByteCode& bytecode);
+
+    // 解释器主循环
+    // Threaded: 使用预翻译的处理程序地址流分派（需要 computed goto 支持）
+    // Trace:    每条指令打印调试信息（仅 -d 模式使用，避免正常运行时每条指令检查 debug_）
+    // Checked:  是否做栈下溢、全局偏移检查（false 仅用于校验过的程序；溢出总是由保护页检测）
+    template <bool Threaded, bool Trace, bool Checked>
+    int run(const ByteCode& bytecode);
+
+    // 栈顶缓存版本的主循环：sp/fp/pc 是局部变量，栈顶元素保存在局部变量 tos 中，
+    // 只在执行结束时写回成员
+    template <bool Threaded, bool Checked>
+    int runCached(const ByteCode& bytecode);
 };
 
 std::string opcodeName(OpCode op);
+// 单条指令的文本形式（没有操作数的指令不打印操作数）
+std::string formatInstruction(const Instruction& instr);
 
 #endif // VM_H
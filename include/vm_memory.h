@@ -0,0 +1,57 @@
+#ifndef VM_MEMORY_H
+#define VM_MEMORY_H
+
+#include <csetjmp>
+#include <cstddef>
+#include <cstdint>
+
+// vm_memory.h
+// VM 的线性内存：全局区和栈在同一段连续的 slot 数组里，地址就是数组下标
+//
+//   [保护页][0: 空指针][全局区 GLOBAL_BASE ...][栈 ...][保护页]
+//
+// 用 mmap 分配，两端各有一页不可访问的保护页（guard page）。
+// 栈在最上面，解释器只通过 push 一个 slot 一个 slot 地增长栈，越过栈顶一定先碰到上方的保护页，
+// 硬件产生 SIGSEGV，信号处理函数跳回执行入口报告 "Stack overflow"，
+// 因此 push 不需要每次比较栈指针。
+//
+// 大小以 slot 计，向上取整到整页，多出的部分留给栈。映射使用 MAP_NORESERVE，
+// 物理内存在第一次访问时才分配，栈设得很大也只占用实际用到的部分，深递归时逐页增长。
+class VMMemory {
+public:
+    // 保护页触发时 siglongjmp 的返回值
+    static constexpr int OVERFLOW_JUMP = 1;     // 上方保护页：栈溢出
+    static constexpr int OUT_OF_RANGE_JUMP = 2; // 下方保护页：地址 0 以下
+
+    VMMemory() = default;
+    ~VMMemory();
+    VMMemory(const VMMemory&) = delete;
+    VMMemory& operator=(const VMMemory&) = delete;
+
+    // 重新分配（原有内容丢弃；取整后大小不变时什么也不做），slots 必须为正，失败抛出 std::runtime_error
+    void resize(int slots);
+
+    int32_t* data() const { return data_; }
+    int size() const { return size_; }
+    int32_t& operator[](int i) const { return data_[i]; }
+
+    // 在当前线程上登记保护页：之后访问保护页会 siglongjmp(*env, OVERFLOW_JUMP / OUT_OF_RANGE_JUMP)，
+    // 跳转前自动解除登记。env 必须在登记期间一直有效（由调用 sigsetjmp 的函数持有）
+    void arm(sigjmp_buf* env);
+    void disarm();
+
+private:
+    char* mapping_ = nullptr;   // 整个映射，包括两端的保护页
+    size_t mapping_bytes_ = 0;
+    int32_t* data_ = nullptr;
+    int size_ = 0;
+    sigjmp_buf* env_ = nullptr;
+    VMMemory* previous_ = nullptr;  // 登记前当前线程上登记的内存
+
+    void release();
+
+    // SIGSEGV 处理函数（vm_memory.cpp）
+    friend struct VMMemorySignal;
+};
+
+#endif // VM_MEMORY_H
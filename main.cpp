@@ -3,10 +3,23 @@
 #include "include/sema.h"
 #include "include/codegen.h"
 #include "include/vm.h"
+#include "include/regvm.h"
+#include "include/superinstr.h"
+#include "include/peephole.h"
+#include "include/inliner.h"
+#include "include/verifier.h"
+#include "include/jit.h"
+#include "include/cbackend.h"
+#include "include/bytecode_file.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <chrono>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <sys/resource.h>
 
 void printUsage(const char* program) {
     std::cout << "SimpleC 编译器\n";
@@ -19,20 +32,23 @@ void printUsage(const char* program) {
     std::cout << "  -c, --code       显示生成的字节码\n";
     std::cout << "  -d, --debug      调试模式运行\n";
     std::cout << "  -b, --benchmark  性能测试模式\n";
+    std::cout << "  --emit-c         翻译成 C 源文件（AOT，用系统 cc 编译为原生程序）\n";
+    std::cout << "  --emit-bc        编译并保存字节码文件，之后用 --run-bc 直接执行\n";
+    std::cout << "  -o <文件>        --emit-c / --emit-bc 的输出文件（默认 <源文件名>.gen.c / <源文件名>.bc）\n";
+    std::cout << "  --run-bc         输入是 --emit-bc 生成的字节码文件，跳过前端直接执行\n";
+    std::cout << "  --cache-dir=<d>  字节码缓存目录：按源代码内容哈希保存编译结果，内容不变时跳过前端\n";
+    std::cout << "  --dispatch=<m>   VM 指令分派方式: switch | threaded（默认 threaded，编译器不支持时回退 switch）\n";
+    std::cout << "  --backend=<b>    执行后端: stack（栈式 VM，默认）| register（寄存器式 VM）\n";
+    std::cout << "  -O0 / -O1 / -O2  优化级别：-O1 做常量折叠/传播和窥孔优化，-O2 再内联小的叶子函数（默认 -O0）\n";
+    std::cout << "  --no-fuse        不做超级指令融合（栈式 VM 默认融合）\n";
+    std::cout << "  --tos-cache      栈式 VM 使用栈顶缓存（栈顶和 sp/fp/pc 放在局部变量中）\n";
+    std::cout << "  --verify         加载时校验字节码，通过后去掉冗余的运行时检查执行\n";
+    std::cout << "  --stack-size=<n> 栈式 VM 的栈大小（slot 数，默认 4096），深递归时调大\n";
+    std::cout << "  --jit            校验后把字节码编译成 x86-64 机器码执行（其他平台回退解释器）\n";
     std::cout << "  -h, --help       显示帮助信息\n";
 }
 
-std::string readFile(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        throw std::runtime_error("无法打开文件: " + filename);
-    }
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    return buffer.str();
-}
-
-void runLexer(const std::string& source) {
+void runLexer(std::string_view source) {
     std::cout << "=== 词法分析结果 ===\n\n";
     Lexer lexer(source);
 
@@ -46,7 +62,7 @@ void runLexer(const std::string& source) {
     std::cout << "\n共识别 " << count << " 个Token\n";
 }
 
-void runParser(const std::string& source) {
+void runParser(std::string_view source) {
     std::cout << "=== 语法分析结果 ===\n\n";
     Lexer lexer(source);
     Parser parser(lexer);
@@ -58,17 +74,17 @@ void runParser(const std::string& source) {
     const auto& functions = program->getFunctions();
     std::cout << "识别到 " << functions.size() << " 个函数:\n";
     for (const auto& func : functions) {
-        std::cout << "  - " << func->getReturnType() << " " << func->getName() << "(";
+        std::cout << "  - " << func->getReturnType()->toString() << " " << func->getName() << "(";
         const auto& params = func->getParams();
         for (size_t i = 0; i < params.size(); ++i) {
             if (i > 0) std::cout << ", ";
-            std::cout << params[i].type << " " << params[i].name;
+            std::cout << params[i].type->toString() << " " << params[i].name.str();
         }
         std::cout << ")\n";
     }
 }
 
-void runSema(const std::string& source) {
+void runSema(std::string_view source) {
     std::cout << "=== 语义分析结果 ===\n\n";
     Lexer lexer(source);
     Parser parser(lexer);
@@ -79,11 +95,11 @@ void runSema(const std::string& source) {
     const auto& functions = program->getFunctions();
     std::cout << "识别到 " << functions.size() << " 个函数:\n";
     for (const auto& func : functions) {
-        std::cout << "  - " << func->getReturnType() << " " << func->getName() << "(";
+        std::cout << "  - " << func->getReturnType()->toString() << " " << func->getName() << "(";
         const auto& params = func->getParams();
         for (size_t i = 0; i < params.size(); ++i) {
             if (i > 0) std::cout << ", ";
-            std::cout << params[i].type << " " << params[i].name;
+            std::cout << params[i].type->toString() << " " << params[i].name.str();
         }
         std::cout << ")\n";
     }
@@ -103,7 +119,198 @@ void runSema(const std::string& source) {
     }
 }
 
-enum class Mode { Lexer, Parser, Sema, Run, Code, Benchmark };
+// 进程到目前为止的峰值常驻内存（KB）
+long peakRssKB() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+// 对源代码做 runs 次词法分析（只取 Token），返回最快一次的耗时
+std::chrono::microseconds benchmarkLexer(std::string_view source, bool simd, int runs, size_t& tokens) {
+    auto best = std::chrono::microseconds::max();
+    for (int i = 0; i < runs; ++i) {
+        auto start = std::chrono::high_resolution_clock::now();
+        Lexer lexer(source);
+        lexer.setSimdEnabled(simd);
+        tokens = 0;
+        while (!lexer.getNextToken().is(TokenType::End)) tokens++;
+        auto end = std::chrono::high_resolution_clock::now();
+        best = std::min(best, std::chrono::duration_cast<std::chrono::microseconds>(end - start));
+    }
+    return best;
+}
+
+// 重复执行字节码 runs 次，返回总耗时（用于比较 VM 执行方式）
+// verifier 非空时使用校验过的无检查执行
+std::chrono::microseconds benchmarkVM(const ByteCode& bytecode, DispatchMode dispatch, int runs, int& result,
+                                      bool tos_cache = false, const BytecodeVerifier* verifier = nullptr) {
+    VM vm;
+    vm.setDispatchMode(dispatch);
+    vm.setTosCache(tos_cache);
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < runs; ++i) {
+        result = verifier ? vm.executeVerified(bytecode, *verifier) : vm.execute(bytecode);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+}
+
+// 重复执行 JIT 编译好的程序 runs 次，返回总耗时（不含编译时间）
+std::chrono::microseconds benchmarkJit(const JitProgram& program, int runs, int& result) {
+    VM vm;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < runs; ++i) {
+        result = vm.executeJit(program);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+}
+
+// 重复执行寄存器字节码 runs 次，返回总耗时
+std::chrono::microseconds benchmarkRegVM(const RegByteCode& bytecode, int runs, int& result) {
+    RegVM vm;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < runs; ++i) {
+        result = vm.execute(bytecode);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+}
+
+// AOT：生成 C 文件，用系统 cc -O2 编译后执行 runs 次
+// 返回 false 表示没有可用的 C 编译器或执行失败；成功时 time 为生成程序自己测得的执行时间
+bool benchmarkNative(const std::string& c_source, int runs, int& result, std::chrono::microseconds& time) {
+    namespace fs = std::filesystem;
+    fs::path dir = fs::temp_directory_path();
+    fs::path c_file = dir / "simplec_aot_bench.c";
+    fs::path binary = dir / "simplec_aot_bench";
+    {
+        std::ofstream out(c_file);
+        out << c_source;
+    }
+    std::string compile = "cc -O2 -o \"" + binary.string() + "\" \"" + c_file.string() + "\" 2>/dev/null";
+    if (std::system(compile.c_str()) != 0) {
+        return false;
+    }
+
+    std::string command = "\"" + binary.string() + "\" " + std::to_string(runs);
+    FILE* pipe = popen(command.c_str(), "r");
+    if (!pipe) {
+        return false;
+    }
+    bool got_result = false, got_time = false;
+    char line[256];
+    while (fgets(line, sizeof(line), pipe)) {
+        long value = 0;
+        int n = 0;
+        if (std::sscanf(line, "程序返回值: %ld", &value) == 1) {
+            result = (int)value;
+            got_result = true;
+        } else if (std::sscanf(line, "执行 %d 次: %ld", &n, &value) == 2) {
+            time = std::chrono::microseconds(value);
+            got_time = true;
+        }
+    }
+    return pclose(pipe) == 0 && got_result && got_time;
+}
+
+void printFusionStats(const FusionStats& stats) {
+    std::cout << "超级指令融合:   " << stats.total() << " 处"
+              << " (INCLOCAL " << stats.inc_local
+              << ", JLT_LOCALS " << stats.jlt_locals
+              << ", JLT_LOCAL_CONST " << stats.jlt_local_const
+              << ", JLE_LOCAL_CONST " << stats.jle_local_const
+              << ", LOADIDX " << stats.load_idx << ")\n";
+}
+
+void printPeepholeStats(const PeepholeStats& stats) {
+    std::cout << "窥孔优化:       删除 " << stats.total() << " 条指令（" << stats.rounds << " 轮）";
+    const char* sep = " (";
+    for (const auto& [name, count] : stats.removed_per_function) {
+        std::cout << sep << name << " " << count;
+        sep = ", ";
+    }
+    std::cout << (stats.removed_per_function.empty() ? "" : ")") << "\n";
+}
+
+void printInlineStats(const InlineStats& stats) {
+    std::cout << "函数内联:       消除 " << stats.total() << " 次调用";
+    const char* sep = " (";
+    for (const auto& [name, count] : stats.inlined_calls) {
+        std::cout << sep << name << " " << count;
+        sep = ", ";
+    }
+    std::cout << (stats.inlined_calls.empty() ? "" : ")") << "\n";
+}
+
+enum class Mode { Lexer, Parser, Sema, Run, Code, Benchmark, EmitC, EmitBC, RunBC };
+enum class Backend { Stack, Register };
+
+// 执行选项：编译得到的字节码和从字节码文件加载的字节码共用
+struct RunOptions {
+    Backend backend = Backend::Stack;
+    DispatchMode dispatch = VM::defaultDispatchMode();
+    bool debug = false;
+    bool tos_cache = false;
+    bool verify = false;
+    bool jit = false;
+    int stack_size = VM::DEFAULT_STACK_SIZE;
+};
+
+// 执行字节码（栈式 VM 的超级指令融合已经做过）并输出返回值；字节码校验失败时返回 false
+bool runBytecode(const ByteCode& bytecode, RunOptions options) {
+    std::cout << "=== 运行程序 ===\n\n";
+    if (options.backend == Backend::Register) {
+        RegisterLowering lowering;
+        RegByteCode reg_code = lowering.lower(bytecode);
+        RegVM vm;
+        vm.setStackSize(options.stack_size);
+        int result = vm.execute(reg_code);
+        std::cout << "\n程序返回值: " << result << "\n";
+        return true;
+    }
+
+    VM vm;
+    vm.setDebug(options.debug);
+    vm.setDispatchMode(options.dispatch);
+    vm.setTosCache(options.tos_cache);
+    vm.setStackSize(options.stack_size);
+    int result = 0;
+    if (options.jit && !JitCompiler::isSupported()) {
+        std::cout << "当前平台不支持 JIT，使用解释器执行\n";
+        options.jit = false;
+    }
+    if (options.verify || options.jit) {
+        BytecodeVerifier verifier;
+        if (!verifier.verify(bytecode)) {
+            std::cout << "✗ 字节码校验失败:\n";
+            for (const auto& err : verifier.getErrors()) {
+                std::cout << "  错误: " << err << "\n";
+            }
+            return false;
+        }
+        if (options.jit) {
+            JitCompiler compiler;
+            auto jit_program = compiler.compile(bytecode, verifier);
+            result = vm.executeJit(*jit_program);
+        } else {
+            result = vm.executeVerified(bytecode, verifier);
+        }
+    } else {
+        result = vm.execute(bytecode);
+    }
+    std::cout << "\n程序返回值: " << result << "\n";
+    return true;
+}
+
+// 字节码缓存中的文件名：源代码哈希 + 影响生成结果的选项
+std::string bytecodeCachePath(const std::string& cache_dir, uint64_t source_hash, int opt_level, bool fuse) {
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(source_hash));
+    std::string name = std::string(hex) + "-O" + std::to_string(opt_level) + (fuse ? "" : "-nofuse") + ".bc";
+    return (std::filesystem::path(cache_dir) / name).string();
+}
 
 int main(int argc, char* argv[]) {
     if (argc < 2) {
@@ -114,6 +321,16 @@ int main(int argc, char* argv[]) {
     std::string filename;
     Mode mode = Mode::Run;  // 默认编译运行
     bool debug = false;
+    DispatchMode dispatch = VM::defaultDispatchMode();
+    Backend backend = Backend::Stack;
+    bool fuse = true;
+    bool tos_cache = false;
+    bool verify = false;
+    bool jit = false;
+    int stack_size = VM::DEFAULT_STACK_SIZE;
+    int opt_level = 0;
+    std::string output_file;
+    std::string cache_dir;
 
     for (int i = 1; i < argc; ++i) {
         std::string arg = argv[i];
@@ -134,6 +351,47 @@ int main(int argc, char* argv[]) {
             mode = Mode::Benchmark;
         } else if (arg == "-d" || arg == "--debug") {
             debug = true;
+        } else if (arg == "--dispatch=switch") {
+            dispatch = DispatchMode::Switch;
+        } else if (arg == "--dispatch=threaded") {
+            dispatch = DispatchMode::Threaded;
+        } else if (arg == "--backend=stack") {
+            backend = Backend::Stack;
+        } else if (arg == "--backend=register") {
+            backend = Backend::Register;
+        } else if (arg == "-O0" || arg == "-O1" || arg == "-O2") {
+            opt_level = arg[2] - '0';
+        } else if (arg == "--no-fuse") {
+            fuse = false;
+        } else if (arg == "--tos-cache") {
+            tos_cache = true;
+        } else if (arg == "--verify") {
+            verify = true;
+        } else if (arg == "--jit") {
+            jit = true;
+        } else if (arg == "--emit-c") {
+            mode = Mode::EmitC;
+        } else if (arg == "--emit-bc") {
+            mode = Mode::EmitBC;
+        } else if (arg == "--run-bc") {
+            mode = Mode::RunBC;
+        } else if (arg.rfind("--stack-size=", 0) == 0) {
+            // 整个值都必须是数字：1e9、4096abc 不能当成 1、4096
+            std::string value = arg.substr(13);
+            size_t used = 0;
+            try {
+                stack_size = std::stoi(value, &used);
+            } catch (const std::exception&) {
+                used = 0;
+            }
+            if (used == 0 || used != value.size()) {
+                std::cerr << "错误: 无效的栈大小: " << value << "\n";
+                return 1;
+            }
+        } else if (arg.rfind("--cache-dir=", 0) == 0) {
+            cache_dir = arg.substr(12);
+        } else if (arg == "-o" && i + 1 < argc) {
+            output_file = argv[++i];
         } else if (arg[0] != '-') {
             filename = arg;
         }
@@ -145,8 +403,31 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
+    RunOptions run_options;
+    run_options.backend = backend;
+    run_options.dispatch = dispatch;
+    run_options.debug = debug;
+    run_options.tos_cache = tos_cache;
+    run_options.verify = verify;
+    run_options.jit = jit;
+    run_options.stack_size = stack_size;
+
     try {
-        std::string source = readFile(filename);
+        if (mode == Mode::RunBC) {
+            ByteCode bytecode = BytecodeFile::load(filename);
+            std::cout << "字节码文件: " << filename << "（" << bytecode.code.size() << " 条指令"
+                      << (bytecode.code.isBorrowed() ? "，直接引用映射的文件" : "") << "）\n";
+            std::cout << "----------------------------------------\n\n";
+            if (!runBytecode(bytecode, run_options)) {
+                return 1;
+            }
+            std::cout << "\n✓ 完成\n";
+            return 0;
+        }
+
+        // 源文件映射到内存，Lexer 和 Token 直接引用其中的字节
+        SourceFile source_file(filename);
+        std::string_view source = source_file.text();
 
         std::cout << "源文件: " << filename << "\n";
         std::cout << "----------------------------------------\n";
@@ -163,39 +444,89 @@ int main(int argc, char* argv[]) {
             case Mode::Sema:
                 runSema(source);
                 break;
+            case Mode::RunBC:
+                break;  // 在读取源文件之前已经处理
             case Mode::Benchmark: {
                 std::cout << "=== 性能测试模式 ===\n\n";
 
-                // 测试 Lexer + Parser
-                auto start_parse = std::chrono::high_resolution_clock::now();
-                Lexer lexer1(source);
-                Parser parser1(lexer1);
-                auto program = parser1.parseProgram();
-                auto end_parse = std::chrono::high_resolution_clock::now();
-                auto parse_time = std::chrono::duration_cast<std::chrono::microseconds>(end_parse - start_parse);
+                // 前端各阶段重复执行，取最快的一次（单次计时受缓存和调度影响很大）
+                const int frontend_runs = 5;
+                using Micros = std::chrono::microseconds;
+
+                // 单独测试 Lexer 吞吐：只取 Token，不建 AST
+                // 第一组扫描已经映射好的源代码，第二组每次重新打开并映射文件
+                Micros lex_time = Micros::max();
+                Micros lex_file_time = Micros::max();
+                size_t token_count = 0;
+                for (int run = 0; run < frontend_runs; ++run) {
+                    auto start_lex = std::chrono::high_resolution_clock::now();
+                    Lexer lexer0(source);
+                    token_count = 0;
+                    while (!lexer0.getNextToken().is(TokenType::End)) token_count++;
+                    auto end_lex = std::chrono::high_resolution_clock::now();
+                    lex_time = std::min(lex_time, std::chrono::duration_cast<Micros>(end_lex - start_lex));
+
+                    auto start_file = std::chrono::high_resolution_clock::now();
+                    Lexer file_lexer(filename.c_str());
+                    while (!file_lexer.getNextToken().is(TokenType::End)) {}
+                    auto end_file = std::chrono::high_resolution_clock::now();
+                    lex_file_time = std::min(lex_file_time, std::chrono::duration_cast<Micros>(end_file - start_file));
+                }
+                // 字节 / 微秒 = MB/s
+                auto throughput = [&](Micros time) {
+                    return source.size() / (double)std::max<long long>(time.count(), 1);
+                };
+                Micros parse_time = Micros::max();
+                Micros sema_time = Micros::max();
+                Micros codegen_time = Micros::max();
+                Micros release_time = Micros::max();
+                size_t chars_scanned = 0;    // 解析过程中 Lexer 扫描的字符数（向前看不重复扫描时等于源代码长度）
+                size_t tokens_scanned = 0;
+                std::unique_ptr<ProgramNode> program;
+                ByteCode bytecode;
+                for (int run = 0; run < frontend_runs; ++run) {
+                    // 释放上一轮的 AST（同时避免两棵树同时存在，影响峰值内存）
+                    if (program) {
+                        auto start_release = std::chrono::high_resolution_clock::now();
+                        program.reset();
+                        auto end_release = std::chrono::high_resolution_clock::now();
+                        release_time = std::min(release_time, std::chrono::duration_cast<Micros>(end_release - start_release));
+                    }
 
-                // 测试 Sema
-                auto start_sema = std::chrono::high_resolution_clock::now();
-                Sema sema;
-                bool sema_success = sema.analyze(program.get());
-                auto end_sema = std::chrono::high_resolution_clock::now();
-                auto sema_time = std::chrono::duration_cast<std::chrono::microseconds>(end_sema - start_sema);
+                    // 测试 Lexer + Parser
+                    auto start_parse = std::chrono::high_resolution_clock::now();
+                    Lexer lexer1(source);
+                    Parser parser1(lexer1);
+                    program = parser1.parseProgram();
+                    auto end_parse = std::chrono::high_resolution_clock::now();
+                    parse_time = std::min(parse_time, std::chrono::duration_cast<Micros>(end_parse - start_parse));
+                    chars_scanned = lexer1.getCharsScanned();
+                    tokens_scanned = lexer1.getTokensScanned();
+
+                    // 测试 Sema
+                    auto start_sema = std::chrono::high_resolution_clock::now();
+                    Sema sema;
+                    bool sema_success = sema.analyze(program.get());
+                    auto end_sema = std::chrono::high_resolution_clock::now();
+                    sema_time = std::min(sema_time, std::chrono::duration_cast<Micros>(end_sema - start_sema));
+
+                    if (!sema_success) {
+                        std::cout << "✗ 语义分析失败\n";
+                        return 1;
+                    }
 
-                if (!sema_success) {
-                    std::cout << "✗ 语义分析失败\n";
-                    return 1;
+                    // 测试 CodeGen
+                    auto start_codegen = std::chrono::high_resolution_clock::now();
+                    CodeGen codegen;
+                    bytecode = codegen.generate(program.get());
+                    auto end_codegen = std::chrono::high_resolution_clock::now();
+                    codegen_time = std::min(codegen_time, std::chrono::duration_cast<Micros>(end_codegen - start_codegen));
                 }
 
-                // 测试 CodeGen
-                auto start_codegen = std::chrono::high_resolution_clock::now();
-                CodeGen codegen;
-                ByteCode bytecode = codegen.generate(program.get());
-                auto end_codegen = std::chrono::high_resolution_clock::now();
-                auto codegen_time = std::chrono::duration_cast<std::chrono::microseconds>(end_codegen - start_codegen);
-
                 // 测试 VM
                 auto start_vm = std::chrono::high_resolution_clock::now();
                 VM vm;
+                vm.setDispatchMode(dispatch);
                 int result = vm.execute(bytecode);
                 auto end_vm = std::chrono::high_resolution_clock::now();
                 auto vm_time = std::chrono::duration_cast<std::chrono::microseconds>(end_vm - start_vm);
@@ -204,20 +535,344 @@ int main(int argc, char* argv[]) {
                 auto total_time = parse_time + sema_time + codegen_time + vm_time;
 
                 // 输出结果
-                std::cout << "性能测试结果:\n";
+                std::cout << "性能测试结果（前端取 " << frontend_runs << " 次中最快）:\n";
                 std::cout << "----------------------------------------\n";
+                std::cout << "Lexer:          " << lex_time.count() << " μs（" << token_count << " 个 Token，"
+                          << throughput(lex_time) << " MB/s）\n";
+                std::cout << "映射 + Lexer:   " << lex_file_time.count() << " μs（"
+                          << throughput(lex_file_time) << " MB/s）\n";
                 std::cout << "Lexer + Parser: " << parse_time.count() << " μs\n";
+                std::cout << "Parser 扫描:    " << chars_scanned << " 字符 / " << tokens_scanned << " 个 Token（每 Token "
+                          << chars_scanned / (double)std::max<size_t>(tokens_scanned, 1) << " 字符，源代码 "
+                          << source.size() << " 字符）\n";
                 std::cout << "Sema:           " << sema_time.count() << " μs\n";
                 std::cout << "CodeGen:        " << codegen_time.count() << " μs\n";
                 std::cout << "VM:             " << vm_time.count() << " μs\n";
                 std::cout << "----------------------------------------\n";
                 std::cout << "总编译时间:     " << (parse_time + sema_time + codegen_time).count() << " μs\n";
                 std::cout << "总执行时间:     " << total_time.count() << " μs\n";
+                std::cout << "AST 释放:       " << release_time.count() << " μs\n";
+                std::cout << "峰值内存 (RSS): " << peakRssKB() << " KB\n";
+                std::cout << "AST Arena:      " << program->getContext().getArena().bytesAllocated() / 1024
+                          << " KB（" << program->getContext().getArena().blockCount() << " 块，"
+                          << program->getContext().getIdentifierCount() << " 个标识符，"
+                          << program->getContext().getTypeCount() << " 个复合类型）\n";
                 std::cout << "程序返回值:     " << result << "\n";
+
+                // Lexer 扫描方式对比：逐字节查表 vs SSE2 一次 16 字节
+                size_t scalar_tokens = 0;
+                size_t simd_tokens = 0;
+                auto scalar_lex_time = benchmarkLexer(source, false, frontend_runs, scalar_tokens);
+                auto simd_lex_time = benchmarkLexer(source, true, frontend_runs, simd_tokens);
+
+                std::cout << "\nLexer 扫描方式对比 (各 " << frontend_runs << " 次取最快):\n";
+                std::cout << "----------------------------------------\n";
+                std::cout << "逐字节:         " << scalar_lex_time.count() << " μs（" << throughput(scalar_lex_time) << " MB/s）\n";
+                std::cout << "SSE2:           " << simd_lex_time.count() << " μs（" << throughput(simd_lex_time) << " MB/s）";
+                if (!Lexer::supportsSimd()) {
+                    std::cout << " (平台不支持 SSE2，已回退逐字节扫描)";
+                }
+                std::cout << "\n";
+                if (simd_lex_time.count() > 0) {
+                    std::cout << "加速比:         "
+                              << (double)scalar_lex_time.count() / simd_lex_time.count() << "x\n";
+                }
+                if (scalar_tokens != simd_tokens) {
+                    std::cout << "✗ 两种扫描方式得到的 Token 数不同\n";
+                    return 1;
+                }
+
+                // VM 分派方式对比：重复执行以放大解释器开销
+                const int vm_runs = 1000;
+                int switch_result = 0;
+                int threaded_result = 0;
+                auto switch_time = benchmarkVM(bytecode, DispatchMode::Switch, vm_runs, switch_result);
+                auto threaded_time = benchmarkVM(bytecode, DispatchMode::Threaded, vm_runs, threaded_result);
+
+                std::cout << "\nVM 分派方式对比 (各执行 " << vm_runs << " 次):\n";
+                std::cout << "----------------------------------------\n";
+                std::cout << "switch:         " << switch_time.count() << " μs\n";
+                std::cout << "threaded:       " << threaded_time.count() << " μs";
+                if (!VM::supportsThreadedDispatch()) {
+                    std::cout << " (编译器不支持 computed goto，已回退 switch)";
+                }
+                std::cout << "\n";
+                if (threaded_time.count() > 0) {
+                    std::cout << "加速比:         "
+                              << (double)switch_time.count() / threaded_time.count() << "x\n";
+                }
+                if (switch_result != threaded_result) {
+                    std::cout << "✗ 两种分派方式结果不一致: " << switch_result
+                              << " vs " << threaded_result << "\n";
+                    return 1;
+                }
+
+                // 栈顶缓存：同样的字节码，栈顶和 sp/fp/pc 放在局部变量里
+                int cached_result = 0;
+                auto cached_time = benchmarkVM(bytecode, VM::defaultDispatchMode(), vm_runs, cached_result, true);
+                auto uncached_time = VM::supportsThreadedDispatch() ? threaded_time : switch_time;
+
+                std::cout << "\n栈顶缓存对比 (各执行 " << vm_runs << " 次):\n";
+                std::cout << "----------------------------------------\n";
+                std::cout << "内存栈:         " << uncached_time.count() << " μs\n";
+                std::cout << "栈顶缓存:       " << cached_time.count() << " μs\n";
+                if (cached_time.count() > 0) {
+                    std::cout << "加速比:         "
+                              << (double)uncached_time.count() / cached_time.count() << "x\n";
+                }
+                if (cached_result != threaded_result) {
+                    std::cout << "✗ 栈顶缓存结果不一致: " << threaded_result
+                              << " vs " << cached_result << "\n";
+                    return 1;
+                }
+
+                // 字节码校验：校验通过后去掉冗余的运行时检查
+                auto start_verify = std::chrono::high_resolution_clock::now();
+                BytecodeVerifier verifier;
+                bool verified = verifier.verify(bytecode);
+                auto end_verify = std::chrono::high_resolution_clock::now();
+                auto verify_time = std::chrono::duration_cast<std::chrono::microseconds>(end_verify - start_verify);
+
+                std::cout << "\n字节码校验对比 (各执行 " << vm_runs << " 次):\n";
+                std::cout << "----------------------------------------\n";
+                std::cout << "校验:           " << verify_time.count() << " μs"
+                          << (verified ? "" : "（未通过）") << "\n";
+                if (verified) {
+                    int unchecked_result = 0;
+                    int unchecked_cached_result = 0;
+                    auto unchecked_time = benchmarkVM(bytecode, VM::defaultDispatchMode(), vm_runs,
+                                                      unchecked_result, false, &verifier);
+                    auto unchecked_cached_time = benchmarkVM(bytecode, VM::defaultDispatchMode(), vm_runs,
+                                                             unchecked_cached_result, true, &verifier);
+                    std::cout << "带检查:         " << uncached_time.count() << " μs"
+                              << "（栈顶缓存 " << cached_time.count() << " μs）\n";
+                    std::cout << "无检查:         " << unchecked_time.count() << " μs"
+                              << "（栈顶缓存 " << unchecked_cached_time.count() << " μs）\n";
+                    if (unchecked_time.count() > 0) {
+                        std::cout << "加速比:         "
+                                  << (double)uncached_time.count() / unchecked_time.count() << "x\n";
+                    }
+                    if (unchecked_result != threaded_result || unchecked_cached_result != threaded_result) {
+                        std::cout << "✗ 无检查执行结果不一致\n";
+                        return 1;
+                    }
+                } else {
+                    for (const auto& err : verifier.getErrors()) {
+                        std::cout << "  " << err << "\n";
+                    }
+                }
+
+                // 栈式 VM vs 寄存器式 VM：翻译时间、静态指令数和执行时间
+                auto start_lower = std::chrono::high_resolution_clock::now();
+                RegisterLowering lowering;
+                RegByteCode reg_code = lowering.lower(bytecode);
+                auto end_lower = std::chrono::high_resolution_clock::now();
+                auto lower_time = std::chrono::duration_cast<std::chrono::microseconds>(end_lower - start_lower);
+
+                int reg_result = 0;
+                auto reg_time = benchmarkRegVM(reg_code, vm_runs, reg_result);
+                auto stack_time = VM::supportsThreadedDispatch() ? threaded_time : switch_time;
+
+                std::cout << "\n执行后端对比 (各执行 " << vm_runs << " 次):\n";
+                std::cout << "----------------------------------------\n";
+                std::cout << "寄存器翻译:     " << lower_time.count() << " μs\n";
+                std::cout << "指令数:         stack " << bytecode.code.size()
+                          << " / register " << reg_code.code.size() << "\n";
+                std::cout << "stack:          " << stack_time.count() << " μs\n";
+                std::cout << "register:       " << reg_time.count() << " μs\n";
+                if (reg_time.count() > 0) {
+                    std::cout << "加速比:         "
+                              << (double)stack_time.count() / reg_time.count() << "x\n";
+                }
+                if (reg_result != threaded_result) {
+                    std::cout << "✗ 两种执行后端结果不一致: " << threaded_result
+                              << " vs " << reg_result << "\n";
+                    return 1;
+                }
+
+                // -O1 前后对比：常量折叠 + 窥孔优化（栈式 VM，默认分派方式，不融合）
+                auto start_fold = std::chrono::high_resolution_clock::now();
+                CodeGen folding_codegen;
+                folding_codegen.setConstantFolding(true);
+                ByteCode optimized_code = folding_codegen.generate(program.get());
+                auto end_fold = std::chrono::high_resolution_clock::now();
+                auto fold_time = std::chrono::duration_cast<std::chrono::microseconds>(end_fold - start_fold);
+                size_t folded_size = optimized_code.code.size();
+
+                auto start_peephole = std::chrono::high_resolution_clock::now();
+                PeepholeOptimizer peephole;
+                PeepholeStats peephole_stats = peephole.run(optimized_code);
+                auto end_peephole = std::chrono::high_resolution_clock::now();
+                auto peephole_time = std::chrono::duration_cast<std::chrono::microseconds>(end_peephole - start_peephole);
+                int optimized_result = 0;
+                auto optimized_time = benchmarkVM(optimized_code, VM::defaultDispatchMode(), vm_runs, optimized_result);
+
+                std::cout << "\n-O1 优化对比 (各执行 " << vm_runs << " 次):\n";
+                std::cout << "----------------------------------------\n";
+                std::cout << "常量折叠 CodeGen: " << fold_time.count() << " μs\n";
+                std::cout << "窥孔优化耗时:   " << peephole_time.count() << " μs\n";
+                printPeepholeStats(peephole_stats);
+                std::cout << "指令数:         -O0 " << bytecode.code.size()
+                          << " / 常量折叠后 " << folded_size
+                          << " / -O1 " << optimized_code.code.size() << "\n";
+                std::cout << "-O0:            " << stack_time.count() << " μs\n";
+                std::cout << "-O1:            " << optimized_time.count() << " μs\n";
+                if (optimized_time.count() > 0) {
+                    std::cout << "加速比:         "
+                              << (double)stack_time.count() / optimized_time.count() << "x\n";
+                }
+                if (optimized_result != threaded_result) {
+                    std::cout << "✗ -O1 优化前后结果不一致: " << threaded_result
+                              << " vs " << optimized_result << "\n";
+                    return 1;
+                }
+
+                // -O2 在 -O1 的基础上内联小的叶子函数，之后再做一次窥孔优化
+                ByteCode inlined_code = optimized_code;
+                auto start_inline = std::chrono::high_resolution_clock::now();
+                FunctionInliner inliner;
+                InlineStats inline_stats = inliner.run(inlined_code);
+                if (inline_stats.total() > 0) {
+                    peephole.run(inlined_code);
+                }
+                auto end_inline = std::chrono::high_resolution_clock::now();
+                auto inline_time = std::chrono::duration_cast<std::chrono::microseconds>(end_inline - start_inline);
+
+                std::cout << "\n-O2 函数内联对比 (各执行 " << vm_runs << " 次):\n";
+                std::cout << "----------------------------------------\n";
+                std::cout << "内联耗时:       " << inline_time.count() << " μs\n";
+                printInlineStats(inline_stats);
+                if (inline_stats.total() == 0) {
+                    // 字节码与 -O1 完全相同，计时差异只是噪声
+                    std::cout << "没有可内联的调用，-O2 与 -O1 相同\n";
+                } else {
+                    int inlined_result = 0;
+                    auto inlined_time = benchmarkVM(inlined_code, VM::defaultDispatchMode(), vm_runs, inlined_result);
+                    std::cout << "指令数:         -O1 " << optimized_code.code.size()
+                              << " / -O2 " << inlined_code.code.size() << "\n";
+                    std::cout << "-O1:            " << optimized_time.count() << " μs\n";
+                    std::cout << "-O2:            " << inlined_time.count() << " μs\n";
+                    if (inlined_time.count() > 0) {
+                        std::cout << "加速比:         "
+                                  << (double)optimized_time.count() / inlined_time.count() << "x\n";
+                    }
+                    if (inlined_result != threaded_result) {
+                        std::cout << "✗ -O2 内联前后结果不一致: " << threaded_result
+                                  << " vs " << inlined_result << "\n";
+                        return 1;
+                    }
+                }
+
+                // 超级指令融合前后对比（栈式 VM，默认分派方式）
+                ByteCode fused_code = bytecode;
+                SuperinstructionFusion fusion;
+                FusionStats fusion_stats = fusion.run(fused_code);
+                int fused_result = 0;
+                auto fused_time = benchmarkVM(fused_code, VM::defaultDispatchMode(), vm_runs, fused_result);
+
+                std::cout << "\n超级指令对比 (各执行 " << vm_runs << " 次):\n";
+                std::cout << "----------------------------------------\n";
+                printFusionStats(fusion_stats);
+                std::cout << "未融合:         " << stack_time.count() << " μs\n";
+                std::cout << "融合:           " << fused_time.count() << " μs\n";
+                if (fused_time.count() > 0) {
+                    std::cout << "加速比:         "
+                              << (double)stack_time.count() / fused_time.count() << "x\n";
+                }
+                if (fused_result != threaded_result) {
+                    std::cout << "✗ 融合前后结果不一致: " << threaded_result
+                              << " vs " << fused_result << "\n";
+                    return 1;
+                }
+
+                // JIT：融合后的字节码编译成机器码，与解释执行对比
+                std::cout << "\nJIT 对比 (各执行 " << vm_runs << " 次):\n";
+                std::cout << "----------------------------------------\n";
+                BytecodeVerifier fused_verifier;
+                if (!JitCompiler::isSupported()) {
+                    std::cout << "当前平台不支持 JIT（仅 x86-64 Linux）\n";
+                } else if (!fused_verifier.verify(fused_code)) {
+                    std::cout << "融合后的字节码未通过校验，跳过 JIT\n";
+                } else {
+                    auto start_jit = std::chrono::high_resolution_clock::now();
+                    JitCompiler compiler;
+                    auto jit_program = compiler.compile(fused_code, fused_verifier);
+                    auto end_jit = std::chrono::high_resolution_clock::now();
+                    auto jit_compile_time = std::chrono::duration_cast<std::chrono::microseconds>(end_jit - start_jit);
+
+                    int jit_result = 0;
+                    auto jit_time = benchmarkJit(*jit_program, vm_runs, jit_result);
+                    std::cout << "JIT 编译:       " << jit_compile_time.count() << " μs"
+                              << "（机器码 " << jit_program->codeSize() << " 字节）\n";
+                    std::cout << "解释执行:       " << fused_time.count() << " μs\n";
+                    std::cout << "JIT:            " << jit_time.count() << " μs\n";
+                    if (jit_time.count() > 0) {
+                        std::cout << "加速比:         "
+                                  << (double)fused_time.count() / jit_time.count() << "x\n";
+                    }
+                    if (jit_result != threaded_result) {
+                        std::cout << "✗ JIT 与解释执行结果不一致: " << threaded_result
+                                  << " vs " << jit_result << "\n";
+                        return 1;
+                    }
+                }
+
+                // AOT：翻译成 C，用系统 cc -O2 编译为原生程序，与 VM::execute 对比
+                std::cout << "\nAOT (C) 对比 (各执行 " << vm_runs << " 次):\n";
+                std::cout << "----------------------------------------\n";
+                if (!verified) {
+                    std::cout << "字节码未通过校验，跳过 AOT\n";
+                } else {
+                    CBackend c_backend;
+                    std::string c_source = c_backend.generate(bytecode, verifier, filename);
+                    int native_result = 0;
+                    std::chrono::microseconds native_time{0};
+                    if (!benchmarkNative(c_source, vm_runs, native_result, native_time)) {
+                        std::cout << "没有可用的 C 编译器（cc）或原生程序执行失败，跳过 AOT\n";
+                    } else {
+                        std::cout << "VM:             " << stack_time.count() << " μs\n";
+                        std::cout << "native:         " << native_time.count() << " μs\n";
+                        if (native_time.count() > 0) {
+                            std::cout << "加速比:         "
+                                      << (double)stack_time.count() / native_time.count() << "x\n";
+                        }
+                        if (native_result != threaded_result) {
+                            std::cout << "✗ 原生程序与解释执行结果不一致: " << threaded_result
+                                      << " vs " << native_result << "\n";
+                            return 1;
+                        }
+                    }
+                }
                 break;
             }
             case Mode::Run:
-            case Mode::Code: {
+            case Mode::Code:
+            case Mode::EmitC:
+            case Mode::EmitBC: {
+                // 字节码缓存：键是源代码内容的哈希和影响生成结果的选项，命中时跳过整个前端
+                std::string cache_path;
+                uint64_t source_hash = 0;
+                if (mode == Mode::Run && !cache_dir.empty()) {
+                    source_hash = BytecodeFile::hashSource(source);
+                    cache_path = bytecodeCachePath(cache_dir, source_hash, opt_level, fuse);
+                    if (std::filesystem::exists(cache_path)) {
+                        try {
+                            uint64_t cached_hash = 0;
+                            ByteCode cached = BytecodeFile::load(cache_path, &cached_hash);
+                            if (cached_hash == source_hash) {
+                                std::cout << "字节码缓存命中: " << cache_path << "\n\n";
+                                if (!runBytecode(cached, run_options)) {
+                                    return 1;
+                                }
+                                break;
+                            }
+                        } catch (const std::exception& e) {
+                            // 旧版本或损坏的缓存文件：重新编译并覆盖
+                            std::cout << "忽略字节码缓存: " << e.what() << "\n";
+                        }
+                    }
+                }
+
                 Lexer lexer(source);
                 Parser parser(lexer);
                 auto program = parser.parseProgram();
@@ -232,18 +887,98 @@ int main(int argc, char* argv[]) {
                 }
 
                 CodeGen codegen;
+                codegen.setConstantFolding(opt_level >= 1);
                 ByteCode bytecode = codegen.generate(program.get());
 
-                if (mode == Mode::Code) {
+                // 窥孔优化和内联在融合和后端翻译之前进行，所有后端共用优化后的字节码
+                if (opt_level >= 1) {
+                    PeepholeOptimizer peephole;
+                    PeepholeStats peephole_stats = peephole.run(bytecode);
+                    // 内联的阈值按窥孔优化后的函数体计算；展开后调用处留下的 STORE/ADJSP/JMP 再做一次窥孔优化
+                    if (opt_level >= 2) {
+                        FunctionInliner inliner;
+                        InlineStats inline_stats = inliner.run(bytecode);
+                        if (inline_stats.total() > 0) {
+                            peephole_stats.merge(peephole.run(bytecode));
+                        }
+                        printInlineStats(inline_stats);
+                    }
+                    printPeepholeStats(peephole_stats);
+                    std::cout << "\n";
+                }
+
+                if (mode == Mode::EmitC) {
+                    BytecodeVerifier verifier;
+                    if (!verifier.verify(bytecode)) {
+                        std::cout << "✗ 字节码校验失败:\n";
+                        for (const auto& err : verifier.getErrors()) {
+                            std::cout << "  错误: " << err << "\n";
+                        }
+                        return 1;
+                    }
+                    CBackend c_backend;
+                    c_backend.setStackSize(stack_size);
+                    std::string c_source = c_backend.generate(bytecode, verifier, filename);
+                    if (output_file.empty()) {
+                        output_file = std::filesystem::path(filename).stem().string() + ".gen.c";
+                    }
+                    std::ofstream out(output_file);
+                    if (!out) {
+                        throw std::runtime_error("无法写入文件: " + output_file);
+                    }
+                    out << c_source;
+                    std::cout << "已生成 C 文件: " << output_file << "\n";
+                    std::cout << "编译: cc -O2 " << output_file << " -o "
+                              << std::filesystem::path(output_file).stem().string() << "\n";
+                } else if (mode == Mode::EmitBC) {
+                    if (fuse) {
+                        SuperinstructionFusion fusion;
+                        fusion.run(bytecode);
+                    }
+                    if (output_file.empty()) {
+                        output_file = std::filesystem::path(filename).stem().string() + ".bc";
+                    }
+                    BytecodeFile::write(bytecode, output_file, BytecodeFile::hashSource(source));
+                    std::cout << "已生成字节码文件: " << output_file << "（" << bytecode.code.size() << " 条指令）\n";
+                    std::cout << "运行: " << argv[0] << " " << output_file << " --run-bc\n";
+                } else if (mode == Mode::Code && backend == Backend::Register) {
+                    RegisterLowering lowering;
+                    RegByteCode reg_code = lowering.lower(bytecode);
+                    std::cout << "=== 生成的寄存器字节码 ===\n\n";
+                    std::cout << reg_code.toString();
+                    std::cout << "\n入口点: " << reg_code.entry_point << "\n";
+                    std::cout << "指令数: " << reg_code.code.size()
+                              << "（栈式字节码 " << bytecode.code.size() << "）\n";
+                } else if (mode == Mode::Code) {
+                    FusionStats fusion_stats;
+                    if (fuse) {
+                        SuperinstructionFusion fusion;
+                        fusion_stats = fusion.run(bytecode);
+                    }
                     std::cout << "=== 生成的字节码 ===\n\n";
                     std::cout << bytecode.toString();
                     std::cout << "\n入口点: " << bytecode.entry_point << "\n";
+                    if (fuse) {
+                        printFusionStats(fusion_stats);
+                    }
                 } else {
-                    std::cout << "=== 运行程序 ===\n\n";
-                    VM vm;
-                    vm.setDebug(debug);
-                    int result = vm.execute(bytecode);
-                    std::cout << "\n程序返回值: " << result << "\n";
+                    // 栈式 VM 执行融合后的字节码；写入缓存的也是融合后的（寄存器后端翻译时会展开）
+                    if (fuse && (backend == Backend::Stack || !cache_path.empty())) {
+                        SuperinstructionFusion fusion;
+                        fusion.run(bytecode);
+                    }
+                    if (!cache_path.empty()) {
+                        try {
+                            std::filesystem::create_directories(cache_dir);
+                            BytecodeFile::write(bytecode, cache_path, source_hash);
+                            std::cout << "已写入字节码缓存: " << cache_path << "\n\n";
+                        } catch (const std::exception& e) {
+                            std::cout << "警告: " << e.what() << "\n\n";
+                        }
+                    }
+                    if (!runBytecode(bytecode, run_options)) {
+                        return 1;
+                    }
                 }
                 break;
             }
@@ -0,0 +1,89 @@
+#!/usr/bin/env python3
+# 生成大型 SimpleC 源文件，用于测量前端（Lexer / Parser / Sema / CodeGen）的性能
+#
+# 用法: python3 scripts/gen_large_source.py [函数个数] [输出文件] [嵌套深度]
+#   默认 2000 个函数，输出到 build/large.c
+#   嵌套深度大于 0 时，每个函数在 return 之前多一串嵌套的代码块，每层声明变量（其中 sum 遮蔽外层的同名变量）
+#   并使用外层的变量，用于测量 Sema 符号表的进入/退出作用域和查找
+#
+# 每个函数覆盖结构体、数组、指针、成员访问、各种循环和条件、&& / ||、函数调用，
+# main 只调用其中少数几个，生成的程序可以正常运行（返回值固定）。
+
+import os
+import sys
+
+
+def gen_nested(depth):
+    lines = []
+    for k in range(depth):
+        pad = "    " * (k + 1)
+        outer = f"v{k - 1}" if k > 0 else "a"
+        lines.append(f"{pad}{{")
+        lines.append(f"{pad}    int v{k} = {outer} % 7 + sum % 5;")
+        lines.append(f"{pad}    int sum = v{k} - b;")
+        lines.append(f"{pad}    p.y = p.y + sum % 3;")
+    lines.append("    " * (depth + 1) + f"t = t + v{depth - 1} + sum % 2;")
+    for k in reversed(range(depth)):
+        lines.append("    " * (k + 1) + "}")
+    return "\n".join(lines) + "\n" if depth > 0 else ""
+
+
+def gen_function(i, depth):
+    prev = f"work{i - 1}(a - 1, b)" if i > 0 else "a + b"
+    return f"""
+int work{i}(int a, int b) {{
+    struct Pair p;
+    struct Pair *q = &p;
+    int arr[8];
+    int i;
+    int sum = 0;
+    int t = {i % 97};
+
+    p.x = a * 3 + {i};
+    p.y = b - t;
+    q->x = q->x + p.y;
+    for (i = 0; i < 8; i = i + 1) {{
+        arr[i] = i * i - a;
+    }}
+    i = 0;
+    while (i < 8 && sum < 1000) {{
+        if (arr[i] > 10 || arr[i] < -10) {{
+            sum = sum + arr[i] / 2;
+        }} else if (arr[i] == 0) {{
+            sum = sum + 1;
+        }} else {{
+            sum = sum - arr[i] % 3;
+        }}
+        i = i + 1;
+    }}
+    do {{
+        t = t - 7;
+    }} while (t > 0);
+    if (a > 0 && b > 0) {{
+        sum = sum + {prev} % 5;
+    }}
+{gen_nested(depth)}    return sum + p.x - q->y + t;
+}}
+"""
+
+
+def main():
+    count = int(sys.argv[1]) if len(sys.argv) > 1 else 2000
+    output = sys.argv[2] if len(sys.argv) > 2 else os.path.join("build", "large.c")
+    depth = int(sys.argv[3]) if len(sys.argv) > 3 else 0
+    os.makedirs(os.path.dirname(output) or ".", exist_ok=True)
+
+    nested = f"，嵌套深度 {depth}" if depth > 0 else ""
+    parts = [f"// 由 scripts/gen_large_source.py 生成：{count} 个函数{nested}\n",
+             "struct Pair {\n    int x;\n    int y;\n};\n"]
+    parts += [gen_function(i, depth) for i in range(count)]
+    calls = " + ".join(f"work{i}({i % 7}, 3)" for i in range(0, count, max(1, count // 8)))
+    parts.append(f"\nint main() {{\n    return {calls};\n}}\n")
+
+    with open(output, "w") as f:
+        f.write("".join(parts))
+    print(f"已生成 {output}（{count} 个函数{nested}）")
+
+
+if __name__ == "__main__":
+    main()
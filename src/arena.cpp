@@ -0,0 +1,17 @@
+#include "../include/arena.h"
+
+void* Arena::allocateSlow(size_t size, size_t align) {
+    // 大对象单独占一块，不浪费当前块的剩余空间
+    if (size + align > BLOCK_SIZE / 2) {
+        blocks_.emplace_back(new char[size + align]);
+        uintptr_t base = reinterpret_cast<uintptr_t>(blocks_.back().get());
+        uintptr_t p = (base + align - 1) & ~(uintptr_t)(align - 1);
+        bytes_allocated_ += size;
+        return reinterpret_cast<void*>(p);
+    }
+
+    blocks_.emplace_back(new char[BLOCK_SIZE]);
+    cursor_ = blocks_.back().get();
+    limit_ = cursor_ + BLOCK_SIZE;
+    return allocate(size, align);
+}
@@ -0,0 +1,238 @@
+#include "../include/bytecode_file.h"
+#include "../include/source.h"
+#include "../include/verifier.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <unistd.h>
+
+// 指令段直接映射为 Instruction 数组，内存布局必须与文件格式一致
+static_assert(sizeof(Instruction) == 8, "Instruction 必须是 8 字节");
+static_assert(offsetof(Instruction, operand) == 4, "Instruction::operand 必须在偏移 4");
+static_assert(alignof(Instruction) <= 8, "指令段按 8 字节对齐");
+
+namespace {
+
+const char MAGIC[4] = {'S', 'C', 'B', 'C'};
+const size_t HEADER_SIZE = 40;
+const size_t INSTRUCTION_SIZE = 8;
+
+bool hostIsLittleEndian() {
+    const uint16_t probe = 1;
+    unsigned char first;
+    std::memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+void putU32(std::string& out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+void putU64(std::string& out, uint64_t value) {
+    putU32(out, static_cast<uint32_t>(value));
+    putU32(out, static_cast<uint32_t>(value >> 32));
+}
+
+uint32_t getU32(const char* p) {
+    const auto* b = reinterpret_cast<const unsigned char*>(p);
+    return b[0] | (b[1] << 8) | (b[2] << 16) | (static_cast<uint32_t>(b[3]) << 24);
+}
+
+// 带边界检查的顺序读取，越界说明文件被截断或损坏
+class Reader {
+public:
+    Reader(std::string_view bytes, const std::string& path) : bytes_(bytes), path_(path) {}
+
+    uint32_t u32() { return getU32(take(4)); }
+    int32_t i32() { return static_cast<int32_t>(u32()); }
+    uint64_t u64() {
+        uint64_t low = u32();
+        return low | (static_cast<uint64_t>(u32()) << 32);
+    }
+    std::string_view bytes(size_t n) { return std::string_view(take(n), n); }
+    size_t position() const { return pos_; }
+
+    [[noreturn]] void fail(const std::string& what) const {
+        throw std::runtime_error("字节码文件已损坏（" + what + "）: " + path_);
+    }
+
+private:
+    std::string_view bytes_;
+    const std::string& path_;
+    size_t pos_ = 0;
+
+    const char* take(size_t n) {
+        if (n > bytes_.size() - pos_) fail("文件被截断");
+        const char* p = bytes_.data() + pos_;
+        pos_ += n;
+        return p;
+    }
+};
+
+} // namespace
+
+std::string BytecodeFile::serialize(const ByteCode& bytecode, uint64_t source_hash) {
+    // 函数按地址（相同时按名字）排序，同样的字节码总是得到同样的文件
+    std::vector<std::pair<int, std::string>> functions;
+    for (const auto& [name, addr] : bytecode.functions) functions.push_back({addr, name});
+    std::sort(functions.begin(), functions.end());
+
+    std::string body;
+    for (const auto& [addr, name] : functions) {
+        auto args = bytecode.arg_slots.find(name);
+        putU32(body, addr);
+        putU32(body, args != bytecode.arg_slots.end() ? args->second : 0);
+        putU32(body, name.size());
+        body += name;
+    }
+    for (const auto& init : bytecode.global_inits) {
+        putU32(body, init.offset);
+        putU32(body, init.slot_count);
+        putU32(body, init.init_data.size());
+        for (int32_t value : init.init_data) putU32(body, value);
+    }
+
+    size_t code_offset = HEADER_SIZE + body.size();
+    code_offset = (code_offset + 7) / 8 * 8;
+
+    std::string out(MAGIC, sizeof(MAGIC));
+    putU32(out, VERSION);
+    putU32(out, OPCODE_COUNT);
+    putU32(out, bytecode.entry_point);
+    putU64(out, source_hash);
+    putU32(out, functions.size());
+    putU32(out, bytecode.global_inits.size());
+    putU32(out, bytecode.code.size());
+    putU32(out, code_offset);
+    out += body;
+    out.resize(code_offset, '\0');
+
+    out.reserve(out.size() + bytecode.code.size() * INSTRUCTION_SIZE);
+    for (const auto& instr : bytecode.code) {
+        out.push_back(static_cast<char>(instr.op));
+        out.append(3, '\0');
+        putU32(out, instr.operand);
+    }
+    return out;
+}
+
+void BytecodeFile::write(const ByteCode& bytecode, const std::string& path, uint64_t source_hash) {
+    std::string bytes = serialize(bytecode, source_hash);
+
+    // 先写临时文件再改名：同时运行的进程（或中途失败）不会看到写了一半的文件
+    std::string tmp_path = path + ".tmp." + std::to_string(getpid());
+    {
+        std::ofstream out(tmp_path, std::ios::binary);
+        if (!out || !out.write(bytes.data(), bytes.size())) {
+            std::remove(tmp_path.c_str());
+            throw std::runtime_error("无法写入文件: " + path);
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp_path, path, ec);
+    if (ec) {
+        std::remove(tmp_path.c_str());
+        throw std::runtime_error("无法写入文件: " + path);
+    }
+}
+
+ByteCode BytecodeFile::load(const std::string& path, uint64_t* source_hash) {
+    auto file = std::make_shared<SourceFile>(path);
+    std::string_view bytes = file->text();
+    Reader reader(bytes, path);
+
+    if (bytes.size() < HEADER_SIZE || std::memcmp(bytes.data(), MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("不是字节码文件: " + path);
+    }
+    reader.bytes(sizeof(MAGIC));
+    uint32_t version = reader.u32();
+    uint32_t opcode_count = reader.u32();
+    if (version != VERSION || opcode_count != static_cast<uint32_t>(OPCODE_COUNT)) {
+        throw std::runtime_error("字节码文件版本不符（文件 " + std::to_string(version) + "/" +
+                                 std::to_string(opcode_count) + "，当前 " + std::to_string(VERSION) + "/" +
+                                 std::to_string(OPCODE_COUNT) + "），需要重新生成: " + path);
+    }
+
+    ByteCode bytecode;
+    bytecode.entry_point = reader.i32();
+    uint64_t hash = reader.u64();
+    uint32_t function_count = reader.u32();
+    uint32_t global_count = reader.u32();
+    uint32_t code_count = reader.u32();
+    uint32_t code_offset = reader.u32();
+
+    for (uint32_t i = 0; i < function_count; ++i) {
+        int32_t addr = reader.i32();
+        int32_t args = reader.i32();
+        uint32_t length = reader.u32();
+        std::string_view name = reader.bytes(length);
+        if (addr < 0 || static_cast<uint32_t>(addr) > code_count) reader.fail("函数地址越界");
+        bytecode.functions[std::string(name)] = addr;
+        bytecode.arg_slots[std::string(name)] = args;
+    }
+    // 全局变量按文件中的顺序紧挨着排列，VM 按 slot_count 之和分配全局区并复制初值
+    int64_t global_slots = 0;
+    for (uint32_t i = 0; i < global_count; ++i) {
+        GlobalVarInit init;
+        init.offset = reader.i32();
+        init.slot_count = reader.i32();
+        uint32_t value_count = reader.u32();
+        if (init.offset != global_slots || init.slot_count < 0) reader.fail("全局变量布局不正确");
+        global_slots += init.slot_count;
+        if (global_slots > VM::MAX_STACK_SIZE) reader.fail("全局区超出 VM 的地址范围");
+        if (value_count > static_cast<uint32_t>(init.slot_count)) reader.fail("全局变量初值多于 slot 数");
+        if (value_count > (bytes.size() - reader.position()) / 4) reader.fail("文件被截断");
+        init.init_data.reserve(value_count);
+        for (uint32_t k = 0; k < value_count; ++k) init.init_data.push_back(reader.i32());
+        bytecode.global_inits.push_back(std::move(init));
+    }
+
+    if (code_offset % 8 != 0 || code_offset < reader.position() || code_offset > bytes.size() ||
+        code_count > (bytes.size() - code_offset) / INSTRUCTION_SIZE) {
+        reader.fail("指令段位置不正确");
+    }
+    if (bytecode.entry_point < -1 || bytecode.entry_point >= static_cast<int64_t>(code_count)) {
+        reader.fail("入口地址越界");
+    }
+
+    const char* code = bytes.data() + code_offset;
+    for (uint32_t i = 0; i < code_count; ++i) {
+        if (static_cast<unsigned char>(code[i * INSTRUCTION_SIZE]) >= OPCODE_COUNT) {
+            reader.fail("第 " + std::to_string(i) + " 条指令编号无效");
+        }
+    }
+
+    bool aligned = reinterpret_cast<uintptr_t>(code) % alignof(Instruction) == 0;
+    if (file->isMapped() && aligned && hostIsLittleEndian()) {
+        // 映射的文件与内存中的 Instruction 布局相同，直接引用，文件随 ByteCode 一起释放
+        bytecode.code.borrow(reinterpret_cast<const Instruction*>(code), code_count, file);
+    } else {
+        for (uint32_t i = 0; i < code_count; ++i) {
+            const char* p = code + i * INSTRUCTION_SIZE;
+            bytecode.code.emplace_back(static_cast<OpCode>(static_cast<unsigned char>(p[0])),
+                                       static_cast<int32_t>(getU32(p + 4)));
+        }
+    }
+
+    // 文件可能被改动过（或是过期的缓存），指令必须先通过校验才能交给不检查帧偏移的解释器执行
+    BytecodeVerifier verifier;
+    if (!verifier.verify(bytecode)) reader.fail("校验失败: " + verifier.getErrors().front());
+
+    if (source_hash) *source_hash = hash;
+    return bytecode;
+}
+
+uint64_t BytecodeFile::hashSource(std::string_view source) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : source) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
@@ -0,0 +1,383 @@
+#include "../include/cbackend.h"
+#include "../include/verifier.h"
+#include <algorithm>
+#include <stdexcept>
+
+void CBackend::setStackSize(int slots) {
+    if (slots <= 0 || slots > VM::MAX_STACK_SIZE) {
+        throw std::runtime_error("栈大小必须在 1 到 " + std::to_string(VM::MAX_STACK_SIZE) + " 个 slot 之间");
+    }
+    stack_size_ = slots;
+}
+
+std::string CBackend::generate(const ByteCode& bytecode, const BytecodeVerifier& verifier,
+                               const std::string& source_name) {
+    if (!verifier.isVerified(bytecode)) {
+        throw std::runtime_error("字节码未通过校验，不能生成 C 代码");
+    }
+    // 线性内存是一个静态数组，超过 2 GB 时默认的代码模型无法链接
+    if (static_cast<int64_t>(VM::stackBase(bytecode.global_inits)) + stack_size_ > INT32_MAX / 4) {
+        throw std::runtime_error("全局区和栈超过 2 GB，生成的 C 代码无法链接，请减小 --stack-size");
+    }
+    bytecode_ = &bytecode;
+    verifier_ = &verifier;
+    out_.str("");
+    out_.clear();
+
+    const auto& code = bytecode.code;
+    const int n = code.size();
+
+    // 只有跳转目标需要标签（避免生成大量未使用的标签）
+    is_target_.assign(n + 1, false);
+    for (int pc = 0; pc < n; pc += instructionLength(code[pc].op)) {
+        switch (code[pc].op) {
+            case OpCode::JMP: case OpCode::JZ: case OpCode::JNZ:
+                is_target_[code[pc].operand] = true;
+                break;
+            case OpCode::JLT_LOCALS: case OpCode::JLT_LOCAL_CONST: case OpCode::JLE_LOCAL_CONST:
+                is_target_[code[pc + 3].operand] = true;
+                break;
+            default:
+                break;
+        }
+    }
+
+    // 函数按地址排序：每个函数的代码范围到下一个函数入口为止
+    std::vector<std::pair<int, std::string>> functions;
+    for (const auto& [name, entry] : bytecode.functions) {
+        functions.push_back({entry, name});
+    }
+    std::sort(functions.begin(), functions.end());
+
+    emitPrelude(source_name);
+    emitGlobals();
+
+    out_ << "/* 函数声明 */\n";
+    for (const auto& [entry, name] : functions) {
+        out_ << "static void " << cName(name) << "(int32_t fp);\n";
+    }
+    out_ << "\n";
+
+    for (size_t i = 0; i < functions.size(); ++i) {
+        entry_ = functions[i].first;
+        end_ = i + 1 < functions.size() ? functions[i + 1].first : n;
+        function_ = functions[i].second;
+        emitFunction();
+    }
+
+    emitMain();
+    return out_.str();
+}
+
+void CBackend::emitPrelude(const std::string& source_name) {
+    out_ << "/* 由 SimpleC --emit-c 从 " << source_name << " 生成 */\n"
+         << "#include <setjmp.h>\n"
+         << "#include <stdint.h>\n"
+         << "#include <stdio.h>\n"
+         << "#include <stdlib.h>\n"
+         << "#include <string.h>\n"
+         << "#include <time.h>\n"
+         << "\n"
+         << "#define STACK_SIZE " << stack_size_ << "\n"
+         << "#define GLOBAL_BASE " << VM::GLOBAL_BASE << "\n"
+         << "\n"
+         << "/* 有符号运算按 32 位回绕（与 VM 一致，避免 C 的有符号溢出未定义行为） */\n"
+         << "#define WADD(a, b) ((int32_t)((uint32_t)(a) + (uint32_t)(b)))\n"
+         << "#define WSUB(a, b) ((int32_t)((uint32_t)(a) - (uint32_t)(b)))\n"
+         << "#define WMUL(a, b) ((int32_t)((uint32_t)(a) * (uint32_t)(b)))\n"
+         << "\n"
+         << "static jmp_buf halt_env;\n"
+         << "static int32_t halt_result;\n"
+         << "\n";
+}
+
+void CBackend::emitGlobals() {
+    int size = 0;
+    for (const auto& init : bytecode_->global_inits) {
+        size += init.slot_count;
+    }
+
+    // 与 VM::setup 相同：按 global_inits 的顺序依次排布，未给出的 slot 为 0
+    // 线性内存与 VM 相同：[空指针][全局区][栈]，指针就是 memory 的下标
+    out_ << "/* 线性内存：[空指针][全局区][栈]，全局区按 GlobalVarInit 的顺序排布 */\n"
+         << "#define GLOBALS_SIZE " << size << "\n"
+         << "#define STACK_BASE (GLOBAL_BASE + GLOBALS_SIZE)\n"
+         << "#define MEMORY_SIZE (STACK_BASE + STACK_SIZE)\n"
+         << "static int32_t memory[MEMORY_SIZE];\n"
+         << "static int32_t* const globals = memory + GLOBAL_BASE;\n"
+         << "static int32_t* const stack = memory + STACK_BASE;\n"
+         << "static const int32_t globals_init[" << std::max(size, 1) << "] = {\n";
+    for (const auto& init : bytecode_->global_inits) {
+        out_ << "    /* offset " << init.offset << ", " << init.slot_count << " slot */";
+        for (int i = 0; i < init.slot_count; ++i) {
+            out_ << " " << (i < (int)init.init_data.size() ? init.init_data[i] : 0) << ",";
+        }
+        out_ << "\n";
+    }
+    if (size == 0) {
+        out_ << "    0\n";
+    }
+    out_ << "};\n\n";
+
+    // 运行时辅助函数：检查项和错误信息与解释器一致
+    out_ << "static void sc_error(const char* msg) {\n"
+            "    fflush(stdout);\n"
+            "    fprintf(stderr, \"错误: %s\\n\", msg);\n"
+            "    exit(1);\n"
+            "}\n"
+            "\n"
+            "static inline void sc_halt(int32_t sp) {\n"
+            "    halt_result = sp > 0 ? stack[sp - 1] : 0;\n"
+            "    longjmp(halt_env, 1);\n"
+            "}\n"
+            "\n"
+            "static inline void sc_print(int32_t value) {\n"
+            "    printf(\"OUTPUT: %d\\n\", (int)value);\n"
+            "}\n"
+            "\n"
+            "/* INT_MIN / -1 按回绕处理 */\n"
+            "static inline int32_t sc_div(int32_t a, int32_t b) {\n"
+            "    if (b == 0) sc_error(\"Division by zero\");\n"
+            "    return b == -1 ? WSUB(0, a) : a / b;\n"
+            "}\n"
+            "\n"
+            "static inline int32_t sc_mod(int32_t a, int32_t b) {\n"
+            "    if (b == 0) sc_error(\"Division by zero\");\n"
+            "    return b == -1 ? 0 : a % b;\n"
+            "}\n"
+            "\n"
+            "/* 有效地址是 [GLOBAL_BASE, MEMORY_SIZE)，空指针和负地址按无符号比较也会越界 */\n"
+            "static inline int sc_valid(int32_t addr) {\n"
+            "    return (uint32_t)addr - GLOBAL_BASE < (uint32_t)(MEMORY_SIZE - GLOBAL_BASE);\n"
+            "}\n"
+            "\n"
+            "static inline int32_t sc_load(int32_t addr) {\n"
+            "    if (!sc_valid(addr)) sc_error(\"LOADM: 内存访问越界\");\n"
+            "    return memory[addr];\n"
+            "}\n"
+            "\n"
+            "static inline void sc_store(int32_t addr, int32_t value) {\n"
+            "    if (!sc_valid(addr)) sc_error(\"STOREM: 内存访问越界\");\n"
+            "    memory[addr] = value;\n"
+            "}\n"
+            "\n"
+            "static inline void sc_memcpy(int32_t src, int32_t dst, int32_t size) {\n"
+            "    if (size == 0) return;\n"
+            "    if (size < 0 || !sc_valid(src) || !sc_valid(dst) ||\n"
+            "        size > MEMORY_SIZE - src || size > MEMORY_SIZE - dst) {\n"
+            "        sc_error(\"MEMCPY: 内存访问越界\");\n"
+            "    }\n"
+            "    memmove(memory + dst, memory + src, (size_t)size * sizeof(int32_t));\n"
+            "}\n"
+            "\n"
+            "/* 块加载/存储（LOADMN/STOREMN）：按地址从低到高逐个 slot 复制 */\n"
+            "static inline int sc_valid_range(int32_t addr, int32_t size) {\n"
+            "    return size >= 0 &&\n"
+            "           (uint64_t)((uint32_t)addr - GLOBAL_BASE) + (uint64_t)size <= (uint64_t)(MEMORY_SIZE - GLOBAL_BASE);\n"
+            "}\n"
+            "\n"
+            "static inline void sc_load_block(int32_t* to, int32_t addr, int32_t size) {\n"
+            "    if (!sc_valid_range(addr, size)) sc_error(\"LOADMN: 内存访问越界\");\n"
+            "    for (int32_t i = 0; i < size; i++) to[i] = memory[addr + i];\n"
+            "}\n"
+            "\n"
+            "static inline void sc_store_block(int32_t addr, const int32_t* from, int32_t size) {\n"
+            "    if (!sc_valid_range(addr, size)) sc_error(\"STOREMN: 内存访问越界\");\n"
+            "    for (int32_t i = 0; i < size; i++) memory[addr + i] = from[i];\n"
+            "}\n"
+            "\n"
+            "/* 块返回（RETN）：结构体返回值复制到调用者预留的返回区 */\n"
+            "static inline void sc_return_block(int32_t src, int32_t dst, int32_t size) {\n"
+            "    if (!sc_valid_range(src, size) || !sc_valid_range(dst, size)) sc_error(\"RETN: 内存访问越界\");\n"
+            "    for (int32_t i = 0; i < size; i++) memory[dst + i] = memory[src + i];\n"
+            "}\n"
+            "\n";
+}
+
+void CBackend::emitFunction() {
+    const auto& code = bytecode_->code;
+    const auto& depths = verifier_->getStackDepths();
+
+    out_ << "/* " << function_ << ": 地址 " << entry_ << " - " << end_ - 1
+         << "，最大栈深度 " << verifier_->getMaxDepths().at(entry_) << " */\n"
+         << "static void " << cName(function_) << "(int32_t fp) {\n"
+         << "    int32_t* const f = stack + fp;\n";
+
+    for (int pc = entry_; pc < end_;) {
+        int len = instructionLength(code[pc].op);
+        if (depths[pc] < 0) {
+            pc += len;  // 不可达
+            continue;
+        }
+        if (is_target_[pc]) {
+            out_ << "L" << pc << ":;\n";
+        }
+        int d = depths[pc];
+        len = emitInstruction(pc, d);
+
+        // 最后一条指令顺序执行会落到下一个函数里，C 函数之间不能这样衔接
+        OpCode op = code[pc].op;
+        bool falls_through = op != OpCode::JMP && op != OpCode::RET && op != OpCode::RETN &&
+                             op != OpCode::HALT;
+        if (pc + len >= end_ && falls_through) {
+            if (end_ != (int)code.size()) {
+                throw std::runtime_error("函数 " + function_ + " 的控制流落入下一个函数");
+            }
+            StackEffect effect = stackEffect(code[pc]);
+            out_ << "    sc_halt(fp + " << d - effect.pops + effect.pushes << ");\n";
+        }
+        pc += len;
+    }
+    out_ << "}\n\n";
+}
+
+void CBackend::emitJump(const std::string& cond, int target, int d) {
+    std::string prefix = cond.empty() ? "    " : "    if (" + cond + ") ";
+    if (target == (int)bytecode_->code.size()) {
+        out_ << prefix << "sc_halt(fp + " << d << ");\n";
+    } else if (target < entry_ || target >= end_) {
+        throw std::runtime_error("函数 " + function_ + " 的跳转目标 " + std::to_string(target) + " 不在函数内");
+    } else {
+        out_ << prefix << "goto L" << target << ";\n";
+    }
+}
+
+int CBackend::emitInstruction(int pc, int d) {
+    const auto& code = bytecode_->code;
+    const Instruction& ins = code[pc];
+    const int32_t v = ins.operand;
+
+    // 操作数栈位置：栈顶 f[d-1]，次栈顶 f[d-2]，压入位置 f[d]
+    auto at = [](int k) { return "f[" + std::to_string(k) + "]"; };
+    std::string top = at(d - 1), second = at(d - 2), next = at(d);
+
+    out_ << "    /* " << pc << ": " << formatInstruction(ins) << " */\n";
+
+    switch (ins.op) {
+        case OpCode::PUSH:   out_ << "    " << next << " = " << v << ";\n"; break;
+        case OpCode::POP:    break;
+        case OpCode::LOAD:   out_ << "    " << next << " = " << at(v) << ";\n"; break;
+        case OpCode::STORE:  out_ << "    " << at(v) << " = " << top << ";\n"; break;
+        case OpCode::LOADM:  out_ << "    " << top << " = sc_load(" << top << ");\n"; break;
+        case OpCode::STOREM: out_ << "    sc_store(" << top << ", " << second << ");\n"; break;
+        case OpCode::LOADG:  out_ << "    " << next << " = globals[" << v << "];\n"; break;
+        case OpCode::STOREG: out_ << "    globals[" << v << "] = " << top << ";\n"; break;
+        case OpCode::LEAG:   out_ << "    " << next << " = GLOBAL_BASE + " << v << ";\n"; break;
+        case OpCode::LEA:    out_ << "    " << next << " = STACK_BASE + fp + " << v << ";\n"; break;
+        case OpCode::ADDPTR: out_ << "    " << top << " = WADD(" << top << ", " << v << ");\n"; break;
+        case OpCode::ADDPTRD:
+            // base = 栈顶, index = 次栈顶
+            out_ << "    " << second << " = WADD(" << top << ", WMUL(" << second << ", " << v << "));\n";
+            break;
+
+        case OpCode::ADD: out_ << "    " << second << " = WADD(" << second << ", " << top << ");\n"; break;
+        case OpCode::SUB: out_ << "    " << second << " = WSUB(" << second << ", " << top << ");\n"; break;
+        case OpCode::MUL: out_ << "    " << second << " = WMUL(" << second << ", " << top << ");\n"; break;
+        case OpCode::DIV: out_ << "    " << second << " = sc_div(" << second << ", " << top << ");\n"; break;
+        case OpCode::MOD: out_ << "    " << second << " = sc_mod(" << second << ", " << top << ");\n"; break;
+        case OpCode::NEG: out_ << "    " << top << " = WSUB(0, " << top << ");\n"; break;
+
+        case OpCode::EQ: out_ << "    " << second << " = " << second << " == " << top << ";\n"; break;
+        case OpCode::NE: out_ << "    " << second << " = " << second << " != " << top << ";\n"; break;
+        case OpCode::LT: out_ << "    " << second << " = " << second << " < " << top << ";\n"; break;
+        case OpCode::LE: out_ << "    " << second << " = " << second << " <= " << top << ";\n"; break;
+        case OpCode::GT: out_ << "    " << second << " = " << second << " > " << top << ";\n"; break;
+        case OpCode::GE: out_ << "    " << second << " = " << second << " >= " << top << ";\n"; break;
+        case OpCode::AND: out_ << "    " << second << " = " << second << " && " << top << ";\n"; break;
+        case OpCode::OR:  out_ << "    " << second << " = " << second << " || " << top << ";\n"; break;
+        case OpCode::NOT: out_ << "    " << top << " = !" << top << ";\n"; break;
+
+        case OpCode::JMP: emitJump("", v, d); break;
+        case OpCode::JZ:  emitJump(top + " == 0", v, d - 1); break;
+        case OpCode::JNZ: emitJump(top + " != 0", v, d - 1); break;
+
+        case OpCode::CALL: {
+            // 与解释器相同：压入 [ret_addr][old_fp]，进入前一次性检查被调函数的栈帧
+            std::string callee;
+            for (const auto& [name, entry] : bytecode_->functions) {
+                if (entry == v) callee = name;
+            }
+            int need = verifier_->getMaxDepths().at(v) + 2;
+            out_ << "    if (fp + " << d + need << " > STACK_SIZE) sc_error(\"Stack overflow\");\n"
+                 << "    " << next << " = " << pc + 1 << ";\n"
+                 << "    " << at(d + 1) << " = fp;\n"
+                 << "    " << cName(callee) << "(fp + " << d + 2 << ");\n";
+            break;
+        }
+        case OpCode::RET:
+            // 返回值是否存在在编译时就知道（栈深度是静态的）
+            out_ << "    " << at(v) << " = " << (d > 0 ? top : "0") << ";\n"
+                 << "    return;\n";
+            break;
+        case OpCode::RETN:
+            out_ << "    sc_return_block(" << second << ", " << top << ", " << v << ");\n"
+                 << "    return;\n";
+            break;
+
+        case OpCode::PRINT: out_ << "    sc_print(" << top << ");\n"; break;
+        case OpCode::HALT:  out_ << "    sc_halt(fp + " << d << ");\n"; break;
+        case OpCode::ADJSP: break;
+        case OpCode::MEMCPY:
+            out_ << "    sc_memcpy(" << second << ", " << top << ", " << v << ");\n";
+            break;
+        case OpCode::LOADMN:
+            // 地址在栈顶，加载的值从它的位置开始压入
+            out_ << "    sc_load_block(f + " << d - 1 << ", " << top << ", " << v << ");\n";
+            break;
+        case OpCode::STOREMN:
+            out_ << "    sc_store_block(" << top << ", f + " << d - 1 - v << ", " << v << ");\n";
+            break;
+
+        // 超级指令整体翻译（后面的原指令没有单独的栈深度）
+        case OpCode::INCLOCAL:
+            out_ << "    " << at(v) << " = WADD(" << at(v) << ", " << code[pc + 1].operand << ");\n";
+            break;
+        case OpCode::JLT_LOCALS:
+            emitJump(at(v) + " >= " + at(code[pc + 1].operand), code[pc + 3].operand, d);
+            break;
+        case OpCode::JLT_LOCAL_CONST:
+            emitJump(at(v) + " >= " + std::to_string(code[pc + 1].operand), code[pc + 3].operand, d);
+            break;
+        case OpCode::JLE_LOCAL_CONST:
+            emitJump(at(v) + " > " + std::to_string(code[pc + 1].operand), code[pc + 3].operand, d);
+            break;
+        case OpCode::LOADIDX:
+            // LEA k; ADDPTRD s; LOADM
+            out_ << "    " << top << " = sc_load(WADD(STACK_BASE + fp + " << v << ", WMUL(" << top << ", "
+                 << code[pc + 1].operand << ")));\n";
+            break;
+    }
+    return instructionLength(ins.op);
+}
+
+void CBackend::emitMain() {
+    std::string entry_name;
+    for (const auto& [name, entry] : bytecode_->functions) {
+        if (entry == bytecode_->entry_point) entry_name = name;
+    }
+
+    out_ << "/* 执行一次程序：与 VM::setup 相同，先建立模拟调用 main 的栈帧 [ret_slot][-1][0] */\n"
+         << "static int32_t sc_run(void) {\n"
+         << "    memcpy(globals, globals_init, GLOBALS_SIZE * sizeof(int32_t));\n"
+         << "    stack[0] = 0;\n"
+         << "    stack[1] = -1;\n"
+         << "    stack[2] = 0;\n"
+         << "    if (setjmp(halt_env)) return halt_result;\n"
+         << "    " << cName(entry_name) << "(3);\n"
+         << "    return stack[0];\n"
+         << "}\n"
+         << "\n"
+         << "/* 可选参数：执行次数（性能测试用），给出时打印总耗时 */\n"
+         << "int main(int argc, char** argv) {\n"
+         << "    int runs = argc > 1 ? atoi(argv[1]) : 1;\n"
+         << "    int32_t result = 0;\n"
+         << "    clock_t start = clock();\n"
+         << "    for (int i = 0; i < runs; i++) result = sc_run();\n"
+         << "    clock_t end = clock();\n"
+         << "    printf(\"\\n程序返回值: %d\\n\", (int)result);\n"
+         << "    if (argc > 1) {\n"
+         << "        printf(\"执行 %d 次: %ld μs\\n\", runs, (long)((double)(end - start) * 1000000.0 / CLOCKS_PER_SEC));\n"
+         << "    }\n"
+         << "    return 0;\n"
+         << "}\n";
+}
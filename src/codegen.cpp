@@ -1,6 +1,76 @@
 #include "../include/codegen.h"
+#include <climits>
 #include <stdexcept>
 
+namespace {
+
+// 收集子树中被直接赋值（x = ...）和被取地址（&x）的变量名
+void collectVariableWrites(ASTNode* node, std::unordered_set<std::string>* assigned,
+                           std::unordered_set<std::string>* address_taken) {
+    if (!node) return;
+    auto visit = [&](ASTNode* child) { collectVariableWrites(child, assigned, address_taken); };
+
+    if (auto* binary = nodeCast<BinaryOpNode>(node)) {
+        if (binary->getOperator() == TokenType::Assign && assigned) {
+            if (auto* var = nodeCast<VariableNode>(binary->getLeft())) {
+                assigned->insert(var->getName());
+            }
+        }
+        visit(binary->getLeft());
+        visit(binary->getRight());
+    } else if (auto* unary = nodeCast<UnaryOpNode>(node)) {
+        if (unary->getOperator() == TokenType::Ampersand && address_taken) {
+            if (auto* var = nodeCast<VariableNode>(unary->getOperand())) {
+                address_taken->insert(var->getName());
+            }
+        }
+        visit(unary->getOperand());
+    } else if (auto* call = nodeCast<FunctionCallNode>(node)) {
+        for (const auto& arg : call->getArgs()) visit(arg);
+    } else if (auto* arr = nodeCast<ArrayAccessNode>(node)) {
+        visit(arr->getArray());
+        visit(arr->getIndex());
+    } else if (auto* member = nodeCast<MemberAccessNode>(node)) {
+        visit(member->getObject());
+    } else if (auto* init_list = nodeCast<InitializerListNode>(node)) {
+        for (const auto& elem : init_list->getElements()) visit(elem);
+    } else if (auto* compound = nodeCast<CompoundStmtNode>(node)) {
+        for (const auto& stmt : compound->getStatements()) visit(stmt);
+    } else if (auto* var_decl = nodeCast<VarDeclStmtNode>(node)) {
+        visit(var_decl->getInitializer());
+    } else if (auto* if_stmt = nodeCast<IfStmtNode>(node)) {
+        visit(if_stmt->getCondition());
+        visit(if_stmt->getThenStmt());
+        for (const auto& else_if : if_stmt->getElseIfs()) {
+            visit(else_if.condition);
+            visit(else_if.statement);
+        }
+        visit(if_stmt->getElseStmt());
+    } else if (auto* while_stmt = nodeCast<WhileStmtNode>(node)) {
+        visit(while_stmt->getCondition());
+        visit(while_stmt->getBody());
+    } else if (auto* for_stmt = nodeCast<ForStmtNode>(node)) {
+        visit(for_stmt->getInit());
+        visit(for_stmt->getCondition());
+        visit(for_stmt->getIncrement());
+        visit(for_stmt->getBody());
+    } else if (auto* do_while = nodeCast<DoWhileStmtNode>(node)) {
+        visit(do_while->getBody());
+        visit(do_while->getCondition());
+    } else if (auto* ret = nodeCast<ReturnStmtNode>(node)) {
+        visit(ret->getExpression());
+    } else if (auto* expr_stmt = nodeCast<ExprStmtNode>(node)) {
+        visit(expr_stmt->getExpression());
+    }
+}
+
+// 与 VM 一致的 32 位回绕运算
+int32_t wrapAdd(int32_t a, int32_t b) { return (int32_t)((uint32_t)a + (uint32_t)b); }
+int32_t wrapSub(int32_t a, int32_t b) { return (int32_t)((uint32_t)a - (uint32_t)b); }
+int32_t wrapMul(int32_t a, int32_t b) { return (int32_t)((uint32_t)a * (uint32_t)b); }
+
+}  // namespace
+
 // ========== 类型判断辅助函数实现 ==========
 
 bool CodeGen::isStructType(ExprNode* node) const {
@@ -33,7 +103,7 @@ int CodeGen::getSlotCount(ExprNode* node) const {
     return type ? type->getSlotCount() : 1;
 }
 
-int CodeGen::getSlotCount(std::shared_ptr<Type> type) const {
+int CodeGen::getSlotCount(const Type* type) const {
     return type ? type->getSlotCount() : 1;
 }
 
@@ -41,7 +111,7 @@ bool CodeGen::hasValidType(ExprNode* node) const {
     return node && node->getResolvedType() != nullptr;
 }
 
-std::shared_ptr<Type> CodeGen::getType(ExprNode* node) const {
+const Type* CodeGen::getType(ExprNode* node) const {
     return node ? node->getResolvedType() : nullptr;
 }
 
@@ -60,7 +130,6 @@ ByteCode CodeGen::generate(ProgramNode* program) {
 
     // 2. 收集全局变量初始化信息（包括未初始化的）
     for (const auto& global_var : program->getGlobalVars()) {
-        auto type = global_var->getResolvedType();
         auto* info = findVariable(global_var->getName());
         if (!info || !info->is_global) {
             throw std::runtime_error("Global variable not allocated: " + global_var->getName());
@@ -74,11 +143,11 @@ ByteCode CodeGen::generate(ProgramNode* program) {
             auto* initializer = global_var->getInitializer();
 
             // 检查是否是初始化列表
-            if (auto* init_list = dynamic_cast<InitializerListNode*>(initializer)) {
+            if (auto* init_list = nodeCast<InitializerListNode>(initializer)) {
                 // 初始化列表：逐个求值元素
                 try {
                     for (const auto& elem : init_list->getElements()) {
-                        int32_t value = evaluateConstExpr(elem.get());
+                        int32_t value = evaluateConstExpr(elem);
                         init.init_data.push_back(value);
                     }
                 } catch (const std::runtime_error& e) {
@@ -101,7 +170,7 @@ ByteCode CodeGen::generate(ProgramNode* program) {
 
     // 3. 生成函数代码（正常流程）
     for (const auto& func : program->getFunctions()) {
-        genFunction(func.get());
+        genFunction(func);
     }
 
     // 设置入口点
@@ -118,20 +187,30 @@ void CodeGen::genFunction(FunctionDeclNode* func) {
     code_.functions[func->getName()] = code_.currentAddress();
 
     // ========== 重置新的变量管理系统 ==========
-    variables_.clear();
+    popLocals(0);
     next_local_offset_ = 0;
     next_param_offset_ = -3;
 
+    // 常量传播只在函数内进行；被取过地址的变量可能经由指针修改，全部排除
+    known_locals_.clear();
+    address_taken_.clear();
+    if (constant_folding_) {
+        collectVariableWrites(func->getBody(), nullptr, &address_taken_);
+    }
+
     // 记录参数 slot 数 (用于计算 ret_slot_offset)
     const auto& params = func->getParams();
     current_param_slots_ = 0;
     for (const auto& param : params) {
         auto param_type = param.getResolvedType();
         if (!param_type) {
-            throw std::runtime_error("Parameter type not resolved: " + param.name);
+            throw std::runtime_error("Parameter type not resolved: " + param.name.str());
         }
         current_param_slots_ += param_type->getSlotCount();
     }
+    // 调用者按返回类型预留返回区（void 也预留一个 slot），再压入参数
+    auto return_type = func->getResolvedReturnType();
+    code_.arg_slots[func->getName()] = current_param_slots_ + (return_type ? return_type->getSlotCount() : 1);
 
     // 为参数分配空间（参数在调用前已压栈，位于负偏移）
     // 栈帧布局:
@@ -153,60 +232,102 @@ void CodeGen::genFunction(FunctionDeclNode* func) {
         int offset = param_offset - slot_count + 1;
 
         // 记录到新系统
-        variables_[params[i].name] = VariableInfo(offset, slot_count, false, true);
+        declareLocal(params[i].name.str(), VariableInfo(offset, slot_count, false, true));
 
         param_offset -= slot_count;
     }
 
     // 生成函数体
+    int entry = code_.currentAddress();
     genCompoundStmt(func->getBody());
 
     // 如果函数没有显式 return，添加默认返回
-    if (code_.code.empty() || code_.code.back().op != OpCode::RET) {
+    // 最后一条是 RET/RETN 但有跳转落到函数末尾（if 没有 else 分支、被折叠掉的死代码）时同样需要
+    int end = code_.currentAddress();
+    bool falls_off_end = end == entry ||
+                         (code_.code.back().op != OpCode::RET && code_.code.back().op != OpCode::RETN);
+    for (int pc = entry; pc < end && !falls_off_end; ++pc) {
+        const Instruction& instr = code_.code[pc];
+        if ((instr.op == OpCode::JMP || instr.op == OpCode::JZ || instr.op == OpCode::JNZ) &&
+            instr.operand == end) {
+            falls_off_end = true;
+        }
+    }
+    if (falls_off_end) {
         code_.emit(OpCode::PUSH, 0);  // 默认返回值 0
         // ret_slot_offset = -3 - param_slots
-        // TODO: 支持 struct 返回值时，需调整偏移计算
+        // 返回结构体的函数也是如此：返回区由 caller 压入 0 预留，最后一个 slot 再写一次 0，结果是全 0 的结构体
         code_.emit(OpCode::RET, -3 - current_param_slots_);
     }
 }
 
 void CodeGen::genStatement(StmtNode* stmt) {
-    if (auto* compound = dynamic_cast<CompoundStmtNode*>(stmt)) {
-        genCompoundStmt(compound);
-    } else if (auto* var_decl = dynamic_cast<VarDeclStmtNode*>(stmt)) {
-        genVarDecl(var_decl);
-    } else if (auto* if_stmt = dynamic_cast<IfStmtNode*>(stmt)) {
-        genIfStmt(if_stmt);
-    } else if (auto* while_stmt = dynamic_cast<WhileStmtNode*>(stmt)) {
-        genWhileStmt(while_stmt);
-    } else if (auto* for_stmt = dynamic_cast<ForStmtNode*>(stmt)) {
-        genForStmt(for_stmt);
-    } else if (auto* do_while = dynamic_cast<DoWhileStmtNode*>(stmt)) {
-        genDoWhileStmt(do_while);
-    } else if (auto* ret_stmt = dynamic_cast<ReturnStmtNode*>(stmt)) {
-        genReturnStmt(ret_stmt);
-    } else if (auto* expr_stmt = dynamic_cast<ExprStmtNode*>(stmt)) {
-        genExprStmt(expr_stmt);
-    } else if (dynamic_cast<BreakStmtNode*>(stmt)) {
-        int jmp_addr = code_.currentAddress();
-        code_.emit(OpCode::JMP, 0);
-        break_targets_.push_back(jmp_addr);
-    } else if (dynamic_cast<ContinueStmtNode*>(stmt)) {
-        int jmp_addr = code_.currentAddress();
-        code_.emit(OpCode::JMP, 0);
-        continue_targets_.push_back(jmp_addr);
+    switch (stmt->getKind()) {
+        case NodeKind::Compound:
+            genCompoundStmt(static_cast<CompoundStmtNode*>(stmt));
+            break;
+        case NodeKind::VarDecl:
+            genVarDecl(static_cast<VarDeclStmtNode*>(stmt));
+            break;
+        case NodeKind::If:
+            genIfStmt(static_cast<IfStmtNode*>(stmt));
+            break;
+        case NodeKind::While:
+            genWhileStmt(static_cast<WhileStmtNode*>(stmt));
+            break;
+        case NodeKind::For:
+            genForStmt(static_cast<ForStmtNode*>(stmt));
+            break;
+        case NodeKind::DoWhile:
+            genDoWhileStmt(static_cast<DoWhileStmtNode*>(stmt));
+            break;
+        case NodeKind::Return:
+            genReturnStmt(static_cast<ReturnStmtNode*>(stmt));
+            break;
+        case NodeKind::ExprStmt:
+            genExprStmt(static_cast<ExprStmtNode*>(stmt));
+            break;
+        case NodeKind::Break: {
+            if (loop_local_bases_.empty()) {
+                throw std::runtime_error("break 不在循环内");
+            }
+            // 跳出循环前回收循环体内声明的局部变量，保证跳转目标处的栈深度一致
+            int vars_to_pop = next_local_offset_ - loop_local_bases_.back();
+            if (vars_to_pop > 0) {
+                code_.emit(OpCode::ADJSP, vars_to_pop);
+            }
+            int jmp_addr = code_.currentAddress();
+            code_.emit(OpCode::JMP, 0);
+            break_targets_.push_back(jmp_addr);
+            break;
+        }
+        case NodeKind::Continue: {
+            if (loop_local_bases_.empty()) {
+                throw std::runtime_error("continue 不在循环内");
+            }
+            int vars_to_pop = next_local_offset_ - loop_local_bases_.back();
+            if (vars_to_pop > 0) {
+                code_.emit(OpCode::ADJSP, vars_to_pop);
+            }
+            int jmp_addr = code_.currentAddress();
+            code_.emit(OpCode::JMP, 0);
+            continue_targets_.push_back(jmp_addr);
+            break;
+        }
+        default:
+            // EmptyStmtNode 不生成代码
+            break;
     }
-    // EmptyStmtNode 不生成代码
 }
 
 void CodeGen::genCompoundStmt(CompoundStmtNode* stmt) {
     // ========== 使用新的变量管理系统管理作用域 ==========
     // 保存当前作用域状态
     int saved_offset = next_local_offset_;
-    auto saved_variables = variables_;
+    size_t saved_locals = locals_.size();
 
     for (const auto& s : stmt->getStatements()) {
-        genStatement(s.get());
+        genStatement(s);
     }
 
     // 恢复作用域状态（回收局部变量空间）
@@ -214,8 +335,11 @@ void CodeGen::genCompoundStmt(CompoundStmtNode* stmt) {
     if (vars_to_pop > 0) {
         code_.emit(OpCode::ADJSP, vars_to_pop);
     }
+    for (int offset = saved_offset; offset < next_local_offset_; ++offset) {
+        known_locals_.erase(offset);
+    }
     next_local_offset_ = saved_offset;
-    variables_ = saved_variables;
+    popLocals(saved_locals);
 }
 
 void CodeGen::genVarDecl(VarDeclStmtNode* stmt) {
@@ -228,19 +352,23 @@ void CodeGen::genVarDecl(VarDeclStmtNode* stmt) {
     // 自动计算 slot 数并分配空间
     int offset = allocateVariable(stmt->getName(), type);
     int slot_count = type->getSlotCount();
+    // 偏移可能被同一函数中已结束作用域的变量用过
+    for (int i = 0; i < slot_count; ++i) {
+        known_locals_.erase(offset + i);
+    }
 
     // 初始化变量
     if (stmt->hasInitializer()) {
         auto* initializer = stmt->getInitializer();
 
         // 检查是否是初始化列表
-        if (auto* init_list = dynamic_cast<InitializerListNode*>(initializer)) {
+        if (auto* init_list = nodeCast<InitializerListNode>(initializer)) {
             // 初始化列表：逐个求值并压栈
             const auto& elements = init_list->getElements();
 
             // 1. 先求值所有元素并压栈
             for (const auto& elem : elements) {
-                genExpression(elem.get());
+                genExpression(elem);
             }
 
             // 2. 如果元素数量少于 slot_count，补0
@@ -249,72 +377,92 @@ void CodeGen::genVarDecl(VarDeclStmtNode* stmt) {
             }
         } else {
             // 单个表达式初始化
+            std::optional<int32_t> value = foldConstant(initializer);
             genExpression(initializer);
             // 初始化器会将所有 slot 压栈，这些 slot 就是变量的存储空间
+            if (value && type->isInt() && isPropagatable(stmt->getName())) {
+                known_locals_[offset] = *value;
+            }
         }
     } else {
         // 无初始化器：初始化为 0
         for (int i = 0; i < slot_count; i++) {
             code_.emit(OpCode::PUSH, 0);
         }
+        if (type->isInt() && isPropagatable(stmt->getName())) {
+            known_locals_[offset] = 0;
+        }
     }
-
-    (void)offset;  // 暂时未使用，后续会用到
 }
 
 void CodeGen::genIfStmt(IfStmtNode* stmt) {
-    genExpression(stmt->getCondition());
-
-    int jz_addr = code_.currentAddress();
-    code_.emit(OpCode::JZ, 0);  // 条件为假跳转
-
-    genStatement(stmt->getThenStmt());
-
-    if (stmt->hasElseStmt() || !stmt->getElseIfs().empty()) {
-        // 收集所有需要跳转到末尾的地址
-        std::vector<int> jmp_ends;
-
-        jmp_ends.push_back(code_.currentAddress());
-        code_.emit(OpCode::JMP, 0);  // 跳过 else
+    // if 和各个 else if 依次生成：条件为假跳到下一个分支，分支结束后跳到末尾
+    // 条件是常量时（-O1）：为假的分支不生成，为真的分支无条件执行，其后的分支都不可达
+    std::vector<std::pair<ExprNode*, StmtNode*>> branches;
+    branches.push_back({stmt->getCondition(), stmt->getThenStmt()});
+    for (const auto& else_if : stmt->getElseIfs()) {
+        branches.push_back({else_if.condition, else_if.statement});
+    }
+    bool needs_end_jump = stmt->hasElseStmt() || !stmt->getElseIfs().empty();
 
-        code_.patch(jz_addr, code_.currentAddress());
+    // 收集所有需要跳转到末尾的地址，以及这些分支结束时已知的常量值
+    std::vector<int> jmp_ends;
+    std::vector<KnownValues> branch_states;
+    bool always_taken = false;
 
-        // 处理 else if
-        for (const auto& else_if : stmt->getElseIfs()) {
-            genExpression(else_if->condition.get());
-            int else_if_jz = code_.currentAddress();
-            code_.emit(OpCode::JZ, 0);
+    for (const auto& [condition, body] : branches) {
+        std::optional<int32_t> value = foldConstant(condition);
+        if (value && *value == 0) {
+            continue;
+        }
+        if (value) {
+            genStatement(body);
+            always_taken = true;
+            break;
+        }
 
-            genStatement(else_if->statement.get());
+        std::vector<int> false_jumps = genCondJump(condition, false);  // 条件为假跳转
+        KnownValues not_taken = known_locals_;
+        genStatement(body);
+        branch_states.push_back(known_locals_);
+        known_locals_ = not_taken;
 
+        if (needs_end_jump) {
             jmp_ends.push_back(code_.currentAddress());
-            code_.emit(OpCode::JMP, 0);
-            code_.patch(else_if_jz, code_.currentAddress());
+            code_.emit(OpCode::JMP, 0);  // 跳过后面的分支
         }
+        patchJumps(false_jumps, code_.currentAddress());
+    }
 
-        if (stmt->hasElseStmt()) {
-            genStatement(stmt->getElseStmt());
-        }
+    if (!always_taken && stmt->hasElseStmt()) {
+        genStatement(stmt->getElseStmt());
+    }
 
-        // 统一回填所有跳转到末尾
-        for (int addr : jmp_ends) {
-            code_.patch(addr, code_.currentAddress());
-        }
-    } else {
-        code_.patch(jz_addr, code_.currentAddress());
+    // 统一回填所有跳转到末尾
+    patchJumps(jmp_ends, code_.currentAddress());
+    for (const auto& state : branch_states) {
+        intersectKnown(known_locals_, state);
     }
 }
 
 void CodeGen::genWhileStmt(WhileStmtNode* stmt) {
+    // 循环里会被赋值的变量在循环开始处就不再是常量
+    forgetAssignedIn(stmt);
+    KnownValues loop_state = known_locals_;
+    std::optional<int32_t> value = foldConstant(stmt->getCondition());
+    if (value && *value == 0) {
+        return;  // 循环体不可达
+    }
+
     int loop_start = code_.currentAddress();
 
-    genExpression(stmt->getCondition());
-    int jz_addr = code_.currentAddress();
-    code_.emit(OpCode::JZ, 0);
+    std::vector<int> exit_jumps = genCondJump(stmt->getCondition(), false);
 
     size_t break_start = break_targets_.size();
     size_t continue_start = continue_targets_.size();
+    loop_local_bases_.push_back(next_local_offset_);
     genStatement(stmt->getBody());
+    loop_local_bases_.pop_back();
 
     // 回填 continue 到 loop_start（条件检查）
     for (size_t i = continue_start; i < continue_targets_.size(); ++i) {
@@ -323,13 +471,14 @@ void CodeGen::genWhileStmt(WhileStmtNode* stmt) {
     continue_targets_.resize(continue_start);
 
     code_.emit(OpCode::JMP, loop_start);
-    code_.patch(jz_addr, code_.currentAddress());
+    patchJumps(exit_jumps, code_.currentAddress());
 
     // 回填 break
     for (size_t i = break_start; i < break_targets_.size(); ++i) {
         code_.patch(break_targets_[i], code_.currentAddress());
     }
     break_targets_.resize(break_start);
+    known_locals_ = loop_state;
 }
 
 void CodeGen::genForStmt(ForStmtNode* stmt) {
@@ -337,18 +486,27 @@ void CodeGen::genForStmt(ForStmtNode* stmt) {
         genStatement(stmt->getInit());
     }
 
+    forgetAssignedIn(stmt);
+    KnownValues loop_state = known_locals_;
+    if (stmt->hasCondition()) {
+        std::optional<int32_t> value = foldConstant(stmt->getCondition());
+        if (value && *value == 0) {
+            return;  // 循环体和增量都不可达
+        }
+    }
+
     int loop_start = code_.currentAddress();
-    int jz_addr = -1;
+    std::vector<int> exit_jumps;
 
     if (stmt->hasCondition()) {
-        genExpression(stmt->getCondition());
-        jz_addr = code_.currentAddress();
-        code_.emit(OpCode::JZ, 0);
+        exit_jumps = genCondJump(stmt->getCondition(), false);
     }
 
     size_t break_start = break_targets_.size();
     size_t continue_start = continue_targets_.size();
+    loop_local_bases_.push_back(next_local_offset_);
     genStatement(stmt->getBody());
+    loop_local_bases_.pop_back();
 
     // 回填 continue 到 increment
     int increment_addr = code_.currentAddress();
@@ -357,30 +515,34 @@ void CodeGen::genForStmt(ForStmtNode* stmt) {
     }
     continue_targets_.resize(continue_start);
 
+    // 增量也是 continue 的目标，从循环开始时的状态出发
+    known_locals_ = loop_state;
     if (stmt->hasIncrement()) {
         genExpression(stmt->getIncrement());
         code_.emit(OpCode::POP);  // 丢弃增量表达式的值
     }
 
     code_.emit(OpCode::JMP, loop_start);
-
-    if (jz_addr >= 0) {
-        code_.patch(jz_addr, code_.currentAddress());
-    }
+    patchJumps(exit_jumps, code_.currentAddress());
 
     // 回填 break
     for (size_t i = break_start; i < break_targets_.size(); ++i) {
         code_.patch(break_targets_[i], code_.currentAddress());
     }
     break_targets_.resize(break_start);
+    known_locals_ = loop_state;
 }
 
 void CodeGen::genDoWhileStmt(DoWhileStmtNode* stmt) {
+    forgetAssignedIn(stmt);
+    KnownValues loop_state = known_locals_;
     int loop_start = code_.currentAddress();
 
     size_t break_start = break_targets_.size();
     size_t continue_start = continue_targets_.size();
+    loop_local_bases_.push_back(next_local_offset_);
     genStatement(stmt->getBody());
+    loop_local_bases_.pop_back();
 
     // 回填 continue 到条件检查
     int cond_addr = code_.currentAddress();
@@ -389,14 +551,15 @@ void CodeGen::genDoWhileStmt(DoWhileStmtNode* stmt) {
     }
     continue_targets_.resize(continue_start);
 
-    genExpression(stmt->getCondition());
-    code_.emit(OpCode::JNZ, loop_start);
+    known_locals_ = loop_state;
+    patchJumps(genCondJump(stmt->getCondition(), true), loop_start);
 
     // 回填 break
     for (size_t i = break_start; i < break_targets_.size(); ++i) {
         code_.patch(break_targets_[i], code_.currentAddress());
     }
     break_targets_.resize(break_start);
+    known_locals_ = loop_state;
 }
 
 void CodeGen::genReturnStmt(ReturnStmtNode* stmt) {
@@ -405,25 +568,28 @@ void CodeGen::genReturnStmt(ReturnStmtNode* stmt) {
 
         // ========== 使用类型判断辅助函数 ==========
         if (isStructType(expr)) {
-            // 结构体返回值：需要将结构体复制到 ret_slot
+            // 结构体返回值：[src_addr, ret_slot 地址] 后一条 RETN 复制整个结构体并返回
             int slot_count = getSlotCount(expr);
 
             // 计算 ret_slot 的位置：fp - 3 - param_slots - (slot_count - 1)
             // ret_slot 占据多个 slot，从 fp - 3 - param_slots - (slot_count - 1) 开始
             int ret_slot_base = -3 - current_param_slots_ - (slot_count - 1);
 
-            // 执行表达式，将结构体的所有 slot 压栈
-            genExpression(expr);
-
-            // 现在栈顶有 slot_count 个值，需要将它们存储到 ret_slot
-            // 从栈顶弹出并存储到 ret_slot（从高地址到低地址）
-            for (int i = slot_count - 1; i >= 0; --i) {
-                code_.emit(OpCode::STORE, ret_slot_base + i);
+            if (auto* call = nodeCast<FunctionCallNode>(expr)) {
+                // 被调函数的返回值留在栈顶，紧接在局部变量之后（语句开始时操作数栈为空）
+                genFunctionCall(call);
+                code_.emit(OpCode::LEA, next_local_offset_);
+            } else {
+                // 变量、成员、数组元素、解引用：直接从原位置复制，不经过操作数栈
+                genStructAddr(expr);
             }
-        } else {
-            // 普通返回值（int、指针等）
-            genExpression(expr);
+            code_.emit(OpCode::LEA, ret_slot_base);
+            code_.emit(OpCode::RETN, slot_count);
+            return;
         }
+
+        // 普通返回值（int、指针等）
+        genExpression(expr);
     } else {
         code_.emit(OpCode::PUSH, 0);  // void 函数默认返回 0
     }
@@ -438,56 +604,84 @@ void CodeGen::genExprStmt(ExprStmtNode* stmt) {
 }
 
 void CodeGen::genExpression(ExprNode* expr) {
-    if (auto* num = dynamic_cast<NumberNode*>(expr)) {
-        code_.emit(OpCode::PUSH, num->getValue());
-    } else if (auto* var = dynamic_cast<VariableNode*>(expr)) {
-        // ========== Phase 6: 支持全局变量访问 ==========
-        auto* info = findVariable(var->getName());
-        if (!info) {
-            throw std::runtime_error("Unknown variable: " + var->getName());
-        }
+    if (std::optional<int32_t> value = foldConstant(expr)) {
+        code_.emit(OpCode::PUSH, *value);
+        return;
+    }
 
-        if (info->is_global) {
-            // 全局变量：使用 LOADG
-            if (isStructType(var)) {
-                // 全局结构体：需要加载所有 slot
-                int slot_count = getSlotCount(var);
-                for (int i = 0; i < slot_count; ++i) {
-                    code_.emit(OpCode::LOADG, info->offset + i);
-                }
-            } else {
-                // 普通全局变量：加载 1 个 slot
-                code_.emit(OpCode::LOADG, info->offset);
-            }
-        } else {
-            // 局部变量：使用 LOAD
-            if (isStructType(var)) {
-                int slot_count = getSlotCount(var);
-                for (int i = 0; i < slot_count; ++i) {
-                    code_.emit(OpCode::LOAD, info->offset + i);
-                }
-            } else {
-                code_.emit(OpCode::LOAD, info->offset);
+    // 结构体的值：按地址一条 LOADMN 压入所有 slot
+    // （函数调用的返回值本来就在栈上；结构体赋值表达式的值是第一个 slot）
+    if (isStructType(expr) && expr->getKind() != NodeKind::FunctionCall &&
+        expr->getKind() != NodeKind::BinaryOp) {
+        genStructAddr(expr);
+        code_.emit(OpCode::LOADMN, getSlotCount(expr));
+        return;
+    }
+
+    switch (expr->getKind()) {
+        case NodeKind::Number:
+            code_.emit(OpCode::PUSH, static_cast<NumberNode*>(expr)->getValue());
+            break;
+        case NodeKind::Variable: {
+            auto* var = static_cast<VariableNode*>(expr);
+            // ========== Phase 6: 支持全局变量访问 ==========
+            auto* info = findVariable(var->getName());
+            if (!info) {
+                throw std::runtime_error("Unknown variable: " + var->getName());
             }
+
+            // 全局变量使用 LOADG，局部变量使用 LOAD
+            code_.emit(info->is_global ? OpCode::LOADG : OpCode::LOAD, info->offset);
+            break;
         }
-    } else if (auto* binary = dynamic_cast<BinaryOpNode*>(expr)) {
-        genBinaryOp(binary);
-    } else if (auto* unary = dynamic_cast<UnaryOpNode*>(expr)) {
-        genUnaryOp(unary);
-    } else if (auto* call = dynamic_cast<FunctionCallNode*>(expr)) {
-        genFunctionCall(call);
-    } else if (auto* arr = dynamic_cast<ArrayAccessNode*>(expr)) {
-        genArrayAccess(arr);
-    } else if (auto* member = dynamic_cast<MemberAccessNode*>(expr)) {
-        genMemberAccess(member);
+        case NodeKind::BinaryOp:
+            genBinaryOp(static_cast<BinaryOpNode*>(expr));
+            break;
+        case NodeKind::UnaryOp:
+            genUnaryOp(static_cast<UnaryOpNode*>(expr));
+            break;
+        case NodeKind::FunctionCall:
+            genFunctionCall(static_cast<FunctionCallNode*>(expr));
+            break;
+        case NodeKind::ArrayAccess:
+            genArrayAccess(static_cast<ArrayAccessNode*>(expr));
+            break;
+        case NodeKind::MemberAccess:
+            genMemberAccess(static_cast<MemberAccessNode*>(expr));
+            break;
+        default:
+            break;
     }
 }
 
 void CodeGen::genBinaryOp(BinaryOpNode* expr) {
     // 赋值运算符特殊处理
     if (expr->getOperator() == TokenType::Assign) {
+        // 结构体整体赋值：左值可以是变量、成员、数组元素或解引用
+        if (isStructType(expr->getLeft())) {
+            ExprNode* left = expr->getLeft();
+            ExprNode* right = expr->getRight();
+            int slot_count = getSlotCount(left);
+            if (auto* call = nodeCast<FunctionCallNode>(right)) {
+                // 返回值已经在栈上：一条 STOREMN 存入目标
+                genFunctionCall(call);
+                genStructAddr(left);
+                code_.emit(OpCode::STOREMN, slot_count);
+            } else {
+                // 源和目标都在内存中：[src_addr, dst_addr] 后一条 MEMCPY
+                genStructAddr(right);
+                genStructAddr(left);
+                code_.emit(OpCode::MEMCPY, slot_count);
+            }
+
+            // 赋值表达式返回值：加载第一个 slot（简化处理）
+            genStructAddr(left);
+            code_.emit(OpCode::LOADM);
+            return;
+        }
+
         // 检查是否是数组赋值（支持多维）
-        if (auto* arr = dynamic_cast<ArrayAccessNode*>(expr->getLeft())) {
+        if (auto* arr = nodeCast<ArrayAccessNode>(expr->getLeft())) {
             // arr[index] = value
             genExpression(expr->getRight());  // 计算值
             genArrayAccessAddr(arr);          // 计算地址
@@ -500,68 +694,19 @@ void CodeGen::genBinaryOp(BinaryOpNode* expr) {
         }
 
         // 检查是否是成员访问赋值 obj.member = value
-        if (auto* member = dynamic_cast<MemberAccessNode*>(expr->getLeft())) {
-            // ========== 使用类型判断辅助函数 ==========
-            if (isStructType(member)) {
-                // 结构体成员赋值：需要复制多个 slot
-                int slot_count = getSlotCount(member);
-
-                // 计算右值（可能是函数调用返回结构体）
-                genExpression(expr->getRight());
-                // 现在栈顶有 slot_count 个值：[val_0, val_1, ..., val_n-1]
-
-                // 计算目标成员的地址
-                genMemberAccessAddr(member);
-                // 栈顶现在是：[val_0, val_1, ..., val_n-1, addr]
-
-                // 我们需要将 addr 移到最底下，然后逐个 STOREM
-                // 但是这很复杂，让我们用另一种方法：
-                // 从栈顶弹出 addr，然后逐个弹出值并存储
-
-                // 方案：使用 MEMCPY 的逆向操作
-                // 栈布局：[val_0, val_1, ..., val_n-1, addr]
-                // 我们需要：逐个存储 val_i 到 addr+i
-
-                // 先将所有值和地址重新排列
-                // 实际上，我们可以直接从高地址到低地址存储
-
-                // 弹出地址，保存到栈底
-                // 然后从栈顶弹出值，通过地址存储
-
-                // 简化方案：直接计算每个成员的地址并存储
-                for (int i = slot_count - 1; i >= 0; --i) {
-                    // 栈顶是 addr（如果 i == slot_count-1）或者是 val_i+1
-                    if (i == slot_count - 1) {
-                        // 第一次：栈顶是 addr
-                        code_.emit(OpCode::ADDPTR, i);  // addr + i
-                        code_.emit(OpCode::STOREM);     // 存储 val_i
-                    } else {
-                        // 后续：需要重新计算地址
-                        genMemberAccessAddr(member);
-                        code_.emit(OpCode::ADDPTR, i);
-                        code_.emit(OpCode::STOREM);
-                    }
-                }
-
-                // 赋值表达式返回值：加载第一个 slot
-                genMemberAccessAddr(member);
-                code_.emit(OpCode::LOADM);
-                return;
-            } else {
-                // 普通成员赋值（int、指针等）
-                genExpression(expr->getRight());  // 计算值
-                genMemberAccessAddr(member);      // 计算成员地址
-                code_.emit(OpCode::STOREM);       // 存储
+        if (auto* member = nodeCast<MemberAccessNode>(expr->getLeft())) {
+            genExpression(expr->getRight());  // 计算值
+            genMemberAccessAddr(member);      // 计算成员地址
+            code_.emit(OpCode::STOREM);       // 存储
 
-                // 赋值表达式返回值，重新加载
-                genMemberAccessAddr(member);
-                code_.emit(OpCode::LOADM);
-                return;
-            }
+            // 赋值表达式返回值，重新加载
+            genMemberAccessAddr(member);
+            code_.emit(OpCode::LOADM);
+            return;
         }
 
         // 检查是否是解引用赋值 *p = value
-        if (auto* unary = dynamic_cast<UnaryOpNode*>(expr->getLeft())) {
+        if (auto* unary = nodeCast<UnaryOpNode>(expr->getLeft())) {
             if (unary->getOperator() == TokenType::Multiply) {
                 genExpression(expr->getRight());     // 计算要存储的值
                 genExpression(unary->getOperand());  // 计算指针值（地址）
@@ -574,86 +719,13 @@ void CodeGen::genBinaryOp(BinaryOpNode* expr) {
         }
 
         // 普通变量赋值
-        auto* var = dynamic_cast<VariableNode*>(expr->getLeft());
+        auto* var = nodeCast<VariableNode>(expr->getLeft());
         if (!var) {
             throw std::runtime_error("Invalid assignment target");
         }
 
-        // ========== 使用类型判断辅助函数 ==========
-        // 检查是否是结构体赋值
-        if (isStructType(expr->getLeft())) {
-            // 结构体整体赋值：使用 MEMCPY
-            int slot_count = getSlotCount(expr->getLeft());
-
-            // 计算源地址（右边）
-            // 右边可以是变量或函数调用
-            if (auto* right_var = dynamic_cast<VariableNode*>(expr->getRight())) {
-                // 右边是变量：直接获取地址
-                auto* src_info = findVariable(right_var->getName());
-                if (!src_info) {
-                    throw std::runtime_error("Unknown variable: " + right_var->getName());
-                }
-                if (src_info->is_global) {
-                    code_.emit(OpCode::LEAG, src_info->offset);  // 源地址（全局）
-                } else {
-                    code_.emit(OpCode::LEA, src_info->offset);  // 源地址（局部）
-                }
-            } else if (auto* right_call = dynamic_cast<FunctionCallNode*>(expr->getRight())) {
-                // 右边是函数调用：函数返回值会在栈上（ret_slot位置）
-                // 先调用函数，ret_slot（多个slot）会被压栈
-                genFunctionCall(right_call);
-                // 现在栈顶有 slot_count 个值（ret_slot）
-                // 我们需要将它们复制到目标变量
-                // 计算目标地址
-                int dst_offset = getLocal(var->getName());
-                code_.emit(OpCode::LEA, dst_offset);  // 目标地址压栈
-
-                // 现在栈布局：[ret_slot_0, ret_slot_1, ..., dst_addr]
-                // 我们需要：[dst_addr, src_addr]，然后 MEMCPY
-                // 但是 ret_slot 已经在栈上了，我们需要获取它的地址
-
-                // 方案：逐个 STORE 到目标位置
-                // 先弹出目标地址
-                code_.emit(OpCode::POP);  // 弹出 dst_addr（暂时不用）
-
-                // 从栈顶弹出 slot_count 个值，存储到目标变量
-                for (int i = slot_count - 1; i >= 0; --i) {
-                    code_.emit(OpCode::STORE, dst_offset + i);
-                }
-
-                // 赋值表达式返回值：加载第一个 slot
-                code_.emit(OpCode::LOAD, dst_offset);
-                return;
-            } else {
-                throw std::runtime_error("结构体赋值的右边必须是变量或函数调用");
-            }
-
-            // 计算目标地址（左边）
-            auto* dst_info = findVariable(var->getName());
-            if (!dst_info) {
-                throw std::runtime_error("Unknown variable: " + var->getName());
-            }
-
-            // 先把目标地址压栈（用于 MEMCPY）
-            if (dst_info->is_global) {
-                code_.emit(OpCode::LEAG, dst_info->offset);  // 目标地址（全局）
-            } else {
-                code_.emit(OpCode::LEA, dst_info->offset);  // 目标地址（局部）
-            }
-
-            // 执行内存复制
-            code_.emit(OpCode::MEMCPY, slot_count);
-
-            // 赋值表达式返回值：加载第一个 slot（简化处理）
-            if (dst_info->is_global) {
-                code_.emit(OpCode::LOADG, dst_info->offset);
-            } else {
-                code_.emit(OpCode::LOAD, dst_info->offset);
-            }
-            return;
-        }
-
         // 普通变量赋值（int、指针等）
+        std::optional<int32_t> value = foldConstant(expr->getRight());
         genExpression(expr->getRight());
 
         // ========== Phase 6: 支持全局变量赋值 ==========
@@ -670,10 +742,20 @@ void CodeGen::genBinaryOp(BinaryOpNode* expr) {
             // 局部变量：使用 STORE
             code_.emit(OpCode::STORE, info->offset);
             code_.emit(OpCode::LOAD, info->offset);  // 赋值表达式返回值
+            if (value && isIntType(var) && isPropagatable(var->getName())) {
+                known_locals_[info->offset] = *value;
+            } else {
+                known_locals_.erase(info->offset);
+            }
         }
         return;
     }
 
+    if (expr->getOperator() == TokenType::LogicalAnd || expr->getOperator() == TokenType::LogicalOr) {
+        genLogicalOp(expr);
+        return;
+    }
+
     genExpression(expr->getLeft());
     genExpression(expr->getRight());
 
@@ -689,17 +771,77 @@ void CodeGen::genBinaryOp(BinaryOpNode* expr) {
         case TokenType::LessEqual:    code_.emit(OpCode::LE);  break;
         case TokenType::Greater:      code_.emit(OpCode::GT);  break;
         case TokenType::GreaterEqual: code_.emit(OpCode::GE);  break;
-        case TokenType::LogicalAnd:   code_.emit(OpCode::AND); break;
-        case TokenType::LogicalOr:    code_.emit(OpCode::OR);  break;
         default:
             throw std::runtime_error("Unknown binary operator");
     }
 }
 
+void CodeGen::genLogicalOp(BinaryOpNode* expr) {
+    // 作为值使用时：短路跳转后分别压入 1 / 0
+    //   a && b:  <a> JZ F; <b> JZ F; PUSH 1; JMP E; F: PUSH 0; E:
+    std::vector<int> false_jumps = genCondJump(expr, false);
+    code_.emit(OpCode::PUSH, 1);
+    int jmp_end = code_.currentAddress();
+    code_.emit(OpCode::JMP, 0);
+    patchJumps(false_jumps, code_.currentAddress());
+    code_.emit(OpCode::PUSH, 0);
+    code_.patch(jmp_end, code_.currentAddress());
+}
+
+std::vector<int> CodeGen::genCondJump(ExprNode* cond, bool jump_if) {
+    // 常量条件：要么无条件跳转，要么不生成任何代码
+    if (std::optional<int32_t> value = foldConstant(cond)) {
+        if ((*value != 0) != jump_if) {
+            return {};
+        }
+        int addr = code_.currentAddress();
+        code_.emit(OpCode::JMP, 0);
+        return {addr};
+    }
+
+    if (auto* bin = nodeCast<BinaryOpNode>(cond)) {
+        TokenType op = bin->getOperator();
+        if (op == TokenType::LogicalAnd || op == TokenType::LogicalOr) {
+            // a && b 为假 <=> a 为假或 b 为假；a || b 为真 <=> a 为真或 b 为真
+            bool short_circuit = (op == TokenType::LogicalOr);
+            // 右操作数不一定执行，其中的赋值之后变量值未知
+            if (jump_if == short_circuit) {
+                std::vector<int> jumps = genCondJump(bin->getLeft(), jump_if);
+                std::vector<int> right = genCondJump(bin->getRight(), jump_if);
+                forgetAssignedIn(bin->getRight());
+                jumps.insert(jumps.end(), right.begin(), right.end());
+                return jumps;
+            }
+            // 否则左操作数决定结果时跳过右操作数，落到整个条件之后
+            std::vector<int> skip = genCondJump(bin->getLeft(), short_circuit);
+            std::vector<int> jumps = genCondJump(bin->getRight(), jump_if);
+            forgetAssignedIn(bin->getRight());
+            patchJumps(skip, code_.currentAddress());
+            return jumps;
+        }
+    }
+    if (auto* unary = nodeCast<UnaryOpNode>(cond)) {
+        if (unary->getOperator() == TokenType::LogicalNot) {
+            return genCondJump(unary->getOperand(), !jump_if);
+        }
+    }
+
+    genExpression(cond);
+    int addr = code_.currentAddress();
+    code_.emit(jump_if ? OpCode::JNZ : OpCode::JZ, 0);
+    return {addr};
+}
+
+void CodeGen::patchJumps(const std::vector<int>& jumps, int target) {
+    for (int addr : jumps) {
+        code_.patch(addr, target);
+    }
+}
+
 void CodeGen::genUnaryOp(UnaryOpNode* expr) {
     // 取地址运算符 &
     if (expr->getOperator() == TokenType::Ampersand) {
-        if (auto* var = dynamic_cast<VariableNode*>(expr->getOperand())) {
+        if (auto* var = nodeCast<VariableNode>(expr->getOperand())) {
             // ========== Phase 6: 支持全局变量取地址 ==========
             auto* info = findVariable(var->getName());
             if (!info) {
@@ -714,11 +856,11 @@ void CodeGen::genUnaryOp(UnaryOpNode* expr) {
                 code_.emit(OpCode::LEA, info->offset);
             }
             return;
-        } else if (auto* member = dynamic_cast<MemberAccessNode*>(expr->getOperand())) {
+        } else if (auto* member = nodeCast<MemberAccessNode>(expr->getOperand())) {
             // 取结构体成员的地址：&obj.member
             genMemberAccessAddr(member);
             return;
-        } else if (auto* arr = dynamic_cast<ArrayAccessNode*>(expr->getOperand())) {
+        } else if (auto* arr = nodeCast<ArrayAccessNode>(expr->getOperand())) {
             // 取数组元素的地址：&arr[i]
             genArrayAccessAddr(arr);
             return;
@@ -760,44 +902,12 @@ void CodeGen::genFunctionCall(FunctionCallNode* expr) {
     }
 
     // 2. 压入参数（从右到左）
-    // 对于结构体参数，需要压入多个 slot
     int total_param_slots = 0;
     for (int i = expr->getArgs().size() - 1; i >= 0; --i) {
-        auto arg = expr->getArgs()[i].get();
-
-        // ========== 使用类型判断辅助函数 ==========
-        if (isStructType(arg)) {
-            // 结构体参数：需要压入多个 slot
-            int slot_count = getSlotCount(arg);
-            total_param_slots += slot_count;
-
-            // 获取结构体变量的地址，然后逐个 slot 压栈
-            if (auto* var = dynamic_cast<VariableNode*>(arg)) {
-                int offset = getLocal(var->getName());
-                // 从低地址到高地址压入（保持内存布局）
-                for (int j = 0; j < slot_count; ++j) {
-                    code_.emit(OpCode::LOAD, offset + j);
-                }
-            } else if (auto* member = dynamic_cast<MemberAccessNode*>(arg)) {
-                // 结构体成员访问：先获取地址，然后逐个加载
-                genMemberAccessAddr(member);
-                // 地址在栈顶，需要逐个加载 slot
-                for (int j = 0; j < slot_count; ++j) {
-                    if (j > 0) {
-                        // 重新计算地址（因为 LOADM 会消耗栈顶）
-                        genMemberAccessAddr(member);
-                        code_.emit(OpCode::ADDPTR, j);
-                    }
-                    code_.emit(OpCode::LOADM);
-                }
-            } else {
-                throw std::runtime_error("Unsupported struct argument type");
-            }
-        } else {
-            // 普通参数（int、指针等）：压入 1 个 slot
-            genExpression(arg);
-            total_param_slots += 1;
-        }
+        auto arg = expr->getArgs()[i];
+        // 结构体参数按值传递：genExpression 一次压入所有 slot
+        genExpression(arg);
+        total_param_slots += isStructType(arg) ? getSlotCount(arg) : 1;
     }
 
     // 3. 查找函数地址并调用
@@ -819,7 +929,7 @@ void CodeGen::genFunctionCall(FunctionCallNode* expr) {
 
 // ========== 新的统一变量管理系统实现 ==========
 
-int CodeGen::allocateVariable(const std::string& name, std::shared_ptr<Type> type) {
+int CodeGen::allocateVariable(const std::string& name, const Type* type) {
     if (!type) {
         throw std::runtime_error("Cannot allocate variable without type: " + name);
     }
@@ -830,12 +940,12 @@ int CodeGen::allocateVariable(const std::string& name, std::shared_ptr<Type> typ
     next_local_offset_ += slot_count;
 
     // 记录到新系统
-    variables_[name] = VariableInfo(offset, slot_count, false, false);
+    declareLocal(name, VariableInfo(offset, slot_count, false, false));
 
     return offset;
 }
 
-int CodeGen::allocateGlobalVariable(const std::string& name, std::shared_ptr<Type> type) {
+int CodeGen::allocateGlobalVariable(const std::string& name, const Type* type) {
     if (!type) {
         throw std::runtime_error("Cannot allocate global variable without type: " + name);
     }
@@ -850,11 +960,26 @@ int CodeGen::allocateGlobalVariable(const std::string& name, std::shared_ptr<Typ
     return offset;
 }
 
+void CodeGen::declareLocal(const std::string& name, const VariableInfo& info) {
+    auto it = local_index_.try_emplace(name, -1).first;
+    locals_.push_back({&it->first, info, it->second});
+    it->second = static_cast<int>(locals_.size()) - 1;
+}
+
+void CodeGen::popLocals(size_t count) {
+    while (locals_.size() > count) {
+        const LocalVariable& local = locals_.back();
+        local_index_.find(*local.name)->second = local.shadowed;
+        locals_.pop_back();
+    }
+}
+
+// 返回的指针在下一次声明局部变量之前有效
 const VariableInfo* CodeGen::findVariable(const std::string& name) const {
     // 先查局部变量（包括参数）
-    auto it = variables_.find(name);
-    if (it != variables_.end()) {
-        return &it->second;
+    auto it = local_index_.find(name);
+    if (it != local_index_.end() && it->second >= 0) {
+        return &locals_[it->second].info;
     }
 
     // 再查全局变量
@@ -913,13 +1038,24 @@ void CodeGen::genArrayAccessAddr(ArrayAccessNode* expr) {
     int elem_size = 1;
     if (isArrayType(expr->getArray())) {
         auto array_type = expr->getArray()->getResolvedType();
-        auto* arr = static_cast<ArrayType*>(array_type.get());
+        auto* arr = static_cast<const ArrayType*>(array_type);
         elem_size = arr->getElementType()->getSlotCount();
     }
 
-    genExpression(expr->getIndex());
+    // 常量下标（-O1）：偏移在编译时算出，并入 LEA/LEAG 或生成 ADDPTR，不再需要 ADDPTRD
+    std::optional<int32_t> index = foldConstant(expr->getIndex());
+    int64_t static_offset = index ? (int64_t)*index * elem_size : 0;
+    if (static_offset < INT32_MIN / 2 || static_offset > INT32_MAX / 2) {
+        index.reset();
+        static_offset = 0;
+    }
+    if (!index) {
+        genExpression(expr->getIndex());
+    }
 
-    if (auto* var = dynamic_cast<VariableNode*>(expr->getArray())) {
+    ExprNode* base = expr->getArray();
+    if (base->getKind() == NodeKind::Variable) {
+        auto* var = static_cast<VariableNode*>(base);
         // ========== Phase 6: 支持全局数组 ==========
         auto* info = findVariable(var->getName());
         if (!info) {
@@ -928,19 +1064,26 @@ void CodeGen::genArrayAccessAddr(ArrayAccessNode* expr) {
 
         if (info->is_global) {
             // 全局数组：使用 LEAG
-            code_.emit(OpCode::LEAG, info->offset);
+            code_.emit(OpCode::LEAG, info->offset + (int32_t)static_offset);
         } else {
             // 局部数组：使用 LEA
-            code_.emit(OpCode::LEA, info->offset);
+            code_.emit(OpCode::LEA, info->offset + (int32_t)static_offset);
+        }
+    } else {
+        if (base->getKind() == NodeKind::ArrayAccess) {
+            genArrayAccessAddr(static_cast<ArrayAccessNode*>(base));
+        } else if (base->getKind() == NodeKind::MemberAccess) {
+            // 成员访问返回的数组：c.arr[0]
+            genMemberAccessAddr(static_cast<MemberAccessNode*>(base));
+        }
+        if (static_offset != 0) {
+            code_.emit(OpCode::ADDPTR, (int32_t)static_offset);
         }
-    } else if (auto* inner = dynamic_cast<ArrayAccessNode*>(expr->getArray())) {
-        genArrayAccessAddr(inner);
-    } else if (auto* member = dynamic_cast<MemberAccessNode*>(expr->getArray())) {
-        // 成员访问返回的数组：c.arr[0]
-        genMemberAccessAddr(member);
     }
 
-    code_.emit(OpCode::ADDPTRD, elem_size);
+    if (!index) {
+        code_.emit(OpCode::ADDPTRD, elem_size);
+    }
 }
 
 // 生成成员访问表达式（加载值）
@@ -957,42 +1100,58 @@ void CodeGen::genMemberAccessAddr(MemberAccessNode* expr) {
     }
 
     auto object_type = expr->getObject()->getResolvedType();
-    auto struct_type = std::dynamic_pointer_cast<StructType>(object_type);
-    int member_offset = struct_type->getMemberOffset(expr->getMember());
+    auto* struct_type = static_cast<const StructType*>(object_type);
+    if (expr->getMemberIndex() < 0) {
+        throw std::runtime_error("Unknown member: " + expr->getMember());
+    }
+    int member_offset = struct_type->getMemberOffset(expr->getMemberIndex());
 
-    // 计算对象基地址 + 成员偏移
-    if (auto* var = dynamic_cast<VariableNode*>(expr->getObject())) {
+    // 计算对象基地址 + 成员偏移：对象是变量时偏移直接并入 LEA/LEAG
+    ExprNode* object = expr->getObject();
+    if (auto* var = nodeCast<VariableNode>(object)) {
         // ========== Phase 6: 支持全局结构体成员 ==========
         auto* info = findVariable(var->getName());
         if (!info) {
             throw std::runtime_error("Unknown variable: " + var->getName());
         }
+        code_.emit(info->is_global ? OpCode::LEAG : OpCode::LEA, info->offset + member_offset);
+        return;
+    }
+    genStructAddr(object);
+    code_.emit(OpCode::ADDPTR, member_offset);
+}
 
-        if (info->is_global) {
-            // 全局结构体：使用 LEAG
-            code_.emit(OpCode::LEAG, info->offset + member_offset);
-        } else {
-            // 局部结构体：使用 LEA
-            code_.emit(OpCode::LEA, info->offset + member_offset);
+// 生成结构体值所在的地址
+void CodeGen::genStructAddr(ExprNode* expr) {
+    switch (expr->getKind()) {
+        case NodeKind::Variable: {
+            auto* var = static_cast<VariableNode*>(expr);
+            auto* info = findVariable(var->getName());
+            if (!info) {
+                throw std::runtime_error("Unknown variable: " + var->getName());
+            }
+            code_.emit(info->is_global ? OpCode::LEAG : OpCode::LEA, info->offset);
+            break;
         }
-    } else if (auto* inner_member = dynamic_cast<MemberAccessNode*>(expr->getObject())) {
-        // 链式成员访问：obj.inner.member
-        genMemberAccessAddr(inner_member);
-        code_.emit(OpCode::ADDPTR, member_offset);
-    } else if (auto* arr = dynamic_cast<ArrayAccessNode*>(expr->getObject())) {
-        // 数组元素的成员访问：arr[i].member
-        genArrayAccessAddr(arr);
-        code_.emit(OpCode::ADDPTR, member_offset);
-    } else if (auto* deref = dynamic_cast<UnaryOpNode*>(expr->getObject())) {
-        // 解引用的成员访问：(*ptr).member 或 ptr->member
-        if (deref->getOperator() == TokenType::Multiply) {
+        case NodeKind::MemberAccess:
+            // 链式成员访问：obj.inner.member
+            genMemberAccessAddr(static_cast<MemberAccessNode*>(expr));
+            break;
+        case NodeKind::ArrayAccess:
+            // 数组元素：arr[i].member
+            genArrayAccessAddr(static_cast<ArrayAccessNode*>(expr));
+            break;
+        case NodeKind::UnaryOp: {
+            // 解引用：(*ptr).member 或 ptr->member
+            auto* deref = static_cast<UnaryOpNode*>(expr);
+            if (deref->getOperator() != TokenType::Multiply) {
+                throw std::runtime_error("Unsupported unary operator in member access");
+            }
             genExpression(deref->getOperand());  // 计算指针值（地址）
-            code_.emit(OpCode::ADDPTR, member_offset);
-        } else {
-            throw std::runtime_error("Unsupported unary operator in member access");
+            break;
         }
-    } else {
-        throw std::runtime_error("Unsupported member access pattern");
+        default:
+            throw std::runtime_error("结构体的值必须是变量、成员、数组元素、解引用或函数调用");
     }
 }
 
@@ -1000,19 +1159,19 @@ void CodeGen::genMemberAccessAddr(MemberAccessNode* expr) {
 
 int32_t CodeGen::evaluateConstExpr(ExprNode* expr) {
     // 1. 数字字面量
-    if (auto* num = dynamic_cast<NumberNode*>(expr)) {
+    if (auto* num = nodeCast<NumberNode>(expr)) {
         return num->getValue();
     }
 
     // 2. 二元运算表达式
-    if (auto* binop = dynamic_cast<BinaryOpNode*>(expr)) {
+    if (auto* binop = nodeCast<BinaryOpNode>(expr)) {
         int32_t left = evaluateConstExpr(binop->getLeft());
         int32_t right = evaluateConstExpr(binop->getRight());
 
         switch (binop->getOperator()) {
-            case TokenType::Plus:     return left + right;
-            case TokenType::Minus:    return left - right;
-            case TokenType::Multiply: return left * right;
+            case TokenType::Plus:     return wrapAdd(left, right);
+            case TokenType::Minus:    return wrapSub(left, right);
+            case TokenType::Multiply: return wrapMul(left, right);
             case TokenType::Divide:
                 if (right == 0) {
                     throw std::runtime_error("常量表达式中除以零");
@@ -1037,12 +1196,12 @@ int32_t CodeGen::evaluateConstExpr(ExprNode* expr) {
     }
 
     // 3. 一元运算表达式
-    if (auto* unary = dynamic_cast<UnaryOpNode*>(expr)) {
+    if (auto* unary = nodeCast<UnaryOpNode>(expr)) {
         switch (unary->getOperator()) {
             case TokenType::Minus: {
                 // 负数: -expr
                 int32_t value = evaluateConstExpr(unary->getOperand());
-                return -value;
+                return wrapSub(0, value);
             }
             case TokenType::LogicalNot: {
                 // 逻辑非: !expr
@@ -1051,7 +1210,7 @@ int32_t CodeGen::evaluateConstExpr(ExprNode* expr) {
             }
             case TokenType::Ampersand: {
                 // 取地址: &global_var
-                auto* var = dynamic_cast<VariableNode*>(unary->getOperand());
+                auto* var = nodeCast<VariableNode>(unary->getOperand());
                 if (!var) {
                     throw std::runtime_error("取地址运算符只能用于变量");
                 }
@@ -1074,10 +1233,114 @@ int32_t CodeGen::evaluateConstExpr(ExprNode* expr) {
     }
 
     // 4. 变量引用（只允许全局变量，但这通常不是常量）
-    if (auto* var = dynamic_cast<VariableNode*>(expr)) {
+    if (auto* var = nodeCast<VariableNode>(expr)) {
         throw std::runtime_error("全局变量初始化不能使用其他变量的值: " + var->getName());
     }
 
     // 5. 其他表达式类型不支持
     throw std::runtime_error("全局变量初始化必须是编译时常量表达式");
 }
+
+// ========== 常量折叠与传播 ==========
+
+std::optional<int32_t> CodeGen::foldConstant(ExprNode* expr) const {
+    if (!constant_folding_ || !expr) {
+        return std::nullopt;
+    }
+
+    if (auto* num = nodeCast<NumberNode>(expr)) {
+        return num->getValue();
+    }
+
+    if (auto* var = nodeCast<VariableNode>(expr)) {
+        auto* info = findVariable(var->getName());
+        if (!info || info->is_global) return std::nullopt;
+        auto it = known_locals_.find(info->offset);
+        if (it == known_locals_.end()) return std::nullopt;
+        return it->second;
+    }
+
+    if (auto* binop = nodeCast<BinaryOpNode>(expr)) {
+        TokenType op = binop->getOperator();
+        if (op == TokenType::Assign) {
+            return std::nullopt;
+        }
+        std::optional<int32_t> left = foldConstant(binop->getLeft());
+
+        // 短路：左操作数决定结果时右操作数不会执行，不要求它是常量
+        if (op == TokenType::LogicalAnd || op == TokenType::LogicalOr) {
+            if (!left) return std::nullopt;
+            bool left_true = *left != 0;
+            if (left_true == (op == TokenType::LogicalOr)) return left_true ? 1 : 0;
+            std::optional<int32_t> right = foldConstant(binop->getRight());
+            if (!right) return std::nullopt;
+            return *right != 0 ? 1 : 0;
+        }
+
+        if (!left) return std::nullopt;
+        std::optional<int32_t> right = foldConstant(binop->getRight());
+        if (!right) return std::nullopt;
+        int32_t l = *left, r = *right;
+        switch (op) {
+            case TokenType::Plus:     return wrapAdd(l, r);
+            case TokenType::Minus:    return wrapSub(l, r);
+            case TokenType::Multiply: return wrapMul(l, r);
+            case TokenType::Divide:
+            case TokenType::Modulo:
+                if (r == 0 || (l == INT32_MIN && r == -1)) return std::nullopt;
+                return op == TokenType::Divide ? l / r : l % r;
+            case TokenType::Equal:        return l == r ? 1 : 0;
+            case TokenType::NotEqual:     return l != r ? 1 : 0;
+            case TokenType::Less:         return l < r ? 1 : 0;
+            case TokenType::LessEqual:    return l <= r ? 1 : 0;
+            case TokenType::Greater:      return l > r ? 1 : 0;
+            case TokenType::GreaterEqual: return l >= r ? 1 : 0;
+            default:                      return std::nullopt;
+        }
+    }
+
+    if (auto* unary = nodeCast<UnaryOpNode>(expr)) {
+        TokenType op = unary->getOperator();
+        if (op != TokenType::Plus && op != TokenType::Minus && op != TokenType::LogicalNot) {
+            return std::nullopt;  // & 和 * 与内存有关
+        }
+        std::optional<int32_t> value = foldConstant(unary->getOperand());
+        if (!value) return std::nullopt;
+        if (op == TokenType::Minus) return wrapSub(0, *value);
+        if (op == TokenType::LogicalNot) return *value == 0 ? 1 : 0;
+        return value;
+    }
+
+    return std::nullopt;
+}
+
+bool CodeGen::isPropagatable(const std::string& name) const {
+    auto* info = findVariable(name);
+    return constant_folding_ && info && !info->is_global && info->slot_count == 1 &&
+           address_taken_.count(name) == 0;
+}
+
+void CodeGen::forgetAssignedIn(ASTNode* node) {
+    if (!constant_folding_ || known_locals_.empty()) {
+        return;
+    }
+    std::unordered_set<std::string> assigned;
+    collectVariableWrites(node, &assigned, nullptr);
+    for (const auto& name : assigned) {
+        auto* info = findVariable(name);
+        if (info && !info->is_global) {
+            known_locals_.erase(info->offset);
+        }
+    }
+}
+
+void CodeGen::intersectKnown(KnownValues& into, const KnownValues& other) {
+    for (auto it = into.begin(); it != into.end(); ) {
+        auto found = other.find(it->first);
+        if (found == other.end() || found->second != it->second) {
+            it = into.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
@@ -0,0 +1,185 @@
+#include "../include/inliner.h"
+#include "../include/verifier.h"
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace {
+
+bool isJump(OpCode op) {
+    return op == OpCode::JMP || op == OpCode::JZ || op == OpCode::JNZ;
+}
+
+}  // namespace
+
+// 只统计可达的指令：return 之后 CodeGen 补上的默认返回等不可达代码不会被复制
+bool FunctionInliner::isInlinable(const InstructionBuffer& code, const std::vector<int>& depth,
+                                  const Function& func) const {
+    int count = 0;
+    for (int pc = func.entry; pc < func.end; ++pc) {
+        if (depth[pc] < 0) continue;
+        const Instruction& instr = code[pc];
+        // 返回结构体的函数不内联：RETN 只能改写成 MEMCPY，MEMCPY 按 memmove 处理重叠，
+        // JIT 里还要调用辅助函数，比 RETN 的逐个 slot 复制慢，抵消了省下的 CALL/RET
+        if (instr.op == OpCode::CALL || instr.op == OpCode::HALT || instr.op == OpCode::RETN) {
+            return false;
+        }
+        if (isJump(instr.op) && (instr.operand < func.entry || instr.operand >= func.end)) {
+            return false;
+        }
+        // 最后一条顺序执行会落到下一个函数里
+        if (pc == func.end - 1 && instr.op != OpCode::JMP && instr.op != OpCode::RET) {
+            return false;
+        }
+        if (++count > max_instructions_) {
+            return false;
+        }
+    }
+    return count > 0;
+}
+
+void FunctionInliner::expand(const InstructionBuffer& code, const std::vector<int>& depth,
+                             const Function& callee, int call_depth, std::vector<Instruction>& out) const {
+    auto relocate = [call_depth](int32_t offset) {
+        return offset >= 0 ? call_depth + offset : call_depth + 2 + offset;
+    };
+
+    // 被调函数内的地址 -> out 中的地址；向后的跳转先记下来，最后回填
+    std::vector<int> new_addr(callee.end - callee.entry, -1);
+    std::vector<int> jumps;   // 函数内的跳转
+    std::vector<int> exits;   // 返回：跳到内联代码之后
+
+    int last = callee.end - 1;
+    while (depth[last] < 0) --last;
+
+    for (int pc = callee.entry; pc < callee.end; ++pc) {
+        const int d = depth[pc];
+        if (d < 0) continue;
+        new_addr[pc - callee.entry] = out.size();
+
+        Instruction instr = code[pc];
+        switch (instr.op) {
+            case OpCode::LOAD:
+            case OpCode::STORE:
+            case OpCode::LEA:
+                instr.operand = relocate(instr.operand);
+                out.push_back(instr);
+                break;
+            case OpCode::JMP:
+            case OpCode::JZ:
+            case OpCode::JNZ:
+                jumps.push_back(out.size());
+                out.push_back(instr);
+                break;
+            case OpCode::RET: {
+                // 写入返回值，rest = 之后还留在栈上的被调函数 slot 数
+                int rest = 0;
+                if (d > 0) {
+                    out.emplace_back(OpCode::STORE, relocate(instr.operand));
+                    rest = d - 1;
+                } else {
+                    // 与 RET 相同：栈上没有值时返回 0
+                    out.emplace_back(OpCode::PUSH, 0);
+                    out.emplace_back(OpCode::STORE, relocate(instr.operand));
+                }
+                if (rest > 0) {
+                    out.emplace_back(OpCode::ADJSP, rest);
+                }
+                if (pc != last) {
+                    exits.push_back(out.size());
+                    out.emplace_back(OpCode::JMP, 0);
+                }
+                break;
+            }
+            default:
+                out.push_back(instr);
+                break;
+        }
+    }
+
+    for (int at : jumps) {
+        out[at].operand = new_addr[out[at].operand - callee.entry];
+    }
+    for (int at : exits) {
+        out[at].operand = out.size();
+    }
+}
+
+InlineStats FunctionInliner::run(ByteCode& bytecode) {
+    for (const auto& instr : bytecode.code) {
+        if (instructionLength(instr.op) > 1) {
+            throw std::runtime_error("函数内联必须在超级指令融合之前运行");
+        }
+    }
+
+    InlineStats stats;
+    BytecodeVerifier verifier;
+    if (!verifier.verify(bytecode)) {
+        return stats;
+    }
+    const InstructionBuffer& code = bytecode.code;
+    const std::vector<int>& depth = verifier.getStackDepths();
+    const int n = code.size();
+
+    functions_.clear();
+    for (const auto& [name, entry] : bytecode.functions) {
+        functions_.push_back({name, entry, n, false});
+    }
+    std::sort(functions_.begin(), functions_.end(),
+              [](const Function& a, const Function& b) { return a.entry < b.entry; });
+    std::unordered_map<int, size_t> by_entry;
+    for (size_t i = 0; i < functions_.size(); ++i) {
+        if (i + 1 < functions_.size()) functions_[i].end = functions_[i + 1].entry;
+        functions_[i].inlinable = isInlinable(code, depth, functions_[i]);
+        by_entry[functions_[i].entry] = i;
+        stats.inlined_calls.push_back({functions_[i].name, 0});
+    }
+
+    // 旧地址 -> 新地址；原有的跳转和没有内联的 CALL 最后统一改写
+    std::vector<Instruction> out;
+    std::vector<int> new_addr(n + 1);
+    std::vector<int> relocations;
+    for (int pc = 0; pc < n; ++pc) {
+        new_addr[pc] = out.size();
+        const Instruction& instr = code[pc];
+        if (instr.op == OpCode::CALL && depth[pc] >= 0) {
+            auto it = by_entry.find(instr.operand);
+            if (it != by_entry.end() && functions_[it->second].inlinable) {
+                expand(code, depth, functions_[it->second], depth[pc], out);
+                stats.inlined_calls[it->second].second++;
+                continue;
+            }
+        }
+        if (isJump(instr.op) || instr.op == OpCode::CALL) {
+            relocations.push_back(out.size());
+        }
+        out.push_back(instr);
+    }
+    new_addr[n] = out.size();
+
+    stats.inlined_calls.erase(
+        std::remove_if(stats.inlined_calls.begin(), stats.inlined_calls.end(),
+                       [](const std::pair<std::string, int>& entry) { return entry.second == 0; }),
+        stats.inlined_calls.end());
+    if (stats.total() == 0) {
+        return stats;
+    }
+
+    for (int at : relocations) {
+        if (out[at].operand >= 0 && out[at].operand <= n) {
+            out[at].operand = new_addr[out[at].operand];
+        }
+    }
+    InstructionBuffer rewritten;
+    for (const auto& instr : out) {
+        rewritten.emplace_back(instr);
+    }
+    bytecode.code = std::move(rewritten);
+    for (auto& [name, entry] : bytecode.functions) {
+        if (entry >= 0 && entry <= n) entry = new_addr[entry];
+    }
+    if (bytecode.entry_point >= 0 && bytecode.entry_point <= n) {
+        bytecode.entry_point = new_addr[bytecode.entry_point];
+    }
+    return stats;
+}
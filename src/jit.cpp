@@ -0,0 +1,739 @@
+#include "../include/jit.h"
+#include "../include/verifier.h"
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__x86_64__) && defined(__linux__)
+#define SIMPLEC_JIT_X86_64 1
+#include <pthread.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#else
+#define SIMPLEC_JIT_X86_64 0
+#endif
+
+// 机器码调用的 C++ 辅助函数（VM 的友元，可以直接使用 copyMemory）
+// 异常不能穿过没有展开信息的 JIT 栈帧，这里必须把异常转换成错误码
+struct JitRuntime {
+    static void print(int32_t value) {
+        std::cout << "OUTPUT: " << value << "\n";
+    }
+
+    static int32_t copyMemory(JitContext* ctx, int32_t src, int32_t dst, int32_t size) {
+        try {
+            ctx->vm->copyMemory(src, dst, size);
+            return static_cast<int32_t>(JitStatus::Ok);
+        } catch (const std::exception& e) {
+            std::strncpy(ctx->error_message, e.what(), sizeof(ctx->error_message) - 1);
+            ctx->error_message[sizeof(ctx->error_message) - 1] = '\0';
+            return static_cast<int32_t>(JitStatus::MemcpyFailed);
+        }
+    }
+};
+
+std::string jitStatusMessage(JitStatus status, const JitContext& ctx) {
+    switch (status) {
+        case JitStatus::Ok:             return "";
+        case JitStatus::StackOverflow:  return "Stack overflow";
+        case JitStatus::DivisionByZero: return "Division by zero";
+        case JitStatus::LoadOutOfRange:  return "LOADM: 内存访问越界";
+        case JitStatus::StoreOutOfRange: return "STOREM: 内存访问越界";
+        case JitStatus::LoadBlockOutOfRange:  return "LOADMN: 内存访问越界";
+        case JitStatus::StoreBlockOutOfRange: return "STOREMN: 内存访问越界";
+        case JitStatus::ReturnBlockOutOfRange: return "RETN: 内存访问越界";
+        case JitStatus::MemcpyFailed:   return ctx.error_message;
+    }
+    return "JIT: 未知错误";
+}
+
+bool JitCompiler::isSupported() {
+    return SIMPLEC_JIT_X86_64 != 0;
+}
+
+#if SIMPLEC_JIT_X86_64
+
+JitProgram::JitProgram(const ByteCode& bytecode, void* memory, size_t mapped_size, size_t code_size,
+                       int entry_depth)
+    : bytecode_(&bytecode), memory_(memory), mapped_size_(mapped_size),
+      code_size_(code_size), entry_depth_(entry_depth) {}
+
+namespace {
+
+// 主线程的 pthread_getattr_np 要读 /proc/self/maps，每个线程只查一次
+uintptr_t computeNativeStackLimit() {
+    // 余量给 C++ 辅助函数（iostream、memmove）和 VM 保护页的信号处理函数
+    const uintptr_t reserve = 256 * 1024;
+    pthread_attr_t attr;
+    void* base = nullptr;
+    size_t size = 0;
+    if (pthread_getattr_np(pthread_self(), &attr) == 0) {
+        pthread_attr_getstack(&attr, &base, &size);
+        pthread_attr_destroy(&attr);
+    }
+    if (base == nullptr) {
+        // 取不到栈的范围时保守地假定当前位置以下还有 1 MB
+        return reinterpret_cast<uintptr_t>(&attr) - 1024 * 1024 + reserve;
+    }
+    return reinterpret_cast<uintptr_t>(base) + reserve;
+}
+
+}  // namespace
+
+uintptr_t jitNativeStackLimit() {
+    static thread_local const uintptr_t limit = computeNativeStackLimit();
+    return limit;
+}
+
+JitProgram::~JitProgram() {
+    munmap(memory_, mapped_size_);
+}
+
+namespace {
+
+// ========== x86-64 指令编码 ==========
+
+enum Reg : int {
+    RAX = 0, RCX = 1, RDX = 2, RBX = 3, RSP = 4, RBP = 5, RSI = 6, RDI = 7,
+    R12 = 12, R13 = 13, R14 = 14, R15 = 15,
+};
+constexpr int NO_INDEX = -1;
+
+// 内存操作数 [base + index * scale + disp]
+struct Mem {
+    int base;
+    int index;
+    int scale;
+    int32_t disp;
+};
+
+// 条件码（Jcc / SETcc 操作码的低 4 位）
+enum Cond : uint8_t {
+    CC_B = 0x2, CC_AE = 0x3, CC_E = 0x4, CC_NE = 0x5, CC_BE = 0x6, CC_A = 0x7,
+    CC_L = 0xC, CC_GE = 0xD, CC_LE = 0xE, CC_G = 0xF,
+};
+
+// ALU 指令在 0x81/0x83 编码中的扩展码（ModRM.reg）
+enum AluExt : int { ALU_ADD = 0, ALU_OR = 1, ALU_AND = 4, ALU_SUB = 5, ALU_CMP = 7 };
+
+// 只实现模板用到的指令；跳转统一用 rel32，先记录位置，最后回填
+class Assembler {
+public:
+    std::vector<uint8_t> buf;
+
+    int newLabel() {
+        labels_.push_back(-1);
+        return (int)labels_.size() - 1;
+    }
+    void bind(int label) { labels_[label] = (int)buf.size(); }
+
+    // 回填所有跳转偏移
+    void resolve() {
+        for (const auto& [pos, label] : fixups_) {
+            if (labels_[label] < 0) {
+                throw std::runtime_error("JIT: 跳转标签未绑定");
+            }
+            int32_t rel = labels_[label] - (pos + 4);
+            std::memcpy(&buf[pos], &rel, 4);
+        }
+    }
+
+    // ----- 数据传送 -----
+    void load32(int reg, const Mem& m) { rm(0x8B, reg, m); }
+    void store32(const Mem& m, int reg) { rm(0x89, reg, m); }
+    void load64(int reg, const Mem& m) { rm(0x8B, reg, m, true); }
+    void store64(const Mem& m, int reg) { rm(0x89, reg, m, true); }
+    void storeImm(const Mem& m, int32_t imm) { rm(0xC7, 0, m); imm32(imm); }
+    void lea32(int reg, const Mem& m) { rm(0x8D, reg, m); }
+    void lea64(int reg, const Mem& m) { rm(0x8D, reg, m, true); }
+    void mov64(int dst, int src) { rr(0x89, src, dst, true); }
+    void movImm32(int reg, int32_t imm) {
+        if (reg & 8) byte(0x41);
+        byte(0xB8 + (reg & 7));
+        imm32(imm);
+    }
+    void movImm64(int reg, uint64_t imm) {
+        rex(true, 0, NO_INDEX, reg);
+        byte(0xB8 + (reg & 7));
+        for (int i = 0; i < 8; i++) byte((imm >> (8 * i)) & 0xFF);
+    }
+    void movzxByte(int reg, int reg8) { byte(0x0F); byte(0xB6); modrmReg(reg, reg8); }
+
+    // ----- 运算 -----
+    // opcode: 0x03 add, 0x2B sub, 0x23 and, 0x0B or, 0x3B cmp（reg op= [mem]）
+    void aluRegMem(uint8_t opcode, int reg, const Mem& m, bool w = false) { rm(opcode, reg, m, w); }
+    void aluMemImm(AluExt ext, const Mem& m, int32_t imm) { rm(0x81, ext, m); imm32(imm); }
+    void aluRegImm(AluExt ext, int reg, int32_t imm, bool w = false) {
+        rex(w, 0, NO_INDEX, reg);
+        if (imm >= -128 && imm <= 127) {
+            byte(0x83);
+            modrmReg(ext, reg);
+            byte((uint8_t)imm);
+        } else {
+            byte(0x81);
+            modrmReg(ext, reg);
+            imm32(imm);
+        }
+    }
+    void addRegReg(int dst, int src) { rr(0x01, src, dst); }
+    void imulRegMem(int reg, const Mem& m) { rex(false, reg, m.index, m.base); byte(0x0F); byte(0xAF); modrm(reg, m); }
+    void imulRegMemImm(int reg, const Mem& m, int32_t imm) { rm(0x69, reg, m); imm32(imm); }
+    void negMem(const Mem& m) { rm(0xF7, 3, m); }
+    void negReg(int reg) { rex(false, 0, NO_INDEX, reg); byte(0xF7); modrmReg(3, reg); }
+    void cdq() { byte(0x99); }
+    void idivReg(int reg) { rex(false, 0, NO_INDEX, reg); byte(0xF7); modrmReg(7, reg); }
+    void testReg(int reg) { rr(0x85, reg, reg); }
+    void xorReg(int reg) { rr(0x31, reg, reg); }
+    void cmp64(int a, int b) { rr(0x39, b, a, true); }
+    void setcc(Cond cc, int reg8) { byte(0x0F); byte(0x90 | cc); modrmReg(0, reg8); }
+    void andByte(int dst8, int src8) { byte(0x20); modrmReg(src8, dst8); }
+    void orByte(int dst8, int src8) { byte(0x08); modrmReg(src8, dst8); }
+
+    // ----- 控制流 -----
+    void jmp(int label) { byte(0xE9); fixup(label); }
+    void jcc(Cond cc, int label) { byte(0x0F); byte(0x80 | cc); fixup(label); }
+    void call(int label) { byte(0xE8); fixup(label); }
+    void callReg(int reg) { rex(false, 0, NO_INDEX, reg); byte(0xFF); modrmReg(2, reg); }
+    void ret() { byte(0xC3); }
+    void push(int reg) { if (reg & 8) byte(0x41); byte(0x50 + (reg & 7)); }
+    void pop(int reg) { if (reg & 8) byte(0x41); byte(0x58 + (reg & 7)); }
+
+private:
+    std::vector<int> labels_;
+    std::vector<std::pair<int, int>> fixups_;  // (rel32 所在位置, 标签)
+
+    void byte(uint8_t b) { buf.push_back(b); }
+    void imm32(int32_t v) {
+        uint32_t u = (uint32_t)v;
+        for (int i = 0; i < 4; i++) byte((u >> (8 * i)) & 0xFF);
+    }
+    void fixup(int label) {
+        fixups_.emplace_back((int)buf.size(), label);
+        imm32(0);
+    }
+
+    void rex(bool w, int reg, int index, int base) {
+        uint8_t r = 0x40 | (w ? 0x08 : 0) | ((reg & 8) ? 0x04 : 0) |
+                    ((index != NO_INDEX && (index & 8)) ? 0x02 : 0) | ((base & 8) ? 0x01 : 0);
+        if (r != 0x40) byte(r);
+    }
+
+    // 内存操作数统一使用 disp32 形式（mod = 10），base 为 rsp/r12 或带 index 时需要 SIB
+    void modrm(int reg, const Mem& m) {
+        if (m.index == NO_INDEX && (m.base & 7) != 4) {
+            byte(0x80 | ((reg & 7) << 3) | (m.base & 7));
+        } else {
+            int index = m.index == NO_INDEX ? 4 : m.index;
+            int scale = m.scale == 8 ? 3 : m.scale == 4 ? 2 : m.scale == 2 ? 1 : 0;
+            byte(0x80 | ((reg & 7) << 3) | 4);
+            byte((scale << 6) | ((index & 7) << 3) | (m.base & 7));
+        }
+        imm32(m.disp);
+    }
+    void modrmReg(int reg, int rmreg) { byte(0xC0 | ((reg & 7) << 3) | (rmreg & 7)); }
+
+    void rm(uint8_t opcode, int reg, const Mem& m, bool w = false) {
+        rex(w, reg, m.index, m.base);
+        byte(opcode);
+        modrm(reg, m);
+    }
+    void rr(uint8_t opcode, int reg, int rmreg, bool w = false) {
+        rex(w, reg, NO_INDEX, rmreg);
+        byte(opcode);
+        modrmReg(reg, rmreg);
+    }
+};
+
+// ========== 字节码 -> 机器码 ==========
+//
+// 寄存器约定（都是 callee-saved，调用 C++ 辅助函数时不需要保存）：
+//   rbx = 栈基址  r12 = sp  r13 = fp  r14 = 全局区基址  r15 = JitContext*
+// sp/fp 是 slot 下标，stack[i] 的地址是 rbx + i * 4。rax/rcx/rdx 是临时寄存器。
+
+Mem sp(int32_t k) { return {RBX, R12, 4, k * 4}; }       // stack[sp + k]
+Mem local(int32_t k) { return {RBX, R13, 4, k * 4}; }    // stack[fp + k]
+Mem global(int32_t k) { return {R14, NO_INDEX, 1, (VM::GLOBAL_BASE + k) * 4}; }  // memory[GLOBAL_BASE + k]
+Mem ctxField(size_t offset) { return {R15, NO_INDEX, 1, (int32_t)offset}; }
+const Mem TOP = sp(-1);
+const Mem SECOND = sp(-2);
+
+class Translator {
+public:
+    Translator(const ByteCode& bytecode, const BytecodeVerifier& verifier)
+        : bytecode_(bytecode), verifier_(verifier), stack_base_(VM::stackBase(bytecode.global_inits)) {}
+
+    std::vector<uint8_t> translate() {
+        const auto& code = bytecode_.code;
+        const int n = code.size();
+
+        for (int i = 0; i <= n; i++) pc_labels_.push_back(as_.newLabel());
+        exit_common_ = as_.newLabel();
+        for (int i = 0; i < STATUS_COUNT; i++) error_labels_.push_back(as_.newLabel());
+
+        emitEntry();
+        for (int pc = 0; pc < n;) {
+            as_.bind(pc_labels_[pc]);
+            int len = emitInstruction(pc);
+            // 超级指令后面的原指令不会是跳转目标（校验器保证），绑定到下一条之前即可
+            for (int k = 1; k < len; k++) as_.bind(pc_labels_[pc + k]);
+            pc += len;
+        }
+
+        // 执行到代码末尾 / HALT：正常结束
+        as_.bind(pc_labels_[n]);
+        as_.xorReg(RAX);
+        as_.jmp(exit_common_);
+
+        for (int i = 1; i < STATUS_COUNT; i++) {
+            as_.bind(error_labels_[i]);
+            as_.movImm32(RAX, i);
+            as_.jmp(exit_common_);
+        }
+
+        as_.resolve();
+        return std::move(as_.buf);
+    }
+
+private:
+    static const int STATUS_COUNT = static_cast<int>(JitStatus::MemcpyFailed) + 1;
+    static const int UNROLLED_COPY_SLOTS = 16;   // LOADMN/STOREMN/RETN 不超过这个大小时展开复制
+
+    const ByteCode& bytecode_;
+    const BytecodeVerifier& verifier_;
+    const int stack_base_;           // LEA 得到的地址 = 栈基址 + fp + k，对同一个程序是常量
+    Assembler as_;
+    std::vector<int> pc_labels_;     // 每个字节码地址对应的标签（末尾多一个：结束执行）
+    std::vector<int> error_labels_;  // JitStatus -> 错误出口
+    int exit_common_ = -1;
+
+    int errorLabel(JitStatus status) { return error_labels_[static_cast<int>(status)]; }
+
+    void adjustSp(int32_t delta) {
+        if (delta != 0) as_.aluRegImm(ALU_ADD, R12, delta, true);
+    }
+    void pushRax() {
+        as_.store32(sp(0), RAX);
+        adjustSp(1);
+    }
+
+    // 入口：int32_t entry(JitContext* ctx)
+    // 保存 callee-saved 寄存器，记录原生栈指针，然后像解释器一样"调用" main
+    void emitEntry() {
+        as_.push(RBP);
+        as_.push(RBX);
+        as_.push(R12);
+        as_.push(R13);
+        as_.push(R14);
+        as_.push(R15);
+        as_.aluRegImm(ALU_SUB, RSP, 8, true);  // 保持 16 字节对齐
+        as_.mov64(R15, RDI);
+        as_.store64(ctxField(offsetof(JitContext, saved_rsp)), RSP);
+        as_.load64(RBX, ctxField(offsetof(JitContext, stack)));
+        as_.load64(R14, ctxField(offsetof(JitContext, memory)));
+        as_.load64(R12, ctxField(offsetof(JitContext, sp)));
+        as_.load64(R13, ctxField(offsetof(JitContext, fp)));
+        as_.call(pc_labels_[bytecode_.entry_point]);
+        as_.xorReg(RAX);
+
+        // 公共出口（eax = 状态码）：写回 sp/fp，从任意调用深度恢复进入时的原生栈
+        as_.bind(exit_common_);
+        as_.store64(ctxField(offsetof(JitContext, sp)), R12);
+        as_.store64(ctxField(offsetof(JitContext, fp)), R13);
+        as_.load64(RSP, ctxField(offsetof(JitContext, saved_rsp)));
+        as_.aluRegImm(ALU_ADD, RSP, 8, true);
+        as_.pop(R15);
+        as_.pop(R14);
+        as_.pop(R13);
+        as_.pop(R12);
+        as_.pop(RBX);
+        as_.pop(RBP);
+        as_.ret();
+    }
+
+    // 调用 C++ 辅助函数（参数已经放在 rdi/rsi/rdx/rcx），调用前把原生栈对齐到 16 字节
+    void callHelper(const void* fn) {
+        as_.push(RBP);
+        as_.mov64(RBP, RSP);
+        as_.aluRegImm(ALU_AND, RSP, -16, true);
+        as_.movImm64(RAX, reinterpret_cast<uint64_t>(fn));
+        as_.callReg(RAX);
+        as_.mov64(RSP, RBP);
+        as_.pop(RBP);
+    }
+
+    // 二元运算：stack[sp-2] = stack[sp-2] op stack[sp-1]
+    void binary(uint8_t opcode) {
+        as_.load32(RAX, SECOND);
+        as_.aluRegMem(opcode, RAX, TOP);
+        as_.store32(SECOND, RAX);
+        adjustSp(-1);
+    }
+    void compare(Cond cc) {
+        as_.load32(RAX, SECOND);
+        as_.aluRegMem(0x3B, RAX, TOP);
+        as_.setcc(cc, RAX);
+        as_.movzxByte(RAX, RAX);
+        as_.store32(SECOND, RAX);
+        adjustSp(-1);
+    }
+    void divide(bool mod) {
+        int minus_one = as_.newLabel(), done = as_.newLabel();
+        as_.load32(RCX, TOP);
+        as_.testReg(RCX);
+        as_.jcc(CC_E, errorLabel(JitStatus::DivisionByZero));
+        as_.load32(RAX, SECOND);
+        // INT_MIN / -1 会让 idiv 触发硬件异常，除数为 -1 时单独处理
+        as_.aluRegImm(ALU_CMP, RCX, -1);
+        as_.jcc(CC_E, minus_one);
+        as_.cdq();
+        as_.idivReg(RCX);
+        as_.store32(SECOND, mod ? RDX : RAX);
+        as_.jmp(done);
+        as_.bind(minus_one);
+        if (mod) {
+            as_.storeImm(SECOND, 0);
+        } else {
+            as_.negReg(RAX);
+            as_.store32(SECOND, RAX);
+        }
+        as_.bind(done);
+        adjustSp(-1);
+    }
+    void logical(bool is_and) {
+        as_.load32(RAX, SECOND);
+        as_.testReg(RAX);
+        as_.setcc(CC_NE, RAX);
+        as_.load32(RCX, TOP);
+        as_.testReg(RCX);
+        as_.setcc(CC_NE, RCX);
+        if (is_and) as_.andByte(RAX, RCX);
+        else as_.orByte(RAX, RCX);
+        as_.movzxByte(RAX, RAX);
+        as_.store32(SECOND, RAX);
+        adjustSp(-1);
+    }
+
+    // eax = 地址：全局区和栈在同一段内存里，一次无符号比较检查 [GLOBAL_BASE, 内存大小)
+    // （空指针和负地址减去 GLOBAL_BASE 后按无符号比较都会超出范围）
+    void checkAddress(JitStatus error) {
+        as_.lea32(RDX, {RAX, NO_INDEX, 1, -VM::GLOBAL_BASE});
+        as_.aluRegMem(0x3B, RDX, ctxField(offsetof(JitContext, address_limit)));
+        as_.jcc(CC_AE, errorLabel(error));
+    }
+
+    void loadMemory() {
+        as_.load32(RAX, TOP);
+        checkAddress(JitStatus::LoadOutOfRange);
+        as_.load32(RAX, {R14, RAX, 4, 0});
+        as_.store32(TOP, RAX);
+    }
+
+    void storeMemory() {
+        as_.load32(RAX, TOP);      // addr
+        as_.load32(RCX, SECOND);   // value
+        adjustSp(-2);
+        checkAddress(JitStatus::StoreOutOfRange);
+        as_.store32({R14, RAX, 4, 0}, RCX);
+    }
+
+    // eax = 地址：[addr, addr + size) 整个在内存中，与 VM::validRange 相同
+    // （减去 GLOBAL_BASE 的结果零扩展到 64 位后再加 size，不会回绕）
+    void checkRange(int32_t size, JitStatus error) {
+        as_.lea32(RDX, {RAX, NO_INDEX, 1, -VM::GLOBAL_BASE});
+        as_.lea64(RDX, {RDX, NO_INDEX, 1, size});
+        as_.aluRegMem(0x3B, RDX, ctxField(offsetof(JitContext, address_limit)), true);
+        as_.jcc(CC_A, errorLabel(error));
+    }
+
+    // [rsi] -> [rdi] 按地址从低到高复制 size 个 slot：短的展开，长的生成循环
+    void copySlots(int32_t size) {
+        if (size <= UNROLLED_COPY_SLOTS) {
+            for (int32_t i = 0; i < size; i++) {
+                as_.load32(RCX, {RSI, NO_INDEX, 1, i * 4});
+                as_.store32({RDI, NO_INDEX, 1, i * 4}, RCX);
+            }
+            return;
+        }
+        int loop = as_.newLabel();
+        as_.movImm32(RDX, size);
+        as_.bind(loop);
+        as_.load32(RCX, {RSI, NO_INDEX, 1, 0});
+        as_.store32({RDI, NO_INDEX, 1, 0}, RCX);
+        as_.aluRegImm(ALU_ADD, RSI, 4, true);
+        as_.aluRegImm(ALU_ADD, RDI, 4, true);
+        as_.aluRegImm(ALU_SUB, RDX, 1);
+        as_.jcc(CC_NE, loop);
+    }
+
+    // 加载的值从地址所在的位置开始压入；栈空间已由 CALL 处按校验器算出的栈帧检查过
+    void loadBlock(int32_t size) {
+        as_.load32(RAX, TOP);
+        checkRange(size, JitStatus::LoadBlockOutOfRange);
+        as_.lea64(RSI, {R14, RAX, 4, 0});
+        as_.lea64(RDI, TOP);
+        copySlots(size);
+        adjustSp(size - 1);
+    }
+
+    void storeBlock(int32_t size) {
+        as_.load32(RAX, TOP);
+        adjustSp(-1 - size);
+        checkRange(size, JitStatus::StoreBlockOutOfRange);
+        as_.lea64(RSI, sp(0));
+        as_.lea64(RDI, {R14, RAX, 4, 0});
+        copySlots(size);
+    }
+
+    void call(int pc, int target) {
+        // 进入前一次性检查被调函数的整个栈帧（解释器由保护页检测溢出，JIT 代码自己检查）
+        auto depth = verifier_.getMaxDepths().find(target);
+        int32_t need = (depth != verifier_.getMaxDepths().end() ? depth->second : 0) + 2;
+        as_.lea64(RAX, {R12, NO_INDEX, 1, need});
+        as_.aluRegMem(0x3B, RAX, ctxField(offsetof(JitContext, stack_size)), true);
+        as_.jcc(CC_A, errorLabel(JitStatus::StackOverflow));
+
+        // 原生栈：每层调用压入 8 字节返回地址，深递归时可能比 VM 栈先用完
+        as_.aluRegMem(0x3B, RSP, ctxField(offsetof(JitContext, native_stack_limit)), true);
+        as_.jcc(CC_B, errorLabel(JitStatus::StackOverflow));
+
+        // [ret_addr][old_fp]，与解释器压入的内容相同
+        as_.storeImm(sp(0), pc + 1);
+        as_.store32(sp(1), R13);
+        adjustSp(2);
+        as_.mov64(R13, R12);
+        as_.call(pc_labels_[target]);
+    }
+
+    void ret(int32_t ret_slot_offset) {
+        int no_value = as_.newLabel();
+        as_.xorReg(RAX);
+        as_.cmp64(R12, R13);
+        as_.jcc(CC_BE, no_value);
+        as_.load32(RAX, TOP);
+        as_.bind(no_value);
+        as_.store32(local(ret_slot_offset), RAX);
+        as_.lea64(R12, {R13, NO_INDEX, 1, -2});
+        as_.load32(R13, local(-1));  // 恢复旧的帧指针（32 位加载会清零高位）
+        as_.ret();
+    }
+
+    // dst = stack[sp-1], src = stack[sp-2]：复制到返回区后与 ret 相同地恢复栈帧
+    void retBlock(int32_t size) {
+        as_.load32(RAX, SECOND);
+        checkRange(size, JitStatus::ReturnBlockOutOfRange);
+        as_.lea64(RSI, {R14, RAX, 4, 0});
+        as_.load32(RAX, TOP);
+        checkRange(size, JitStatus::ReturnBlockOutOfRange);
+        as_.lea64(RDI, {R14, RAX, 4, 0});
+        copySlots(size);
+        as_.lea64(R12, {R13, NO_INDEX, 1, -2});
+        as_.load32(R13, local(-1));
+        as_.ret();
+    }
+
+    // 翻译 code[pc]，返回消耗的字节码条数（超级指令连同后面的原指令一起翻译）
+    int emitInstruction(int pc) {
+        const auto& code = bytecode_.code;
+        const Instruction& ins = code[pc];
+        const int32_t v = ins.operand;
+
+        switch (ins.op) {
+            case OpCode::PUSH:
+                as_.storeImm(sp(0), v);
+                adjustSp(1);
+                break;
+            case OpCode::POP:
+                adjustSp(-1);
+                break;
+            case OpCode::LOAD:
+                as_.load32(RAX, local(v));
+                pushRax();
+                break;
+            case OpCode::STORE:
+                adjustSp(-1);
+                as_.load32(RAX, sp(0));
+                as_.store32(local(v), RAX);
+                break;
+            case OpCode::LOADM:
+                loadMemory();
+                break;
+            case OpCode::STOREM:
+                storeMemory();
+                break;
+            case OpCode::LOADMN:
+                loadBlock(v);
+                break;
+            case OpCode::STOREMN:
+                storeBlock(v);
+                break;
+            case OpCode::LOADG:
+                as_.load32(RAX, global(v));
+                pushRax();
+                break;
+            case OpCode::STOREG:
+                adjustSp(-1);
+                as_.load32(RAX, sp(0));
+                as_.store32(global(v), RAX);
+                break;
+            case OpCode::LEAG:
+                as_.storeImm(sp(0), VM::GLOBAL_BASE + v);
+                adjustSp(1);
+                break;
+            case OpCode::LEA:
+            case OpCode::LOADIDX:  // LEA k; ADDPTRD s; LOADM：后两条按原指令翻译
+                as_.lea32(RAX, {R13, NO_INDEX, 1, stack_base_ + v});
+                pushRax();
+                break;
+            case OpCode::ADDPTR:
+                as_.aluMemImm(ALU_ADD, TOP, v);
+                break;
+            case OpCode::ADDPTRD:
+                // base = stack[sp-1], index = stack[sp-2]
+                as_.load32(RAX, TOP);
+                as_.imulRegMemImm(RCX, SECOND, v);
+                as_.addRegReg(RAX, RCX);
+                as_.store32(SECOND, RAX);
+                adjustSp(-1);
+                break;
+
+            case OpCode::ADD: binary(0x03); break;
+            case OpCode::SUB: binary(0x2B); break;
+            case OpCode::MUL:
+                as_.load32(RAX, SECOND);
+                as_.imulRegMem(RAX, TOP);
+                as_.store32(SECOND, RAX);
+                adjustSp(-1);
+                break;
+            case OpCode::DIV: divide(false); break;
+            case OpCode::MOD: divide(true); break;
+            case OpCode::NEG: as_.negMem(TOP); break;
+
+            case OpCode::EQ: compare(CC_E); break;
+            case OpCode::NE: compare(CC_NE); break;
+            case OpCode::LT: compare(CC_L); break;
+            case OpCode::LE: compare(CC_LE); break;
+            case OpCode::GT: compare(CC_G); break;
+            case OpCode::GE: compare(CC_GE); break;
+
+            case OpCode::AND: logical(true); break;
+            case OpCode::OR: logical(false); break;
+            case OpCode::NOT:
+                as_.aluMemImm(ALU_CMP, TOP, 0);
+                as_.setcc(CC_E, RAX);
+                as_.movzxByte(RAX, RAX);
+                as_.store32(TOP, RAX);
+                break;
+
+            case OpCode::JMP:
+                as_.jmp(pc_labels_[v]);
+                break;
+            case OpCode::JZ:
+            case OpCode::JNZ:
+                adjustSp(-1);
+                as_.aluMemImm(ALU_CMP, sp(0), 0);
+                as_.jcc(ins.op == OpCode::JZ ? CC_E : CC_NE, pc_labels_[v]);
+                break;
+
+            case OpCode::CALL:
+                call(pc, v);
+                break;
+            case OpCode::RET:
+                ret(v);
+                break;
+            case OpCode::RETN:
+                retBlock(v);
+                break;
+
+            case OpCode::PRINT:
+                as_.load32(RDI, TOP);
+                callHelper(reinterpret_cast<const void*>(&JitRuntime::print));
+                break;
+            case OpCode::HALT:
+                as_.jmp(pc_labels_[code.size()]);
+                break;
+            case OpCode::ADJSP:
+                adjustSp(-v);
+                break;
+            case OpCode::MEMCPY:
+                // dst = stack[sp-1], src = stack[sp-2]
+                as_.load32(RDX, TOP);
+                as_.load32(RSI, SECOND);
+                adjustSp(-2);
+                as_.mov64(RDI, R15);
+                as_.movImm32(RCX, v);
+                callHelper(reinterpret_cast<const void*>(&JitRuntime::copyMemory));
+                as_.testReg(RAX);
+                as_.jcc(CC_NE, exit_common_);
+                break;
+
+            // ===== 超级指令：直接生成融合后的机器码 =====
+            case OpCode::INCLOCAL:
+                // LOAD x; PUSH c; ADD; STORE x
+                as_.aluMemImm(ALU_ADD, local(v), code[pc + 1].operand);
+                return 4;
+            case OpCode::JLT_LOCALS:
+                // LOAD a; LOAD b; LT; JZ t
+                as_.load32(RAX, local(v));
+                as_.aluRegMem(0x3B, RAX, local(code[pc + 1].operand));
+                as_.jcc(CC_GE, pc_labels_[code[pc + 3].operand]);
+                return 4;
+            case OpCode::JLT_LOCAL_CONST:
+            case OpCode::JLE_LOCAL_CONST:
+                // LOAD a; PUSH c; LT/LE; JZ t
+                as_.load32(RAX, local(v));
+                as_.aluRegImm(ALU_CMP, RAX, code[pc + 1].operand);
+                as_.jcc(ins.op == OpCode::JLT_LOCAL_CONST ? CC_GE : CC_G,
+                        pc_labels_[code[pc + 3].operand]);
+                return 4;
+        }
+        return 1;
+    }
+};
+
+} // namespace
+
+std::unique_ptr<JitProgram> JitCompiler::compile(const ByteCode& bytecode, const BytecodeVerifier& verifier) {
+    if (!verifier.isVerified(bytecode)) {
+        throw std::runtime_error("字节码未通过校验，不能 JIT 编译");
+    }
+
+    std::vector<uint8_t> machine_code = Translator(bytecode, verifier).translate();
+
+    // 先以可写方式映射、写入机器码，再改为只读可执行（W^X）
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t mapped_size = (machine_code.size() + page - 1) / page * page;
+    void* memory = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        throw std::runtime_error("JIT: 无法分配可执行内存");
+    }
+    std::memcpy(memory, machine_code.data(), machine_code.size());
+    if (mprotect(memory, mapped_size, PROT_READ | PROT_EXEC) != 0) {
+        munmap(memory, mapped_size);
+        throw std::runtime_error("JIT: 无法设置可执行权限");
+    }
+
+    auto main_depth = verifier.getMaxDepths().find(bytecode.entry_point);
+    int entry_depth = main_depth != verifier.getMaxDepths().end() ? main_depth->second : 0;
+    return std::make_unique<JitProgram>(bytecode, memory, mapped_size, machine_code.size(), entry_depth);
+}
+
+#else  // !SIMPLEC_JIT_X86_64
+
+JitProgram::JitProgram(const ByteCode& bytecode, void* memory, size_t mapped_size, size_t code_size,
+                       int entry_depth)
+    : bytecode_(&bytecode), memory_(memory), mapped_size_(mapped_size),
+      code_size_(code_size), entry_depth_(entry_depth) {}
+
+JitProgram::~JitProgram() {}
+
+uintptr_t jitNativeStackLimit() {
+    return 0;
+}
+
+std::unique_ptr<JitProgram> JitCompiler::compile(const ByteCode&, const BytecodeVerifier&) {
+    throw std::runtime_error("JIT 仅支持 x86-64 Linux");
+}
+
+#endif
@@ -1,14 +1,122 @@
 #include "../include/lexer.h"
-#include <fstream>
-#include <sstream>
+#include <array>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+// SSE2 是 x86-64 的基础指令集，其他平台只用逐字节扫描
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define SIMPLEC_LEXER_SSE2 1
+#else
+#define SIMPLEC_LEXER_SSE2 0
+#endif
+
+namespace {
+
+// 字符分类表：每个字节一项，一次查表代替一串范围比较
+enum CharClass : uint8_t {
+    CC_DIGIT = 1,         // 0-9
+    CC_IDENT_START = 2,   // 字母、下划线
+    CC_IDENT = 4,         // 标识符中的字符：字母、数字、下划线
+    CC_SPACE = 8,         // 空白
+};
+
+constexpr std::array<uint8_t, 256> makeCharClassTable() {
+    std::array<uint8_t, 256> table{};
+    for (int c = 0; c < 256; ++c) {
+        uint8_t cls = 0;
+        if (c >= '0' && c <= '9') cls |= CC_DIGIT | CC_IDENT;
+        if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_') cls |= CC_IDENT_START | CC_IDENT;
+        if (c == ' ' || c == '\t' || c == '\n' || c == '\r') cls |= CC_SPACE;
+        table[c] = cls;
+    }
+    return table;
+}
+
+constexpr std::array<uint8_t, 256> CHAR_CLASS = makeCharClassTable();
+
+inline bool hasClass(char c, uint8_t cls) {
+    return CHAR_CLASS[static_cast<unsigned char>(c)] & cls;
+}
+
+// 关键字的完美哈希：(首字符 + 尾字符 + 长度) & 31，11 个关键字落在不同的槽里。
+// 表在编译期生成，有冲突时 makeKeywordTable 中的 throw 让常量求值失败，编译报错
+struct KeywordEntry {
+    std::string_view text;
+    TokenType type = TokenType::Invalid;
+};
+
+constexpr size_t KEYWORD_TABLE_SIZE = 32;
+
+constexpr size_t keywordHash(std::string_view str) {
+    return (static_cast<unsigned char>(str.front()) + static_cast<unsigned char>(str.back()) + str.size()) &
+           (KEYWORD_TABLE_SIZE - 1);
+}
+
+constexpr std::array<KeywordEntry, KEYWORD_TABLE_SIZE> makeKeywordTable() {
+    const KeywordEntry keywords[] = {
+        {"int", TokenType::Int}, {"void", TokenType::Void}, {"return", TokenType::Return},
+        {"if", TokenType::If}, {"else", TokenType::Else}, {"while", TokenType::While},
+        {"for", TokenType::For}, {"do", TokenType::Do}, {"break", TokenType::Break},
+        {"continue", TokenType::Continue}, {"struct", TokenType::Struct},
+    };
+    std::array<KeywordEntry, KEYWORD_TABLE_SIZE> table{};
+    for (const auto& keyword : keywords) {
+        KeywordEntry& slot = table[keywordHash(keyword.text)];
+        if (!slot.text.empty()) throw "关键字哈希冲突";
+        slot = keyword;
+    }
+    return table;
+}
+
+constexpr std::array<KeywordEntry, KEYWORD_TABLE_SIZE> KEYWORD_TABLE = makeKeywordTable();
+constexpr size_t MAX_KEYWORD_LENGTH = 8;   // continue
+
+#if SIMPLEC_LEXER_SSE2
+// 16 个字节中每个字节是否是空白，第 i 位对应第 i 个字节
+inline uint32_t whitespaceMask(__m128i chunk) {
+    __m128i space = _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')),
+                                 _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\t')));
+    __m128i line = _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\n')),
+                                _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\r')));
+    return _mm_movemask_epi8(_mm_or_si128(space, line));
+}
 
-Lexer::Lexer(const std::string& source)
+inline uint32_t newlineMask(__m128i chunk) {
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\n')));
+}
+
+// lo <= c <= hi（有符号比较，>= 0x80 的字节是负数，不会落在 ASCII 范围内）
+inline __m128i inRange(__m128i chunk, char lo, char hi) {
+    return _mm_and_si128(_mm_cmpgt_epi8(chunk, _mm_set1_epi8(lo - 1)),
+                         _mm_cmplt_epi8(chunk, _mm_set1_epi8(hi + 1)));
+}
+
+// 标识符中的字符：c | 0x20 把大写字母转成小写，其余 ASCII 字符不会因此落进 a-z
+inline uint32_t identMask(__m128i chunk) {
+    __m128i lower = _mm_or_si128(chunk, _mm_set1_epi8(0x20));
+    __m128i ident = _mm_or_si128(inRange(lower, 'a', 'z'), inRange(chunk, '0', '9'));
+    ident = _mm_or_si128(ident, _mm_cmpeq_epi8(chunk, _mm_set1_epi8('_')));
+    return _mm_movemask_epi8(ident);
+}
+#endif
+
+}  // namespace
+
+bool Lexer::supportsSimd() {
+    return SIMPLEC_LEXER_SSE2;
+}
+
+Lexer::Lexer(std::string_view source)
     : source_(source) {
     initialize();
 }
 
-Lexer::Lexer(const char* filename) {
-    source_ = loadFromFile(filename);
+Lexer::Lexer(const char* filename)
+    : file_(std::make_unique<SourceFile>(filename)) {
+    source_ = file_->text();
     initialize();
 }
 
@@ -16,12 +124,18 @@ Lexer::~Lexer() {
 }
 
 Token Lexer::getNextToken() {
-    // 如果有缓存的Token，直接返回
-    if (has_cached_token_) {
-        has_cached_token_ = false;
-        return current_token_;
+    // 先取缓冲区中已经扫描好的Token
+    if (lookahead_count_ > 0) {
+        Token token = lookahead_[lookahead_head_];
+        lookahead_head_ = (lookahead_head_ + 1) & (lookahead_.size() - 1);
+        lookahead_count_--;
+        return token;
     }
+    tokens_scanned_++;
+    return scanToken();
+}
 
+Token Lexer::scanToken() {
     // 跳过空白字符
     skipWhitespace();
 
@@ -33,12 +147,12 @@ Token Lexer::getNextToken() {
     char c = getCurrentChar();
 
     // 处理数字
-    if (isDigit(c)) {
+    if (hasClass(c, CC_DIGIT)) {
         return readNumber();
     }
 
     // 处理标识符（以字母开头）
-    if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_') {
+    if (hasClass(c, CC_IDENT_START)) {
         return readIdentifier();
     }
 
@@ -75,7 +189,7 @@ Token Lexer::getNextToken() {
             // 检查是否是单行注释
             if (getCurrentChar() == '/') {
                 skipSingleLineComment();
-                return getNextToken(); // 递归获取下一个Token
+                return scanToken(); // 递归获取下一个Token
             }
             return Token(TokenType::Divide, "/", token_line, token_column);
         }
@@ -168,54 +282,39 @@ Token Lexer::getNextToken() {
             int token_line = line_;
             int token_column = column_;
             advance();
-            return Token(TokenType::Invalid, error_msg, token_line, token_column);
+            return makeInvalid(error_msg, token_line, token_column);
     }
 }
 
 Token Lexer::peekNextToken() {
-    // 如果已经有缓存的Token，直接返回
-    if (has_cached_token_) {
-        return current_token_;
-    }
-
-    // 获取下一个Token并缓存
-    current_token_ = getNextToken();
-    has_cached_token_ = true;
-    return current_token_;
+    return peekNthToken(1);
 }
 
-Token Lexer::peekNthToken(size_t n) {
+const Token& Lexer::peekNthToken(size_t n) {
     if (n == 0) {
         throw std::runtime_error("peekNthToken: n 必须从 1 开始");
     }
 
-    // 保存当前状态
-    size_t saved_pos = current_pos_;
-    int saved_line = line_;
-    int saved_column = column_;
-    Token saved_current_token = current_token_;
-    bool saved_has_cached = has_cached_token_;
-
-    // 清除缓存，确保从当前位置开始读取
-    has_cached_token_ = false;
-
-    // 向前读取 n 个 token
-    Token result = Token(TokenType::End, "", line_, column_);
-    for (size_t i = 0; i < n; i++) {
-        result = getNextToken();
-        if (result.is(TokenType::End)) {
-            break;
+    // 缓冲区不够大时翻倍，按顺序搬到新缓冲区的开头
+    if (n > lookahead_.size()) {
+        size_t capacity = lookahead_.size();
+        while (capacity < n) capacity *= 2;
+        std::vector<Token> grown(capacity);
+        for (size_t i = 0; i < lookahead_count_; ++i) {
+            grown[i] = lookahead_[(lookahead_head_ + i) & (lookahead_.size() - 1)];
         }
+        lookahead_.swap(grown);
+        lookahead_head_ = 0;
     }
 
-    // 恢复状态
-    current_pos_ = saved_pos;
-    line_ = saved_line;
-    column_ = saved_column;
-    current_token_ = saved_current_token;
-    has_cached_token_ = saved_has_cached;
-
-    return result;
+    // 只扫描还没有缓冲的部分；到达结尾后 scanToken 一直返回 End
+    size_t mask = lookahead_.size() - 1;
+    while (lookahead_count_ < n) {
+        lookahead_[(lookahead_head_ + lookahead_count_) & mask] = scanToken();
+        lookahead_count_++;
+        tokens_scanned_++;
+    }
+    return lookahead_[(lookahead_head_ + n - 1) & mask];
 }
 
 char Lexer::getCurrentChar() const {
@@ -241,9 +340,50 @@ void Lexer::advance() {
 }
 
 void Lexer::skipWhitespace() {
-    while (!isAtEnd() && isWhitespace(getCurrentChar())) {
-        advance();
+    size_t pos = current_pos_;
+    size_t size = source_.size();
+    const char* data = source_.data();
+
+    // Token 之间大多没有空白，或者只有一个空格
+    if (pos < size && !hasClass(data[pos], CC_SPACE)) return;
+    if (pos + 1 < size && data[pos] == ' ' && !hasClass(data[pos + 1], CC_SPACE)) {
+        current_pos_ = pos + 1;
+        column_++;
+        return;
     }
+
+#if SIMPLEC_LEXER_SSE2
+    // 一次检查 16 个字节：前导空白的长度就是非空白掩码的最低位；只在不越过源代码结尾时使用
+    if (simd_enabled_) {
+        while (pos + 16 <= size) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+            uint32_t run = __builtin_ctz(~whitespaceMask(chunk));   // 0..16
+            uint32_t newlines = newlineMask(chunk) & ((1u << run) - 1);
+            if (newlines) {
+                line_ += __builtin_popcount(newlines);
+                column_ = run - (31 - __builtin_clz(newlines));   // 最后一个换行之后的字符数 + 1
+            } else {
+                column_ += run;
+            }
+            pos += run;
+            if (run < 16) {
+                current_pos_ = pos;
+                return;
+            }
+        }
+    }
+#endif
+
+    while (pos < size && hasClass(data[pos], CC_SPACE)) {
+        if (data[pos] == '\n') {
+            line_++;
+            column_ = 1;
+        } else {
+            column_++;
+        }
+        pos++;
+    }
+    current_pos_ = pos;
 }
 
 Token Lexer::readNumber() {
@@ -251,15 +391,31 @@ Token Lexer::readNumber() {
     int start_line = line_;
     int start_column = column_;
 
-    // 读取所有数字
-    while (!isAtEnd() && isDigit(getCurrentChar())) {
-        advance();
+    // 读取所有数字，同时计算值
+    int64_t value = 0;
+    bool overflow = false;
+    while (!isAtEnd() && hasClass(source_[current_pos_], CC_DIGIT)) {
+        value = value * 10 + (source_[current_pos_] - '0');
+        if (value > INT_MAX) {
+            overflow = true;
+            value = 0;
+        }
+        current_pos_++;
+    }
+    column_ += current_pos_ - start_pos;
+
+    std::string_view number_str = source_.substr(start_pos, current_pos_ - start_pos);
+    if (overflow) {
+        return makeInvalid("整数字面量超出 int 范围: " + std::string(number_str),
+                           start_line, start_column);
     }
 
-    // 提取数字字符串
-    std::string number_str = source_.substr(start_pos, current_pos_ - start_pos);
+    return Token(TokenType::Number, number_str, start_line, start_column, (int32_t)value);
+}
 
-    return Token(TokenType::Number, number_str, start_line, start_column);
+Token Lexer::makeInvalid(std::string message, int line, int column) {
+    messages_.push_back(std::move(message));
+    return Token(TokenType::Invalid, messages_.back(), line, column);
 }
 
 void Lexer::reset() {
@@ -267,31 +423,45 @@ void Lexer::reset() {
 }
 
 void Lexer::initialize() {
+    chars_before_reset_ += current_pos_;
     current_pos_ = 0;
     line_ = 1;
     column_ = 1;
-    has_cached_token_ = false;
-    current_token_ = Token(TokenType::Invalid, "", 1, 1);  // 初始化缓存Token
+    lookahead_.assign(8, Token());   // Parser 最多向前看 3 个（加上指针的 *），8 个很少需要扩容
+    lookahead_head_ = 0;
+    lookahead_count_ = 0;
 }
 
 Token Lexer::readIdentifier() {
-    int start_pos = current_pos_;
+    size_t start_pos = current_pos_;
     int start_line = line_;
     int start_column = column_;
 
-    // 读取标识符（字母、数字、下划线）
-    while (!isAtEnd() && (getCurrentChar() == '_' ||
-                         (getCurrentChar() >= 'a' && getCurrentChar() <= 'z') ||
-                         (getCurrentChar() >= 'A' && getCurrentChar() <= 'Z') ||
-                         (getCurrentChar() >= '0' && getCurrentChar() <= '9'))) {
-        advance();
+    // 读取标识符（字母、数字、下划线），第一个字符已经由 scanToken 检查过
+    size_t pos = current_pos_ + 1;
+    size_t size = source_.size();
+    const char* data = source_.data();
+#if SIMPLEC_LEXER_SSE2
+    if (simd_enabled_) {
+        while (pos + 16 <= size) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+            uint32_t run = __builtin_ctz(~identMask(chunk));
+            pos += run;
+            if (run < 16) break;
+        }
+    }
+#endif
+    while (pos < size && hasClass(data[pos], CC_IDENT)) {
+        pos++;
     }
 
-    std::string identifier = source_.substr(start_pos, current_pos_ - start_pos);
+    // 标识符中没有换行，只需要移动列号
+    current_pos_ = pos;
+    column_ += pos - start_pos;
 
-    // 检查是否是关键字
-    if (isKeyword(identifier)) {
-        TokenType type = getKeywordType(identifier);
+    std::string_view identifier = source_.substr(start_pos, pos - start_pos);
+    TokenType type = getKeywordType(identifier);
+    if (type != TokenType::Invalid) {
         return Token(type, identifier, start_line, start_column);
     }
 
@@ -302,10 +472,12 @@ void Lexer::skipSingleLineComment() {
     // 跳过第二个 '/'
     advance();
 
-    // 跳过直到行尾的所有字符
-    while (!isAtEnd() && getCurrentChar() != '\n') {
-        advance();
-    }
+    // 跳过直到行尾的所有字符（换行本身留给 skipWhitespace）
+    const char* rest = source_.data() + current_pos_;
+    const void* newline = std::memchr(rest, '\n', source_.size() - current_pos_);
+    size_t length = newline ? static_cast<const char*>(newline) - rest : source_.size() - current_pos_;
+    current_pos_ += length;
+    column_ += length;
 }
 
 // 统一读取多字符运算符（处理 =, ==, !, !=, <, <=, >, >=, &, &&, |, ||）
@@ -370,48 +542,14 @@ Token Lexer::readMultiCharOperator(TokenType type) {
     }
 }
 
-bool Lexer::isKeyword(const std::string& str) {
-    return str == "int" || str == "void" || str == "return" ||
-           str == "if" || str == "else" ||
-           str == "while" || str == "for" || str == "do" ||
-           str == "break" || str == "continue" || str == "struct";
-}
-
-TokenType Lexer::getKeywordType(const std::string& str) {
-    if (str == "int") {
-        return TokenType::Int;
-    } else if (str == "void") {
-        return TokenType::Void;
-    } else if (str == "return") {
-        return TokenType::Return;
-    } else if (str == "if") {
-        return TokenType::If;
-    } else if (str == "else") {
-        return TokenType::Else;
-    } else if (str == "while") {
-        return TokenType::While;
-    } else if (str == "for") {
-        return TokenType::For;
-    } else if (str == "do") {
-        return TokenType::Do;
-    } else if (str == "break") {
-        return TokenType::Break;
-    } else if (str == "continue") {
-        return TokenType::Continue;
-    } else if (str == "struct") {
-        return TokenType::Struct;
-    }
-    return TokenType::Invalid;
+bool Lexer::isKeyword(std::string_view str) {
+    return getKeywordType(str) != TokenType::Invalid;
 }
 
-std::string Lexer::loadFromFile(const char* filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        throw std::runtime_error("无法打开文件: " + std::string(filename));
+TokenType Lexer::getKeywordType(std::string_view str) {
+    if (str.size() < 2 || str.size() > MAX_KEYWORD_LENGTH) {
+        return TokenType::Invalid;
     }
-
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    return buffer.str();
+    const KeywordEntry& entry = KEYWORD_TABLE[keywordHash(str)];
+    return entry.text == str ? entry.type : TokenType::Invalid;
 }
-
@@ -2,7 +2,8 @@
 #include <stdexcept>
 #include <iostream>
 
-Parser::Parser(Lexer& lexer) : lexer_(lexer) {
+Parser::Parser(Lexer& lexer)
+    : lexer_(lexer), context_(std::make_unique<ASTContext>()), ctx_(context_.get()) {
     // 获取第一个Token
     currentToken_ = lexer_.getNextToken();
 }
@@ -19,7 +20,7 @@ bool Parser::isAtEnd() const {
     return currentToken_.is(TokenType::End);
 }
 
-std::unique_ptr<ExprNode> Parser::parseExpression() {
+ExprNode* Parser::parseExpression() {
     // 递归下降解析器入口点
     // 表达式语法优先级链（从低到高）:
     // assignment -> logical_or -> logical_and -> equality -> comparison -> term -> factor -> unary -> primary
@@ -27,7 +28,7 @@ std::unique_ptr<ExprNode> Parser::parseExpression() {
 }
 
 // 解析完整表达式并检查语法错误
-std::unique_ptr<ExprNode> Parser::parseCompleteExpression() {
+ExprNode* Parser::parseCompleteExpression() {
     auto expr = parseExpression();
 
     // 检查是否还有未消费的Token
@@ -39,24 +40,24 @@ std::unique_ptr<ExprNode> Parser::parseCompleteExpression() {
 }
 
 // 解析赋值表达式（最低优先级，右结合）
-std::unique_ptr<ExprNode> Parser::parseAssignment() {
+ExprNode* Parser::parseAssignment() {
     // 先解析右边的高优先级表达式
-    std::unique_ptr<ExprNode> expr = parseLogicalOr();
+    ExprNode* expr = parseLogicalOr();
 
     if (match(TokenType::Assign)) {
         advance(); // 消费=
         auto right = parseAssignment(); // 右结合：递归调用自身，a = b = c 解析为 a = (b = c)
 
         // 安全检查：赋值运算符左边必须是变量、数组访问、成员访问或解引用表达式
-        if (dynamic_cast<VariableNode*>(expr.get()) ||
-            dynamic_cast<ArrayAccessNode*>(expr.get()) ||
-            dynamic_cast<MemberAccessNode*>(expr.get())) {
-            return std::make_unique<BinaryOpNode>(std::move(expr), TokenType::Assign, std::move(right));
+        if (nodeCast<VariableNode>(expr) ||
+            nodeCast<ArrayAccessNode>(expr) ||
+            nodeCast<MemberAccessNode>(expr)) {
+            return ctx_->create<BinaryOpNode>(expr, TokenType::Assign, right);
         }
         // 检查是否是解引用表达式 *p = value
-        if (auto* unary = dynamic_cast<UnaryOpNode*>(expr.get())) {
+        if (auto* unary = nodeCast<UnaryOpNode>(expr)) {
             if (unary->getOperator() == TokenType::Multiply) {
-                return std::make_unique<BinaryOpNode>(std::move(expr), TokenType::Assign, std::move(right));
+                return ctx_->create<BinaryOpNode>(expr, TokenType::Assign, right);
             }
         }
         throw std::runtime_error("赋值运算符左边必须是变量、数组元素、成员访问或解引用表达式");
@@ -66,178 +67,178 @@ std::unique_ptr<ExprNode> Parser::parseAssignment() {
 }
 
 // 解析逻辑或表达式（优先级低于逻辑与，左结合）
-std::unique_ptr<ExprNode> Parser::parseLogicalOr() {
-    std::unique_ptr<ExprNode> expr = parseLogicalAnd();
+ExprNode* Parser::parseLogicalOr() {
+    ExprNode* expr = parseLogicalAnd();
 
     // 检查 || 运算符（短路逻辑，左结合）
     while (match(TokenType::LogicalOr)) {
         TokenType op = currentToken_.getType();
         advance(); // 消费||
         auto right = parseLogicalAnd();
-        expr = std::make_unique<BinaryOpNode>(std::move(expr), op, std::move(right));
+        expr = ctx_->create<BinaryOpNode>(expr, op, right);
     }
 
     return expr;
 }
 
 // 解析逻辑与表达式（优先级低于比较运算符，左结合）
-std::unique_ptr<ExprNode> Parser::parseLogicalAnd() {
-    std::unique_ptr<ExprNode> expr = parseEquality();
+ExprNode* Parser::parseLogicalAnd() {
+    ExprNode* expr = parseEquality();
 
     // 检查 && 运算符（短路逻辑，左结合）
     while (match(TokenType::LogicalAnd)) {
         TokenType op = currentToken_.getType();
         advance(); // 消费&&
         auto right = parseEquality();
-        expr = std::make_unique<BinaryOpNode>(std::move(expr), op, std::move(right));
+        expr = ctx_->create<BinaryOpNode>(expr, op, right);
     }
 
     return expr;
 }
 
-std::unique_ptr<ExprNode> Parser::parseEquality() {
+ExprNode* Parser::parseEquality() {
     // 解析等值比较表达式: == 和 !=
-    std::unique_ptr<ExprNode> expr = parseComparison();
+    ExprNode* expr = parseComparison();
 
     // 检查是否有 == 或 != 运算符
     while (match(TokenType::Equal) || match(TokenType::NotEqual)) {
         TokenType op = currentToken_.getType();
         advance(); // 消费运算符
-        std::unique_ptr<ExprNode> right = parseComparison();
+        ExprNode* right = parseComparison();
         // 构建二元运算节点，左结合
-        expr = std::make_unique<BinaryOpNode>(std::move(expr), op, std::move(right));
+        expr = ctx_->create<BinaryOpNode>(expr, op, right);
     }
 
     return expr;
 }
 
-std::unique_ptr<ExprNode> Parser::parseComparison() {
+ExprNode* Parser::parseComparison() {
     // 解析大小比较表达式: <, <=, >, >=
-    std::unique_ptr<ExprNode> expr = parseTerm();
+    ExprNode* expr = parseTerm();
 
     // 检查所有大小比较运算符
     while (match(TokenType::Less) || match(TokenType::LessEqual) ||
            match(TokenType::Greater) || match(TokenType::GreaterEqual)) {
         TokenType op = currentToken_.getType();
         advance(); // 消费运算符
-        std::unique_ptr<ExprNode> right = parseTerm();
+        ExprNode* right = parseTerm();
         // 构建二元运算节点，左结合
-        expr = std::make_unique<BinaryOpNode>(std::move(expr), op, std::move(right));
+        expr = ctx_->create<BinaryOpNode>(expr, op, right);
     }
 
     return expr;
 }
 
-std::unique_ptr<ExprNode> Parser::parseTerm() {
+ExprNode* Parser::parseTerm() {
     // 解析加减法表达式: + 和 -
-    std::unique_ptr<ExprNode> expr = parseFactor();
+    ExprNode* expr = parseFactor();
 
     // 检查加减法运算符（左结合）
     while (match(TokenType::Plus) || match(TokenType::Minus)) {
         TokenType op = currentToken_.getType();
         advance(); // 消费运算符
-        std::unique_ptr<ExprNode> right = parseFactor();
-        expr = std::make_unique<BinaryOpNode>(std::move(expr), op, std::move(right));
+        ExprNode* right = parseFactor();
+        expr = ctx_->create<BinaryOpNode>(expr, op, right);
     }
 
     return expr;
 }
 
-std::unique_ptr<ExprNode> Parser::parseFactor() {
+ExprNode* Parser::parseFactor() {
     // 解析乘除法表达式: *, / 和 %
-    std::unique_ptr<ExprNode> expr = parseUnary();
+    ExprNode* expr = parseUnary();
 
     // 检查乘除法运算符（左结合，比加减法优先级高）
     while (match(TokenType::Multiply) || match(TokenType::Divide) || match(TokenType::Modulo)) {
         TokenType op = currentToken_.getType();
         advance(); // 消费运算符
-        std::unique_ptr<ExprNode> right = parseUnary();
-        expr = std::make_unique<BinaryOpNode>(std::move(expr), op, std::move(right));
+        ExprNode* right = parseUnary();
+        expr = ctx_->create<BinaryOpNode>(expr, op, right);
     }
 
     return expr;
 }
 
-std::unique_ptr<ExprNode> Parser::parseUnary() {
+ExprNode* Parser::parseUnary() {
     // 解析一元运算符: +x, -x, !x, &x, *p（优先级很高，仅次于括号）
     if (match(TokenType::Plus)) {
         advance(); // 消费+
         auto operand = parseUnary(); // 递归解析操作数
-        return std::make_unique<UnaryOpNode>(TokenType::Plus, std::move(operand));
+        return ctx_->create<UnaryOpNode>(TokenType::Plus, operand);
     }
 
     if (match(TokenType::Minus)) {
         advance(); // 消费-
         auto operand = parseUnary(); // 递归解析操作数，支持--x这样的表达式
-        return std::make_unique<UnaryOpNode>(TokenType::Minus, std::move(operand));
+        return ctx_->create<UnaryOpNode>(TokenType::Minus, operand);
     }
 
     if (match(TokenType::LogicalNot)) {
         advance(); // 消费!
         auto operand = parseUnary(); // 递归解析操作数
-        return std::make_unique<UnaryOpNode>(TokenType::LogicalNot, std::move(operand));
+        return ctx_->create<UnaryOpNode>(TokenType::LogicalNot, operand);
     }
 
     if (match(TokenType::Ampersand)) {
         advance(); // 消费&
         auto operand = parseUnary(); // 递归解析操作数
-        return std::make_unique<UnaryOpNode>(TokenType::Ampersand, std::move(operand));
+        return ctx_->create<UnaryOpNode>(TokenType::Ampersand, operand);
     }
 
     if (match(TokenType::Multiply)) {
         advance(); // 消费*
         auto operand = parseUnary(); // 递归解析操作数，支持**p这样的表达式
-        return std::make_unique<UnaryOpNode>(TokenType::Multiply, std::move(operand));
+        return ctx_->create<UnaryOpNode>(TokenType::Multiply, operand);
     }
 
     // 没有一元运算符，直接解析基础表达式
     return parsePrimary();
 }
 
-std::unique_ptr<ExprNode> Parser::parsePrimary() {
+ExprNode* Parser::parsePrimary() {
     // 解析基础表达式：数字、变量、函数调用、数组访问、成员访问、括号表达式
     if (match(TokenType::Number)) {
-        int value = std::stoi(currentToken_.getValue());
+        int value = currentToken_.getNumber();
         advance();
-        return std::make_unique<NumberNode>(value);
+        return ctx_->create<NumberNode>(value);
     }
 
     if (match(TokenType::Identifier)) {
-        std::string name = currentToken_.getValue();
+        Identifier name = ctx_->intern(currentToken_.getValue());
         advance();
         // 检查是否是函数调用
         if (match(TokenType::LParen)) {
             return parseFunctionCall(name);
         }
         // 检查是否是数组访问、成员访问或箭头访问（支持多维和链式）
-        std::unique_ptr<ExprNode> expr = std::make_unique<VariableNode>(name);
+        ExprNode* expr = ctx_->create<VariableNode>(name);
         while (match(TokenType::LBracket) || match(TokenType::Dot) || match(TokenType::Arrow)) {
             if (match(TokenType::LBracket)) {
                 // 数组访问
                 advance(); // 消费[
                 auto index = parseExpression();
                 consume(TokenType::RBracket, "期望 ']' 在数组下标后");
-                expr = std::make_unique<ArrayAccessNode>(std::move(expr), std::move(index));
+                expr = ctx_->create<ArrayAccessNode>(expr, index);
             } else if (match(TokenType::Dot)) {
                 // 成员访问：obj.member
                 advance(); // 消费.
                 if (!match(TokenType::Identifier)) {
                     throw std::runtime_error("期望成员名，但得到: " + currentToken_.toString());
                 }
-                std::string member = currentToken_.getValue();
+                Identifier member = ctx_->intern(currentToken_.getValue());
                 advance();
-                expr = std::make_unique<MemberAccessNode>(std::move(expr), member);
+                expr = ctx_->create<MemberAccessNode>(expr, member);
             } else if (match(TokenType::Arrow)) {
                 // 箭头访问：ptr->member (等价于 (*ptr).member)
                 advance(); // 消费->
                 if (!match(TokenType::Identifier)) {
                     throw std::runtime_error("期望成员名，但得到: " + currentToken_.toString());
                 }
-                std::string member = currentToken_.getValue();
+                Identifier member = ctx_->intern(currentToken_.getValue());
                 advance();
                 // 将 ptr->member 转换为 (*ptr).member
-                auto deref = std::make_unique<UnaryOpNode>(TokenType::Multiply, std::move(expr));
-                expr = std::make_unique<MemberAccessNode>(std::move(deref), member);
+                auto deref = ctx_->create<UnaryOpNode>(TokenType::Multiply, expr);
+                expr = ctx_->create<MemberAccessNode>(deref, member);
             }
         }
         return expr;
@@ -253,32 +254,32 @@ std::unique_ptr<ExprNode> Parser::parsePrimary() {
     // 初始化列表：{expr1, expr2, ...}
     if (match(TokenType::LBrace)) {
         advance(); // 消费{
-        auto init_list = std::make_unique<InitializerListNode>();
+        std::vector<ExprNode*> elements;
 
         // 解析初始化列表元素
         if (!match(TokenType::RBrace)) {
-            init_list->addElement(parseExpression());
+            elements.push_back(parseExpression());
             while (match(TokenType::Comma)) {
                 advance(); // 消费,
                 // 允许尾随逗号：{1, 2, 3,}
                 if (match(TokenType::RBrace)) {
                     break;
                 }
-                init_list->addElement(parseExpression());
+                elements.push_back(parseExpression());
             }
         }
 
         consume(TokenType::RBrace, "期望 '}' 在初始化列表后");
-        return init_list;
+        return ctx_->create<InitializerListNode>(ctx_->copyArray(elements));
     }
 
     throw std::runtime_error("意外的Token: " + currentToken_.toString());
 }
 
 // 解析函数调用：foo(arg1, arg2, ...)
-std::unique_ptr<FunctionCallNode> Parser::parseFunctionCall(const std::string& name) {
+FunctionCallNode* Parser::parseFunctionCall(Identifier name) {
     advance(); // 消费(
-    std::vector<std::unique_ptr<ExprNode>> args;
+    std::vector<ExprNode*> args;
 
     // 解析参数列表
     if (!match(TokenType::RParen)) {
@@ -290,7 +291,7 @@ std::unique_ptr<FunctionCallNode> Parser::parseFunctionCall(const std::string& n
     }
 
     consume(TokenType::RParen, "期望 ')' 在函数调用后");
-    return std::make_unique<FunctionCallNode>(name, std::move(args));
+    return ctx_->create<FunctionCallNode>(name, ctx_->copyArray(args));
 }
 
 // 前进到下一个Token（更新currentToken_）
@@ -319,7 +320,7 @@ bool Parser::match(TokenType type) {
 }
 
 // 解析语句
-std::unique_ptr<StmtNode> Parser::parseStatement() {
+StmtNode* Parser::parseStatement() {
     if (match(TokenType::LBrace)) {
         // 复合语句：{ ... }
         advance(); // 消费{
@@ -374,13 +375,13 @@ std::unique_ptr<StmtNode> Parser::parseStatement() {
     if (match(TokenType::Semicolon)) {
         // 空语句：;
         advance(); // 消费分号
-        return std::make_unique<EmptyStmtNode>();
+        return ctx_->create<EmptyStmtNode>();
     }
 
     // 表达式语句：表达式;
     auto expr = parseExpression();
     consume(TokenType::Semicolon, "期望分号");
-    return std::make_unique<ExprStmtNode>(std::move(expr));
+    return ctx_->create<ExprStmtNode>(expr);
 }
 
 // 检查是否是类型关键字
@@ -388,9 +389,22 @@ bool Parser::isTypeKeyword() const {
     return currentToken_.is(TokenType::Int) || currentToken_.is(TokenType::Void);
 }
 
+const Type* Parser::keywordType() const {
+    return currentToken_.is(TokenType::Void) ? Type::getVoidType() : Type::getIntType();
+}
+
+const Type* Parser::structType() {
+    return ctx_->getTypes().getStructType(std::string(currentToken_.getValue()));
+}
+
 // 解析程序（函数定义的序列）
 std::unique_ptr<ProgramNode> Parser::parseProgram() {
-    auto program = std::make_unique<ProgramNode>();
+    // 之后分配的节点（包括解析失败时已分配的）都归 program 所有
+    if (!context_) {
+        context_ = std::make_unique<ASTContext>();
+        ctx_ = context_.get();
+    }
+    auto program = std::make_unique<ProgramNode>(std::move(context_));
 
     while (!isAtEnd()) {
         try {
@@ -404,7 +418,7 @@ std::unique_ptr<ProgramNode> Parser::parseProgram() {
                 // 情况1: struct Point { ... } -> 结构体定义
                 if (next1.is(TokenType::Identifier) && next2.is(TokenType::LBrace)) {
                     auto struct_decl = parseStructDeclaration();
-                    program->addStruct(std::move(struct_decl));
+                    program->addStruct(struct_decl);
                 }
                 // 情况2: struct Point foo(...) { ... } -> 函数定义（返回结构体类型）
                 else if (next1.is(TokenType::Identifier) && next2.is(TokenType::Identifier)) {
@@ -412,19 +426,19 @@ std::unique_ptr<ProgramNode> Parser::parseProgram() {
                     if (next3.is(TokenType::LParen)) {
                         // 返回结构体类型的函数
                         auto func = parseFunctionDeclaration();
-                        program->addFunction(std::move(func));
+                        program->addFunction(func);
                     } else {
                         // 情况3: 全局变量声明
                         // 包括：struct Point p;
                         //      struct Point *p;
                         //      struct Point arr[10];
                         auto global_var = parseGlobalVarDeclaration();
-                        program->addGlobalVar(std::move(global_var));
+                        program->addGlobalVar(global_var);
                     }
                 } else {
                     // 其他情况也是全局变量声明
                     auto global_var = parseGlobalVarDeclaration();
-                    program->addGlobalVar(std::move(global_var));
+                    program->addGlobalVar(global_var);
                 }
             } else {
                 // int/void 开头：可能是全局变量或函数定义
@@ -443,11 +457,11 @@ std::unique_ptr<ProgramNode> Parser::parseProgram() {
                     if (next2.is(TokenType::LParen)) {
                         // 函数定义：int foo(...) { ... } 或 int* foo(...) { ... }
                         auto func = parseFunctionDeclaration();
-                        program->addFunction(std::move(func));
+                        program->addFunction(func);
                     } else {
                         // 全局变量声明：int global_x; 或 int* global_ptr;
                         auto global_var = parseGlobalVarDeclaration();
-                        program->addGlobalVar(std::move(global_var));
+                        program->addGlobalVar(global_var);
                     }
                 } else {
                     throw std::runtime_error("期望标识符或函数名，但得到: " + next1.toString());
@@ -463,14 +477,14 @@ std::unique_ptr<ProgramNode> Parser::parseProgram() {
 }
 
 // 解析函数定义：int foo(int a, int b) { ... } 或 struct Point foo(...) { ... }
-std::unique_ptr<FunctionDeclNode> Parser::parseFunctionDeclaration() {
+FunctionDeclNode* Parser::parseFunctionDeclaration() {
     // 解析返回类型
-    std::string return_type;
+    const Type* return_type;
     if (match(TokenType::Int)) {
-        return_type = "int";
+        return_type = Type::getIntType();
         advance();
     } else if (match(TokenType::Void)) {
-        return_type = "void";
+        return_type = Type::getVoidType();
         advance();
     } else if (match(TokenType::Struct)) {
         // 结构体返回类型：struct Point
@@ -478,7 +492,7 @@ std::unique_ptr<FunctionDeclNode> Parser::parseFunctionDeclaration() {
         if (!match(TokenType::Identifier)) {
             throw std::runtime_error("期望结构体类型名");
         }
-        return_type = "struct " + currentToken_.getValue();
+        return_type = structType();
         advance();
     } else {
         throw std::runtime_error("期望函数返回类型，但得到: " + currentToken_.toString());
@@ -488,7 +502,7 @@ std::unique_ptr<FunctionDeclNode> Parser::parseFunctionDeclaration() {
     if (!match(TokenType::Identifier)) {
         throw std::runtime_error("期望函数名，但得到: " + currentToken_.toString());
     }
-    std::string func_name = currentToken_.getValue();
+    std::string func_name(currentToken_.getValue());
     advance();
 
     // 解析参数列表
@@ -497,7 +511,7 @@ std::unique_ptr<FunctionDeclNode> Parser::parseFunctionDeclaration() {
 
     if (!match(TokenType::RParen)) {
         // 解析第一个参数
-        std::string param_type;
+        const Type* param_type;
 
         // 支持结构体类型参数：struct Point p
         if (match(TokenType::Struct)) {
@@ -505,10 +519,10 @@ std::unique_ptr<FunctionDeclNode> Parser::parseFunctionDeclaration() {
             if (!match(TokenType::Identifier)) {
                 throw std::runtime_error("期望结构体类型名");
             }
-            param_type = "struct " + currentToken_.getValue();
+            param_type = structType();
             advance();
         } else if (isTypeKeyword()) {
-            param_type = currentToken_.getValue();
+            param_type = keywordType();
             advance();
         } else {
             throw std::runtime_error("期望参数类型");
@@ -516,16 +530,16 @@ std::unique_ptr<FunctionDeclNode> Parser::parseFunctionDeclaration() {
 
         // 处理指针类型参数
         while (match(TokenType::Multiply)) {
-            param_type += "*";
+            param_type = ctx_->getTypes().getPointerType(param_type);
             advance();
         }
 
         if (!match(TokenType::Identifier)) {
             throw std::runtime_error("期望参数名");
         }
-        std::string param_name = currentToken_.getValue();
+        std::string param_name(currentToken_.getValue());
         advance();
-        params.emplace_back(param_type, param_name);
+        params.emplace_back(param_type, ctx_->intern(param_name));
 
         // 解析剩余参数
         while (match(TokenType::Comma)) {
@@ -537,10 +551,10 @@ std::unique_ptr<FunctionDeclNode> Parser::parseFunctionDeclaration() {
                 if (!match(TokenType::Identifier)) {
                     throw std::runtime_error("期望结构体类型名");
                 }
-                param_type = "struct " + currentToken_.getValue();
+                param_type = structType();
                 advance();
             } else if (isTypeKeyword()) {
-                param_type = currentToken_.getValue();
+                param_type = keywordType();
                 advance();
             } else {
                 throw std::runtime_error("期望参数类型");
@@ -548,7 +562,7 @@ std::unique_ptr<FunctionDeclNode> Parser::parseFunctionDeclaration() {
 
             // 处理指针类型参数
             while (match(TokenType::Multiply)) {
-                param_type += "*";
+                param_type = ctx_->getTypes().getPointerType(param_type);
                 advance();
             }
 
@@ -557,7 +571,7 @@ std::unique_ptr<FunctionDeclNode> Parser::parseFunctionDeclaration() {
             }
             param_name = currentToken_.getValue();
             advance();
-            params.emplace_back(param_type, param_name);
+            params.emplace_back(param_type, ctx_->intern(param_name));
         }
     }
 
@@ -567,24 +581,24 @@ std::unique_ptr<FunctionDeclNode> Parser::parseFunctionDeclaration() {
     consume(TokenType::LBrace, "期望 '{' 在函数体开始");
     auto body = parseCompoundStatement();
 
-    return std::make_unique<FunctionDeclNode>(return_type, func_name, std::move(params), std::move(body));
+    return ctx_->create<FunctionDeclNode>(return_type, ctx_->intern(func_name),
+                                          ctx_->copyArray(params), body);
 }
 
 // 解析复合语句：{ stmt1; stmt2; ... }
-std::unique_ptr<CompoundStmtNode> Parser::parseCompoundStatement() {
-    auto compound = std::make_unique<CompoundStmtNode>();
+CompoundStmtNode* Parser::parseCompoundStatement() {
+    std::vector<StmtNode*> statements;
 
     while (!isAtEnd() && !match(TokenType::RBrace)) {
         try {
-            auto stmt = parseStatement();
-            compound->addStatement(std::move(stmt));
+            statements.push_back(parseStatement());
         } catch (const std::exception& e) {
             throw std::runtime_error(std::string("在代码块中: ") + e.what());
         }
     }
 
     consume(TokenType::RBrace, "期望 '}'");
-    return compound;
+    return ctx_->create<CompoundStmtNode>(ctx_->copyArray(statements));
 }
 
 // 获取运算符的优先级（数值越大优先级越高）
@@ -617,30 +631,30 @@ Parser::Precedence Parser::getOperatorPrecedence(TokenType op) {
 }
 
 // 解析变量声明语句：int x; 或 int y = 5; 或 int arr[10]; 或 int *p; 或 int arr[3][4]; 或 int *arr[10]; 或 struct Point p; 或 struct Point *ptr;
-std::unique_ptr<VarDeclStmtNode> Parser::parseVariableDeclaration() {
+VarDeclStmtNode* Parser::parseVariableDeclaration() {
     // 处理结构体类型声明：struct Point p; 或 struct Point *ptr;
-    std::string varType;
+    const Type* varType;
     if (match(TokenType::Struct)) {
         advance(); // 消费 struct
         if (!match(TokenType::Identifier)) {
             throw std::runtime_error("期望结构体类型名");
         }
-        varType = "struct " + currentToken_.getValue();
+        varType = structType();
         advance();
 
         // 处理结构体指针类型：struct Point *ptr
         while (match(TokenType::Multiply)) {
-            varType += "*";
+            varType = ctx_->getTypes().getPointerType(varType);
             advance(); // 消费*
         }
     } else {
         // 基本类型声明：int x;
         advance(); // 消费int
 
-        // 构建类型字符串，处理指针类型 int*, int**, ...
-        varType = "int";
+        // 处理指针类型 int*, int**, ...
+        varType = Type::getIntType();
         while (match(TokenType::Multiply)) {
-            varType += "*";
+            varType = ctx_->getTypes().getPointerType(varType);
             advance(); // 消费*
         }
     }
@@ -650,7 +664,7 @@ std::unique_ptr<VarDeclStmtNode> Parser::parseVariableDeclaration() {
         throw std::runtime_error("期望变量名，但得到: " + currentToken_.toString());
     }
 
-    std::string varName = currentToken_.getValue();
+    std::string varName(currentToken_.getValue());
     advance(); // 消费变量名
 
     // 检查是否是数组声明（支持多维）
@@ -660,14 +674,14 @@ std::unique_ptr<VarDeclStmtNode> Parser::parseVariableDeclaration() {
         if (!match(TokenType::Number)) {
             throw std::runtime_error("期望数组大小，但得到: " + currentToken_.toString());
         }
-        dims.push_back(std::stoi(currentToken_.getValue()));
+        dims.push_back(currentToken_.getNumber());
         advance(); // 消费数字
         consume(TokenType::RBracket, "期望 ']' 在数组大小后");
     }
 
     // 数组声明：支持初始化列表
     if (!dims.empty()) {
-        std::unique_ptr<ExprNode> initializer = nullptr;
+        ExprNode* initializer = nullptr;
 
         // 检查是否有初始化列表
         if (match(TokenType::Assign)) {
@@ -676,10 +690,11 @@ std::unique_ptr<VarDeclStmtNode> Parser::parseVariableDeclaration() {
         }
 
         consume(TokenType::Semicolon, "期望分号");
-        return std::make_unique<VarDeclStmtNode>(varType, varName, std::move(dims), std::move(initializer));
+        return ctx_->create<VarDeclStmtNode>(varType, ctx_->intern(varName),
+                                             ctx_->copyArray(dims), initializer);
     }
 
-    std::unique_ptr<ExprNode> initializer = nullptr;
+    ExprNode* initializer = nullptr;
 
     // 检查是否有初始化值
     if (match(TokenType::Assign)) {
@@ -689,14 +704,14 @@ std::unique_ptr<VarDeclStmtNode> Parser::parseVariableDeclaration() {
 
     consume(TokenType::Semicolon, "期望分号");
 
-    return std::make_unique<VarDeclStmtNode>(varType, varName, std::move(initializer));
+    return ctx_->create<VarDeclStmtNode>(varType, ctx_->intern(varName), initializer);
 }
 
 // 解析返回语句：return; 或 return x;
-std::unique_ptr<ReturnStmtNode> Parser::parseReturnStatement() {
+ReturnStmtNode* Parser::parseReturnStatement() {
     advance(); // 消费return
 
-    std::unique_ptr<ExprNode> expr = nullptr;
+    ExprNode* expr = nullptr;
 
     // 检查是否有返回值
     if (!match(TokenType::Semicolon)) {
@@ -705,11 +720,11 @@ std::unique_ptr<ReturnStmtNode> Parser::parseReturnStatement() {
 
     consume(TokenType::Semicolon, "期望分号");
 
-    return std::make_unique<ReturnStmtNode>(std::move(expr));
+    return ctx_->create<ReturnStmtNode>(expr);
 }
 
 // 解析If语句：if (condition) stmt [else if (condition) stmt ...] [else stmt]
-std::unique_ptr<IfStmtNode> Parser::parseIfStatement() {
+IfStmtNode* Parser::parseIfStatement() {
     advance(); // 消费if
 
     consume(TokenType::LParen, "期望 '(' 在if条件后");
@@ -722,10 +737,9 @@ std::unique_ptr<IfStmtNode> Parser::parseIfStatement() {
     // 解析then分支
     auto then_stmt = parseStatement();
 
-    // 创建If节点
-    auto if_node = std::make_unique<IfStmtNode>(std::move(condition), std::move(then_stmt));
-
     // 解析可选的else if和else分支
+    std::vector<ElseIfBranch> else_ifs;
+    StmtNode* else_stmt = nullptr;
     while (match(TokenType::Else)) {
         advance(); // 消费else
 
@@ -742,20 +756,20 @@ std::unique_ptr<IfStmtNode> Parser::parseIfStatement() {
             auto else_if_stmt = parseStatement();
 
             // 添加else if分支
-            if_node->addElseIf(std::move(else_if_condition), std::move(else_if_stmt));
+            else_ifs.emplace_back(else_if_condition, else_if_stmt);
         } else {
             // else 分支
-            auto else_stmt = parseStatement();
-            if_node->setElseStmt(std::move(else_stmt));
+            else_stmt = parseStatement();
             break; // else后面不能再有else if
         }
     }
 
-    return if_node;
+    // 创建If节点
+    return ctx_->create<IfStmtNode>(condition, then_stmt, ctx_->copyArray(else_ifs), else_stmt);
 }
 
 // 解析While语句：while (condition) stmt
-std::unique_ptr<WhileStmtNode> Parser::parseWhileStatement() {
+WhileStmtNode* Parser::parseWhileStatement() {
     advance(); // 消费while
 
     consume(TokenType::LParen, "期望 '(' 在while条件后");
@@ -768,17 +782,17 @@ std::unique_ptr<WhileStmtNode> Parser::parseWhileStatement() {
     // 解析循环体
     auto body = parseStatement();
 
-    return std::make_unique<WhileStmtNode>(std::move(condition), std::move(body));
+    return ctx_->create<WhileStmtNode>(condition, body);
 }
 
 // 解析For语句：for (init; condition; increment) stmt
-std::unique_ptr<ForStmtNode> Parser::parseForStatement() {
+ForStmtNode* Parser::parseForStatement() {
     advance(); // 消费for
 
     consume(TokenType::LParen, "期望 '(' 在for后");
 
     // 解析初始化部分（可为空）
-    std::unique_ptr<StmtNode> init = nullptr;
+    StmtNode* init = nullptr;
     if (!match(TokenType::Semicolon)) {
         // 可能是变量声明或表达式
         if (match(TokenType::Int)) {
@@ -786,14 +800,14 @@ std::unique_ptr<ForStmtNode> Parser::parseForStatement() {
         } else {
             auto init_expr = parseExpression();
             consume(TokenType::Semicolon, "期望分号在for初始化后");
-            init = std::make_unique<ExprStmtNode>(std::move(init_expr));
+            init = ctx_->create<ExprStmtNode>(init_expr);
         }
     } else {
         advance(); // 消费空初始化的分号
     }
 
     // 解析条件部分（可为空）
-    std::unique_ptr<ExprNode> condition = nullptr;
+    ExprNode* condition = nullptr;
     if (!match(TokenType::Semicolon)) {
         condition = parseExpression();
         consume(TokenType::Semicolon, "期望分号在for条件后");
@@ -802,7 +816,7 @@ std::unique_ptr<ForStmtNode> Parser::parseForStatement() {
     }
 
     // 解析增量部分（可为空）
-    std::unique_ptr<ExprNode> increment = nullptr;
+    ExprNode* increment = nullptr;
     if (!match(TokenType::RParen)) {
         increment = parseExpression();
         consume(TokenType::RParen, "期望 ')' 在for增量后");
@@ -813,11 +827,11 @@ std::unique_ptr<ForStmtNode> Parser::parseForStatement() {
     // 解析循环体
     auto body = parseStatement();
 
-    return std::make_unique<ForStmtNode>(std::move(init), std::move(condition), std::move(increment), std::move(body));
+    return ctx_->create<ForStmtNode>(init, condition, increment, body);
 }
 
 // 解析Do-While语句：do stmt while (condition);
-std::unique_ptr<DoWhileStmtNode> Parser::parseDoWhileStatement() {
+DoWhileStmtNode* Parser::parseDoWhileStatement() {
     advance(); // 消费do
 
     // 解析循环体
@@ -832,41 +846,41 @@ std::unique_ptr<DoWhileStmtNode> Parser::parseDoWhileStatement() {
     consume(TokenType::RParen, "期望 ')' 在while条件后");
     consume(TokenType::Semicolon, "期望分号在do-while语句后");
 
-    return std::make_unique<DoWhileStmtNode>(std::move(body), std::move(condition));
+    return ctx_->create<DoWhileStmtNode>(body, condition);
 }
 
 // 解析Break语句：break;
-std::unique_ptr<BreakStmtNode> Parser::parseBreakStatement() {
+BreakStmtNode* Parser::parseBreakStatement() {
     advance(); // 消费break
 
     consume(TokenType::Semicolon, "期望分号在break语句后");
 
-    return std::make_unique<BreakStmtNode>();
+    return ctx_->create<BreakStmtNode>();
 }
 
 // 解析Continue语句：continue;
-std::unique_ptr<ContinueStmtNode> Parser::parseContinueStatement() {
+ContinueStmtNode* Parser::parseContinueStatement() {
     advance(); // 消费continue
 
     consume(TokenType::Semicolon, "期望分号在continue语句后");
 
-    return std::make_unique<ContinueStmtNode>();
+    return ctx_->create<ContinueStmtNode>();
 }
 
 // 解析结构体定义：struct Point { int x; int y; };
-std::unique_ptr<StructDeclNode> Parser::parseStructDeclaration() {
+StructDeclNode* Parser::parseStructDeclaration() {
     consume(TokenType::Struct, "期望 'struct' 关键字");
 
     // 解析结构体名
     if (!match(TokenType::Identifier)) {
         throw std::runtime_error("期望结构体名，但得到: " + currentToken_.toString());
     }
-    std::string struct_name = currentToken_.getValue();
+    std::string struct_name(currentToken_.getValue());
     advance();
 
     consume(TokenType::LBrace, "期望 '{' 在结构体名后");
 
-    auto struct_decl = std::make_unique<StructDeclNode>(struct_name);
+    std::vector<StructMember> members;
 
     // 解析成员列表
     while (!match(TokenType::RBrace) && !isAtEnd()) {
@@ -875,29 +889,29 @@ std::unique_ptr<StructDeclNode> Parser::parseStructDeclaration() {
             throw std::runtime_error("期望成员类型，但得到: " + currentToken_.toString());
         }
 
-        std::string member_type;
+        const Type* member_type;
         if (match(TokenType::Struct)) {
             // 结构体类型成员：struct Point p; 或 struct Point *ptr;
             advance(); // 消费 struct
             if (!match(TokenType::Identifier)) {
                 throw std::runtime_error("期望结构体类型名");
             }
-            member_type = "struct " + currentToken_.getValue();
+            member_type = structType();
             advance();
 
             // 处理结构体指针类型成员
             while (match(TokenType::Multiply)) {
-                member_type += "*";
+                member_type = ctx_->getTypes().getPointerType(member_type);
                 advance();
             }
         } else {
             // 基本类型成员
-            member_type = currentToken_.getValue();
+            member_type = keywordType();
             advance();
 
             // 处理指针类型成员
             while (match(TokenType::Multiply)) {
-                member_type += "*";
+                member_type = ctx_->getTypes().getPointerType(member_type);
                 advance();
             }
         }
@@ -906,7 +920,7 @@ std::unique_ptr<StructDeclNode> Parser::parseStructDeclaration() {
         if (!match(TokenType::Identifier)) {
             throw std::runtime_error("期望成员名，但得到: " + currentToken_.toString());
         }
-        std::string member_name = currentToken_.getValue();
+        std::string member_name(currentToken_.getValue());
         advance();
 
         // 检查是否是数组成员
@@ -917,7 +931,7 @@ std::unique_ptr<StructDeclNode> Parser::parseStructDeclaration() {
             if (!match(TokenType::Number)) {
                 throw std::runtime_error("期望数组大小");
             }
-            int size = std::stoi(currentToken_.getValue());
+            int size = currentToken_.getNumber();
             if (size <= 0) {
                 throw std::runtime_error("数组大小必须为正数");
             }
@@ -928,11 +942,8 @@ std::unique_ptr<StructDeclNode> Parser::parseStructDeclaration() {
         }
 
         // 添加成员
-        if (array_dims.empty()) {
-            struct_decl->addMember(member_type, member_name);
-        } else {
-            struct_decl->addMember(member_type, member_name, std::move(array_dims));
-        }
+        members.emplace_back(member_type, ctx_->intern(member_name),
+                             ctx_->copyArray(array_dims));
 
         consume(TokenType::Semicolon, "期望分号在成员声明后");
     }
@@ -940,34 +951,34 @@ std::unique_ptr<StructDeclNode> Parser::parseStructDeclaration() {
     consume(TokenType::RBrace, "期望 '}' 在结构体定义结束");
     consume(TokenType::Semicolon, "期望分号在结构体定义后");
 
-    return struct_decl;
+    return ctx_->create<StructDeclNode>(ctx_->intern(struct_name), ctx_->copyArray(members));
 }
 
 // 解析全局变量声明：int global_x; int global_arr[10]; struct Point p;
-std::unique_ptr<VarDeclStmtNode> Parser::parseGlobalVarDeclaration() {
+VarDeclStmtNode* Parser::parseGlobalVarDeclaration() {
     // 处理结构体类型全局变量：struct Point p; 或 struct Point *ptr;
-    std::string varType;
+    const Type* varType;
     if (match(TokenType::Struct)) {
         advance(); // 消费 struct
         if (!match(TokenType::Identifier)) {
             throw std::runtime_error("期望结构体类型名");
         }
-        varType = "struct " + currentToken_.getValue();
+        varType = structType();
         advance();
 
         // 处理结构体指针类型：struct Point *ptr
         while (match(TokenType::Multiply)) {
-            varType += "*";
+            varType = ctx_->getTypes().getPointerType(varType);
             advance(); // 消费*
         }
     } else {
         // 基本类型声明：int x;
         advance(); // 消费 int
 
-        // 构建类型字符串，处理指针类型 int*, int**, ...
-        varType = "int";
+        // 处理指针类型 int*, int**, ...
+        varType = Type::getIntType();
         while (match(TokenType::Multiply)) {
-            varType += "*";
+            varType = ctx_->getTypes().getPointerType(varType);
             advance(); // 消费*
         }
     }
@@ -977,7 +988,7 @@ std::unique_ptr<VarDeclStmtNode> Parser::parseGlobalVarDeclaration() {
         throw std::runtime_error("期望变量名，但得到: " + currentToken_.toString());
     }
 
-    std::string varName = currentToken_.getValue();
+    std::string varName(currentToken_.getValue());
     advance(); // 消费变量名
 
     // 检查是否是数组声明（支持多维）
@@ -987,14 +998,14 @@ std::unique_ptr<VarDeclStmtNode> Parser::parseGlobalVarDeclaration() {
         if (!match(TokenType::Number)) {
             throw std::runtime_error("期望数组大小，但得到: " + currentToken_.toString());
         }
-        dims.push_back(std::stoi(currentToken_.getValue()));
+        dims.push_back(currentToken_.getNumber());
         advance(); // 消费数字
         consume(TokenType::RBracket, "期望 ']' 在数组大小后");
     }
 
     // 如果是数组，支持初始化列表
     if (!dims.empty()) {
-        std::unique_ptr<ExprNode> initializer = nullptr;
+        ExprNode* initializer = nullptr;
 
         // 检查是否有初始化列表
         if (match(TokenType::Assign)) {
@@ -1003,16 +1014,17 @@ std::unique_ptr<VarDeclStmtNode> Parser::parseGlobalVarDeclaration() {
         }
 
         consume(TokenType::Semicolon, "期望分号");
-        return std::make_unique<VarDeclStmtNode>(varType, varName, std::move(dims), std::move(initializer));
+        return ctx_->create<VarDeclStmtNode>(varType, ctx_->intern(varName),
+                                             ctx_->copyArray(dims), initializer);
     }
 
     // 普通变量：检查是否有初始化
-    std::unique_ptr<ExprNode> initializer = nullptr;
+    ExprNode* initializer = nullptr;
     if (match(TokenType::Assign)) {
         advance(); // 消费 =
         initializer = parseExpression();
     }
 
     consume(TokenType::Semicolon, "期望分号");
-    return std::make_unique<VarDeclStmtNode>(varType, varName, std::move(initializer));
+    return ctx_->create<VarDeclStmtNode>(varType, ctx_->intern(varName), initializer);
 }
\ No newline at end of file
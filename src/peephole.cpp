@@ -0,0 +1,297 @@
+#include "../include/peephole.h"
+#include <algorithm>
+#include <climits>
+#include <stdexcept>
+
+namespace {
+
+bool isJump(OpCode op) {
+    return op == OpCode::JMP || op == OpCode::JZ || op == OpCode::JNZ;
+}
+
+// 没有副作用、不会出错的指令（DIV/MOD 可能除零，LOADM 可能越界，都不算）
+bool isPure(OpCode op) {
+    switch (op) {
+        case OpCode::PUSH: case OpCode::LOAD: case OpCode::LOADG:
+        case OpCode::LEA: case OpCode::LEAG:
+        case OpCode::ADDPTR: case OpCode::ADDPTRD:
+        case OpCode::ADD: case OpCode::SUB: case OpCode::MUL: case OpCode::NEG:
+        case OpCode::EQ: case OpCode::NE: case OpCode::LT:
+        case OpCode::LE: case OpCode::GT: case OpCode::GE:
+        case OpCode::AND: case OpCode::OR: case OpCode::NOT:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// 只压入一个值、不读栈的指令
+bool isSinglePush(OpCode op) {
+    return op == OpCode::PUSH || op == OpCode::LOAD || op == OpCode::LOADG ||
+           op == OpCode::LEA || op == OpCode::LEAG;
+}
+
+bool sameInstruction(const Instruction& a, const Instruction& b) {
+    return a.op == b.op && a.operand == b.operand;
+}
+
+}  // namespace
+
+bool PeepholeOptimizer::isStraightLine(int start, int end) const {
+    if (start < 0 || end > (int)code_->size() || removed_[start]) return false;
+    for (int k = start + 1; k < end; ++k) {
+        if (is_label_[k] || removed_[k]) return false;
+    }
+    return true;
+}
+
+void PeepholeOptimizer::collectLabels(const ByteCode& bytecode) {
+    int n = code_->size();
+    is_label_.assign(n + 1, false);
+    for (const auto& instr : *code_) {
+        if ((isJump(instr.op) || instr.op == OpCode::CALL) &&
+            instr.operand >= 0 && instr.operand <= n) {
+            is_label_[instr.operand] = true;
+        }
+    }
+    for (const auto& [name, entry] : bytecode.functions) {
+        if (entry >= 0 && entry <= n) is_label_[entry] = true;
+    }
+    if (bytecode.entry_point >= 0 && bytecode.entry_point <= n) {
+        is_label_[bytecode.entry_point] = true;
+    }
+}
+
+int PeepholeOptimizer::pureValueStart(int end) const {
+    const auto& code = *code_;
+    int need = 1;   // 还需要由前面的指令提供的值的个数
+    for (int j = end - 1; j >= 0; --j) {
+        if (removed_[j] || !isPure(code[j].op)) return -1;
+        StackEffect effect = stackEffect(code[j]);
+        need += effect.pops - effect.pushes;
+        if (need == 0) return j;
+        if (need < 0 || is_label_[j]) return -1;
+    }
+    return -1;
+}
+
+// <纯表达式>; POP  ->  （删除）
+bool PeepholeOptimizer::removeDeadValue(int i) {
+    const auto& code = *code_;
+    if (code[i].op != OpCode::POP || is_label_[i] || removed_[i]) return false;
+    int start = pureValueStart(i);
+    if (start < 0) return false;
+    for (int k = start; k <= i; ++k) remove(k);
+    return true;
+}
+
+// <地址>; STOREM; <相同的地址>; LOADM; POP  ->  <地址>; STOREM
+// 赋值表达式的值在 CodeGen 中通过重新加载左值得到，作为语句时这个值被直接丢弃。
+// 结构体赋值以 STOREMN/MEMCPY 结束（目标地址同样在栈顶），重新加载的是第一个 slot
+bool PeepholeOptimizer::removeStoreReload(int i) {
+    const auto& code = *code_;
+    int n = code.size();
+    OpCode op = code[i].op;
+    if ((op != OpCode::STOREM && op != OpCode::STOREMN && op != OpCode::MEMCPY) || removed_[i]) return false;
+    int start = pureValueStart(i);
+    if (start < 0) return false;
+    int len = i - start;
+    int end = i + 1 + len + 2;   // 重新计算地址 + LOADM + POP
+    if (end > n || !isStraightLine(i, end)) return false;
+    for (int k = 0; k < len; ++k) {
+        if (!sameInstruction(code[start + k], code[i + 1 + k])) return false;
+    }
+    if (code[i + 1 + len].op != OpCode::LOADM || code[i + 2 + len].op != OpCode::POP) return false;
+    for (int k = i + 1; k < end; ++k) remove(k);
+    return true;
+}
+
+bool PeepholeOptimizer::simplifyStack(int i) {
+    auto& code = *code_;
+    int n = code.size();
+    if (removed_[i]) return false;
+
+    // ADJSP 0  ->  （删除）
+    if (code[i].op == OpCode::ADJSP && code[i].operand == 0) {
+        remove(i);
+        return true;
+    }
+    if (i + 1 >= n || !isStraightLine(i, i + 2)) return false;
+    Instruction& first = code[i];
+    const Instruction& second = code[i + 1];
+
+    // PUSH/LOAD/...; ADJSP n  ->  ADJSP n-1
+    if (isSinglePush(first.op) && second.op == OpCode::ADJSP && second.operand >= 1) {
+        first = {OpCode::ADJSP, second.operand - 1};
+        remove(i + 1);
+        return true;
+    }
+
+    // LEA/LEAG k; ADDPTR j  ->  LEA/LEAG k+j（常量下标、嵌套成员的静态偏移）
+    if ((first.op == OpCode::LEA || first.op == OpCode::LEAG) && second.op == OpCode::ADDPTR) {
+        int64_t offset = (int64_t)first.operand + second.operand;
+        if (offset >= INT32_MIN && offset <= INT32_MAX) {
+            first.operand = (int32_t)offset;
+            remove(i + 1);
+            return true;
+        }
+    }
+
+    // POP/ADJSP 的任意组合合并为一条 ADJSP
+    auto popCount = [](const Instruction& instr) {
+        if (instr.op == OpCode::POP) return 1;
+        if (instr.op == OpCode::ADJSP && instr.operand >= 0) return (int)instr.operand;
+        return -1;
+    };
+    int a = popCount(first);
+    int b = popCount(second);
+    if (a >= 0 && b >= 0) {
+        first = {OpCode::ADJSP, a + b};
+        remove(i + 1);
+        return true;
+    }
+    return false;
+}
+
+bool PeepholeOptimizer::simplifyJump(int i) {
+    auto& code = *code_;
+    int n = code.size();
+    Instruction& instr = code[i];
+    if (removed_[i] || !isJump(instr.op)) return false;
+    bool changed = false;
+
+    // 跳转链：目标是 JMP 时直接跳到最终目标（JMP 构成环时保持不变）
+    int target = instr.operand;
+    for (int hops = 0; hops < n && target < n && code[target].op == OpCode::JMP && !removed_[target]; ++hops) {
+        target = code[target].operand;
+    }
+    if (target < n && code[target].op == OpCode::JMP && !removed_[target]) {
+        target = instr.operand;
+    }
+    if (target != instr.operand) {
+        instr.operand = target;
+        changed = true;
+    }
+
+    // JMP 到 RET：直接返回（RET 按运行时的 sp 决定返回值，两处栈深度相同）
+    if (instr.op == OpCode::JMP && target < n && code[target].op == OpCode::RET) {
+        instr = code[target];
+        return true;
+    }
+
+    // 跳到下一条：JMP 删除，条件跳转只保留出栈
+    if (target == i + 1) {
+        if (instr.op == OpCode::JMP) {
+            remove(i);
+        } else {
+            instr = {OpCode::POP, 0};
+        }
+        return true;
+    }
+
+    // JZ L; JMP M; L:  ->  JNZ M（JNZ 同理）
+    if (instr.op != OpCode::JMP && target == i + 2 && isStraightLine(i, i + 2) &&
+        code[i + 1].op == OpCode::JMP) {
+        instr = {instr.op == OpCode::JZ ? OpCode::JNZ : OpCode::JZ, code[i + 1].operand};
+        remove(i + 1);
+        return true;
+    }
+    return changed;
+}
+
+// JMP/RET/RETN/HALT 之后直到下一个跳转目标（或函数入口）之前的指令都不可达
+bool PeepholeOptimizer::removeUnreachable(int i) {
+    const auto& code = *code_;
+    int n = code.size();
+    OpCode op = code[i].op;
+    if (removed_[i] || (op != OpCode::JMP && op != OpCode::RET && op != OpCode::RETN &&
+                        op != OpCode::HALT)) {
+        return false;
+    }
+    bool changed = false;
+    for (int k = i + 1; k < n && !is_label_[k]; ++k) {
+        if (!removed_[k]) {
+            remove(k);
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+void PeepholeOptimizer::compact(ByteCode& bytecode, PeepholeStats& stats) {
+    auto& code = bytecode.code;
+    int n = code.size();
+
+    // 按入口地址排序的函数，用来把删除的指令归到所属函数（顺序与 removed_per_function 一致）
+    std::vector<int> entries;
+    for (const auto& [name, entry] : bytecode.functions) entries.push_back(entry);
+    std::sort(entries.begin(), entries.end());
+
+    // 旧地址 -> 新地址；被删除的地址映射到其后第一条保留的指令
+    std::vector<int> new_addr(n + 1);
+    int next = 0;
+    for (int pc = 0; pc < n; ++pc) {
+        new_addr[pc] = next;
+        if (!removed_[pc]) {
+            code[next++] = code[pc];
+        } else {
+            // 第一个函数之前的指令计入最后的 <全局>
+            int index = std::upper_bound(entries.begin(), entries.end(), pc) - entries.begin() - 1;
+            if (index < 0) index = entries.size();
+            stats.removed_per_function[index].second++;
+        }
+    }
+    new_addr[n] = next;
+    code.truncate(next);
+
+    for (auto& instr : code) {
+        if ((isJump(instr.op) || instr.op == OpCode::CALL) && instr.operand >= 0 && instr.operand <= n) {
+            instr.operand = new_addr[instr.operand];
+        }
+    }
+    for (auto& [name, entry] : bytecode.functions) {
+        if (entry >= 0 && entry <= n) entry = new_addr[entry];
+    }
+    if (bytecode.entry_point >= 0 && bytecode.entry_point <= n) {
+        bytecode.entry_point = new_addr[bytecode.entry_point];
+    }
+}
+
+PeepholeStats PeepholeOptimizer::run(ByteCode& bytecode) {
+    code_ = &bytecode.code;
+    for (const auto& instr : bytecode.code) {
+        if (instructionLength(instr.op) > 1) {
+            throw std::runtime_error("窥孔优化必须在超级指令融合之前运行");
+        }
+    }
+
+    PeepholeStats stats;
+    std::vector<std::pair<int, std::string>> entries;
+    for (const auto& [name, entry] : bytecode.functions) entries.push_back({entry, name});
+    std::sort(entries.begin(), entries.end());
+    for (const auto& [entry, name] : entries) stats.removed_per_function.push_back({name, 0});
+    stats.removed_per_function.push_back({"<全局>", 0});
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        int n = code_->size();
+        collectLabels(bytecode);
+        removed_.assign(n, false);
+
+        for (int i = 0; i < n; ++i) {
+            bool hit = (config_.dead_values && (removeDeadValue(i) || removeStoreReload(i))) ||
+                       (config_.stack_adjust && simplifyStack(i)) ||
+                       (config_.jumps && simplifyJump(i)) ||
+                       (config_.unreachable && removeUnreachable(i));
+            changed = changed || hit;
+        }
+        if (!changed) break;
+        stats.rounds++;
+        compact(bytecode, stats);
+    }
+
+    // 没有指令落在任何函数之外时不显示 <全局>
+    if (stats.removed_per_function.back().second == 0) stats.removed_per_function.pop_back();
+    return stats;
+}
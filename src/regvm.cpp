@@ -0,0 +1,928 @@
+#include "../include/regvm.h"
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+std::string regOpcodeName(RegOp op) {
+    switch (op) {
+        case RegOp::MOV:     return "MOV";
+        case RegOp::MOVI:    return "MOVI";
+        case RegOp::LOADM:   return "LOADM";
+        case RegOp::STOREM:  return "STOREM";
+        case RegOp::LOADG:   return "LOADG";
+        case RegOp::STOREG:  return "STOREG";
+        case RegOp::MEMCPY:  return "MEMCPY";
+        case RegOp::LOADMN:  return "LOADMN";
+        case RegOp::STOREMN: return "STOREMN";
+        case RegOp::LEA:     return "LEA";
+        case RegOp::LEAG:    return "LEAG";
+        case RegOp::ADDPTRD: return "ADDPTRD";
+        case RegOp::ADD:     return "ADD";
+        case RegOp::SUB:     return "SUB";
+        case RegOp::MUL:     return "MUL";
+        case RegOp::DIV:     return "DIV";
+        case RegOp::MOD:     return "MOD";
+        case RegOp::EQ:      return "EQ";
+        case RegOp::NE:      return "NE";
+        case RegOp::LT:      return "LT";
+        case RegOp::LE:      return "LE";
+        case RegOp::GT:      return "GT";
+        case RegOp::GE:      return "GE";
+        case RegOp::AND:     return "AND";
+        case RegOp::OR:      return "OR";
+        case RegOp::ADDI:    return "ADDI";
+        case RegOp::SUBI:    return "SUBI";
+        case RegOp::MULI:    return "MULI";
+        case RegOp::DIVI:    return "DIVI";
+        case RegOp::MODI:    return "MODI";
+        case RegOp::EQI:     return "EQI";
+        case RegOp::NEI:     return "NEI";
+        case RegOp::LTI:     return "LTI";
+        case RegOp::LEI:     return "LEI";
+        case RegOp::GTI:     return "GTI";
+        case RegOp::GEI:     return "GEI";
+        case RegOp::ANDI:    return "ANDI";
+        case RegOp::ORI:     return "ORI";
+        case RegOp::NEG:     return "NEG";
+        case RegOp::NOT:     return "NOT";
+        case RegOp::JMP:     return "JMP";
+        case RegOp::JZ:      return "JZ";
+        case RegOp::JNZ:     return "JNZ";
+        case RegOp::CALL:    return "CALL";
+        case RegOp::RET:     return "RET";
+        case RegOp::RETI:    return "RETI";
+        case RegOp::RETN:    return "RETN";
+        case RegOp::PRINT:   return "PRINT";
+        case RegOp::HALT:    return "HALT";
+        default:             return "???";
+    }
+}
+
+std::string RegByteCode::toString() const {
+    std::ostringstream ss;
+    auto r = [](int32_t k) { return "r" + std::to_string(k); };
+
+    for (size_t i = 0; i < code.size(); ++i) {
+        const auto& in = code[i];
+        ss << i << ":\t" << regOpcodeName(in.op);
+        switch (in.op) {
+            case RegOp::MOV: case RegOp::NEG: case RegOp::NOT: case RegOp::LOADM:
+                ss << " " << r(in.dst) << ", " << r(in.a);
+                break;
+            case RegOp::MOVI: case RegOp::LOADG: case RegOp::LEA: case RegOp::LEAG:
+                ss << " " << r(in.dst) << ", " << in.imm;
+                break;
+            case RegOp::STOREM:
+                ss << " [" << r(in.a) << "], " << r(in.b);
+                break;
+            case RegOp::STOREG:
+                ss << " " << in.imm << ", " << r(in.a);
+                break;
+            case RegOp::MEMCPY: case RegOp::RETN:
+                ss << " [" << r(in.b) << "], [" << r(in.a) << "], " << in.imm;
+                break;
+            case RegOp::LOADMN:
+                ss << " " << r(in.dst) << ", [" << r(in.a) << "], " << in.imm;
+                break;
+            case RegOp::STOREMN:
+                ss << " [" << r(in.a) << "], " << r(in.b) << ", " << in.imm;
+                break;
+            case RegOp::ADDPTRD:
+                ss << " " << r(in.dst) << ", " << r(in.a) << ", " << r(in.b) << " * " << in.imm;
+                break;
+            case RegOp::ADD: case RegOp::SUB: case RegOp::MUL: case RegOp::DIV: case RegOp::MOD:
+            case RegOp::EQ: case RegOp::NE: case RegOp::LT: case RegOp::LE: case RegOp::GT:
+            case RegOp::GE: case RegOp::AND: case RegOp::OR:
+                ss << " " << r(in.dst) << ", " << r(in.a) << ", " << r(in.b);
+                break;
+            case RegOp::ADDI: case RegOp::SUBI: case RegOp::MULI: case RegOp::DIVI: case RegOp::MODI:
+            case RegOp::EQI: case RegOp::NEI: case RegOp::LTI: case RegOp::LEI: case RegOp::GTI:
+            case RegOp::GEI: case RegOp::ANDI: case RegOp::ORI:
+                ss << " " << r(in.dst) << ", " << r(in.a) << ", " << in.imm;
+                break;
+            case RegOp::JMP:
+                ss << " " << in.imm;
+                break;
+            case RegOp::JZ: case RegOp::JNZ:
+                ss << " " << r(in.a) << ", " << in.imm;
+                break;
+            case RegOp::CALL:
+                ss << " " << in.imm << " (frame at r" << in.dst << ")";
+                break;
+            case RegOp::RET:
+                ss << " " << r(in.imm) << " <- " << r(in.a);
+                break;
+            case RegOp::RETI:
+                ss << " " << r(in.imm) << " <- " << in.a;
+                break;
+            case RegOp::PRINT:
+                ss << " " << r(in.a);
+                break;
+            case RegOp::HALT:
+                break;
+        }
+        ss << "\n";
+    }
+    return ss.str();
+}
+
+// ========== 栈式字节码 -> 寄存器字节码 ==========
+
+// 计算每条指令执行前的栈深度，以及每个函数的栈帧大小
+// 跳转汇合处的栈深度必须一致，否则无法把栈位置静态地映射为寄存器
+void RegisterLowering::analyzeDepths() {
+    const auto& code = src_->code;
+    int n = code.size();
+    depth_.assign(n, -1);
+    is_label_.assign(n, false);
+
+    for (const auto& instr : code) {
+        if (instr.op == OpCode::JMP || instr.op == OpCode::JZ ||
+            instr.op == OpCode::JNZ || instr.op == OpCode::CALL) {
+            if (instr.operand < 0 || instr.operand >= n) {
+                throw std::runtime_error("寄存器后端: 跳转目标越界: " + std::to_string(instr.operand));
+            }
+            is_label_[instr.operand] = true;
+        }
+    }
+
+    for (const auto& [name, entry] : src_->functions) {
+        is_label_[entry] = true;
+
+        int max_depth = 0;
+        std::vector<std::pair<int, int>> worklist = {{entry, 0}};
+        while (!worklist.empty()) {
+            auto [pc, depth] = worklist.back();
+            worklist.pop_back();
+            if (pc >= n) continue;
+
+            if (depth_[pc] >= 0) {
+                if (depth_[pc] != depth) {
+                    throw std::runtime_error("寄存器后端: 函数 " + name + " 在地址 " +
+                                             std::to_string(pc) + " 处栈深度不一致");
+                }
+                continue;
+            }
+            depth_[pc] = depth;
+
+            const auto& instr = code[pc];
+            StackEffect effect = stackEffect(instr);
+            int next = depth - effect.pops + effect.pushes;
+            if (next < 0) {
+                throw std::runtime_error("寄存器后端: 函数 " + name + " 在地址 " +
+                                         std::to_string(pc) + " 处栈下溢");
+            }
+            max_depth = std::max(max_depth, next);
+
+            switch (instr.op) {
+                case OpCode::JMP:
+                    worklist.push_back({instr.operand, next});
+                    break;
+                case OpCode::JZ:
+                case OpCode::JNZ:
+                    worklist.push_back({instr.operand, next});
+                    worklist.push_back({pc + 1, next});
+                    break;
+                case OpCode::RET:
+                case OpCode::RETN:
+                case OpCode::HALT:
+                    break;
+                default:
+                    worklist.push_back({pc + 1, next});
+                    break;
+            }
+        }
+        frame_sizes_[entry] = max_depth;
+    }
+}
+
+void RegisterLowering::emit(RegOp op, int32_t dst, int32_t a, int32_t b, int32_t imm) {
+    out_.code.emplace_back(op, dst, a, b, imm);
+    last_def_ = -1;
+}
+
+void RegisterLowering::resetStack(int depth) {
+    stack_.assign(depth, StackValue{StackValue::Slot, 0});
+    last_def_ = -1;
+}
+
+void RegisterLowering::materialize(int pos) {
+    auto& v = stack_[pos];
+    if (v.kind == StackValue::Imm) {
+        emit(RegOp::MOVI, pos, 0, 0, v.value);
+    } else if (v.kind == StackValue::Reg) {
+        emit(RegOp::MOV, pos, v.value);
+    }
+    v = StackValue{StackValue::Slot, 0};
+}
+
+void RegisterLowering::flush() {
+    for (int pos = 0; pos < (int)stack_.size(); ++pos) {
+        if (stack_[pos].kind != StackValue::Slot) {
+            materialize(pos);
+        }
+    }
+}
+
+void RegisterLowering::materializeAliasesOf(int k) {
+    for (int pos = 0; pos < (int)stack_.size(); ++pos) {
+        if (stack_[pos].kind == StackValue::Reg && stack_[pos].value == k) {
+            materialize(pos);
+        }
+    }
+}
+
+int RegisterLowering::operandReg(const StackValue& v, int pos) {
+    switch (v.kind) {
+        case StackValue::Slot:
+            return pos;
+        case StackValue::Reg:
+            return v.value;
+        case StackValue::Imm:
+        default:
+            emit(RegOp::MOVI, pos, 0, 0, v.value);
+            return pos;
+    }
+}
+
+void RegisterLowering::lowerBinary(OpCode op) {
+    StackValue b = stack_.back();
+    stack_.pop_back();
+    StackValue a = stack_.back();
+    stack_.pop_back();
+    int pos = stack_.size();
+
+    // 两个操作数都是常量：直接折叠（除零留给运行时报错）
+    if (a.kind == StackValue::Imm && b.kind == StackValue::Imm &&
+        !((op == OpCode::DIV || op == OpCode::MOD) && b.value == 0)) {
+        int32_t x = a.value, y = b.value, r = 0;
+        switch (op) {
+            case OpCode::ADD: r = x + y; break;
+            case OpCode::SUB: r = x - y; break;
+            case OpCode::MUL: r = x * y; break;
+            case OpCode::DIV: r = x / y; break;
+            case OpCode::MOD: r = x % y; break;
+            case OpCode::EQ:  r = x == y; break;
+            case OpCode::NE:  r = x != y; break;
+            case OpCode::LT:  r = x < y; break;
+            case OpCode::LE:  r = x <= y; break;
+            case OpCode::GT:  r = x > y; break;
+            case OpCode::GE:  r = x >= y; break;
+            case OpCode::AND: r = (x && y) ? 1 : 0; break;
+            case OpCode::OR:  r = (x || y) ? 1 : 0; break;
+            default: break;
+        }
+        stack_.push_back(StackValue{StackValue::Imm, r});
+        return;
+    }
+
+    // 左操作数是常量：可交换的运算交换操作数，比较运算取镜像
+    if (a.kind == StackValue::Imm && b.kind != StackValue::Imm) {
+        bool swapped = true;
+        switch (op) {
+            case OpCode::ADD: case OpCode::MUL: case OpCode::EQ:
+            case OpCode::NE: case OpCode::AND: case OpCode::OR:
+                break;
+            case OpCode::LT: op = OpCode::GT; break;
+            case OpCode::LE: op = OpCode::GE; break;
+            case OpCode::GT: op = OpCode::LT; break;
+            case OpCode::GE: op = OpCode::LE; break;
+            default: swapped = false; break;
+        }
+        if (swapped) {
+            std::swap(a, b);
+        }
+    }
+
+    // 寄存器 op 寄存器 / 寄存器 op 立即数，结果写入左操作数的位置
+    RegOp reg_op, imm_op;
+    switch (op) {
+        case OpCode::ADD: reg_op = RegOp::ADD; imm_op = RegOp::ADDI; break;
+        case OpCode::SUB: reg_op = RegOp::SUB; imm_op = RegOp::SUBI; break;
+        case OpCode::MUL: reg_op = RegOp::MUL; imm_op = RegOp::MULI; break;
+        case OpCode::DIV: reg_op = RegOp::DIV; imm_op = RegOp::DIVI; break;
+        case OpCode::MOD: reg_op = RegOp::MOD; imm_op = RegOp::MODI; break;
+        case OpCode::EQ:  reg_op = RegOp::EQ;  imm_op = RegOp::EQI;  break;
+        case OpCode::NE:  reg_op = RegOp::NE;  imm_op = RegOp::NEI;  break;
+        case OpCode::LT:  reg_op = RegOp::LT;  imm_op = RegOp::LTI;  break;
+        case OpCode::LE:  reg_op = RegOp::LE;  imm_op = RegOp::LEI;  break;
+        case OpCode::GT:  reg_op = RegOp::GT;  imm_op = RegOp::GTI;  break;
+        case OpCode::GE:  reg_op = RegOp::GE;  imm_op = RegOp::GEI;  break;
+        case OpCode::AND: reg_op = RegOp::AND; imm_op = RegOp::ANDI; break;
+        case OpCode::OR:  reg_op = RegOp::OR;  imm_op = RegOp::ORI;  break;
+        default:
+            throw std::runtime_error("寄存器后端: 未知的二元运算 " + opcodeName(op));
+    }
+
+    int ra = operandReg(a, pos);
+    if (b.kind == StackValue::Imm) {
+        emit(imm_op, pos, ra, 0, b.value);
+    } else {
+        int rb = operandReg(b, pos + 1);
+        emit(reg_op, pos, ra, rb);
+    }
+    stack_.push_back(StackValue{StackValue::Slot, 0});
+    last_def_ = pos;
+}
+
+void RegisterLowering::lowerStore(int k) {
+    StackValue v = stack_.back();
+    stack_.pop_back();
+    int pos = stack_.size();
+
+    bool has_alias = false;
+    for (const auto& e : stack_) {
+        if (e.kind == StackValue::Reg && e.value == k) {
+            has_alias = true;
+            break;
+        }
+    }
+
+    if (v.kind == StackValue::Slot && last_def_ == pos && !has_alias) {
+        // 值刚由上一条指令算出：直接把那条指令的目标改成 r[k]
+        out_.code.back().dst = k;
+        last_def_ = -1;
+    } else if (!(v.kind == StackValue::Reg && v.value == k)) {
+        materializeAliasesOf(k);
+        if (v.kind == StackValue::Imm) {
+            emit(RegOp::MOVI, k, 0, 0, v.value);
+        } else {
+            emit(RegOp::MOV, k, operandReg(v, pos));
+        }
+    }
+
+    if (k >= 0 && k < (int)stack_.size()) {
+        stack_[k] = StackValue{StackValue::Slot, 0};
+    }
+}
+
+RegByteCode RegisterLowering::lower(const ByteCode& input) {
+    // 超级指令按原序列翻译：被融合的原指令都还在，只需还原第一条
+    ByteCode unfused;
+    bool has_fused = false;
+    for (const auto& instr : input.code) {
+        if (instructionLength(instr.op) > 1) {
+            has_fused = true;
+            break;
+        }
+    }
+    if (has_fused) {
+        unfused = input;
+        for (auto& instr : unfused.code) {
+            instr.op = unfusedOpcode(instr.op);
+        }
+    }
+    const ByteCode& bytecode = has_fused ? unfused : input;
+
+    src_ = &bytecode;
+    out_ = RegByteCode();
+    out_.global_inits = bytecode.global_inits;
+    frame_sizes_.clear();
+
+    analyzeDepths();
+
+    const auto& code = bytecode.code;
+    int n = code.size();
+    std::vector<int> pc_map(n + 1, 0);
+    int block_start = 0;      // 当前基本块第一条寄存器指令（之前的指令可能是跳转目标，不能删除）
+    bool reachable = false;   // 上一条指令是否会顺序执行到当前指令
+
+    for (int i = 0; i < n; ++i) {
+        // 顺序流入跳转目标：先把值写回 slot，跳转目标处所有值都在自己的 slot 里
+        if (is_label_[i] && reachable) {
+            flush();
+        }
+        pc_map[i] = out_.code.size();
+
+        if (depth_[i] < 0) {
+            reachable = false;  // 不可达代码
+            continue;
+        }
+        if (is_label_[i] || !reachable) {
+            resetStack(depth_[i]);
+            block_start = out_.code.size();
+        }
+        reachable = true;
+
+        const auto& instr = code[i];
+        switch (instr.op) {
+            case OpCode::PUSH:
+                stack_.push_back(StackValue{StackValue::Imm, instr.operand});
+                break;
+
+            case OpCode::POP: {
+                stack_.pop_back();
+                // 删除结果不再被使用的无副作用指令（例如赋值表达式语句末尾重新加载的值）
+                while ((int)out_.code.size() > block_start) {
+                    const auto& last = out_.code.back();
+                    bool pure = last.op != RegOp::STOREM && last.op != RegOp::STOREG &&
+                                last.op != RegOp::MEMCPY && last.op != RegOp::STOREMN &&
+                                last.op != RegOp::DIV &&
+                                last.op != RegOp::MOD && last.op != RegOp::DIVI &&
+                                last.op != RegOp::MODI && last.op != RegOp::JMP &&
+                                last.op != RegOp::JZ && last.op != RegOp::JNZ &&
+                                last.op != RegOp::CALL && last.op != RegOp::RET &&
+                                last.op != RegOp::RETI && last.op != RegOp::RETN &&
+                                last.op != RegOp::PRINT &&
+                                last.op != RegOp::HALT;
+                    if (!pure || last.dst < (int)stack_.size()) break;
+                    out_.code.pop_back();
+                }
+                last_def_ = -1;
+                break;
+            }
+
+            case OpCode::LOAD: {
+                int k = instr.operand;
+                if (k >= 0 && k < (int)stack_.size() && stack_[k].kind != StackValue::Slot) {
+                    materialize(k);
+                }
+                stack_.push_back(StackValue{StackValue::Reg, k});
+                break;
+            }
+
+            case OpCode::STORE:
+                lowerStore(instr.operand);
+                break;
+
+            case OpCode::LOADM: {
+                StackValue addr = stack_.back();
+                stack_.pop_back();
+                int pos = stack_.size();
+                int ra = operandReg(addr, pos);
+                flush();
+                emit(RegOp::LOADM, pos, ra);
+                stack_.push_back(StackValue{StackValue::Slot, 0});
+                last_def_ = pos;
+                break;
+            }
+
+            case OpCode::STOREM: {
+                StackValue addr = stack_.back();
+                stack_.pop_back();
+                StackValue value = stack_.back();
+                stack_.pop_back();
+                int pos = stack_.size();
+                int rv = operandReg(value, pos);
+                int ra = operandReg(addr, pos + 1);
+                flush();
+                emit(RegOp::STOREM, 0, ra, rv);
+                break;
+            }
+
+            case OpCode::LOADG: {
+                int pos = stack_.size();
+                emit(RegOp::LOADG, pos, 0, 0, instr.operand);
+                stack_.push_back(StackValue{StackValue::Slot, 0});
+                last_def_ = pos;
+                break;
+            }
+
+            case OpCode::STOREG: {
+                StackValue v = stack_.back();
+                stack_.pop_back();
+                emit(RegOp::STOREG, 0, operandReg(v, stack_.size()), 0, instr.operand);
+                break;
+            }
+
+            case OpCode::LEAG: {
+                int pos = stack_.size();
+                emit(RegOp::LEAG, pos, 0, 0, instr.operand);
+                stack_.push_back(StackValue{StackValue::Slot, 0});
+                last_def_ = pos;
+                break;
+            }
+
+            case OpCode::LEA: {
+                int pos = stack_.size();
+                emit(RegOp::LEA, pos, 0, 0, instr.operand);
+                stack_.push_back(StackValue{StackValue::Slot, 0});
+                last_def_ = pos;
+                break;
+            }
+
+            case OpCode::ADDPTR: {
+                StackValue addr = stack_.back();
+                stack_.pop_back();
+                int pos = stack_.size();
+                if (addr.kind == StackValue::Slot && last_def_ == pos &&
+                    (out_.code.back().op == RegOp::LEA || out_.code.back().op == RegOp::LEAG)) {
+                    // LEA k; ADDPTR m  ->  LEA k+m
+                    out_.code.back().imm += instr.operand;
+                } else {
+                    emit(RegOp::ADDI, pos, operandReg(addr, pos), 0, instr.operand);
+                }
+                stack_.push_back(StackValue{StackValue::Slot, 0});
+                last_def_ = pos;
+                break;
+            }
+
+            case OpCode::ADDPTRD: {
+                StackValue base = stack_.back();
+                stack_.pop_back();
+                StackValue index = stack_.back();
+                stack_.pop_back();
+                int pos = stack_.size();
+                int ri = operandReg(index, pos);
+                int rb = operandReg(base, pos + 1);
+                emit(RegOp::ADDPTRD, pos, rb, ri, instr.operand);
+                stack_.push_back(StackValue{StackValue::Slot, 0});
+                last_def_ = pos;
+                break;
+            }
+
+            case OpCode::ADD: case OpCode::SUB: case OpCode::MUL: case OpCode::DIV:
+            case OpCode::MOD: case OpCode::EQ: case OpCode::NE: case OpCode::LT:
+            case OpCode::LE: case OpCode::GT: case OpCode::GE: case OpCode::AND:
+            case OpCode::OR:
+                lowerBinary(instr.op);
+                break;
+
+            case OpCode::NEG:
+            case OpCode::NOT: {
+                StackValue v = stack_.back();
+                stack_.pop_back();
+                int pos = stack_.size();
+                if (v.kind == StackValue::Imm) {
+                    int32_t r = instr.op == OpCode::NEG ? -v.value : (v.value == 0 ? 1 : 0);
+                    stack_.push_back(StackValue{StackValue::Imm, r});
+                    break;
+                }
+                emit(instr.op == OpCode::NEG ? RegOp::NEG : RegOp::NOT, pos, operandReg(v, pos));
+                stack_.push_back(StackValue{StackValue::Slot, 0});
+                last_def_ = pos;
+                break;
+            }
+
+            case OpCode::JMP:
+                flush();
+                emit(RegOp::JMP, 0, 0, 0, instr.operand);
+                reachable = false;
+                break;
+
+            case OpCode::JZ:
+            case OpCode::JNZ: {
+                StackValue cond = stack_.back();
+                stack_.pop_back();
+                if (cond.kind == StackValue::Imm) {
+                    // 常量条件：要么总是跳转，要么从不跳转
+                    bool taken = (instr.op == OpCode::JZ) == (cond.value == 0);
+                    if (taken) {
+                        flush();
+                        emit(RegOp::JMP, 0, 0, 0, instr.operand);
+                        reachable = false;
+                    }
+                    break;
+                }
+                int rc = operandReg(cond, stack_.size());
+                flush();
+                emit(instr.op == OpCode::JZ ? RegOp::JZ : RegOp::JNZ, 0, rc, 0, instr.operand);
+                block_start = out_.code.size();
+                break;
+            }
+
+            case OpCode::CALL:
+                // 参数必须真正写入栈帧，被调函数通过 fp 负偏移读取
+                flush();
+                emit(RegOp::CALL, stack_.size(), 0, 0, instr.operand);
+                block_start = out_.code.size();
+                break;
+
+            case OpCode::RET: {
+                if (stack_.empty()) {
+                    emit(RegOp::RETI, 0, 0, 0, instr.operand);
+                } else {
+                    StackValue v = stack_.back();
+                    if (v.kind == StackValue::Imm) {
+                        emit(RegOp::RETI, 0, v.value, 0, instr.operand);
+                    } else {
+                        emit(RegOp::RET, 0, operandReg(v, stack_.size() - 1), 0, instr.operand);
+                    }
+                }
+                reachable = false;
+                break;
+            }
+
+            case OpCode::RETN: {
+                // 与 MEMCPY 相同：源区间可能是栈上的值（函数调用的返回值），先写回内存
+                StackValue dst = stack_.back();
+                stack_.pop_back();
+                StackValue src = stack_.back();
+                stack_.pop_back();
+                int pos = stack_.size();
+                int rs = operandReg(src, pos);
+                int rd = operandReg(dst, pos + 1);
+                flush();
+                emit(RegOp::RETN, 0, rs, rd, instr.operand);
+                reachable = false;
+                break;
+            }
+
+            case OpCode::PRINT: {
+                int pos = stack_.size() - 1;
+                int r = operandReg(stack_.back(), pos);
+                stack_.back() = StackValue{r == pos ? StackValue::Slot : StackValue::Reg, r};
+                emit(RegOp::PRINT, 0, r);
+                break;
+            }
+
+            case OpCode::HALT:
+                emit(RegOp::HALT);
+                reachable = false;
+                break;
+
+            case OpCode::ADJSP:
+                stack_.resize(stack_.size() - instr.operand);
+                last_def_ = -1;
+                break;
+
+            case OpCode::MEMCPY: {
+                StackValue dst = stack_.back();
+                stack_.pop_back();
+                StackValue src = stack_.back();
+                stack_.pop_back();
+                int pos = stack_.size();
+                int rs = operandReg(src, pos);
+                int rd = operandReg(dst, pos + 1);
+                flush();
+                emit(RegOp::MEMCPY, 0, rs, rd, instr.operand);
+                break;
+            }
+
+            case OpCode::LOADMN: {
+                StackValue addr = stack_.back();
+                stack_.pop_back();
+                int pos = stack_.size();
+                int ra = operandReg(addr, pos);
+                flush();
+                emit(RegOp::LOADMN, pos, ra, 0, instr.operand);
+                for (int k = 0; k < instr.operand; ++k) {
+                    stack_.push_back(StackValue{StackValue::Slot, 0});
+                }
+                last_def_ = -1;
+                break;
+            }
+
+            case OpCode::STOREMN: {
+                // 值和地址都写回自己的 slot：r[pos..pos+n-1] 是值，r[pos+n] 是地址
+                flush();
+                stack_.resize(stack_.size() - instr.operand - 1);
+                int pos = stack_.size();
+                emit(RegOp::STOREMN, 0, pos + instr.operand, pos, instr.operand);
+                break;
+            }
+
+            default:
+                // 超级指令已在入口处还原
+                throw std::runtime_error("寄存器后端: 不支持的指令 " + opcodeName(instr.op));
+        }
+    }
+    pc_map[n] = out_.code.size();
+
+    // 回填跳转地址，CALL 记录被调函数的栈帧大小
+    for (auto& in : out_.code) {
+        if (in.op == RegOp::CALL) {
+            in.a = frame_sizes_[in.imm];
+        }
+        if (in.op == RegOp::JMP || in.op == RegOp::JZ ||
+            in.op == RegOp::JNZ || in.op == RegOp::CALL) {
+            in.imm = pc_map[in.imm];
+        }
+    }
+    for (const auto& [name, entry] : bytecode.functions) {
+        out_.functions[name] = pc_map[entry];
+        out_.frame_sizes[pc_map[entry]] = frame_sizes_[entry];
+    }
+    out_.entry_point = bytecode.entry_point >= 0 ? pc_map[bytecode.entry_point] : -1;
+
+    return out_;
+}
+
+// ========== 寄存器式虚拟机 ==========
+
+void RegVM::setStackSize(int slots) {
+    if (slots <= 0 || slots > VM::MAX_STACK_SIZE) {
+        throw std::runtime_error("栈大小必须在 1 到 " + std::to_string(VM::MAX_STACK_SIZE) + " 个 slot 之间");
+    }
+    stack_size_ = slots;
+}
+
+int RegVM::execute(const RegByteCode& bytecode) {
+    if (bytecode.entry_point < 0) {
+        throw std::runtime_error("No entry point (main function)");
+    }
+
+    // 与栈式 VM 相同的线性内存: [空指针][全局区][栈]
+    const int stack_base = VM::stackBase(bytecode.global_inits);
+    const int globals_size = stack_base - VM::GLOBAL_BASE;
+    if (stack_base > INT32_MAX - stack_size_) {
+        throw std::runtime_error("全局区和栈超出 VM 的地址范围");
+    }
+    memory_.resize(stack_base + stack_size_);
+    const int stack_size = memory_.size() - stack_base;   // 取整到整页后多出的部分留给栈
+    int32_t* const globals = memory_.data() + VM::GLOBAL_BASE;
+    int32_t* global = globals;
+    for (const auto& init : bytecode.global_inits) {
+        for (int i = 0; i < init.slot_count; i++) {
+            *global++ = i < (int)init.init_data.size() ? init.init_data[i] : 0;
+        }
+    }
+    const uint32_t address_limit = memory_.size() - VM::GLOBAL_BASE;
+
+    // 与栈式 VM 相同的虚拟调用帧: [ret_slot][ret_addr = -1][old_fp]，fp = 3
+    int32_t* stack = memory_.data() + stack_base;
+    stack[0] = 0;
+    stack[1] = -1;
+    stack[2] = 0;
+    int fp = 3;
+    auto main_frame = bytecode.frame_sizes.find(bytecode.entry_point);
+    if (main_frame != bytecode.frame_sizes.end() && fp + main_frame->second > stack_size) {
+        throw std::runtime_error("Stack overflow");
+    }
+
+    const RegInstr* code = bytecode.code.data();
+    const int code_size = bytecode.code.size();
+    int32_t* r = stack + fp;   // 当前帧的寄存器: r[k] = stack[fp + k]
+    int pc = bytecode.entry_point;
+
+    // 内存地址访问（与栈式 VM 的 LOADM/STOREM 语义一致）：一次无符号比较
+    auto memRef = [&](int32_t addr, const char* what) -> int32_t& {
+        if (static_cast<uint32_t>(addr) - VM::GLOBAL_BASE >= address_limit) {
+            throw std::runtime_error(std::string(what) + ": 内存访问越界");
+        }
+        return memory_[addr];
+    };
+    // 整个区间 [addr, addr + size) 在内存中（LOADMN/STOREMN），与 VM::validRange 相同
+    auto checkRange = [&](int32_t addr, int32_t size, const char* what) {
+        if (size < 0 || static_cast<uint32_t>(addr) - VM::GLOBAL_BASE + static_cast<uint64_t>(size) > address_limit) {
+            throw std::runtime_error(std::string(what) + ": 内存访问越界");
+        }
+    };
+
+    while (pc >= 0 && pc < code_size) {
+        const RegInstr& in = code[pc++];
+
+        switch (in.op) {
+            case RegOp::MOV:  r[in.dst] = r[in.a]; break;
+            case RegOp::MOVI: r[in.dst] = in.imm; break;
+
+            case RegOp::LOADM:
+                r[in.dst] = memRef(r[in.a], "LOADM");
+                break;
+            case RegOp::STOREM:
+                memRef(r[in.a], "STOREM") = r[in.b];
+                break;
+            case RegOp::LOADG:
+                if (in.imm < 0 || in.imm >= globals_size) {
+                    throw std::runtime_error("LOADG: 全局变量访问越界");
+                }
+                r[in.dst] = globals[in.imm];
+                break;
+            case RegOp::STOREG:
+                if (in.imm < 0 || in.imm >= globals_size) {
+                    throw std::runtime_error("STOREG: 全局变量访问越界");
+                }
+                globals[in.imm] = r[in.a];
+                break;
+            case RegOp::MEMCPY: {
+                int32_t src = r[in.a];
+                int32_t dst = r[in.b];
+                int32_t size = in.imm;
+                // 两个区间各检查一次首尾，之后一次 memmove
+                if (size > 0) {
+                    if (static_cast<uint32_t>(src) - VM::GLOBAL_BASE >= address_limit ||
+                        static_cast<uint32_t>(dst) - VM::GLOBAL_BASE >= address_limit ||
+                        size > (int)memory_.size() - src || size > (int)memory_.size() - dst) {
+                        throw std::runtime_error("MEMCPY: 内存访问越界");
+                    }
+                    std::memmove(memory_.data() + dst, memory_.data() + src, size * sizeof(int32_t));
+                }
+                break;
+            }
+
+            case RegOp::LOADMN: {
+                int32_t addr = r[in.a];
+                checkRange(addr, in.imm, "LOADMN");
+                for (int32_t i = 0; i < in.imm; ++i) r[in.dst + i] = memory_[addr + i];
+                break;
+            }
+            case RegOp::STOREMN: {
+                int32_t addr = r[in.a];
+                checkRange(addr, in.imm, "STOREMN");
+                for (int32_t i = 0; i < in.imm; ++i) memory_[addr + i] = r[in.b + i];
+                break;
+            }
+
+            case RegOp::LEA:     r[in.dst] = stack_base + fp + in.imm; break;
+            case RegOp::LEAG:    r[in.dst] = VM::GLOBAL_BASE + in.imm; break;
+            case RegOp::ADDPTRD: r[in.dst] = r[in.a] + r[in.b] * in.imm; break;
+
+            case RegOp::ADD: r[in.dst] = r[in.a] + r[in.b]; break;
+            case RegOp::SUB: r[in.dst] = r[in.a] - r[in.b]; break;
+            case RegOp::MUL: r[in.dst] = r[in.a] * r[in.b]; break;
+            case RegOp::DIV:
+                if (r[in.b] == 0) throw std::runtime_error("Division by zero");
+                r[in.dst] = r[in.a] / r[in.b];
+                break;
+            case RegOp::MOD:
+                if (r[in.b] == 0) throw std::runtime_error("Division by zero");
+                r[in.dst] = r[in.a] % r[in.b];
+                break;
+            case RegOp::EQ:  r[in.dst] = r[in.a] == r[in.b]; break;
+            case RegOp::NE:  r[in.dst] = r[in.a] != r[in.b]; break;
+            case RegOp::LT:  r[in.dst] = r[in.a] < r[in.b]; break;
+            case RegOp::LE:  r[in.dst] = r[in.a] <= r[in.b]; break;
+            case RegOp::GT:  r[in.dst] = r[in.a] > r[in.b]; break;
+            case RegOp::GE:  r[in.dst] = r[in.a] >= r[in.b]; break;
+            case RegOp::AND: r[in.dst] = (r[in.a] && r[in.b]) ? 1 : 0; break;
+            case RegOp::OR:  r[in.dst] = (r[in.a] || r[in.b]) ? 1 : 0; break;
+
+            case RegOp::ADDI: r[in.dst] = r[in.a] + in.imm; break;
+            case RegOp::SUBI: r[in.dst] = r[in.a] - in.imm; break;
+            case RegOp::MULI: r[in.dst] = r[in.a] * in.imm; break;
+            case RegOp::DIVI:
+                if (in.imm == 0) throw std::runtime_error("Division by zero");
+                r[in.dst] = r[in.a] / in.imm;
+                break;
+            case RegOp::MODI:
+                if (in.imm == 0) throw std::runtime_error("Division by zero");
+                r[in.dst] = r[in.a] % in.imm;
+                break;
+            case RegOp::EQI:  r[in.dst] = r[in.a] == in.imm; break;
+            case RegOp::NEI:  r[in.dst] = r[in.a] != in.imm; break;
+            case RegOp::LTI:  r[in.dst] = r[in.a] < in.imm; break;
+            case RegOp::LEI:  r[in.dst] = r[in.a] <= in.imm; break;
+            case RegOp::GTI:  r[in.dst] = r[in.a] > in.imm; break;
+            case RegOp::GEI:  r[in.dst] = r[in.a] >= in.imm; break;
+            case RegOp::ANDI: r[in.dst] = (r[in.a] && in.imm) ? 1 : 0; break;
+            case RegOp::ORI:  r[in.dst] = (r[in.a] || in.imm) ? 1 : 0; break;
+
+            case RegOp::NEG: r[in.dst] = -r[in.a]; break;
+            case RegOp::NOT: r[in.dst] = r[in.a] == 0 ? 1 : 0; break;
+
+            case RegOp::JMP: pc = in.imm; break;
+            case RegOp::JZ:  if (r[in.a] == 0) pc = in.imm; break;
+            case RegOp::JNZ: if (r[in.a] != 0) pc = in.imm; break;
+
+            case RegOp::CALL: {
+                // 新帧: [ret_addr][old_fp] 紧跟在当前帧已用的 dst 个 slot（含参数）之后
+                int base = fp + in.dst;
+                if (base + 2 + in.a > stack_size) {
+                    throw std::runtime_error("Stack overflow");
+                }
+                stack[base] = pc;
+                stack[base + 1] = fp;
+                fp = base + 2;
+                r = stack + fp;
+                pc = in.imm;
+                break;
+            }
+
+            case RegOp::RET:
+            case RegOp::RETI: {
+                // ret_slot 在 fp + imm（由 caller 预留），栈帧布局与栈式 VM 相同
+                r[in.imm] = in.op == RegOp::RET ? r[in.a] : in.a;
+                int32_t ret_addr = r[-2];
+                fp = r[-1];
+                r = stack + fp;
+                if (ret_addr == -1) {
+                    return stack[0];
+                }
+                pc = ret_addr;
+                break;
+            }
+
+            case RegOp::RETN: {
+                // 返回区在被调函数的栈帧下面，按地址从低到高复制（与栈式 VM 的 RETN 相同）
+                // 两个区间的检查写在一个条件里（负的 size 转成 uint64 后一定超出范围）
+                int32_t src = r[in.a];
+                int32_t dst = r[in.b];
+                int32_t size = in.imm;
+                if (static_cast<uint32_t>(src) - VM::GLOBAL_BASE + static_cast<uint64_t>(size) > address_limit ||
+                    static_cast<uint32_t>(dst) - VM::GLOBAL_BASE + static_cast<uint64_t>(size) > address_limit) {
+                    throw std::runtime_error("RETN: 内存访问越界");
+                }
+                int32_t* memory = memory_.data();
+                for (int32_t i = 0; i < size; ++i) memory[dst + i] = memory[src + i];
+                int32_t ret_addr = r[-2];
+                fp = r[-1];
+                r = stack + fp;
+                if (ret_addr == -1) {
+                    return stack[0];
+                }
+                pc = ret_addr;
+                break;
+            }
+
+            case RegOp::PRINT:
+                std::cout << "OUTPUT: " << r[in.a] << "\n";
+                break;
+
+            case RegOp::HALT:
+                return stack[0];
+        }
+    }
+
+    return stack[0];
+}
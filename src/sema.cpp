@@ -1,35 +1,23 @@
 #include "../include/sema.h"
 
-std::shared_ptr<Type> Sema::stringToType(const std::string& type_name) {
-    if (type_name == "int") return Type::getIntType();
-    if (type_name == "void") return Type::getVoidType();
-
-    // 处理指针类型: int*, int**, struct Point*, ...
-    if (type_name.size() > 1 && type_name.back() == '*') {
-        // 递归获取基类型
-        auto base_type = stringToType(type_name.substr(0, type_name.size() - 1));
-        if (base_type) {
-            return std::make_shared<PointerType>(base_type);
-        }
+// 声明中的类型已经由 Parser 解析成类型对象；结构体（以及指向它的指针）必须已经定义
+bool Sema::isDefinedType(const Type* type) const {
+    while (type->isPointer()) {
+        type = static_cast<const PointerType*>(type)->getBaseType();
     }
-
-    // 处理结构体类型: struct Point
-    if (type_name.size() > 7 && type_name.substr(0, 7) == "struct ") {
-        std::string struct_name = type_name.substr(7);
-        auto it = struct_types_.find(struct_name);
-        if (it != struct_types_.end()) {
-            return it->second;
-        }
-        return nullptr;
+    if (!type->isStruct()) {
+        return true;
     }
-
-    return nullptr;
+    auto it = struct_types_.find(static_cast<const StructType*>(type)->getName());
+    return it != struct_types_.end() && it->second == type;
 }
 
 bool Sema::analyze(ProgramNode* program) {
+    types_ = &program->getContext().getTypes();
+
     // 先分析所有结构体定义（结构体前向声明需要）
     for (const auto& struct_decl : program->getStructs()) {
-        analyzeStructDecl(struct_decl.get());
+        analyzeStructDecl(struct_decl);
     }
 
     // 按照源文件声明顺序分析全局变量和函数
@@ -42,12 +30,12 @@ bool Sema::analyze(ProgramNode* program) {
     for (int decl_type : decl_order) {
         if (decl_type == 1) {  // global_var
             if (global_idx < program->getGlobalVars().size()) {
-                analyzeGlobalVarDecl(program->getGlobalVars()[global_idx].get());
+                analyzeGlobalVarDecl(program->getGlobalVars()[global_idx]);
                 global_idx++;
             }
         } else if (decl_type == 2) {  // function
             if (func_idx < program->getFunctions().size()) {
-                analyzeFunction(program->getFunctions()[func_idx].get());
+                analyzeFunction(program->getFunctions()[func_idx]);
                 func_idx++;
             }
         }
@@ -59,28 +47,22 @@ bool Sema::analyze(ProgramNode* program) {
 
 void Sema::analyzeFunction(FunctionDeclNode* func) {
     // 获取返回类型
-    auto return_type = stringToType(func->getReturnType());
-    if (!return_type) {
-        error("未知的返回类型: " + func->getReturnType());
+    const Type* return_type = func->getReturnType();
+    if (!isDefinedType(return_type)) {
+        error("未知的返回类型: " + return_type->toString());
         return;
     }
 
-    // 设置函数返回类型到AST
-    func->setResolvedReturnType(return_type);
-
     // 构建函数类型
-    std::vector<FunctionType::Param> params;
-    for (auto& param : func->getParams()) {
-        auto param_type = stringToType(param.type);
-        if (!param_type) {
-            error("未知的参数类型: " + param.type);
+    std::vector<const Type*> params;
+    for (const auto& param : func->getParams()) {
+        if (!isDefinedType(param.type)) {
+            error("未知的参数类型: " + param.type->toString());
             return;
         }
-        // 设置参数类型到AST
-        param.setResolvedType(param_type);
-        params.emplace_back(param_type, param.name);
+        params.push_back(param.type);
     }
-    auto func_type = std::make_shared<FunctionType>(return_type, params);
+    const Type* func_type = types_->getFunctionType(return_type, params);
 
     // 检查函数是否重复定义
     if (scope_.findSymbolInCurrentScope(func->getName())) {
@@ -97,9 +79,8 @@ void Sema::analyzeFunction(FunctionDeclNode* func) {
 
     // 添加参数到作用域
     for (const auto& param : func->getParams()) {
-        auto param_type = stringToType(param.type);
-        if (!scope_.addSymbol(param.name, param_type)) {
-            error("参数名重复: " + param.name);
+        if (!scope_.addSymbol(param.name.str(), param.type)) {
+            error("参数名重复: " + param.name.str());
         }
     }
 
@@ -112,38 +93,49 @@ void Sema::analyzeFunction(FunctionDeclNode* func) {
 }
 
 void Sema::analyzeStatement(StmtNode* stmt) {
-    if (auto* compound = dynamic_cast<CompoundStmtNode*>(stmt)) {
-        scope_.enterScope();
-        analyzeCompoundStatement(compound);
-        scope_.exitScope();
-    } else if (auto* var_decl = dynamic_cast<VarDeclStmtNode*>(stmt)) {
-        analyzeVarDecl(var_decl);
-    } else if (auto* ret_stmt = dynamic_cast<ReturnStmtNode*>(stmt)) {
-        analyzeReturnStatement(ret_stmt);
-    } else if (auto* if_stmt = dynamic_cast<IfStmtNode*>(stmt)) {
-        analyzeIfStatement(if_stmt);
-    } else if (auto* while_stmt = dynamic_cast<WhileStmtNode*>(stmt)) {
-        analyzeWhileStatement(while_stmt);
-    } else if (auto* for_stmt = dynamic_cast<ForStmtNode*>(stmt)) {
-        analyzeForStatement(for_stmt);
-    } else if (auto* do_while = dynamic_cast<DoWhileStmtNode*>(stmt)) {
-        analyzeDoWhileStatement(do_while);
-    } else if (auto* expr_stmt = dynamic_cast<ExprStmtNode*>(stmt)) {
-        analyzeExprStatement(expr_stmt);
-    }
-    // EmptyStmtNode, BreakStmtNode, ContinueStmtNode 不需要语义检查
+    switch (stmt->getKind()) {
+        case NodeKind::Compound:
+            scope_.enterScope();
+            analyzeCompoundStatement(static_cast<CompoundStmtNode*>(stmt));
+            scope_.exitScope();
+            break;
+        case NodeKind::VarDecl:
+            analyzeVarDecl(static_cast<VarDeclStmtNode*>(stmt));
+            break;
+        case NodeKind::Return:
+            analyzeReturnStatement(static_cast<ReturnStmtNode*>(stmt));
+            break;
+        case NodeKind::If:
+            analyzeIfStatement(static_cast<IfStmtNode*>(stmt));
+            break;
+        case NodeKind::While:
+            analyzeWhileStatement(static_cast<WhileStmtNode*>(stmt));
+            break;
+        case NodeKind::For:
+            analyzeForStatement(static_cast<ForStmtNode*>(stmt));
+            break;
+        case NodeKind::DoWhile:
+            analyzeDoWhileStatement(static_cast<DoWhileStmtNode*>(stmt));
+            break;
+        case NodeKind::ExprStmt:
+            analyzeExprStatement(static_cast<ExprStmtNode*>(stmt));
+            break;
+        default:
+            // EmptyStmtNode, BreakStmtNode, ContinueStmtNode 不需要语义检查
+            break;
+    }
 }
 
 void Sema::analyzeCompoundStatement(CompoundStmtNode* stmt) {
     for (const auto& s : stmt->getStatements()) {
-        analyzeStatement(s.get());
+        analyzeStatement(s);
     }
 }
 
 void Sema::analyzeVarDecl(VarDeclStmtNode* stmt) {
-    auto base_type = stringToType(stmt->getType());
-    if (!base_type) {
-        error("未知的变量类型: " + stmt->getType());
+    const Type* base_type = stmt->getType();
+    if (!isDefinedType(base_type)) {
+        error("未知的变量类型: " + base_type->toString());
         return;
     }
 
@@ -159,7 +151,7 @@ void Sema::analyzeVarDecl(VarDeclStmtNode* stmt) {
     }
 
     // 确定实际类型（普通变量或多维数组）
-    std::shared_ptr<Type> var_type = base_type;
+    const Type* var_type = base_type;
     const auto& dims = stmt->getArrayDims();
     if (!dims.empty()) {
         // 从最内层开始构建数组类型：int arr[3][4] -> ArrayType(ArrayType(int, 4), 3)
@@ -168,7 +160,7 @@ void Sema::analyzeVarDecl(VarDeclStmtNode* stmt) {
                 error("数组大小必须为正整数: " + stmt->getName());
                 return;
             }
-            var_type = std::make_shared<ArrayType>(var_type, *it);
+            var_type = types_->getArrayType(var_type, *it);
         }
     }
 
@@ -183,11 +175,11 @@ void Sema::analyzeVarDecl(VarDeclStmtNode* stmt) {
         auto* initializer = stmt->getInitializer();
 
         // 检查是否是初始化列表
-        if (auto* init_list = dynamic_cast<InitializerListNode*>(initializer)) {
+        if (auto* init_list = nodeCast<InitializerListNode>(initializer)) {
             // 初始化列表：可以用于数组、结构体或标量类型
-            if (auto* array_type = dynamic_cast<ArrayType*>(var_type.get())) {
+            if (auto* array_type = dynamic_cast<const ArrayType*>(var_type)) {
                 checkArrayInitializer(init_list, array_type, false);  // false = 局部变量
-            } else if (auto* struct_type = dynamic_cast<StructType*>(var_type.get())) {
+            } else if (auto* struct_type = dynamic_cast<const StructType*>(var_type)) {
                 checkStructInitializer(init_list, struct_type, false);
             } else {
                 // 标量类型：只能有一个元素
@@ -196,7 +188,7 @@ void Sema::analyzeVarDecl(VarDeclStmtNode* stmt) {
                     return;
                 }
                 // 检查元素类型
-                auto elem_type = analyzeExpression(init_list->getElements()[0].get());
+                auto elem_type = analyzeExpression(init_list->getElements()[0]);
                 if (elem_type->isVoid()) {
                     error("void 类型的值不能用于初始化变量");
                     return;
@@ -249,8 +241,8 @@ void Sema::analyzeIfStatement(IfStmtNode* stmt) {
     analyzeStatement(stmt->getThenStmt());
 
     for (const auto& else_if : stmt->getElseIfs()) {
-        analyzeExpression(else_if->condition.get());
-        analyzeStatement(else_if->statement.get());
+        analyzeExpression(else_if.condition);
+        analyzeStatement(else_if.statement);
     }
 
     if (stmt->hasElseStmt()) {
@@ -289,32 +281,39 @@ void Sema::analyzeExprStatement(ExprStmtNode* stmt) {
     analyzeExpression(stmt->getExpression());
 }
 
-std::shared_ptr<Type> Sema::analyzeExpression(ExprNode* expr) {
-    std::shared_ptr<Type> type;
-
-    if (auto* num = dynamic_cast<NumberNode*>(expr)) {
-        type = Type::getIntType();
-    } else if (auto* var = dynamic_cast<VariableNode*>(expr)) {
-        type = analyzeVariable(var);
-    } else if (auto* binary = dynamic_cast<BinaryOpNode*>(expr)) {
-        type = analyzeBinaryOp(binary);
-    } else if (auto* unary = dynamic_cast<UnaryOpNode*>(expr)) {
-        type = analyzeUnaryOp(unary);
-    } else if (auto* call = dynamic_cast<FunctionCallNode*>(expr)) {
-        type = analyzeFunctionCall(call);
-    } else if (auto* arr = dynamic_cast<ArrayAccessNode*>(expr)) {
-        type = analyzeArrayAccess(arr);
-    } else if (auto* member = dynamic_cast<MemberAccessNode*>(expr)) {
-        type = analyzeMemberAccess(member);
-    } else {
-        type = Type::getIntType();
+const Type* Sema::analyzeExpression(ExprNode* expr) {
+    const Type* type;
+
+    switch (expr->getKind()) {
+        case NodeKind::Variable:
+            type = analyzeVariable(static_cast<VariableNode*>(expr));
+            break;
+        case NodeKind::BinaryOp:
+            type = analyzeBinaryOp(static_cast<BinaryOpNode*>(expr));
+            break;
+        case NodeKind::UnaryOp:
+            type = analyzeUnaryOp(static_cast<UnaryOpNode*>(expr));
+            break;
+        case NodeKind::FunctionCall:
+            type = analyzeFunctionCall(static_cast<FunctionCallNode*>(expr));
+            break;
+        case NodeKind::ArrayAccess:
+            type = analyzeArrayAccess(static_cast<ArrayAccessNode*>(expr));
+            break;
+        case NodeKind::MemberAccess:
+            type = analyzeMemberAccess(static_cast<MemberAccessNode*>(expr));
+            break;
+        default:
+            // NumberNode 以及其他情况
+            type = Type::getIntType();
+            break;
     }
 
     expr->setResolvedType(type);
     return type;
 }
 
-std::shared_ptr<Type> Sema::analyzeVariable(VariableNode* expr) {
+const Type* Sema::analyzeVariable(VariableNode* expr) {
     // 先在局部作用域中查找
     auto symbol = scope_.findSymbol(expr->getName());
     if (symbol) {
@@ -335,17 +334,17 @@ std::shared_ptr<Type> Sema::analyzeVariable(VariableNode* expr) {
     return Type::getIntType();
 }
 
-std::shared_ptr<Type> Sema::analyzeBinaryOp(BinaryOpNode* expr) {
+const Type* Sema::analyzeBinaryOp(BinaryOpNode* expr) {
     auto left_type = analyzeExpression(expr->getLeft());
     auto right_type = analyzeExpression(expr->getRight());
 
     // 赋值运算符：左边必须是变量、数组元素、成员访问或解引用表达式
     if (expr->getOperator() == TokenType::Assign) {
-        bool is_lvalue = dynamic_cast<VariableNode*>(expr->getLeft()) ||
-                         dynamic_cast<ArrayAccessNode*>(expr->getLeft()) ||
-                         dynamic_cast<MemberAccessNode*>(expr->getLeft());
+        bool is_lvalue = nodeCast<VariableNode>(expr->getLeft()) ||
+                         nodeCast<ArrayAccessNode>(expr->getLeft()) ||
+                         nodeCast<MemberAccessNode>(expr->getLeft());
         // 检查是否是解引用表达式 *p
-        if (auto* unary = dynamic_cast<UnaryOpNode*>(expr->getLeft())) {
+        if (auto* unary = nodeCast<UnaryOpNode>(expr->getLeft())) {
             if (unary->getOperator() == TokenType::Multiply) {
                 is_lvalue = true;
             }
@@ -379,7 +378,7 @@ std::shared_ptr<Type> Sema::analyzeBinaryOp(BinaryOpNode* expr) {
     return Type::getIntType();
 }
 
-std::shared_ptr<Type> Sema::analyzeUnaryOp(UnaryOpNode* expr) {
+const Type* Sema::analyzeUnaryOp(UnaryOpNode* expr) {
     auto operand_type = analyzeExpression(expr->getOperand());
 
     // void 类型不能用于任何一元运算
@@ -390,12 +389,12 @@ std::shared_ptr<Type> Sema::analyzeUnaryOp(UnaryOpNode* expr) {
     // 取地址运算符 &
     if (expr->getOperator() == TokenType::Ampersand) {
         // 操作数必须是左值（变量或数组元素）
-        if (!dynamic_cast<VariableNode*>(expr->getOperand()) &&
-            !dynamic_cast<ArrayAccessNode*>(expr->getOperand())) {
+        if (!nodeCast<VariableNode>(expr->getOperand()) &&
+            !nodeCast<ArrayAccessNode>(expr->getOperand())) {
             error("取地址运算符 & 的操作数必须是左值");
         }
         // 返回指针类型
-        return std::make_shared<PointerType>(operand_type);
+        return types_->getPointerType(operand_type);
     }
 
     // 解引用运算符 *
@@ -406,8 +405,7 @@ std::shared_ptr<Type> Sema::analyzeUnaryOp(UnaryOpNode* expr) {
             return Type::getIntType();
         }
         // 返回指针指向的类型
-        auto ptr_type = std::dynamic_pointer_cast<PointerType>(operand_type);
-        return ptr_type->getBaseType();
+        return static_cast<const PointerType*>(operand_type)->getBaseType();
     }
 
     // 一元 + 和 - 运算符：操作数必须是整数类型
@@ -421,7 +419,7 @@ std::shared_ptr<Type> Sema::analyzeUnaryOp(UnaryOpNode* expr) {
     return Type::getIntType();
 }
 
-std::shared_ptr<Type> Sema::analyzeFunctionCall(FunctionCallNode* expr) {
+const Type* Sema::analyzeFunctionCall(FunctionCallNode* expr) {
     auto symbol = scope_.findSymbol(expr->getName());
     if (!symbol) {
         error("未声明的函数: " + expr->getName());
@@ -433,7 +431,7 @@ std::shared_ptr<Type> Sema::analyzeFunctionCall(FunctionCallNode* expr) {
         return Type::getIntType();
     }
 
-    auto func_type = std::dynamic_pointer_cast<FunctionType>(symbol->getType());
+    auto func_type = dynamic_cast<const FunctionType*>(symbol->getType());
     if (!func_type) {
         return Type::getIntType();
     }
@@ -447,8 +445,8 @@ std::shared_ptr<Type> Sema::analyzeFunctionCall(FunctionCallNode* expr) {
 
     // 分析每个参数并检查类型兼容性
     for (size_t i = 0; i < expr->getArgs().size() && i < func_type->getParams().size(); ++i) {
-        auto arg_type = analyzeExpression(expr->getArgs()[i].get());
-        auto param_type = func_type->getParams()[i].type;
+        auto arg_type = analyzeExpression(expr->getArgs()[i]);
+        const Type* param_type = func_type->getParams()[i];
 
         // 检查参数类型是否兼容
         if (!isTypeCompatible(param_type, arg_type)) {
@@ -461,7 +459,7 @@ std::shared_ptr<Type> Sema::analyzeFunctionCall(FunctionCallNode* expr) {
     return func_type->getReturnType();
 }
 
-std::shared_ptr<Type> Sema::analyzeArrayAccess(ArrayAccessNode* expr) {
+const Type* Sema::analyzeArrayAccess(ArrayAccessNode* expr) {
     // 分析数组表达式（可能是变量或另一个数组访问）
     auto array_type = analyzeExpression(expr->getArray());
 
@@ -470,11 +468,9 @@ std::shared_ptr<Type> Sema::analyzeArrayAccess(ArrayAccessNode* expr) {
 
     // 检查是否可以进行下标访问
     if (array_type->isArray()) {
-        auto arr_type = std::dynamic_pointer_cast<ArrayType>(array_type);
-        return arr_type->getElementType();
+        return static_cast<const ArrayType*>(array_type)->getElementType();
     } else if (array_type->isPointer()) {
-        auto ptr_type = std::dynamic_pointer_cast<PointerType>(array_type);
-        return ptr_type->getBaseType();
+        return static_cast<const PointerType*>(array_type)->getBaseType();
     } else {
         error("下标运算符只能用于数组或指针类型");
         return Type::getIntType();
@@ -489,43 +485,31 @@ void Sema::analyzeStructDecl(StructDeclNode* struct_decl) {
         return;
     }
 
-    // 创建结构体类型
-    auto struct_type = std::make_shared<StructType>(struct_decl->getName());
+    // 结构体类型对象在 Parser 第一次遇到这个名字时已经创建，这里填入成员
+    StructType* struct_type = types_->getStructType(struct_decl->getName());
 
     // 分析每个成员
     for (const auto& member : struct_decl->getMembers()) {
-        // 解析成员类型
-        std::shared_ptr<Type> member_type;
-
-        if (member.isArray()) {
-            // 数组成员：从最内层开始构建类型
-            member_type = stringToType(member.type);
-            if (!member_type) {
-                error("未知的成员类型: " + member.type);
-                continue;
-            }
+        // 成员类型中的结构体必须在这之前定义（包括结构体自身）
+        const Type* member_type = member.type;
+        if (!isDefinedType(member_type)) {
+            error("未知的成员类型: " + member_type->toString());
+            continue;
+        }
 
-            // 从右到左构建多维数组类型
-            for (auto it = member.array_dims.rbegin(); it != member.array_dims.rend(); ++it) {
-                member_type = std::make_shared<ArrayType>(member_type, *it);
-            }
-        } else {
-            // 普通成员
-            member_type = stringToType(member.type);
-            if (!member_type) {
-                error("未知的成员类型: " + member.type);
-                continue;
-            }
+        // 数组成员：从右到左构建多维数组类型
+        for (auto it = member.array_dims.rbegin(); it != member.array_dims.rend(); ++it) {
+            member_type = types_->getArrayType(member_type, *it);
         }
 
         // 检查成员类型是否为void
         if (member_type->isVoid()) {
-            error("结构体成员不能是void类型: " + member.name);
+            error("结构体成员不能是void类型: " + member.name.str());
             continue;
         }
 
         // 添加成员到结构体类型
-        struct_type->addMember(member.name, member_type);
+        struct_type->addMember(member.name.str(), member_type);
     }
 
     // 注册结构体类型
@@ -533,7 +517,7 @@ void Sema::analyzeStructDecl(StructDeclNode* struct_decl) {
 }
 
 // 分析成员访问表达式
-std::shared_ptr<Type> Sema::analyzeMemberAccess(MemberAccessNode* expr) {
+const Type* Sema::analyzeMemberAccess(MemberAccessNode* expr) {
     // 分析对象表达式
     auto object_type = analyzeExpression(expr->getObject());
 
@@ -544,67 +528,39 @@ std::shared_ptr<Type> Sema::analyzeMemberAccess(MemberAccessNode* expr) {
     }
 
     // 获取结构体类型
-    auto struct_type = std::dynamic_pointer_cast<StructType>(object_type);
+    auto struct_type = static_cast<const StructType*>(object_type);
 
-    // 查找成员类型
-    auto member_type = struct_type->getMemberType(expr->getMember());
-    if (!member_type) {
+    // 查找成员，记录下标供 CodeGen 直接取偏移量
+    int member_index = struct_type->findMember(expr->getMember());
+    if (member_index < 0) {
         error("结构体 " + struct_type->getName() + " 没有成员: " + expr->getMember());
         return Type::getIntType();
     }
+    expr->setMemberIndex(member_index);
 
-    return member_type;
+    return struct_type->getMemberType(member_index);
 }
 
 // 检查两个类型是否兼容（用于赋值）
-bool Sema::isTypeCompatible(const std::shared_ptr<Type>& left, const std::shared_ptr<Type>& right) {
-    // 如果类型完全相同
+// 类型都是驻留的，相同的类型就是同一个对象；只有数组不要求大小相同，需要比较元素类型
+bool Sema::isTypeCompatible(const Type* left, const Type* right) {
     if (left == right) {
         return true;
     }
 
-    // int 类型兼容
-    if (left->isInt() && right->isInt()) {
-        return true;
-    }
-
-    // 指针类型检查
+    // 指针：指向的类型兼容即可
     if (left->isPointer() && right->isPointer()) {
-        auto left_ptr = std::dynamic_pointer_cast<PointerType>(left);
-        auto right_ptr = std::dynamic_pointer_cast<PointerType>(right);
-
-        auto left_base = left_ptr->getBaseType();
-        auto right_base = right_ptr->getBaseType();
-
-        // 递归检查基类型
-        if (left_base->isStruct() && right_base->isStruct()) {
-            auto left_struct = std::dynamic_pointer_cast<StructType>(left_base);
-            auto right_struct = std::dynamic_pointer_cast<StructType>(right_base);
-            // 结构体指针必须指向相同的结构体类型
-            return left_struct->getName() == right_struct->getName();
-        }
-
-        // 其他指针类型递归检查
-        return isTypeCompatible(left_base, right_base);
+        return isTypeCompatible(static_cast<const PointerType*>(left)->getBaseType(),
+                                static_cast<const PointerType*>(right)->getBaseType());
     }
 
-    // 数组类型检查
+    // 数组：元素类型兼容即可
     if (left->isArray() && right->isArray()) {
-        auto left_arr = std::dynamic_pointer_cast<ArrayType>(left);
-        auto right_arr = std::dynamic_pointer_cast<ArrayType>(right);
-        // 数组元素类型必须兼容
-        return isTypeCompatible(left_arr->getElementType(), right_arr->getElementType());
-    }
-
-    // 结构体类型检查
-    if (left->isStruct() && right->isStruct()) {
-        auto left_struct = std::dynamic_pointer_cast<StructType>(left);
-        auto right_struct = std::dynamic_pointer_cast<StructType>(right);
-        // 结构体必须是相同的类型
-        return left_struct->getName() == right_struct->getName();
+        return isTypeCompatible(static_cast<const ArrayType*>(left)->getElementType(),
+                                static_cast<const ArrayType*>(right)->getElementType());
     }
 
-    // 其他情况不兼容
+    // 其他情况（int、void、结构体、函数）只有同一个类型才兼容
     return false;
 }
 
@@ -617,14 +573,12 @@ void Sema::analyzeGlobalVarDecl(VarDeclStmtNode* global_var) {
     }
 
     // 解析变量类型
-    std::shared_ptr<Type> var_type;
+    const Type* var_type = global_var->getType();
+    if (!isDefinedType(var_type)) {
+        error((global_var->isArray() ? "未知的数组元素类型: " : "未知的变量类型: ") + var_type->toString());
+        return;
+    }
     if (global_var->isArray()) {
-        // 数组类型
-        auto element_type = stringToType(global_var->getType());
-        if (!element_type) {
-            error("未知的数组元素类型: " + global_var->getType());
-            return;
-        }
 
         // 计算数组总大小
         int total_size = 1;
@@ -632,14 +586,7 @@ void Sema::analyzeGlobalVarDecl(VarDeclStmtNode* global_var) {
             total_size *= dim;
         }
 
-        var_type = std::make_shared<ArrayType>(element_type, total_size);
-    } else {
-        // 普通类型
-        var_type = stringToType(global_var->getType());
-        if (!var_type) {
-            error("未知的变量类型: " + global_var->getType());
-            return;
-        }
+        var_type = types_->getArrayType(var_type, total_size);
     }
 
     // 设置类型到AST
@@ -653,11 +600,11 @@ void Sema::analyzeGlobalVarDecl(VarDeclStmtNode* global_var) {
         auto* initializer = global_var->getInitializer();
 
         // 检查是否是初始化列表
-        if (auto* init_list = dynamic_cast<InitializerListNode*>(initializer)) {
+        if (auto* init_list = nodeCast<InitializerListNode>(initializer)) {
             // 初始化列表：可以用于数组、结构体或标量类型
-            if (auto* array_type = dynamic_cast<ArrayType*>(var_type.get())) {
+            if (auto* array_type = dynamic_cast<const ArrayType*>(var_type)) {
                 checkArrayInitializer(init_list, array_type, true);
-            } else if (auto* struct_type = dynamic_cast<StructType*>(var_type.get())) {
+            } else if (auto* struct_type = dynamic_cast<const StructType*>(var_type)) {
                 checkStructInitializer(init_list, struct_type, true);
             } else {
                 // 标量类型：只能有一个元素
@@ -666,14 +613,14 @@ void Sema::analyzeGlobalVarDecl(VarDeclStmtNode* global_var) {
                     return;
                 }
                 // 检查元素类型
-                auto elem_type = analyzeExpression(init_list->getElements()[0].get());
+                auto elem_type = analyzeExpression(init_list->getElements()[0]);
                 if (!isTypeCompatible(var_type, elem_type)) {
                     error("初始化类型不匹配: 不能将 " + elem_type->toString() +
                           " 类型赋值给 " + var_type->toString() + " 类型");
                     return;
                 }
                 // 检查是否是常量表达式
-                if (!isConstantExpression(init_list->getElements()[0].get())) {
+                if (!isConstantExpression(init_list->getElements()[0])) {
                     error("全局变量 '" + global_var->getName() + "' 的初始化器必须是编译时常量表达式");
                     return;
                 }
@@ -708,18 +655,18 @@ bool Sema::isConstantExpression(ExprNode* expr) {
     if (!expr) return false;
 
     // 1. 数字字面量是常量
-    if (dynamic_cast<NumberNode*>(expr)) {
+    if (nodeCast<NumberNode>(expr)) {
         return true;
     }
 
     // 2. 二元运算：两个操作数都是常量
-    if (auto* binop = dynamic_cast<BinaryOpNode*>(expr)) {
+    if (auto* binop = nodeCast<BinaryOpNode>(expr)) {
         return isConstantExpression(binop->getLeft()) &&
                isConstantExpression(binop->getRight());
     }
 
     // 3. 一元运算
-    if (auto* unary = dynamic_cast<UnaryOpNode*>(expr)) {
+    if (auto* unary = nodeCast<UnaryOpNode>(expr)) {
         switch (unary->getOperator()) {
             case TokenType::Minus:      // 负数: -expr
             case TokenType::LogicalNot: // 逻辑非: !expr
@@ -728,7 +675,7 @@ bool Sema::isConstantExpression(ExprNode* expr) {
             case TokenType::Ampersand: {
                 // 取地址: &global_var
                 // 只允许取全局变量的地址
-                auto* var = dynamic_cast<VariableNode*>(unary->getOperand());
+                auto* var = nodeCast<VariableNode>(unary->getOperand());
                 if (!var) {
                     return false;  // 只能取变量的地址
                 }
@@ -742,7 +689,7 @@ bool Sema::isConstantExpression(ExprNode* expr) {
     }
 
     // 4. 变量引用：不是常量（即使是全局变量）
-    if (dynamic_cast<VariableNode*>(expr)) {
+    if (nodeCast<VariableNode>(expr)) {
         return false;
     }
 
@@ -752,7 +699,7 @@ bool Sema::isConstantExpression(ExprNode* expr) {
 
 // ========== 初始化列表检查 (Phase 7) ==========
 
-void Sema::checkArrayInitializer(InitializerListNode* init_list, ArrayType* array_type, bool is_global) {
+void Sema::checkArrayInitializer(InitializerListNode* init_list, const ArrayType* array_type, bool is_global) {
     const auto& elements = init_list->getElements();
 
     // 1. 检查数量：初始化列表元素不能超过数组大小
@@ -767,19 +714,19 @@ void Sema::checkArrayInitializer(InitializerListNode* init_list, ArrayType* arra
         auto& elem = elements[i];
 
         // Phase 1: 不支持嵌套初始化列表
-        if (dynamic_cast<InitializerListNode*>(elem.get())) {
+        if (nodeCast<InitializerListNode>(elem)) {
             error("暂不支持嵌套初始化列表");
             return;
         }
 
         // 全局变量：必须是常量表达式
-        if (is_global && !isConstantExpression(elem.get())) {
+        if (is_global && !isConstantExpression(elem)) {
             error("全局数组初始化列表的第 " + std::to_string(i + 1) + " 个元素必须是编译时常量表达式");
             return;
         }
 
         // 类型检查：元素类型必须与数组元素类型兼容
-        auto elem_type = analyzeExpression(elem.get());
+        auto elem_type = analyzeExpression(elem);
         if (!isTypeCompatible(array_type->getElementType(), elem_type)) {
             error("数组初始化列表的第 " + std::to_string(i + 1) + " 个元素类型不匹配：期望 " +
                   array_type->getElementType()->toString() + "，实际 " + elem_type->toString());
@@ -788,7 +735,7 @@ void Sema::checkArrayInitializer(InitializerListNode* init_list, ArrayType* arra
     }
 }
 
-void Sema::checkStructInitializer(InitializerListNode* init_list, StructType* struct_type, bool is_global) {
+void Sema::checkStructInitializer(InitializerListNode* init_list, const StructType* struct_type, bool is_global) {
     const auto& elements = init_list->getElements();
     const auto& members = struct_type->getMembers();
 
@@ -804,19 +751,19 @@ void Sema::checkStructInitializer(InitializerListNode* init_list, StructType* st
         auto& elem = elements[i];
 
         // Phase 1: 不支持嵌套初始化列表
-        if (dynamic_cast<InitializerListNode*>(elem.get())) {
+        if (nodeCast<InitializerListNode>(elem)) {
             error("暂不支持嵌套初始化列表");
             return;
         }
 
         // 全局变量：必须是常量表达式
-        if (is_global && !isConstantExpression(elem.get())) {
+        if (is_global && !isConstantExpression(elem)) {
             error("全局结构体初始化列表的第 " + std::to_string(i + 1) + " 个元素必须是编译时常量表达式");
             return;
         }
 
         // 类型检查：元素类型必须与对应成员类型兼容
-        auto elem_type = analyzeExpression(elem.get());
+        auto elem_type = analyzeExpression(elem);
         const auto& [member_name, member_type] = members[i];
         if (!isTypeCompatible(member_type, elem_type)) {
             error("结构体初始化列表的第 " + std::to_string(i + 1) + " 个元素类型不匹配：期望 " +
@@ -0,0 +1,46 @@
+#include "../include/source.h"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+SourceFile::SourceFile(const std::string& filename) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("无法打开文件: " + filename);
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        void* addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED) {
+            // Lexer 从头到尾顺序扫描一遍
+            madvise(addr, st.st_size, MADV_SEQUENTIAL);
+            data_ = static_cast<const char*>(addr);
+            size_ = st.st_size;
+            mapped_ = true;
+        }
+    }
+    close(fd);
+    if (mapped_) return;
+
+    // 退回到读入内存
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("无法打开文件: " + filename);
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    buffer_ = buffer.str();
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+}
+
+SourceFile::~SourceFile() {
+    if (mapped_) {
+        munmap(const_cast<char*>(data_), size_);
+    }
+}
@@ -0,0 +1,135 @@
+#include "../include/superinstr.h"
+#include <climits>
+
+bool SuperinstructionFusion::isStraightLine(int start, int len) const {
+    for (int k = start + 1; k < start + len; ++k) {
+        if (is_label_[k]) return false;
+    }
+    return true;
+}
+
+// LOAD x; PUSH c; ADD; STORE x  ->  INCLOCAL x, c
+// LOAD x; PUSH c; SUB; STORE x  ->  INCLOCAL x, -c（原序列改写为等价的 PUSH -c; ADD）
+bool SuperinstructionFusion::matchIncLocal(InstructionBuffer& code, int i) {
+    if (code[i].op != OpCode::LOAD || code[i + 1].op != OpCode::PUSH ||
+        (code[i + 2].op != OpCode::ADD && code[i + 2].op != OpCode::SUB) ||
+        code[i + 3].op != OpCode::STORE || code[i + 3].operand != code[i].operand) {
+        return false;
+    }
+    if (code[i + 2].op == OpCode::SUB) {
+        if (code[i + 1].operand == INT32_MIN) return false;
+        code[i + 1].operand = -code[i + 1].operand;
+        code[i + 2].op = OpCode::ADD;
+    }
+    code[i].op = OpCode::INCLOCAL;
+    return true;
+}
+
+// LOAD a; LOAD b; LT; JZ t  ->  JLT_LOCALS a, b -> t
+// LOAD a; PUSH c; LT; JZ t  ->  JLT_LOCAL_CONST a, c -> t
+// LOAD a; PUSH c; LE; JZ t  ->  JLE_LOCAL_CONST a, c -> t
+bool SuperinstructionFusion::matchCompareJump(InstructionBuffer& code, int i, FusionStats& stats) {
+    if (code[i].op != OpCode::LOAD || code[i + 3].op != OpCode::JZ) {
+        return false;
+    }
+    OpCode second = code[i + 1].op;
+    OpCode cmp = code[i + 2].op;
+
+    if (second == OpCode::LOAD && cmp == OpCode::LT) {
+        code[i].op = OpCode::JLT_LOCALS;
+        stats.jlt_locals++;
+        return true;
+    }
+    if (second == OpCode::PUSH && cmp == OpCode::LT) {
+        code[i].op = OpCode::JLT_LOCAL_CONST;
+        stats.jlt_local_const++;
+        return true;
+    }
+    if (second == OpCode::PUSH && cmp == OpCode::LE) {
+        code[i].op = OpCode::JLE_LOCAL_CONST;
+        stats.jle_local_const++;
+        return true;
+    }
+    return false;
+}
+
+// LEA k; ADDPTRD s; LOADM  ->  LOADIDX k, s
+bool SuperinstructionFusion::matchLoadIdx(InstructionBuffer& code, int i) {
+    if (code[i].op != OpCode::LEA || code[i + 1].op != OpCode::ADDPTRD ||
+        code[i + 2].op != OpCode::LOADM) {
+        return false;
+    }
+    code[i].op = OpCode::LOADIDX;
+    return true;
+}
+
+FusionStats SuperinstructionFusion::run(ByteCode& bytecode) {
+    auto& code = bytecode.code;
+    int n = code.size();
+    FusionStats stats;
+
+    // 跳转目标和函数入口
+    is_label_.assign(n + 1, false);
+    for (const auto& instr : code) {
+        // 融合后的比较跳转，目标仍在保留下来的 JZ 上
+        if ((instr.op == OpCode::JMP || instr.op == OpCode::JZ ||
+             instr.op == OpCode::JNZ || instr.op == OpCode::CALL) &&
+            instr.operand >= 0 && instr.operand <= n) {
+            is_label_[instr.operand] = true;
+        }
+    }
+    for (const auto& [name, entry] : bytecode.functions) {
+        if (entry >= 0 && entry <= n) is_label_[entry] = true;
+    }
+
+    for (int i = 0; i < n; ) {
+        // 已经融合过的指令（重复运行本 pass）整体跳过
+        if (instructionLength(code[i].op) > 1) {
+            i += instructionLength(code[i].op);
+            continue;
+        }
+
+        if (i + 4 <= n && isStraightLine(i, 4)) {
+            if (matchIncLocal(code, i)) {
+                stats.inc_local++;
+                i += 4;
+                continue;
+            }
+            if (matchCompareJump(code, i, stats)) {
+                i += 4;
+                continue;
+            }
+        }
+        if (i + 3 <= n && isStraightLine(i, 3) && matchLoadIdx(code, i)) {
+            stats.load_idx++;
+            i += 3;
+            continue;
+        }
+        ++i;
+    }
+
+    return stats;
+}
+
+bool isWellFormedSuperinstruction(const InstructionBuffer& code, int pc) {
+    int len = instructionLength(code[pc].op);
+    if (pc + len > (int)code.size()) {
+        return false;
+    }
+    const Instruction* in = &code[pc];
+    switch (in->op) {
+        case OpCode::INCLOCAL:
+            return in[1].op == OpCode::PUSH && in[2].op == OpCode::ADD &&
+                   in[3].op == OpCode::STORE && in[3].operand == in->operand;
+        case OpCode::JLT_LOCALS:
+            return in[1].op == OpCode::LOAD && in[2].op == OpCode::LT && in[3].op == OpCode::JZ;
+        case OpCode::JLT_LOCAL_CONST:
+            return in[1].op == OpCode::PUSH && in[2].op == OpCode::LT && in[3].op == OpCode::JZ;
+        case OpCode::JLE_LOCAL_CONST:
+            return in[1].op == OpCode::PUSH && in[2].op == OpCode::LE && in[3].op == OpCode::JZ;
+        case OpCode::LOADIDX:
+            return in[1].op == OpCode::ADDPTRD && in[2].op == OpCode::LOADM;
+        default:
+            return len == 1;
+    }
+}
@@ -1,12 +1,12 @@
 #include "../include/token.h"
 
-Token::Token(TokenType type, const std::string& value, int line, int column)
-    : type_(type), value_(value), line_(line), column_(column) {
+Token::Token(TokenType type, std::string_view value, int line, int column, int32_t number)
+    : type_(type), number_(number), value_(value), line_(line), column_(column) {
 }
 
 std::string Token::toString() const {
     return "Token(" + typeToString(type_) +
-           (value_.empty() ? "" : ", \"" + value_ + "\"") +
+           (value_.empty() ? "" : ", \"" + std::string(value_) + "\"") +
            ", line=" + std::to_string(line_) +
            ", col=" + std::to_string(column_) + ")";
 }
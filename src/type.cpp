@@ -1,13 +1,55 @@
 #include "../include/type.h"
 
 // 单例：int 类型
-std::shared_ptr<Type> Type::getIntType() {
-    static auto int_type = std::make_shared<PrimaryType>(TypeKind::Int);
-    return int_type;
+const Type* Type::getIntType() {
+    static const PrimaryType int_type(TypeKind::Int);
+    return &int_type;
 }
 
 // 单例：void 类型
-std::shared_ptr<Type> Type::getVoidType() {
-    static auto void_type = std::make_shared<PrimaryType>(TypeKind::Void);
-    return void_type;
+const Type* Type::getVoidType() {
+    static const PrimaryType void_type(TypeKind::Void);
+    return &void_type;
+}
+
+const PointerType* TypeContext::getPointerType(const Type* base) {
+    auto it = pointers_.find(base);
+    if (it != pointers_.end()) return it->second;
+    auto* type = new PointerType(base);
+    types_.emplace_back(type);
+    pointers_.emplace(base, type);
+    return type;
+}
+
+const ArrayType* TypeContext::getArrayType(const Type* element, int size) {
+    auto key = std::make_pair(element, size);
+    auto it = arrays_.find(key);
+    if (it != arrays_.end()) return it->second;
+    auto* type = new ArrayType(element, size);
+    types_.emplace_back(type);
+    arrays_.emplace(key, type);
+    return type;
+}
+
+const FunctionType* TypeContext::getFunctionType(const Type* return_type,
+                                                 const std::vector<const Type*>& params) {
+    std::vector<const Type*> key;
+    key.reserve(params.size() + 1);
+    key.push_back(return_type);
+    key.insert(key.end(), params.begin(), params.end());
+    auto it = functions_.find(key);
+    if (it != functions_.end()) return it->second;
+    auto* type = new FunctionType(return_type, params);
+    types_.emplace_back(type);
+    functions_.emplace(std::move(key), type);
+    return type;
+}
+
+StructType* TypeContext::getStructType(const std::string& name) {
+    auto it = structs_.find(name);
+    if (it != structs_.end()) return it->second;
+    auto* type = new StructType(name);
+    types_.emplace_back(type);
+    structs_.emplace(name, type);
+    return type;
 }
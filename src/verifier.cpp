@@ -0,0 +1,226 @@
+#include "../include/verifier.h"
+#include "../include/superinstr.h"
+#include <algorithm>
+
+bool BytecodeVerifier::checkTarget(const ByteCode& bytecode, int pc, int target) {
+    // 目标等于 code.size() 表示跳到末尾（结束执行）
+    if (target < 0 || target > (int)bytecode.code.size()) {
+        error("地址 " + std::to_string(pc) + ": 跳转目标越界 " + std::to_string(target));
+        return false;
+    }
+    return true;
+}
+
+void BytecodeVerifier::verifyFunction(const ByteCode& bytecode, const std::string& name, int entry) {
+    const auto& code = bytecode.code;
+    const int n = code.size();
+    if (entry < 0 || entry >= n) {
+        error("函数 " + name + ": 入口地址越界 " + std::to_string(entry));
+        return;
+    }
+
+    auto args = arg_slots_.find(entry);
+    if (args == arg_slots_.end()) {
+        error("函数 " + name + ": 缺少参数和返回值的 slot 数");
+        return;
+    }
+    // 负偏移只能落在调用者压入的参数和返回值上，-1/-2 是 [old_fp][ret_addr]
+    const int64_t lowest = -2 - static_cast<int64_t>(args->second);
+
+    std::vector<int>& depth = function_depth_;
+    std::vector<int> visited;
+    int max_depth = 0;
+    std::vector<std::pair<int, int>> worklist = {{entry, 0}};
+
+    while (!worklist.empty()) {
+        const int pc = worklist.back().first;
+        const int d = worklist.back().second;
+        worklist.pop_back();
+        if (pc >= n) continue;  // 执行到代码末尾即结束
+
+        // 错误信息的前缀只在出错时拼接，通过校验的程序每条指令不分配字符串
+        auto where = [&] { return "函数 " + name + " 地址 " + std::to_string(pc) + ": "; };
+        // 按帧偏移访问：非负偏移必须小于 limit（已经分配的局部变量）
+        auto checkSlot = [&](OpCode op, int32_t k, int limit) {
+            if (k >= 0 ? k >= limit : (k > -3 || k < lowest)) {
+                error(where() + opcodeName(op) + (k >= 0 ? " 访问未分配的局部变量 " : " 访问参数和返回值以外的偏移 ") +
+                      std::to_string(k));
+            }
+        };
+        if (inside_fused_[pc]) {
+            error(where() + "跳转到超级指令中间");
+            continue;
+        }
+        if (depth[pc] >= 0) {
+            if (depth[pc] != d) {
+                error(where() + "栈深度不一致 (" + std::to_string(depth[pc]) + " / " + std::to_string(d) + ")");
+            }
+            continue;
+        }
+        depth[pc] = d;
+        visited.push_back(pc);
+
+        const Instruction& instr = code[pc];
+        int len = instructionLength(instr.op);
+        if (len > 1 && !isWellFormedSuperinstruction(code, pc)) {
+            error(where() + opcodeName(instr.op) + " 的操作数序列不完整");
+            continue;
+        }
+
+        if ((instr.op == OpCode::LOADMN || instr.op == OpCode::STOREMN || instr.op == OpCode::RETN) &&
+            (instr.operand < 0 || instr.operand > VM::MAX_STACK_SIZE)) {
+            error(where() + opcodeName(instr.op) + " 的 slot 数无效 " + std::to_string(instr.operand));
+            continue;
+        }
+        StackEffect effect = stackEffect(instr);
+        if (effect.pops < 0 || d < effect.pops) {
+            error(where() + opcodeName(instr.op) + " 栈下溢");
+            continue;
+        }
+        if (static_cast<int64_t>(d) - effect.pops + effect.pushes > VM::MAX_STACK_SIZE) {
+            error(where() + "栈深度超过上限");
+            continue;
+        }
+        int next = d - effect.pops + effect.pushes;
+        max_depth = std::max(max_depth, next);
+
+        switch (instr.op) {
+            case OpCode::LOAD:
+            case OpCode::LEA:
+            case OpCode::INCLOCAL:
+            case OpCode::JLT_LOCAL_CONST:
+            case OpCode::JLE_LOCAL_CONST:
+                checkSlot(instr.op, instr.operand, d);
+                break;
+            case OpCode::STORE:
+                checkSlot(instr.op, instr.operand, d - 1);
+                break;
+            case OpCode::JLT_LOCALS:
+                checkSlot(instr.op, instr.operand, d);
+                checkSlot(instr.op, code[pc + 1].operand, d);
+                break;
+            case OpCode::LOADIDX:
+                // 栈顶是下标，数组在它下面
+                checkSlot(instr.op, instr.operand, d - 1);
+                break;
+            case OpCode::RET:
+                // 返回值 slot 只能是负偏移
+                checkSlot(instr.op, instr.operand, 0);
+                break;
+            case OpCode::LOADG:
+            case OpCode::STOREG:
+                if (instr.operand < 0 || instr.operand >= globals_size_) {
+                    error(where() + opcodeName(instr.op) + " 全局变量偏移越界 " + std::to_string(instr.operand));
+                }
+                break;
+            default:
+                break;
+        }
+
+        // 后继指令
+        switch (instr.op) {
+            case OpCode::JMP:
+                if (checkTarget(bytecode, pc, instr.operand)) {
+                    worklist.push_back({instr.operand, next});
+                }
+                break;
+            case OpCode::JZ:
+            case OpCode::JNZ:
+                if (checkTarget(bytecode, pc, instr.operand)) {
+                    worklist.push_back({instr.operand, next});
+                }
+                worklist.push_back({pc + 1, next});
+                break;
+            case OpCode::JLT_LOCALS:
+            case OpCode::JLT_LOCAL_CONST:
+            case OpCode::JLE_LOCAL_CONST:
+                // 跳转目标在保留下来的 JZ 上
+                if (checkTarget(bytecode, pc, code[pc + 3].operand)) {
+                    worklist.push_back({code[pc + 3].operand, next});
+                }
+                worklist.push_back({pc + len, next});
+                break;
+            case OpCode::CALL: {
+                auto callee = arg_slots_.find(instr.operand);
+                if (callee == arg_slots_.end()) {
+                    error(where() + "CALL 目标不是函数入口 " + std::to_string(instr.operand));
+                } else if (d < callee->second) {
+                    // 被调函数的负偏移会越过本帧，落到调用者的 [old_fp][ret_addr] 上
+                    error(where() + "CALL 之前栈上只有 " + std::to_string(d) + " 个 slot，少于被调函数的参数和返回值 " +
+                          std::to_string(callee->second) + " 个");
+                }
+                worklist.push_back({pc + 1, next});
+                break;
+            }
+            case OpCode::RET:
+            case OpCode::RETN:
+            case OpCode::HALT:
+                break;
+            default:
+                worklist.push_back({pc + len, next});
+                break;
+        }
+    }
+
+    max_depths_[entry] = max_depth;
+    for (int pc : visited) {
+        depth_[pc] = depth[pc];
+        depth[pc] = -1;
+    }
+}
+
+bool BytecodeVerifier::verify(const ByteCode& bytecode) {
+    errors_.clear();
+    max_depths_.clear();
+    verified_ = nullptr;
+
+    const auto& code = bytecode.code;
+    const int n = code.size();
+
+    // 全局数据区大小：与 VM::setup 的分配方式一致
+    globals_size_ = 0;
+    for (const auto& init : bytecode.global_inits) {
+        globals_size_ += init.slot_count;
+    }
+
+    depth_.assign(n, -1);
+    function_depth_.assign(n, -1);
+
+    // 超级指令后面保留的原指令不能作为跳转目标
+    inside_fused_.assign(n, false);
+    for (int pc = 0; pc < n; ) {
+        int len = instructionLength(code[pc].op);
+        for (int k = 1; k < len && pc + k < n; ++k) {
+            inside_fused_[pc + k] = true;
+        }
+        pc += len;
+    }
+
+    bool entry_found = false;
+    std::vector<std::pair<int, std::string>> functions;
+    arg_slots_.clear();
+    for (const auto& [name, entry] : bytecode.functions) {
+        functions.push_back({entry, name});
+        if (entry == bytecode.entry_point) entry_found = true;
+        auto args = bytecode.arg_slots.find(name);
+        if (args != bytecode.arg_slots.end() && args->second >= 1 && args->second <= VM::MAX_STACK_SIZE) {
+            arg_slots_[entry] = args->second;
+        }
+    }
+    if (!entry_found) {
+        error("入口点 " + std::to_string(bytecode.entry_point) + " 不是函数入口");
+    } else if (arg_slots_.count(bytecode.entry_point) && arg_slots_[bytecode.entry_point] > 1) {
+        error("入口函数不能有参数或多个 slot 的返回值");
+    }
+
+    // 按地址顺序校验，错误信息的顺序稳定
+    std::sort(functions.begin(), functions.end());
+    for (const auto& [entry, name] : functions) {
+        verifyFunction(bytecode, name, entry);
+    }
+
+    if (errors_.empty()) {
+        verified_ = &bytecode;
+    }
+    return errors_.empty();
+}
@@ -1,8 +1,18 @@
 #include "../include/vm.h"
+#include "../include/verifier.h"
+#include "../include/jit.h"
+#include <cstring>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
 
+// computed goto（标签地址 &&label）是 GCC/Clang 扩展，其他编译器回退到 switch 分派
+#if defined(__GNUC__) || defined(__clang__)
+#define SIMPLEC_COMPUTED_GOTO 1
+#else
+#define SIMPLEC_COMPUTED_GOTO 0
+#endif
+
 std::string opcodeName(OpCode op) {
     switch (op) {
         case OpCode::PUSH:   return "PUSH";
@@ -37,69 +47,240 @@ std::string opcodeName(OpCode op) {
         case OpCode::JNZ:    return "JNZ";
         case OpCode::CALL:   return "CALL";
         case OpCode::RET:    return "RET";
+        case OpCode::RETN:   return "RETN";
         case OpCode::PRINT:  return "PRINT";
         case OpCode::HALT:   return "HALT";
         case OpCode::ADJSP:  return "ADJSP";
         case OpCode::MEMCPY: return "MEMCPY";
+        case OpCode::LOADMN: return "LOADMN";
+        case OpCode::STOREMN:return "STOREMN";
+        case OpCode::INCLOCAL:        return "INCLOCAL";
+        case OpCode::JLT_LOCALS:      return "JLT_LOCALS";
+        case OpCode::JLT_LOCAL_CONST: return "JLT_LOCAL_CONST";
+        case OpCode::JLE_LOCAL_CONST: return "JLE_LOCAL_CONST";
+        case OpCode::LOADIDX:         return "LOADIDX";
         default:             return "???";
     }
 }
 
+int instructionLength(OpCode op) {
+    switch (op) {
+        case OpCode::INCLOCAL:
+        case OpCode::JLT_LOCALS:
+        case OpCode::JLT_LOCAL_CONST:
+        case OpCode::JLE_LOCAL_CONST:
+            return 4;
+        case OpCode::LOADIDX:
+            return 3;
+        default:
+            return 1;
+    }
+}
+
+OpCode unfusedOpcode(OpCode op) {
+    switch (op) {
+        case OpCode::INCLOCAL:
+        case OpCode::JLT_LOCALS:
+        case OpCode::JLT_LOCAL_CONST:
+        case OpCode::JLE_LOCAL_CONST:
+            return OpCode::LOAD;
+        case OpCode::LOADIDX:
+            return OpCode::LEA;
+        default:
+            return op;
+    }
+}
+
+StackEffect stackEffect(const Instruction& instr) {
+    switch (instr.op) {
+        case OpCode::PUSH: case OpCode::LOAD: case OpCode::LOADG:
+        case OpCode::LEAG: case OpCode::LEA:
+            return {0, 1};
+        case OpCode::POP: case OpCode::STORE: case OpCode::STOREG:
+        case OpCode::JZ: case OpCode::JNZ:
+            return {1, 0};
+        case OpCode::LOADM: case OpCode::ADDPTR: case OpCode::NEG: case OpCode::NOT:
+        case OpCode::PRINT: case OpCode::LOADIDX:
+            return {1, 1};
+        case OpCode::ADDPTRD:
+        case OpCode::ADD: case OpCode::SUB: case OpCode::MUL: case OpCode::DIV: case OpCode::MOD:
+        case OpCode::EQ: case OpCode::NE: case OpCode::LT: case OpCode::LE:
+        case OpCode::GT: case OpCode::GE: case OpCode::AND: case OpCode::OR:
+            return {2, 1};
+        case OpCode::STOREM: case OpCode::MEMCPY: case OpCode::RETN:
+            return {2, 0};
+        case OpCode::LOADMN:
+            return {1, instr.operand};
+        case OpCode::STOREMN:
+            return {instr.operand < 0 || instr.operand == INT32_MAX ? -1 : instr.operand + 1, 0};
+        case OpCode::ADJSP:
+            return {instr.operand, 0};
+        default:
+            // JMP, CALL（返回后参数仍在栈上，由 ADJSP 清理）, RET, HALT, INCLOCAL, 比较跳转超级指令
+            return {0, 0};
+    }
+}
+
+// 单条指令的文本形式（没有操作数的指令不打印操作数）
+std::string formatInstruction(const Instruction& instr) {
+    std::string text = opcodeName(instr.op);
+    if (instr.op == OpCode::PUSH || instr.op == OpCode::LOAD ||
+        instr.op == OpCode::STORE || instr.op == OpCode::LOADG ||
+        instr.op == OpCode::STOREG || instr.op == OpCode::JMP ||
+        instr.op == OpCode::JZ || instr.op == OpCode::JNZ ||
+        instr.op == OpCode::CALL || instr.op == OpCode::LEA ||
+        instr.op == OpCode::LEAG || instr.op == OpCode::ADDPTR ||
+        instr.op == OpCode::ADDPTRD || instr.op == OpCode::ADJSP ||
+        instr.op == OpCode::RET || instr.op == OpCode::RETN || instr.op == OpCode::MEMCPY ||
+        instr.op == OpCode::LOADMN || instr.op == OpCode::STOREMN) {
+        text += " " + std::to_string(instr.operand);
+    }
+    return text;
+}
+
 std::string ByteCode::toString() const {
     std::ostringstream ss;
     for (size_t i = 0; i < code.size(); ++i) {
-        ss << i << ":\t" << opcodeName(code[i].op);
-        if (code[i].op == OpCode::PUSH || code[i].op == OpCode::LOAD ||
-            code[i].op == OpCode::STORE || code[i].op == OpCode::LOADG ||
-            code[i].op == OpCode::STOREG || code[i].op == OpCode::JMP ||
-            code[i].op == OpCode::JZ || code[i].op == OpCode::JNZ ||
-            code[i].op == OpCode::CALL || code[i].op == OpCode::LEA ||
-            code[i].op == OpCode::LEAG || code[i].op == OpCode::ADDPTR ||
-            code[i].op == OpCode::ADDPTRD || code[i].op == OpCode::ADJSP ||
-            code[i].op == OpCode::RET || code[i].op == OpCode::MEMCPY) {
-            ss << " " << code[i].operand;
+        int len = instructionLength(code[i].op);
+        if (len > 1 && i + len <= code.size()) {
+            // 超级指令：打印融合后的操作数，被吸收的原指令缩进显示（地址保持不变）
+            const Instruction* in = &code[i];
+            ss << i << ":\t" << opcodeName(in->op) << " " << in->operand;
+            switch (in->op) {
+                case OpCode::INCLOCAL:
+                    ss << ", " << in[1].operand;
+                    break;
+                case OpCode::JLT_LOCALS:
+                case OpCode::JLT_LOCAL_CONST:
+                case OpCode::JLE_LOCAL_CONST:
+                    ss << ", " << in[1].operand << " -> " << in[3].operand;
+                    break;
+                case OpCode::LOADIDX:
+                    ss << ", " << in[1].operand;
+                    break;
+                default:
+                    break;
+            }
+            ss << "\n";
+            for (int k = 1; k < len; ++k) {
+                ss << i + k << ":\t  | " << formatInstruction(in[k]) << "\n";
+            }
+            i += len - 1;
+            continue;
         }
-        ss << "\n";
+
+        ss << i << ":\t" << formatInstruction(code[i]) << "\n";
     }
     return ss.str();
 }
 
 void VM::push(int32_t val) {
-    if (sp_ >= STACK_SIZE) {
-        throw std::runtime_error("Stack overflow");
-    }
     stack_[sp_++] = val;
 }
 
+template <bool Checked>
 int32_t VM::pop() {
-    if (sp_ <= 0) {
-        throw std::runtime_error("Stack underflow");
+    if constexpr (Checked) {
+        if (sp_ <= 0) {
+            throw std::runtime_error("Stack underflow");
+        }
     }
     return stack_[--sp_];
 }
 
-int VM::execute(const ByteCode& bytecode) {
+// 复制 size 个 slot（MEMCPY）：全局区和栈在同一段内存里，检查两个区间后一次 memmove
+void VM::copyMemory(int32_t src, int32_t dst, int32_t size) {
+    if (size == 0) {
+        return;
+    }
+    if (!validRange(src, size) || !validRange(dst, size)) {
+        throw std::runtime_error("MEMCPY: 内存访问越界");
+    }
+    std::memmove(memory_.data() + dst, memory_.data() + src, static_cast<size_t>(size) * sizeof(int32_t));
+}
+
+// 一次增长 size 个 slot，可能跨过保护页，这里显式检查栈溢出
+void VM::loadBlock(int32_t addr, int32_t size, int sp) {
+    if (!validRange(addr, size)) {
+        throw std::runtime_error("LOADMN: 内存访问越界");
+    }
+    if (size > stackCapacity() - sp) {
+        throw std::runtime_error("Stack overflow");
+    }
+    const int32_t* from = memory_.data() + addr;
+    for (int32_t i = 0; i < size; ++i) {
+        stack_[sp + i] = from[i];
+    }
+}
+
+void VM::storeBlock(int32_t addr, int32_t size, int sp) {
+    if (!validRange(addr, size)) {
+        throw std::runtime_error("STOREMN: 内存访问越界");
+    }
+    int32_t* to = memory_.data() + addr;
+    for (int32_t i = 0; i < size; ++i) {
+        to[i] = stack_[sp + i];
+    }
+}
+
+// 源区间是被调函数的局部变量或栈顶的返回值、或者调用者可以访问的内存，
+// 目标是调用者预留的返回区（在被调函数的栈帧下面），按地址从低到高复制即可
+void VM::returnBlock(int32_t src, int32_t dst, int32_t size) {
+    if (!validRange(src, size) || !validRange(dst, size)) {
+        throw std::runtime_error("RETN: 内存访问越界");
+    }
+    int32_t* memory = memory_.data();
+    for (int32_t i = 0; i < size; ++i) {
+        memory[dst + i] = memory[src + i];
+    }
+}
+
+// 线索化分派不在运行时检查 pc 是否越界，执行前一次性检查所有跳转目标
+// （目标等于 code.size() 表示跳到末尾，即结束执行）
+void VM::checkJumpTargets(const ByteCode& bytecode) {
+    const int code_size = (int)bytecode.code.size();
+    for (const auto& instr : bytecode.code) {
+        if (instr.op == OpCode::JMP || instr.op == OpCode::JZ ||
+            instr.op == OpCode::JNZ || instr.op == OpCode::CALL) {
+            if (instr.operand < 0 || instr.operand > code_size) {
+                throw std::runtime_error("跳转目标越界: " + std::to_string(instr.operand));
+            }
+        }
+    }
+}
+
+bool VM::supportsThreadedDispatch() {
+#if SIMPLEC_COMPUTED_GOTO
+    return true;
+#else
+    return false;
+#endif
+}
+
+void VM::setup(const ByteCode& bytecode) {
     if (bytecode.entry_point < 0) {
         throw std::runtime_error("No entry point (main function)");
     }
 
+    // 内存布局：[空指针][全局区][栈]，大小不变时不重新分配
+    stack_base_ = stackBase(bytecode.global_inits);
+    global_slots_ = stack_base_ - GLOBAL_BASE;
+    if (stack_base_ > INT32_MAX - stack_size_) {
+        throw std::runtime_error("全局区和栈超出 VM 的地址范围");
+    }
+    memory_.resize(stack_base_ + stack_size_);
+    globals_ = memory_.data() + GLOBAL_BASE;
+    stack_ = memory_.data() + stack_base_;
+
     // 初始化全局变量存储区 (Phase 6)
+    // 每次执行都重新初始化，同一个 VM 可以多次 execute（benchmark 依赖这一点）
+    int32_t* global = globals_;
     for (const auto& init : bytecode.global_inits) {
-        if (init.init_data.empty()) {
-            // 没有初始化数据，全部初始化为 0
-            for (int i = 0; i < init.slot_count; i++) {
-                globals_.push_back(0);
-            }
-        } else {
-            // 使用提供的初始化数据
-            for (size_t i = 0; i < init.init_data.size() && i < (size_t)init.slot_count; i++) {
-                globals_.push_back(init.init_data[i]);
-            }
-            // 剩余 slot 初始化为 0
-            for (size_t i = init.init_data.size(); i < (size_t)init.slot_count; i++) {
-                globals_.push_back(0);
-            }
-        }
+        // init_data 之外的 slot 初始化为 0
+        int given = std::min<int>(init.init_data.size(), init.slot_count);
+        std::copy(init.init_data.begin(), init.init_data.begin() + given, global);
+        std::fill(global + given, global + init.slot_count, 0);
+        global += init.slot_count;
     }
 
     // 设置虚拟调用帧
@@ -115,196 +296,340 @@ int VM::execute(const ByteCode& bytecode) {
     fp_ = sp_;
     pc_ = bytecode.entry_point;
     running_ = true;
+}
 
+int VM::stackBase(const std::vector<GlobalVarInit>& global_inits) {
+    int64_t slots = 0;
+    for (const auto& init : global_inits) {
+        slots += init.slot_count;
+    }
+    if (slots > MAX_STACK_SIZE) {
+        throw std::runtime_error("全局区超出 VM 的地址范围");
+    }
+    return GLOBAL_BASE + static_cast<int>(slots);
+}
+
+void VM::setStackSize(int slots) {
+    if (slots <= 0 || slots > MAX_STACK_SIZE) {
+        throw std::runtime_error("栈大小必须在 1 到 " + std::to_string(MAX_STACK_SIZE) + " 个 slot 之间");
+    }
+    stack_size_ = slots;
+}
+
+// body 的调用链（dispatch、run、runCached）里不能有需要析构的局部对象：
+// siglongjmp 回到这里时不会执行它们的析构函数
+template <typename Body>
+int VM::guarded(Body&& body) {
+    sigjmp_buf env;
+    int jump = sigsetjmp(env, 1);
+    if (jump != 0) {
+        // 信号处理函数已经解除登记
+        running_ = false;
+        throw std::runtime_error(jump == VMMemory::OVERFLOW_JUMP ? "Stack overflow" : "内存访问越界");
+    }
+    memory_.arm(&env);
+    try {
+        int result = body();
+        memory_.disarm();
+        return result;
+    } catch (...) {
+        memory_.disarm();
+        throw;
+    }
+}
+
+int VM::execute(const ByteCode& bytecode) {
+    setup(bytecode);
+    return guarded([&] { return dispatch<true>(bytecode); });
+}
+
+int VM::executeVerified(const ByteCode& bytecode, const BytecodeVerifier& verifier) {
+    if (!verifier.isVerified(bytecode)) {
+        throw std::runtime_error("字节码未通过校验，不能使用无检查执行");
+    }
+    setup(bytecode);
+    return guarded([&] { return dispatch<false>(bytecode); });
+}
+
+int VM::executeJit(const JitProgram& program) {
+    setup(program.bytecode());
+    if (fp_ + program.entryDepth() > stackCapacity()) {
+        throw std::runtime_error("Stack overflow");
+    }
+
+    JitContext ctx{};
+    ctx.memory = memory_.data();
+    ctx.stack = stack_;
+    ctx.sp = sp_;
+    ctx.fp = fp_;
+    ctx.stack_size = stackCapacity();
+    ctx.address_limit = memory_.size() - GLOBAL_BASE;
+    ctx.native_stack_limit = jitNativeStackLimit();
+    ctx.vm = this;
+
+    JitStatus status = program.run(ctx);
+    sp_ = (int)ctx.sp;
+    fp_ = (int)ctx.fp;
+    running_ = false;
+    if (status != JitStatus::Ok) {
+        throw std::runtime_error(jitStatusMessage(status, ctx));
+    }
+    return sp_ > 0 ? stack_[sp_ - 1] : 0;
+}
+
+template <bool Checked>
+int VM::dispatch(const ByteCode& bytecode) {
+    // 调试模式需要逐条打印，只走 switch 分派（并保留所有检查）；
+    // 正常运行时 debug_ 只在这里检查一次，而不是每条指令检查
+    if (debug_) {
+        return run<false, true, true>(bytecode);
+    }
+    bool threaded = dispatch_ == DispatchMode::Threaded && supportsThreadedDispatch();
+    if (tos_cache_) {
+        return threaded ? runCached<true, Checked>(bytecode) : runCached<false, Checked>(bytecode);
+    }
+    return threaded ? run<true, false, Checked>(bytecode) : run<false, false, Checked>(bytecode);
+}
+
+// ========== 解释器主循环 ==========
+//
+// 两种分派方式共用同一份指令处理代码：
+//   - Switch:   循环顶部取指令，switch 跳到 case，处理完 continue 回到循环顶部
+//   - Threaded: 执行前把 code[i].op 翻译成处理程序的地址 targets[i]，
+//               每条指令处理完直接 goto *targets[pc]，省掉循环条件、switch 边界检查
+//               和间接跳转前的比较，并让每个处理程序拥有独立的分支预测入口
+//
+// VM_CASE(X) 同时定义 switch 的 case 标签和 computed goto 的跳转标签，
+// VM_NEXT()  分派下一条指令，VM_EXIT() 结束执行。
+
+#if SIMPLEC_COMPUTED_GOTO
+#define VM_CASE(name) case OpCode::name: op_##name:
+#define VM_NEXT()                              \
+    if constexpr (Threaded) {                  \
+        ip = code.data() + pc_;                \
+        goto *targets[pc_++];                  \
+    } else                                     \
+        continue
+#else
+#define VM_CASE(name) case OpCode::name:
+#define VM_NEXT() continue
+#endif
+#define VM_EXIT() goto vm_exit
+
+template <bool Threaded, bool Trace, bool Checked>
+int VM::run(const ByteCode& bytecode) {
     const auto& code = bytecode.code;
+    const int code_size = (int)code.size();
+    const Instruction* ip = nullptr;
 
-    while (running_ && pc_ >= 0 && pc_ < (int)code.size()) {
-        const auto& instr = code[pc_];
+#if SIMPLEC_COMPUTED_GOTO
+    // 跳转表：下标与 OpCode 的声明顺序严格一致
+    static const void* const labels[] = {
+        &&op_PUSH, &&op_POP,
+        &&op_LOAD, &&op_STORE, &&op_LOADM, &&op_STOREM,
+        &&op_LOADG, &&op_STOREG, &&op_LEAG,
+        &&op_LEA, &&op_ADDPTR, &&op_ADDPTRD,
+        &&op_ADD, &&op_SUB, &&op_MUL, &&op_DIV, &&op_MOD, &&op_NEG,
+        &&op_EQ, &&op_NE, &&op_LT, &&op_LE, &&op_GT, &&op_GE,
+        &&op_AND, &&op_OR, &&op_NOT,
+        &&op_JMP, &&op_JZ, &&op_JNZ,
+        &&op_CALL, &&op_RET, &&op_RETN,
+        &&op_PRINT, &&op_HALT, &&op_ADJSP, &&op_MEMCPY,
+        &&op_LOADMN, &&op_STOREMN,
+        &&op_INCLOCAL, &&op_JLT_LOCALS, &&op_JLT_LOCAL_CONST, &&op_JLE_LOCAL_CONST,
+        &&op_LOADIDX,
+    };
+    static_assert(sizeof(labels) / sizeof(labels[0]) == OPCODE_COUNT,
+                  "跳转表必须覆盖所有 OpCode");
 
-        if (debug_) {
-            std::cout << "[" << pc_ << "] " << opcodeName(instr.op);
-            if (instr.operand != 0) std::cout << " " << instr.operand;
+    // 预翻译：每条指令对应一个处理程序地址，末尾追加一个哨兵（执行越过代码末尾即结束）
+    // 跳转目标在这里一次性检查，运行时就不需要每条指令检查 pc 是否越界
+    std::vector<const void*>& targets = threaded_targets_;
+    if constexpr (Threaded) {
+        if constexpr (Checked) {
+            checkJumpTargets(bytecode);
+        }
+        targets.resize(code_size + 1);
+        for (int i = 0; i < code_size; ++i) {
+            targets[i] = labels[static_cast<int>(code[i].op)];
+        }
+        targets[code_size] = &&vm_exit;
+
+        if (pc_ < 0 || pc_ >= code_size) {
+            VM_EXIT();
+        }
+        ip = code.data() + pc_;
+        goto *targets[pc_++];
+    }
+#endif
+
+    while (running_ && pc_ >= 0 && pc_ < code_size) {
+        ip = code.data() + pc_;
+
+        if constexpr (Trace) {
+            std::cout << "[" << pc_ << "] " << opcodeName(ip->op);
+            if (ip->operand != 0) std::cout << " " << ip->operand;
             std::cout << "  (sp=" << sp_ << ", fp=" << fp_ << ")\n";
         }
 
         pc_++;
 
-        switch (instr.op) {
-            case OpCode::PUSH:
-                push(instr.operand);
-                break;
+        switch (ip->op) {
+            VM_CASE(PUSH)
+                push(ip->operand);
+                VM_NEXT();
 
-            case OpCode::POP:
-                pop();
-                break;
+            VM_CASE(POP)
+                pop<Checked>();
+                VM_NEXT();
 
-            case OpCode::LOAD:
-                push(stack_[fp_ + instr.operand]);
-                break;
+            VM_CASE(LOAD)
+                push(stack_[fp_ + ip->operand]);
+                VM_NEXT();
 
-            case OpCode::STORE:
-                stack_[fp_ + instr.operand] = pop();
-                break;
+            VM_CASE(STORE)
+                stack_[fp_ + ip->operand] = pop<Checked>();
+                VM_NEXT();
 
-            case OpCode::LOADM: {
-                // 内存加载: addr = pop(); push(stack[addr] 或 globals_[addr - GLOBAL_BASE])
-                int32_t addr = pop();
-                if (addr >= GLOBAL_BASE) {
-                    // 全局变量
-                    int global_offset = addr - GLOBAL_BASE;
-                    if (global_offset < 0 || global_offset >= (int)globals_.size()) {
-                        throw std::runtime_error("LOADM: 全局变量访问越界");
-                    }
-                    push(globals_[global_offset]);
-                } else {
-                    // 栈变量
-                    if (addr < 0 || addr >= STACK_SIZE) {
-                        throw std::runtime_error("LOADM: 栈访问越界");
-                    }
-                    push(stack_[addr]);
+            VM_CASE(LOADM) {
+                // 内存加载: addr = pop<Checked>(); push(memory[addr])
+                int32_t addr = pop<Checked>();
+                if (!validAddress(addr)) {
+                    throw std::runtime_error("LOADM: 内存访问越界");
                 }
-                break;
+                push(memory_[addr]);
+                VM_NEXT();
             }
 
-            case OpCode::STOREM: {
-                // 内存存储: addr = pop(); value = pop(); stack[addr] 或 globals_[...] = value
-                int32_t addr = pop();
-                int32_t value = pop();
-                if (addr >= GLOBAL_BASE) {
-                    // 全局变量
-                    int global_offset = addr - GLOBAL_BASE;
-                    if (global_offset < 0 || global_offset >= (int)globals_.size()) {
-                        throw std::runtime_error("STOREM: 全局变量访问越界");
-                    }
-                    globals_[global_offset] = value;
-                } else {
-                    // 栈变量
-                    if (addr < 0 || addr >= STACK_SIZE) {
-                        throw std::runtime_error("STOREM: 栈访问越界");
-                    }
-                    stack_[addr] = value;
+            VM_CASE(STOREM) {
+                // 内存存储: addr = pop<Checked>(); value = pop<Checked>(); memory[addr] = value
+                int32_t addr = pop<Checked>();
+                int32_t value = pop<Checked>();
+                if (!validAddress(addr)) {
+                    throw std::runtime_error("STOREM: 内存访问越界");
                 }
-                break;
+                memory_[addr] = value;
+                VM_NEXT();
             }
 
-            case OpCode::LEA:
-                // 加载有效地址: push(fp + operand)
-                push(fp_ + instr.operand);
-                break;
+            VM_CASE(LEA)
+                // 加载有效地址: push(栈基址 + fp + operand)
+                push(stack_base_ + fp_ + ip->operand);
+                VM_NEXT();
 
-            case OpCode::ADDPTR: {
-                // 地址加静态偏移: addr = pop(); push(addr + operand)
-                int32_t addr = pop();
-                push(addr + instr.operand);
-                break;
+            VM_CASE(ADDPTR) {
+                // 地址加静态偏移: addr = pop<Checked>(); push(addr + operand)
+                int32_t addr = pop<Checked>();
+                push(addr + ip->operand);
+                VM_NEXT();
             }
 
-            case OpCode::ADDPTRD: {
-                // 地址加动态偏移: base = pop(); index = pop(); push(base + index * operand)
-                int32_t base = pop();
-                int32_t index = pop();
-                push(base + index * instr.operand);
-                break;
+            VM_CASE(ADDPTRD) {
+                // 地址加动态偏移: base = pop<Checked>(); index = pop<Checked>(); push(base + index * operand)
+                int32_t base = pop<Checked>();
+                int32_t index = pop<Checked>();
+                push(base + index * ip->operand);
+                VM_NEXT();
             }
 
-            case OpCode::ADD: {
-                int32_t b = pop(), a = pop();
+            VM_CASE(ADD) {
+                int32_t b = pop<Checked>(), a = pop<Checked>();
                 push(a + b);
-                break;
+                VM_NEXT();
             }
-            case OpCode::SUB: {
-                int32_t b = pop(), a = pop();
+            VM_CASE(SUB) {
+                int32_t b = pop<Checked>(), a = pop<Checked>();
                 push(a - b);
-                break;
+                VM_NEXT();
             }
-            case OpCode::MUL: {
-                int32_t b = pop(), a = pop();
+            VM_CASE(MUL) {
+                int32_t b = pop<Checked>(), a = pop<Checked>();
                 push(a * b);
-                break;
+                VM_NEXT();
             }
-            case OpCode::DIV: {
-                int32_t b = pop(), a = pop();
+            VM_CASE(DIV) {
+                int32_t b = pop<Checked>(), a = pop<Checked>();
                 if (b == 0) throw std::runtime_error("Division by zero");
                 push(a / b);
-                break;
+                VM_NEXT();
             }
-            case OpCode::MOD: {
-                int32_t b = pop(), a = pop();
+            VM_CASE(MOD) {
+                int32_t b = pop<Checked>(), a = pop<Checked>();
                 if (b == 0) throw std::runtime_error("Division by zero");
                 push(a % b);
-                break;
+                VM_NEXT();
             }
-            case OpCode::NEG:
-                push(-pop());
-                break;
+            VM_CASE(NEG)
+                push(-pop<Checked>());
+                VM_NEXT();
 
-            case OpCode::EQ: {
-                int32_t b = pop(), a = pop();
+            VM_CASE(EQ) {
+                int32_t b = pop<Checked>(), a = pop<Checked>();
                 push(a == b ? 1 : 0);
-                break;
+                VM_NEXT();
             }
-            case OpCode::NE: {
-                int32_t b = pop(), a = pop();
+            VM_CASE(NE) {
+                int32_t b = pop<Checked>(), a = pop<Checked>();
                 push(a != b ? 1 : 0);
-                break;
+                VM_NEXT();
             }
-            case OpCode::LT: {
-                int32_t b = pop(), a = pop();
+            VM_CASE(LT) {
+                int32_t b = pop<Checked>(), a = pop<Checked>();
                 push(a < b ? 1 : 0);
-                break;
+                VM_NEXT();
             }
-            case OpCode::LE: {
-                int32_t b = pop(), a = pop();
+            VM_CASE(LE) {
+                int32_t b = pop<Checked>(), a = pop<Checked>();
                 push(a <= b ? 1 : 0);
-                break;
+                VM_NEXT();
             }
-            case OpCode::GT: {
-                int32_t b = pop(), a = pop();
+            VM_CASE(GT) {
+                int32_t b = pop<Checked>(), a = pop<Checked>();
                 push(a > b ? 1 : 0);
-                break;
+                VM_NEXT();
             }
-            case OpCode::GE: {
-                int32_t b = pop(), a = pop();
+            VM_CASE(GE) {
+                int32_t b = pop<Checked>(), a = pop<Checked>();
                 push(a >= b ? 1 : 0);
-                break;
+                VM_NEXT();
             }
 
-            case OpCode::AND: {
-                int32_t b = pop(), a = pop();
+            VM_CASE(AND) {
+                int32_t b = pop<Checked>(), a = pop<Checked>();
                 push((a && b) ? 1 : 0);
-                break;
+                VM_NEXT();
             }
-            case OpCode::OR: {
-                int32_t b = pop(), a = pop();
+            VM_CASE(OR) {
+                int32_t b = pop<Checked>(), a = pop<Checked>();
                 push((a || b) ? 1 : 0);
-                break;
+                VM_NEXT();
             }
-            case OpCode::NOT:
-                push(pop() == 0 ? 1 : 0);
-                break;
+            VM_CASE(NOT)
+                push(pop<Checked>() == 0 ? 1 : 0);
+                VM_NEXT();
 
-            case OpCode::JMP:
-                pc_ = instr.operand;
-                break;
+            VM_CASE(JMP)
+                pc_ = ip->operand;
+                VM_NEXT();
 
-            case OpCode::JZ:
-                if (pop() == 0) pc_ = instr.operand;
-                break;
+            VM_CASE(JZ)
+                if (pop<Checked>() == 0) pc_ = ip->operand;
+                VM_NEXT();
 
-            case OpCode::JNZ:
-                if (pop() != 0) pc_ = instr.operand;
-                break;
+            VM_CASE(JNZ)
+                if (pop<Checked>() != 0) pc_ = ip->operand;
+                VM_NEXT();
 
-            case OpCode::CALL: {
+            VM_CASE(CALL) {
                 // 保存返回地址和帧指针
                 push(pc_);
                 push(fp_);
                 fp_ = sp_;
-                pc_ = instr.operand;
-                break;
+                pc_ = ip->operand;
+                VM_NEXT();
             }
 
-            case OpCode::RET: {
+            VM_CASE(RET) {
                 // 新 ABI: operand = ret_slot_offset (相对于 fp)
                 // 栈帧布局 (caller 视角，调用前):
                 //   [ret_slot]   fp + ret_slot_offset (由 caller 预留)
@@ -313,120 +638,603 @@ int VM::execute(const ByteCode& bytecode) {
                 //   [ret_addr]   fp - 2
                 //   [old_fp]     fp - 1
                 //   fp ->
-                // TODO: 支持 struct 返回值时，需循环写入多个 slot
-                int ret_slot_offset = instr.operand;
-                int32_t retval = (sp_ > fp_) ? pop() : 0;
+                // 结构体返回值占多个 slot，由 RETN 一次复制到返回区
+                int ret_slot_offset = ip->operand;
+                int32_t retval = (sp_ > fp_) ? pop<Checked>() : 0;
                 stack_[fp_ + ret_slot_offset] = retval;
 
                 sp_ = fp_;
-                fp_ = pop();  // 恢复旧的帧指针
-                int32_t ret_addr = pop();  // 获取返回地址
+                fp_ = pop<Checked>();  // 恢复旧的帧指针
+                int32_t ret_addr = pop<Checked>();  // 获取返回地址
 
                 if (ret_addr == -1) {
                     running_ = false;
-                } else {
-                    pc_ = ret_addr;
+                    VM_EXIT();
                 }
-                break;
+                if (ret_addr < 0 || ret_addr >= code_size) {
+                    throw std::runtime_error("RET: 返回地址越界");
+                }
+                pc_ = ret_addr;
+                VM_NEXT();
             }
 
-            case OpCode::PRINT:
+            VM_CASE(RETN) {
+                // 块返回: dst = pop<Checked>(); src = pop<Checked>(); 复制 operand 个 slot 后按 RET 返回
+                int32_t dst = pop<Checked>();
+                int32_t src = pop<Checked>();
+                returnBlock(src, dst, ip->operand);
+
+                sp_ = fp_;
+                fp_ = pop<Checked>();
+                int32_t ret_addr = pop<Checked>();
+
+                if (ret_addr == -1) {
+                    running_ = false;
+                    VM_EXIT();
+                }
+                if (ret_addr < 0 || ret_addr >= code_size) {
+                    throw std::runtime_error("RET: 返回地址越界");
+                }
+                pc_ = ret_addr;
+                VM_NEXT();
+            }
+
+            VM_CASE(PRINT)
                 std::cout << "OUTPUT: " << stack_[sp_ - 1] << "\n";
-                break;
+                VM_NEXT();
 
-            case OpCode::HALT:
+            VM_CASE(HALT)
                 running_ = false;
-                break;
+                VM_EXIT();
 
-            case OpCode::ADJSP: {
+            VM_CASE(ADJSP) {
                 // 调整栈指针: sp -= operand
-                sp_ -= instr.operand;
-                break;
+                if constexpr (Checked) {
+                    // 负的 operand 一次增长多个 slot 而不写入，可能跨过保护页
+                    if (sp_ - ip->operand > stackCapacity()) {
+                        throw std::runtime_error("Stack overflow");
+                    }
+                }
+                sp_ -= ip->operand;
+                VM_NEXT();
             }
 
-            case OpCode::MEMCPY: {
-                // 内存复制: size = operand; dst = pop(); src = pop();
-                // 复制 size 个 slot，支持全局和栈之间的复制
-                int32_t dst = pop();
-                int32_t src = pop();
-                int32_t size = instr.operand;
-
-                // 判断 src 和 dst 是全局还是栈地址
-                bool src_is_global = (src >= GLOBAL_BASE);
-                bool dst_is_global = (dst >= GLOBAL_BASE);
-
-                // 边界检查和内存复制
-                if (src_is_global && dst_is_global) {
-                    // 全局到全局
-                    int src_offset = src - GLOBAL_BASE;
-                    int dst_offset = dst - GLOBAL_BASE;
-                    if (src_offset < 0 || src_offset + size > (int)globals_.size() ||
-                        dst_offset < 0 || dst_offset + size > (int)globals_.size()) {
-                        throw std::runtime_error("MEMCPY: 全局变量访问越界");
+            VM_CASE(MEMCPY) {
+                // 内存复制: size = operand; dst = pop<Checked>(); src = pop<Checked>();
+                int32_t dst = pop<Checked>();
+                int32_t src = pop<Checked>();
+                copyMemory(src, dst, ip->operand);
+                VM_NEXT();
+            }
+
+            VM_CASE(LOADMN) {
+                // 块加载: addr = pop<Checked>(); 依次压入 memory[addr..addr+operand-1]
+                int32_t addr = pop<Checked>();
+                loadBlock(addr, ip->operand, sp_);
+                sp_ += ip->operand;
+                VM_NEXT();
+            }
+
+            VM_CASE(STOREMN) {
+                // 块存储: addr = pop<Checked>(); 栈顶 operand 个值存入 memory[addr..]
+                int32_t addr = pop<Checked>();
+                if constexpr (Checked) {
+                    if (sp_ < ip->operand) {
+                        throw std::runtime_error("Stack underflow");
                     }
-                    for (int32_t i = 0; i < size; i++) {
-                        globals_[dst_offset + i] = globals_[src_offset + i];
+                }
+                storeBlock(addr, ip->operand, sp_ - ip->operand);
+                sp_ -= ip->operand;
+                VM_NEXT();
+            }
+
+            VM_CASE(LOADG) {
+                // 加载全局变量: push(globals_[operand])
+                int32_t offset = ip->operand;
+                if constexpr (Checked) {
+                    if (offset < 0 || offset >= global_slots_) {
+                        throw std::runtime_error("LOADG: 全局变量访问越界");
                     }
-                } else if (src_is_global && !dst_is_global) {
-                    // 全局到栈
-                    int src_offset = src - GLOBAL_BASE;
-                    if (src_offset < 0 || src_offset + size > (int)globals_.size() ||
-                        dst < 0 || dst + size > STACK_SIZE) {
-                        throw std::runtime_error("MEMCPY: 内存访问越界");
+                }
+                push(globals_[offset]);
+                VM_NEXT();
+            }
+
+            VM_CASE(STOREG) {
+                // 存储全局变量: globals_[operand] = pop<Checked>()
+                int32_t offset = ip->operand;
+                if constexpr (Checked) {
+                    if (offset < 0 || offset >= global_slots_) {
+                        throw std::runtime_error("STOREG: 全局变量访问越界");
                     }
-                    for (int32_t i = 0; i < size; i++) {
-                        stack_[dst + i] = globals_[src_offset + i];
+                }
+                globals_[offset] = pop<Checked>();
+                VM_NEXT();
+            }
+
+            VM_CASE(LEAG) {
+                // 加载全局变量地址: push(GLOBAL_BASE + operand)
+                push(GLOBAL_BASE + ip->operand);
+                VM_NEXT();
+            }
+
+            // ===== 超级指令 =====
+            // ip[1..] 是被融合的原指令，处理完后 pc 跳过它们
+
+            VM_CASE(INCLOCAL)
+                // LOAD x; PUSH c; ADD; STORE x
+                stack_[fp_ + ip->operand] += ip[1].operand;
+                pc_ += 3;
+                VM_NEXT();
+
+            VM_CASE(JLT_LOCALS)
+                // LOAD a; LOAD b; LT; JZ t
+                if (stack_[fp_ + ip->operand] < stack_[fp_ + ip[1].operand]) {
+                    pc_ += 3;
+                } else {
+                    pc_ = ip[3].operand;
+                }
+                VM_NEXT();
+
+            VM_CASE(JLT_LOCAL_CONST)
+                // LOAD a; PUSH c; LT; JZ t
+                if (stack_[fp_ + ip->operand] < ip[1].operand) {
+                    pc_ += 3;
+                } else {
+                    pc_ = ip[3].operand;
+                }
+                VM_NEXT();
+
+            VM_CASE(JLE_LOCAL_CONST)
+                // LOAD a; PUSH c; LE; JZ t
+                if (stack_[fp_ + ip->operand] <= ip[1].operand) {
+                    pc_ += 3;
+                } else {
+                    pc_ = ip[3].operand;
+                }
+                VM_NEXT();
+
+            VM_CASE(LOADIDX) {
+                // LEA k; ADDPTRD s; LOADM: 局部数组元素读取
+                int32_t index = pop<Checked>();
+                int32_t addr = stack_base_ + fp_ + ip->operand + index * ip[1].operand;
+                if (!validAddress(addr)) {
+                    throw std::runtime_error("LOADM: 内存访问越界");
+                }
+                push(memory_[addr]);
+                pc_ += 2;
+                VM_NEXT();
+            }
+        }
+    }
+
+vm_exit:
+    return sp_ > 0 ? stack_[sp_ - 1] : 0;
+}
+
+// ========== 栈顶缓存（top-of-stack caching）==========
+//
+// run() 里每次 push/pop 都要读写 stack_ 和成员 sp_，这里把它们换成局部变量：
+//   - sp/fp/pc 是局部变量，编译器可以把它们放在寄存器里
+//   - 栈顶元素保存在 tos 中，stack[sp - 1] 里的内容是过期的；
+//     只有栈顶被压到下面时（push）才写内存，弹出后的新栈顶才从内存读
+//   - 执行结束时把 tos 和 sp/fp/pc 写回成员
+//
+// 局部变量本身也在栈上，LOAD/STORE 或指针访问的地址可能恰好是栈顶，
+// 因此按栈下标访问时要经过 TOS_READ/TOS_WRITE，按内存地址访问时经过 MEM_READ/MEM_WRITE。
+
+#undef VM_NEXT
+#if SIMPLEC_COMPUTED_GOTO
+#define VM_NEXT()                              \
+    if constexpr (Threaded) {                  \
+        ip = code.data() + pc;                 \
+        goto *targets[pc++];                   \
+    } else                                     \
+        continue
+#else
+#define VM_NEXT() continue
+#endif
+
+#define TOS_READ(a) ((a) == sp - 1 ? tos : stack[a])
+#define TOS_WRITE(a, v)                        \
+    do {                                       \
+        if ((a) == sp - 1) tos = (v);          \
+        else stack[a] = (v);                   \
+    } while (0)
+// 按内存地址访问（LOADM/STOREM）：地址是栈顶时同样经过 tos
+#define MEM_READ(a) ((a) == stack_base + sp - 1 ? tos : memory[a])
+#define MEM_WRITE(a, v)                        \
+    do {                                       \
+        if ((a) == stack_base + sp - 1) tos = (v); \
+        else memory[a] = (v);                  \
+    } while (0)
+#define TOS_PUSH(v)                            \
+    do {                                       \
+        int32_t pushed_ = (v);                 \
+        stack[sp - 1] = tos;                   \
+        tos = pushed_;                         \
+        ++sp;                                  \
+    } while (0)
+// 二元运算: a = 次栈顶（内存），b = 栈顶（tos），结果替换为新栈顶
+#define TOS_BINARY(expr)                       \
+    do {                                       \
+        if constexpr (Checked) {               \
+            if (sp < 2) {                      \
+                throw std::runtime_error("Stack underflow"); \
+            }                                  \
+        }                                      \
+        int32_t b = tos;                       \
+        int32_t a = stack[sp - 2];             \
+        --sp;                                  \
+        tos = (expr);                          \
+    } while (0)
+
+template <bool Threaded, bool Checked>
+int VM::runCached(const ByteCode& bytecode) {
+    const auto& code = bytecode.code;
+    const int code_size = (int)code.size();
+    const Instruction* ip = nullptr;
+
+    int32_t* const memory = memory_.data();
+    int32_t* const stack = stack_;
+    const int stack_base = stack_base_;
+    const int stack_size = stackCapacity();
+    int sp = sp_;
+    int fp = fp_;
+    int pc = pc_;
+    int32_t tos = sp > 0 ? stack[sp - 1] : 0;
+
+    auto pop = [&]() -> int32_t {
+        if constexpr (Checked) {
+            if (sp <= 0) {
+                throw std::runtime_error("Stack underflow");
+            }
+        }
+        int32_t v = tos;
+        --sp;
+        tos = stack[sp > 0 ? sp - 1 : 0];
+        return v;
+    };
+
+#if SIMPLEC_COMPUTED_GOTO
+    // 与 run() 相同的跳转表（标签只在本函数内可见，需要单独定义）
+    static const void* const labels[] = {
+        &&op_PUSH, &&op_POP,
+        &&op_LOAD, &&op_STORE, &&op_LOADM, &&op_STOREM,
+        &&op_LOADG, &&op_STOREG, &&op_LEAG,
+        &&op_LEA, &&op_ADDPTR, &&op_ADDPTRD,
+        &&op_ADD, &&op_SUB, &&op_MUL, &&op_DIV, &&op_MOD, &&op_NEG,
+        &&op_EQ, &&op_NE, &&op_LT, &&op_LE, &&op_GT, &&op_GE,
+        &&op_AND, &&op_OR, &&op_NOT,
+        &&op_JMP, &&op_JZ, &&op_JNZ,
+        &&op_CALL, &&op_RET, &&op_RETN,
+        &&op_PRINT, &&op_HALT, &&op_ADJSP, &&op_MEMCPY,
+        &&op_LOADMN, &&op_STOREMN,
+        &&op_INCLOCAL, &&op_JLT_LOCALS, &&op_JLT_LOCAL_CONST, &&op_JLE_LOCAL_CONST,
+        &&op_LOADIDX,
+    };
+    static_assert(sizeof(labels) / sizeof(labels[0]) == OPCODE_COUNT,
+                  "跳转表必须覆盖所有 OpCode");
+
+    std::vector<const void*>& targets = threaded_targets_;
+    if constexpr (Threaded) {
+        if constexpr (Checked) {
+            checkJumpTargets(bytecode);
+        }
+        targets.resize(code_size + 1);
+        for (int i = 0; i < code_size; ++i) {
+            targets[i] = labels[static_cast<int>(code[i].op)];
+        }
+        targets[code_size] = &&vm_exit;
+
+        if (pc < 0 || pc >= code_size) {
+            VM_EXIT();
+        }
+        ip = code.data() + pc;
+        goto *targets[pc++];
+    }
+#endif
+
+    while (pc >= 0 && pc < code_size) {
+        ip = code.data() + pc;
+        pc++;
+
+        switch (ip->op) {
+            VM_CASE(PUSH)
+                TOS_PUSH(ip->operand);
+                VM_NEXT();
+
+            VM_CASE(POP)
+                pop();
+                VM_NEXT();
+
+            VM_CASE(LOAD) {
+                int32_t addr = fp + ip->operand;
+                TOS_PUSH(TOS_READ(addr));
+                VM_NEXT();
+            }
+
+            VM_CASE(STORE) {
+                int32_t value = pop();
+                int32_t addr = fp + ip->operand;
+                TOS_WRITE(addr, value);
+                VM_NEXT();
+            }
+
+            VM_CASE(LOADM) {
+                // 地址在栈顶，读出的值直接替换栈顶
+                if (Checked && sp <= 0) throw std::runtime_error("Stack underflow");
+                int32_t addr = tos;
+                if (!validAddress(addr)) {
+                    throw std::runtime_error("LOADM: 内存访问越界");
+                }
+                tos = MEM_READ(addr);
+                VM_NEXT();
+            }
+
+            VM_CASE(STOREM) {
+                int32_t addr = pop();
+                int32_t value = pop();
+                if (!validAddress(addr)) {
+                    throw std::runtime_error("STOREM: 内存访问越界");
+                }
+                MEM_WRITE(addr, value);
+                VM_NEXT();
+            }
+
+            VM_CASE(LEA)
+                TOS_PUSH(stack_base + fp + ip->operand);
+                VM_NEXT();
+
+            VM_CASE(ADDPTR)
+                if (Checked && sp <= 0) throw std::runtime_error("Stack underflow");
+                tos += ip->operand;
+                VM_NEXT();
+
+            VM_CASE(ADDPTRD)
+                // base 在栈顶，index 在次栈顶
+                TOS_BINARY(b + a * ip->operand);
+                VM_NEXT();
+
+            VM_CASE(ADD) TOS_BINARY(a + b); VM_NEXT();
+            VM_CASE(SUB) TOS_BINARY(a - b); VM_NEXT();
+            VM_CASE(MUL) TOS_BINARY(a * b); VM_NEXT();
+            VM_CASE(DIV)
+                if (sp >= 1 && tos == 0) throw std::runtime_error("Division by zero");
+                TOS_BINARY(a / b);
+                VM_NEXT();
+            VM_CASE(MOD)
+                if (sp >= 1 && tos == 0) throw std::runtime_error("Division by zero");
+                TOS_BINARY(a % b);
+                VM_NEXT();
+            VM_CASE(NEG)
+                if (Checked && sp <= 0) throw std::runtime_error("Stack underflow");
+                tos = -tos;
+                VM_NEXT();
+
+            VM_CASE(EQ) TOS_BINARY(a == b ? 1 : 0); VM_NEXT();
+            VM_CASE(NE) TOS_BINARY(a != b ? 1 : 0); VM_NEXT();
+            VM_CASE(LT) TOS_BINARY(a < b ? 1 : 0); VM_NEXT();
+            VM_CASE(LE) TOS_BINARY(a <= b ? 1 : 0); VM_NEXT();
+            VM_CASE(GT) TOS_BINARY(a > b ? 1 : 0); VM_NEXT();
+            VM_CASE(GE) TOS_BINARY(a >= b ? 1 : 0); VM_NEXT();
+
+            VM_CASE(AND) TOS_BINARY((a && b) ? 1 : 0); VM_NEXT();
+            VM_CASE(OR)  TOS_BINARY((a || b) ? 1 : 0); VM_NEXT();
+            VM_CASE(NOT)
+                if (Checked && sp <= 0) throw std::runtime_error("Stack underflow");
+                tos = tos == 0 ? 1 : 0;
+                VM_NEXT();
+
+            VM_CASE(JMP)
+                pc = ip->operand;
+                VM_NEXT();
+
+            VM_CASE(JZ)
+                if (pop() == 0) pc = ip->operand;
+                VM_NEXT();
+
+            VM_CASE(JNZ)
+                if (pop() != 0) pc = ip->operand;
+                VM_NEXT();
+
+            VM_CASE(CALL)
+                TOS_PUSH(pc);
+                TOS_PUSH(fp);
+                fp = sp;
+                pc = ip->operand;
+                VM_NEXT();
+
+            VM_CASE(RET) {
+                // 先把栈顶写回内存，之后按 run() 中的帧布局直接访问 stack
+                stack[sp - 1] = tos;
+                int32_t retval = (sp > fp) ? stack[sp - 1] : 0;
+                stack[fp + ip->operand] = retval;
+
+                int32_t ret_addr = stack[fp - 2];
+                sp = fp - 2;
+                fp = stack[fp - 1];
+                tos = stack[sp - 1];
+
+                if (ret_addr == -1) {
+                    VM_EXIT();
+                }
+                if (ret_addr < 0 || ret_addr >= code_size) {
+                    throw std::runtime_error("RET: 返回地址越界");
+                }
+                pc = ret_addr;
+                VM_NEXT();
+            }
+
+            VM_CASE(RETN) {
+                int32_t dst = pop();
+                int32_t src = pop();
+                // 源区间可能包含栈顶，复制前同步 tos；返回后从调用者的栈顶重新加载
+                if (sp > 0) stack[sp - 1] = tos;
+                returnBlock(src, dst, ip->operand);
+
+                int32_t ret_addr = stack[fp - 2];
+                sp = fp - 2;
+                fp = stack[fp - 1];
+                tos = stack[sp - 1];
+
+                if (ret_addr == -1) {
+                    VM_EXIT();
+                }
+                if (ret_addr < 0 || ret_addr >= code_size) {
+                    throw std::runtime_error("RET: 返回地址越界");
+                }
+                pc = ret_addr;
+                VM_NEXT();
+            }
+
+            VM_CASE(PRINT)
+                std::cout << "OUTPUT: " << tos << "\n";
+                VM_NEXT();
+
+            VM_CASE(HALT)
+                VM_EXIT();
+
+            VM_CASE(ADJSP)
+                if constexpr (Checked) {
+                    if (sp - ip->operand > stack_size) {
+                        throw std::runtime_error("Stack overflow");
                     }
-                } else if (!src_is_global && dst_is_global) {
-                    // 栈到全局
-                    int dst_offset = dst - GLOBAL_BASE;
-                    if (src < 0 || src + size > STACK_SIZE ||
-                        dst_offset < 0 || dst_offset + size > (int)globals_.size()) {
-                        throw std::runtime_error("MEMCPY: 内存访问越界");
+                }
+                stack[sp - 1] = tos;
+                sp -= ip->operand;
+                tos = stack[sp > 0 ? sp - 1 : 0];
+                VM_NEXT();
+
+            VM_CASE(MEMCPY) {
+                int32_t dst = pop();
+                int32_t src = pop();
+                // 复制范围可能包含栈顶，复制前后同步 tos
+                if (sp > 0) stack[sp - 1] = tos;
+                copyMemory(src, dst, ip->operand);
+                if (sp > 0) tos = stack[sp - 1];
+                VM_NEXT();
+            }
+
+            VM_CASE(LOADMN) {
+                if (Checked && sp <= 0) throw std::runtime_error("Stack underflow");
+                // 地址出栈（写回它的 slot：源区间可能包含这个位置），加载的值从它开始压入
+                int32_t addr = tos;
+                stack[sp - 1] = tos;
+                --sp;
+                loadBlock(addr, ip->operand, sp);
+                sp += ip->operand;
+                tos = stack[sp > 0 ? sp - 1 : 0];
+                VM_NEXT();
+            }
+
+            VM_CASE(STOREMN) {
+                int32_t addr = pop();
+                if (Checked && sp < ip->operand) throw std::runtime_error("Stack underflow");
+                if (sp > 0) stack[sp - 1] = tos;
+                storeBlock(addr, ip->operand, sp - ip->operand);
+                sp -= ip->operand;
+                tos = stack[sp > 0 ? sp - 1 : 0];
+                VM_NEXT();
+            }
+
+            VM_CASE(LOADG) {
+                int32_t offset = ip->operand;
+                if constexpr (Checked) {
+                    if (offset < 0 || offset >= global_slots_) {
+                        throw std::runtime_error("LOADG: 全局变量访问越界");
                     }
-                    for (int32_t i = 0; i < size; i++) {
-                        globals_[dst_offset + i] = stack_[src + i];
+                }
+                TOS_PUSH(globals_[offset]);
+                VM_NEXT();
+            }
+
+            VM_CASE(STOREG) {
+                int32_t offset = ip->operand;
+                if constexpr (Checked) {
+                    if (offset < 0 || offset >= global_slots_) {
+                        throw std::runtime_error("STOREG: 全局变量访问越界");
                     }
+                }
+                globals_[offset] = pop();
+                VM_NEXT();
+            }
+
+            VM_CASE(LEAG)
+                TOS_PUSH(GLOBAL_BASE + ip->operand);
+                VM_NEXT();
+
+            // ===== 超级指令 =====
+
+            VM_CASE(INCLOCAL) {
+                int32_t addr = fp + ip->operand;
+                TOS_WRITE(addr, TOS_READ(addr) + ip[1].operand);
+                pc += 3;
+                VM_NEXT();
+            }
+
+            VM_CASE(JLT_LOCALS) {
+                int32_t a = fp + ip->operand;
+                int32_t b = fp + ip[1].operand;
+                if (TOS_READ(a) < TOS_READ(b)) {
+                    pc += 3;
                 } else {
-                    // 栈到栈
-                    if (src < 0 || src + size > STACK_SIZE ||
-                        dst < 0 || dst + size > STACK_SIZE) {
-                        throw std::runtime_error("MEMCPY: 栈访问越界");
-                    }
-                    for (int32_t i = 0; i < size; i++) {
-                        stack_[dst + i] = stack_[src + i];
-                    }
+                    pc = ip[3].operand;
                 }
-                break;
+                VM_NEXT();
             }
 
-            case OpCode::LOADG: {
-                // 加载全局变量: push(globals_[operand])
-                int32_t offset = instr.operand;
-                if (offset < 0 || offset >= (int)globals_.size()) {
-                    throw std::runtime_error("LOADG: 全局变量访问越界");
+            VM_CASE(JLT_LOCAL_CONST) {
+                int32_t a = fp + ip->operand;
+                if (TOS_READ(a) < ip[1].operand) {
+                    pc += 3;
+                } else {
+                    pc = ip[3].operand;
                 }
-                push(globals_[offset]);
-                break;
+                VM_NEXT();
             }
 
-            case OpCode::STOREG: {
-                // 存储全局变量: globals_[operand] = pop()
-                int32_t offset = instr.operand;
-                if (offset < 0 || offset >= (int)globals_.size()) {
-                    throw std::runtime_error("STOREG: 全局变量访问越界");
+            VM_CASE(JLE_LOCAL_CONST) {
+                int32_t a = fp + ip->operand;
+                if (TOS_READ(a) <= ip[1].operand) {
+                    pc += 3;
+                } else {
+                    pc = ip[3].operand;
                 }
-                globals_[offset] = pop();
-                break;
+                VM_NEXT();
             }
 
-            case OpCode::LEAG: {
-                // 加载全局变量地址: push(GLOBAL_BASE + operand)
-                push(GLOBAL_BASE + instr.operand);
-                break;
+            VM_CASE(LOADIDX) {
+                // index 在栈顶，读出的元素直接替换栈顶
+                if (Checked && sp <= 0) throw std::runtime_error("Stack underflow");
+                int32_t addr = stack_base + fp + ip->operand + tos * ip[1].operand;
+                if (!validAddress(addr)) {
+                    throw std::runtime_error("LOADM: 内存访问越界");
+                }
+                tos = MEM_READ(addr);
+                pc += 2;
+                VM_NEXT();
             }
         }
     }
 
-    return sp_ > 0 ? stack_[sp_ - 1] : 0;
+vm_exit:
+    // 写回成员
+    if (sp > 0) stack[sp - 1] = tos;
+    sp_ = sp;
+    fp_ = fp;
+    pc_ = pc;
+    running_ = false;
+    return sp > 0 ? tos : 0;
 }
+
+#undef TOS_READ
+#undef TOS_WRITE
+#undef MEM_READ
+#undef MEM_WRITE
+#undef TOS_PUSH
+#undef TOS_BINARY
+
+#undef VM_CASE
+#undef VM_NEXT
+#undef VM_EXIT
@@ -0,0 +1,110 @@
+#include "../include/vm_memory.h"
+#include <csignal>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// 当前线程正在执行、已登记保护页的内存
+static thread_local VMMemory* active_memory = nullptr;
+
+struct VMMemorySignal {
+    static struct sigaction previous;
+
+    static void install() {
+        // 第一次登记时安装，之后一直保留（不是保护页引起的 SIGSEGV 交还给原来的处理方式）
+        static const bool installed = [] {
+            struct sigaction action {};
+            action.sa_sigaction = &VMMemorySignal::handle;
+            action.sa_flags = SA_SIGINFO;
+            sigemptyset(&action.sa_mask);
+            sigaction(SIGSEGV, &action, &previous);
+            return true;
+        }();
+        (void)installed;
+    }
+
+    static void handle(int sig, siginfo_t* info, void* context) {
+        VMMemory* memory = active_memory;
+        if (memory) {
+            const char* addr = static_cast<const char*>(info->si_addr);
+            const char* low = reinterpret_cast<const char*>(memory->data_);
+            const char* high = low + static_cast<size_t>(memory->size_) * sizeof(int32_t);
+            size_t page = static_cast<size_t>(low - memory->mapping_);
+            int jump = 0;
+            if (addr >= memory->mapping_ && addr < low) {
+                jump = VMMemory::OUT_OF_RANGE_JUMP;
+            } else if (addr >= high && addr < high + page) {
+                jump = VMMemory::OVERFLOW_JUMP;
+            }
+            if (jump != 0) {
+                sigjmp_buf* env = memory->env_;
+                memory->disarm();
+                siglongjmp(*env, jump);
+            }
+        }
+
+        // 其他地址的段错误：恢复原来的处理方式后返回，出错的指令重新执行时按原来的方式处理。
+        // 加载的字节码文件都经过校验，LOAD/STORE 的帧偏移不会越出栈帧，走到这里说明是 VM 自身的错误
+        // （tests/test_bytecode_file.cpp 检查被改动的文件在加载时就被拒绝）
+        sigaction(sig, &previous, nullptr);
+        (void)context;
+    }
+};
+
+struct sigaction VMMemorySignal::previous;
+
+VMMemory::~VMMemory() {
+    release();
+}
+
+void VMMemory::resize(int slots) {
+    if (slots <= 0) {
+        throw std::runtime_error("VM 内存大小必须为正: " + std::to_string(slots));
+    }
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t bytes = (static_cast<size_t>(slots) * sizeof(int32_t) + page - 1) / page * page;
+    if (mapping_ && bytes == static_cast<size_t>(size_) * sizeof(int32_t)) {
+        return;
+    }
+
+    void* addr = mmap(nullptr, bytes + 2 * page, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (addr == MAP_FAILED) {
+        throw std::runtime_error("无法分配 VM 内存（" + std::to_string(slots) + " 个 slot）");
+    }
+    char* mapping = static_cast<char*>(addr);
+    if (mprotect(mapping, page, PROT_NONE) != 0 ||
+        mprotect(mapping + page + bytes, page, PROT_NONE) != 0) {
+        munmap(addr, bytes + 2 * page);
+        throw std::runtime_error("无法设置 VM 内存的保护页");
+    }
+
+    release();
+    mapping_ = mapping;
+    mapping_bytes_ = bytes + 2 * page;
+    data_ = reinterpret_cast<int32_t*>(mapping + page);
+    size_ = static_cast<int>(bytes / sizeof(int32_t));
+}
+
+void VMMemory::release() {
+    if (mapping_) {
+        munmap(mapping_, mapping_bytes_);
+        mapping_ = nullptr;
+        data_ = nullptr;
+        size_ = 0;
+    }
+}
+
+void VMMemory::arm(sigjmp_buf* env) {
+    VMMemorySignal::install();
+    env_ = env;
+    previous_ = active_memory;
+    active_memory = this;
+}
+
+void VMMemory::disarm() {
+    active_memory = previous_;
+    previous_ = nullptr;
+    env_ = nullptr;
+}
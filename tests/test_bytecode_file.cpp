@@ -0,0 +1,145 @@
+// test_bytecode_file.cpp
+// 字节码文件的加载：被改动过的文件必须在加载时报错，而不是交给不检查帧偏移的解释器执行
+
+#include "../include/lexer.h"
+#include "../include/parser.h"
+#include "../include/sema.h"
+#include "../include/codegen.h"
+#include "../include/vm.h"
+#include "../include/bytecode_file.h"
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+namespace {
+
+int failures = 0;
+
+void check(bool ok, const std::string& what) {
+    std::cout << (ok ? "  ✓ " : "  ✗ ") << what << "\n";
+    if (!ok) ++failures;
+}
+
+ByteCode compile(const std::string& source) {
+    Lexer lexer(source);
+    Parser parser(lexer);
+    auto program = parser.parseProgram();
+    Sema sema;
+    if (!sema.analyze(program.get())) throw std::runtime_error("语义分析失败");
+    CodeGen codegen;
+    return codegen.generate(program.get());
+}
+
+uint32_t getU32(const std::string& bytes, size_t pos) {
+    uint32_t value;
+    std::memcpy(&value, bytes.data() + pos, 4);
+    return value;
+}
+
+void putI32(std::string& bytes, size_t pos, int32_t value) {
+    std::memcpy(&bytes[pos], &value, 4);
+}
+
+// 第一条 op/operand 相同的指令的操作数在文件中的位置
+size_t findOperand(const std::string& bytes, OpCode op, int32_t operand) {
+    size_t code_offset = getU32(bytes, 36);
+    for (size_t pos = code_offset; pos + 8 <= bytes.size(); pos += 8) {
+        if (static_cast<unsigned char>(bytes[pos]) == static_cast<unsigned char>(op) &&
+            static_cast<int32_t>(getU32(bytes, pos + 4)) == operand) {
+            return pos + 4;
+        }
+    }
+    throw std::runtime_error("找不到指令");
+}
+
+// 写入临时文件后加载；返回加载时的错误信息，加载成功时返回空串
+std::string loadError(const std::string& bytes, ByteCode* loaded = nullptr) {
+    std::string path = (std::filesystem::temp_directory_path() /
+                        ("simplec_test_" + std::to_string(getpid()) + ".bc")).string();
+    {
+        std::ofstream out(path, std::ios::binary);
+        out.write(bytes.data(), bytes.size());
+    }
+    std::string message;
+    try {
+        ByteCode bytecode = BytecodeFile::load(path);
+        if (loaded) *loaded = std::move(bytecode);
+    } catch (const std::exception& e) {
+        message = e.what();
+    }
+    std::filesystem::remove(path);
+    return message;
+}
+
+bool isCorrupted(const std::string& message) {
+    return message.find("字节码文件已损坏") != std::string::npos;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "字节码文件加载测试\n";
+
+    // f 的参数在 fp-3，返回值 slot 在 fp-4；f 从地址 0 开始，在函数表的第一项
+    const std::string original = BytecodeFile::serialize(compile("int f(int a){return a;} int main(){return f(5);}"));
+    const size_t load_param = findOperand(original, OpCode::LOAD, -3);
+
+    {
+        ByteCode bytecode;
+        std::string message = loadError(original, &bytecode);
+        check(message.empty(), "未改动的文件可以加载" + (message.empty() ? "" : "（" + message + "）"));
+        if (message.empty()) {
+            VM vm;
+            check(vm.execute(bytecode) == 5, "加载后执行结果正确");
+        }
+    }
+    {
+        std::string bytes = original;
+        putI32(bytes, load_param, -200000000);
+        check(isCorrupted(loadError(bytes)), "LOAD 远超出栈帧的负偏移被拒绝");
+    }
+    {
+        std::string bytes = original;
+        putI32(bytes, load_param, -5);
+        check(isCorrupted(loadError(bytes)), "LOAD 越过参数和返回值的负偏移被拒绝");
+    }
+    {
+        std::string bytes = original;
+        putI32(bytes, load_param, -1);
+        check(isCorrupted(loadError(bytes)), "LOAD 保存的 fp 被拒绝");
+    }
+    {
+        std::string bytes = original;
+        putI32(bytes, load_param, 1000);
+        check(isCorrupted(loadError(bytes)), "LOAD 未分配的局部变量被拒绝");
+    }
+    {
+        // 函数表第一项 { 地址; 参数和返回值 slot 数; 名字长度; 名字 }
+        std::string bytes = original;
+        putI32(bytes, 44, 0x7FFFFFFF);
+        check(isCorrupted(loadError(bytes)), "函数表中无效的参数和返回值 slot 数被拒绝");
+    }
+    {
+        std::string bytes = original;
+        putI32(bytes, findOperand(bytes, OpCode::RET, -4), -3);
+        ByteCode bytecode;
+        check(loadError(bytes, &bytecode).empty(), "偏移仍在参数和返回值范围内时可以加载");
+    }
+    {
+        std::string bytes = original;
+        bytes.resize(bytes.size() - 4);
+        check(isCorrupted(loadError(bytes)), "截断的文件被拒绝");
+    }
+
+    if (failures > 0) {
+        std::cout << failures << " 项失败\n";
+        return 1;
+    }
+    std::cout << "全部通过\n";
+    return 0;
+}